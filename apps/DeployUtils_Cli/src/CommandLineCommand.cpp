@@ -30,8 +30,12 @@ QString commandName( CommandLineCommand command)
       return QLatin1String("get-shared-libraries-target-depends-on");
     case CommandLineCommand::CopySharedLibrariesTargetDependsOn:
       return QLatin1String("copy-shared-libraries-target-depends-on");
+    case CommandLineCommand::GenerateRuntimeEnvironmentTargetDependsOn:
+      return QLatin1String("generate-runtime-environment-target-depends-on");
     case CommandLineCommand::DeployApplication:
       return QLatin1String("deploy-application");
+    case CommandLineCommand::Serve:
+      return QLatin1String("serve");
   }
   return QString();
 }
@@ -44,9 +48,15 @@ CommandLineCommand commandFromString(const QString & command)
   if( command == commandName( CommandLineCommand::CopySharedLibrariesTargetDependsOn) ){
     return CommandLineCommand::CopySharedLibrariesTargetDependsOn;
   }
+  if( command == commandName( CommandLineCommand::GenerateRuntimeEnvironmentTargetDependsOn) ){
+    return CommandLineCommand::GenerateRuntimeEnvironmentTargetDependsOn;
+  }
   if( command == commandName( CommandLineCommand::DeployApplication) ){
     return CommandLineCommand::DeployApplication;
   }
+  if( command == commandName( CommandLineCommand::Serve) ){
+    return CommandLineCommand::Serve;
+  }
 
   return CommandLineCommand::Unknown;
 }
@@ -30,7 +30,9 @@ enum class CommandLineCommand
   Unknown,                            /*!< Unknown command */
   GetSharedLibrariesTargetDependsOn,  /*!< get-shared-libraries-target-depends-on command */
   CopySharedLibrariesTargetDependsOn, /*!< copy-shared-libraries-target-depends-on command */
-  DeployApplication                   /*!< deploy-application command */
+  GenerateRuntimeEnvironmentTargetDependsOn, /*!< generate-runtime-environment-target-depends-on command */
+  DeployApplication,                  /*!< deploy-application command */
+  Serve                               /*!< serve command */
 };
 
 /*! \brief Get command name for \a command
@@ -82,6 +82,10 @@ void CommandLineParser::process(const QStringList & arguments)
     }
   }
 
+  if( parserResult.isSet( mParserDefinition.asyncLoggerOption() ) ){
+    mIsAsyncLogger = true;
+  }
+
   const QStringList logLevelOptionValues = parserResult.getValues( mParserDefinition.logLevelOption() );
   if( !logLevelOptionValues.isEmpty() ){
     if( logLevelOptionValues.count() > 1 ){
@@ -108,6 +112,33 @@ void CommandLineParser::process(const QStringList & arguments)
       throw CommandLineParseError(message);
     }
   }
+
+  const QStringList serverOptionValues = parserResult.getValues( mParserDefinition.serverOption() );
+  if( !serverOptionValues.isEmpty() ){
+    if( serverOptionValues.count() > 1 ){
+      const QString message = tr("server option given more than once");
+      throw CommandLineParseError(message);
+    }
+    mServerName = serverOptionValues.at(0);
+  }
+
+  const QStringList fileStatBackendOptionValues = parserResult.getValues( mParserDefinition.fileStatBackendOption() );
+  if( !fileStatBackendOptionValues.isEmpty() ){
+    if( fileStatBackendOptionValues.count() > 1 ){
+      const QString message = tr("file-stat-backend option given more than once");
+      throw CommandLineParseError(message);
+    }
+    const QString backend = fileStatBackendOptionValues.at(0);
+    if( backend == QLatin1String("sync") ){
+      mFileStatBackend = FileStatBackend::Synchronous;
+    }else if( backend == QLatin1String("io_uring") ){
+      mFileStatBackend = FileStatBackend::IoUring;
+    }else{
+      const QString message = tr("given file stat backend '%1' is not supported").arg(backend);
+      throw CommandLineParseError(message);
+    }
+  }
+
 //   if( parserResult.isSet( mParserDefinition.verboseOption() ) ){
 //     mVerboseOptionIsSet = true;
 //   }
@@ -120,9 +151,15 @@ void CommandLineParser::process(const QStringList & arguments)
     case CommandLineCommand::CopySharedLibrariesTargetDependsOn:
       processCopySharedLibrariesTargetDependsOn( parserResult.subCommand() );
       return;
+    case CommandLineCommand::GenerateRuntimeEnvironmentTargetDependsOn:
+      processGenerateRuntimeEnvironmentTargetDependsOn( parserResult.subCommand() );
+      return;
     case CommandLineCommand::DeployApplication:
       processDeployApplicationCommand( parserResult.subCommand() );
       return;
+    case CommandLineCommand::Serve:
+      processServeCommand( parserResult.subCommand() );
+      return;
     case CommandLineCommand::Unknown:
       break;
   }
@@ -344,6 +381,10 @@ void CommandLineParser::processCopySharedLibrariesTargetDependsOn(const ParserRe
     mCopySharedLibrariesTargetDependsOnRequest.removeRpath = true;
   }
 
+  if( resultCommand.isSet( definition.pipelinedCopyOption() ) ){
+    mCopySharedLibrariesTargetDependsOnRequest.pipelinedCopy = true;
+  }
+
   const QChar pathListSeparator = parsePathListSeparator( resultCommand, definition.pathListSeparatorOption() );
 
   mCopySharedLibrariesTargetDependsOnRequest.searchPrefixPathList
@@ -352,6 +393,24 @@ void CommandLineParser::processCopySharedLibrariesTargetDependsOn(const ParserRe
   mCopySharedLibrariesTargetDependsOnRequest.compilerLocation
    = parseCompilerLocation( resultCommand, definition.compilerLocationOption() );
 
+  mCopySharedLibrariesTargetDependsOnRequest.redistributionPolicyFilePath
+   = parseSingleValueOption( resultCommand, definition.redistributionPolicyFileOption() );
+
+  mCopySharedLibrariesTargetDependsOnRequest.depFilePath
+   = parseSingleValueOption( resultCommand, definition.depFileOption() );
+
+  mCopySharedLibrariesTargetDependsOnRequest.stampFilePath
+   = parseSingleValueOption( resultCommand, definition.stampFileOption() );
+
+  if( !mCopySharedLibrariesTargetDependsOnRequest.depFilePath.isEmpty() && mCopySharedLibrariesTargetDependsOnRequest.stampFilePath.isEmpty() ){
+    const QString message = tr("%1 option requires the %2 option")
+                            .arg( definition.depFileOption().name(), definition.stampFileOption().name() );
+    throw CommandLineParseError(message);
+  }
+
+  mCopySharedLibrariesTargetDependsOnRequest.deployStoreDirectoryPath
+   = parseSingleValueOption( resultCommand, definition.deployStoreOption() );
+
   if( resultCommand.positionalArgumentCount() != 2 ){
     const QString message = tr(
       "expected 2 (positional) arguments: target file and destination directory.\n"
@@ -364,6 +423,43 @@ void CommandLineParser::processCopySharedLibrariesTargetDependsOn(const ParserRe
   mCopySharedLibrariesTargetDependsOnRequest.destinationDirectoryPath = resultCommand.positionalArgumentAt(1);
 }
 
+void CommandLineParser::processGenerateRuntimeEnvironmentTargetDependsOn(const ParserResultCommand & resultCommand)
+{
+  mCommand = CommandLineCommand::GenerateRuntimeEnvironmentTargetDependsOn;
+
+  if( resultCommand.isHelpOptionSet() ){
+    showInfo( mParserDefinition.getGenerateRuntimeEnvironmentTargetDependsOnHelpText() );
+    std::exit(0);
+  }
+
+  const GenerateRuntimeEnvironmentTargetDependsOnCommandLineParserDefinition & definition = mParserDefinition.generateRuntimeEnvironmentTargetDependsOn();
+
+  const QChar pathListSeparator = parsePathListSeparator( resultCommand, definition.pathListSeparatorOption() );
+
+  mGenerateRuntimeEnvironmentTargetDependsOnRequest.searchPrefixPathList
+   = parseSearchPrefixPathList( resultCommand, definition.searchPrefixPathListOption(), pathListSeparator );
+
+  mGenerateRuntimeEnvironmentTargetDependsOnRequest.compilerLocation
+   = parseCompilerLocation( resultCommand, definition.compilerLocationOption() );
+
+  mGenerateRuntimeEnvironmentTargetDependsOnRequest.redistributionPolicyFilePath
+   = parseSingleValueOption( resultCommand, definition.redistributionPolicyFileOption() );
+
+  mGenerateRuntimeEnvironmentTargetDependsOnRequest.depFilePath
+   = parseSingleValueOption( resultCommand, definition.depFileOption() );
+
+  if( resultCommand.positionalArgumentCount() != 2 ){
+    const QString message = tr(
+      "expected 2 (positional) arguments: target file and environment file.\n"
+      "given: %1"
+    ).arg( resultCommand.positionalArguments().join( QLatin1Char(',') ) );
+    throw CommandLineParseError(message);
+  }
+
+  mGenerateRuntimeEnvironmentTargetDependsOnRequest.targetFilePath = resultCommand.positionalArgumentAt(0);
+  mGenerateRuntimeEnvironmentTargetDependsOnRequest.environmentFilePath = resultCommand.positionalArgumentAt(1);
+}
+
 void CommandLineParser::processDeployApplicationCommand(const Mdt::CommandLineParser::ParserResultCommand & resultCommand)
 {
   mCommand = CommandLineCommand::DeployApplication;
@@ -395,14 +491,69 @@ void CommandLineParser::processDeployApplicationCommand(const Mdt::CommandLinePa
 
   parseQtPluginsSet( mDeployApplicationRequest.qtPluginsSet, resultCommand, definition.qtPluginsSetOption() );
 
-  if( resultCommand.positionalArgumentCount() != 2 ){
+  mDeployApplicationRequest.redistributionPolicyFilePath
+   = parseSingleValueOption( resultCommand, definition.redistributionPolicyFileOption() );
+
+  if( resultCommand.isSet( definition.ignoreDeployManifestOption() ) ){
+    mDeployApplicationRequest.ignoreDeployManifest = true;
+  }
+
+  if( resultCommand.isSet( definition.pruneOption() ) ){
+    mDeployApplicationRequest.pruneStaleFiles = true;
+  }
+
+  mDeployApplicationRequest.deployStoreDirectoryPath
+   = parseSingleValueOption( resultCommand, definition.deployStoreOption() );
+
+  mDeployApplicationRequest.archiveFilePath
+   = parseSingleValueOption( resultCommand, definition.archiveOption() );
+
+  if( resultCommand.positionalArgumentCount() < 2 ){
     const QString message = tr(
-      "expected 2 (positional) arguments: target file and destination directory.\n"
+      "expected at least 2 (positional) arguments: target file(s) and destination directory.\n"
+      "given: %1"
+    ).arg( resultCommand.positionalArguments().join( QLatin1Char(',') ) );
+    throw CommandLineParseError(message);
+  }
+
+  const QStringList positionalArguments = resultCommand.positionalArguments();
+  const int destinationIndex = positionalArguments.count() - 1;
+
+  mDeployApplicationRequest.targetFilePath = positionalArguments.at(0);
+  mDeployApplicationRequest.additionalTargetFilePathList = positionalArguments.mid(1, destinationIndex - 1);
+  mDeployApplicationRequest.destinationDirectoryPath = positionalArguments.at(destinationIndex);
+}
+
+void CommandLineParser::processServeCommand(const Mdt::CommandLineParser::ParserResultCommand & resultCommand)
+{
+  mCommand = CommandLineCommand::Serve;
+
+  if( resultCommand.isHelpOptionSet() ){
+    showInfo( mParserDefinition.getServeHelpText() );
+    std::exit(0);
+  }
+
+  const ServeCommandLineParserDefinition & definition = mParserDefinition.serve();
+
+  const QString idleTimeoutString = parseSingleValueOption( resultCommand, definition.idleTimeoutOption() );
+  if( !idleTimeoutString.isEmpty() ){
+    bool ok = false;
+    const int idleTimeout = idleTimeoutString.toInt(&ok);
+    if( !ok || (idleTimeout < 0) ){
+      const QString message = tr("%1 option expects a positive number of seconds, given %2")
+                              .arg(definition.idleTimeoutOption().name(), idleTimeoutString);
+      throw CommandLineParseError(message);
+    }
+    mServeIdleTimeoutSeconds = idleTimeout;
+  }
+
+  if( resultCommand.positionalArgumentCount() != 1 ){
+    const QString message = tr(
+      "expected 1 (positional) argument: the socket name.\n"
       "given: %1"
     ).arg( resultCommand.positionalArguments().join( QLatin1Char(',') ) );
     throw CommandLineParseError(message);
   }
 
-  mDeployApplicationRequest.targetFilePath = resultCommand.positionalArgumentAt(0);
-  mDeployApplicationRequest.destinationDirectoryPath = resultCommand.positionalArgumentAt(1);
+  mServeSocketName = resultCommand.positionalArgumentAt(0);
 }
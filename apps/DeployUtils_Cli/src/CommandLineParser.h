@@ -29,11 +29,14 @@
 #include "Mdt/CommandLineParser/ParserDefinitionCommand.h"
 #include "Mdt/CommandLineParser/ParserResultCommand.h"
 #include "Mdt/DeployUtils/LogLevel.h"
+#include "Mdt/DeployUtils/FileStatBackend.h"
 #include "Mdt/DeployUtils/OverwriteBehavior.h"
 #include "Mdt/DeployUtils/CompilerLocationRequest.h"
 #include "Mdt/DeployUtils/CopySharedLibrariesTargetDependsOnRequest.h"
+#include "Mdt/DeployUtils/GenerateRuntimeEnvironmentTargetDependsOnRequest.h"
 #include "Mdt/DeployUtils/DeployApplicationRequest.h"
 #include <QObject>
+#include <QString>
 #include <QStringList>
 #include <QChar>
 #include <cassert>
@@ -81,6 +84,15 @@ class CommandLineParser : public QObject
     return mMessageLoggerBackend;
   }
 
+  /*! \brief Check if messages should be written from a background thread
+   *
+   * \sa Mdt::DeployUtils::AsyncConsoleMessageLogger
+   */
+  bool isAsyncLogger() const noexcept
+  {
+    return mIsAsyncLogger;
+  }
+
   /*! \brief get the choosen log level
    */
   Mdt::DeployUtils::LogLevel logLevel() const noexcept
@@ -88,6 +100,46 @@ class CommandLineParser : public QObject
     return mLogLevel;
   }
 
+  /*! \brief Get the choosen file stat backend
+   */
+  Mdt::DeployUtils::FileStatBackend fileStatBackend() const noexcept
+  {
+    return mFileStatBackend;
+  }
+
+  /*! \brief Get the name of the server to forward the command to
+   *
+   * Returns a empty string if the server option was not given
+   */
+  const QString & serverName() const noexcept
+  {
+    return mServerName;
+  }
+
+  /*! \brief Get the name of the socket the server must listen to
+   *
+   * \pre processedCommand() must be Serve
+   */
+  const QString & serveSocketName() const noexcept
+  {
+    assert( processedCommand() == CommandLineCommand::Serve );
+
+    return mServeSocketName;
+  }
+
+  /*! \brief Get the idle timeout of the server, in seconds
+   *
+   * A value of 0 means no timeout.
+   *
+   * \pre processedCommand() must be Serve
+   */
+  int serveIdleTimeoutSeconds() const noexcept
+  {
+    assert( processedCommand() == CommandLineCommand::Serve );
+
+    return mServeIdleTimeoutSeconds;
+  }
+
   /*! \brief Get the DTO to copy shared libraries a target depends on
    *
    * \pre processedCommand() must be CopySharedLibrariesTargetDependsOn
@@ -99,6 +151,17 @@ class CommandLineParser : public QObject
     return mCopySharedLibrariesTargetDependsOnRequest;
   }
 
+  /*! \brief Get the DTO to generate the runtime environment of a target
+   *
+   * \pre processedCommand() must be GenerateRuntimeEnvironmentTargetDependsOn
+   */
+  const Mdt::DeployUtils::GenerateRuntimeEnvironmentTargetDependsOnRequest & generateRuntimeEnvironmentTargetDependsOnRequest() const noexcept
+  {
+    assert( processedCommand() == CommandLineCommand::GenerateRuntimeEnvironmentTargetDependsOn );
+
+    return mGenerateRuntimeEnvironmentTargetDependsOnRequest;
+  }
+
   /*! \brief Get the DTO to deploy a application
    *
    * \pre processedCommand() must be DeployApplication
@@ -157,12 +220,20 @@ class CommandLineParser : public QObject
 
   void processGetSharedLibrariesTargetDependsOn(const Mdt::CommandLineParser::ParserResultCommand & resultCommand);
   void processCopySharedLibrariesTargetDependsOn(const Mdt::CommandLineParser::ParserResultCommand & resultCommand);
+  void processGenerateRuntimeEnvironmentTargetDependsOn(const Mdt::CommandLineParser::ParserResultCommand & resultCommand);
   void processDeployApplicationCommand(const Mdt::CommandLineParser::ParserResultCommand & resultCommand);
+  void processServeCommand(const Mdt::CommandLineParser::ParserResultCommand & resultCommand);
 
   CommandLineCommand mCommand = CommandLineCommand::Unknown;
   MessageLoggerBackend mMessageLoggerBackend = MessageLoggerBackend::Console;
+  bool mIsAsyncLogger = false;
   Mdt::DeployUtils::LogLevel mLogLevel = Mdt::DeployUtils::LogLevel::Status;
+  Mdt::DeployUtils::FileStatBackend mFileStatBackend = Mdt::DeployUtils::FileStatBackend::Synchronous;
+  QString mServerName;
+  QString mServeSocketName;
+  int mServeIdleTimeoutSeconds = 0;
   Mdt::DeployUtils::CopySharedLibrariesTargetDependsOnRequest mCopySharedLibrariesTargetDependsOnRequest;
+  Mdt::DeployUtils::GenerateRuntimeEnvironmentTargetDependsOnRequest mGenerateRuntimeEnvironmentTargetDependsOnRequest;
   Mdt::DeployUtils::DeployApplicationRequest mDeployApplicationRequest;
   CommandLineParserDefinition mParserDefinition;
 };
@@ -62,13 +62,50 @@ CommandLineParserDefinition::CommandLineParserDefinition(QObject *parent) noexce
   logLevelOption.setPossibleValues({QLatin1String("STATUS"),QLatin1String("VERBOSE"),QLatin1String("DEBUG")});
   mParserDefinition.addOption(logLevelOption);
 
+  const QString serverDescription = tr(
+    "Send the command to a server started with the serve command, listening to given socket, "
+    "instead of executing it in this process.\n"
+    "The server executes the command in the working directory and with the environment variables of this process.\n"
+    "The server keeps the informations it read from executables and shared libraries between requests.\n"
+    "If the server can not be reached, the command is executed in this process."
+  );
+  ParserDefinitionOption serverOption( QLatin1String("server"), serverDescription );
+  serverOption.setValueName( QLatin1String("socket") );
+  mParserDefinition.addOption(serverOption);
+
+  const QString fileStatBackendDescription = tr(
+    "Backend used to stat the files where shared libraries are searched.\n"
+    "Available backends:\n"
+    "- sync (the default): each file is stat'ed when a library is searched\n"
+    "- io_uring: the files where all the libraries of a pass could be are stat'ed in batches using io_uring (Linux only)."
+    " If io_uring is not available on the host, sync is used."
+  );
+  ParserDefinitionOption fileStatBackendOption( QLatin1String("file-stat-backend"), fileStatBackendDescription );
+  fileStatBackendOption.setValueName( QLatin1String("backend") );
+  fileStatBackendOption.setPossibleValues({QLatin1String("sync"),QLatin1String("io_uring")});
+  mParserDefinition.addOption(fileStatBackendOption);
+
+  const QString asyncLoggerDescription = tr(
+    "Write the messages from a background thread, in batches, instead of flushing the output for each message.\n"
+    "This can save time with many messages (for example with DEBUG log level) when the output is captured.\n"
+    "Errors, and the messages that precede them, are still written immediately."
+  );
+  ParserDefinitionOption asyncLoggerOption( QLatin1String("async-logger"), asyncLoggerDescription );
+  mParserDefinition.addOption(asyncLoggerOption);
+
   addGetSharedLibrariesTargetDependsOnCommand();
 
   mCopySharedLibrariesTargetDependsOnDefinition.setApplicationName( mParserDefinition.applicationName() );
   mCopySharedLibrariesTargetDependsOnDefinition.setup();
   mParserDefinition.addSubCommand( mCopySharedLibrariesTargetDependsOnDefinition.command() );
 
+  mGenerateRuntimeEnvironmentTargetDependsOnDefinition.setApplicationName( mParserDefinition.applicationName() );
+  mGenerateRuntimeEnvironmentTargetDependsOnDefinition.setup();
+  mParserDefinition.addSubCommand( mGenerateRuntimeEnvironmentTargetDependsOnDefinition.command() );
+
   addDeployApplicationCommand();
+
+  addServeCommand();
 }
 
 QString CommandLineParserDefinition::getGetSharedLibrariesTargetDependsOnHelpText() const noexcept
@@ -81,11 +118,21 @@ QString CommandLineParserDefinition::getCopySharedLibrariesTargetDependsOnHelpTe
   return mParserDefinition.getSubCommandHelpText( commandName(CommandLineCommand::CopySharedLibrariesTargetDependsOn) );
 }
 
+QString CommandLineParserDefinition::getGenerateRuntimeEnvironmentTargetDependsOnHelpText() const noexcept
+{
+  return mParserDefinition.getSubCommandHelpText( commandName(CommandLineCommand::GenerateRuntimeEnvironmentTargetDependsOn) );
+}
+
 QString CommandLineParserDefinition::getDeployApplicationHelpText() const noexcept
 {
   return mParserDefinition.getSubCommandHelpText( commandName(CommandLineCommand::DeployApplication) );
 }
 
+QString CommandLineParserDefinition::getServeHelpText() const noexcept
+{
+  return mParserDefinition.getSubCommandHelpText( commandName(CommandLineCommand::Serve) );
+}
+
 void CommandLineParserDefinition::setApplicationDescription()
 {
   const QString description = tr(
@@ -123,3 +170,10 @@ void CommandLineParserDefinition::addDeployApplicationCommand()
   mDeployApplicationCommandLineParserDefinition.setup();
   mParserDefinition.addSubCommand( mDeployApplicationCommandLineParserDefinition.command() );
 }
+
+void CommandLineParserDefinition::addServeCommand()
+{
+  mServeCommandLineParserDefinition.setApplicationName( mParserDefinition.applicationName() );
+  mServeCommandLineParserDefinition.setup();
+  mParserDefinition.addSubCommand( mServeCommandLineParserDefinition.command() );
+}
@@ -22,7 +22,9 @@
 #define COMMAND_LINE_PARSER_DEFINITION_H
 
 #include "CopySharedLibrariesTargetDependsOnCommandLineParserDefinition.h"
+#include "GenerateRuntimeEnvironmentTargetDependsOnCommandLineParserDefinition.h"
 #include "DeployApplicationCommandLineParserDefinition.h"
+#include "ServeCommandLineParserDefinition.h"
 #include "Mdt/CommandLineParser/ParserDefinition.h"
 #include "Mdt/CommandLineParser/ParserDefinitionOption.h"
 #include <QObject>
@@ -62,6 +64,27 @@ class CommandLineParserDefinition : public QObject
     return mParserDefinition.optionAt(2);
   }
 
+  /*! \brief Get the server option
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & serverOption() const noexcept
+  {
+    return mParserDefinition.optionAt(3);
+  }
+
+  /*! \brief Get the file-stat-backend option
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & fileStatBackendOption() const noexcept
+  {
+    return mParserDefinition.optionAt(4);
+  }
+
+  /*! \brief Get the async-logger option
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & asyncLoggerOption() const noexcept
+  {
+    return mParserDefinition.optionAt(5);
+  }
+
   /*! \brief Get the help text for the "Get Shared Libraries Target Depends On" command
    */
   QString getGetSharedLibrariesTargetDependsOnHelpText() const noexcept;
@@ -70,10 +93,18 @@ class CommandLineParserDefinition : public QObject
    */
   QString getCopySharedLibrariesTargetDependsOnHelpText() const noexcept;
 
+  /*! \brief Get the help text for the "Generate Runtime Environment Target Depends On" command
+   */
+  QString getGenerateRuntimeEnvironmentTargetDependsOnHelpText() const noexcept;
+
   /*! \brief Get the help text for the "Deploy Application" command
    */
   QString getDeployApplicationHelpText() const noexcept;
 
+  /*! \brief Get the help text for the "Serve" command
+   */
+  QString getServeHelpText() const noexcept;
+
   /*! \brief Get the parser definition
    */
   const Mdt::CommandLineParser::ParserDefinition & parserDefinition() const noexcept
@@ -88,6 +119,13 @@ class CommandLineParserDefinition : public QObject
     return mCopySharedLibrariesTargetDependsOnDefinition;
   }
 
+  /*! \brief Get the "Generate Runtime Environment Target Depends On" command
+   */
+  const GenerateRuntimeEnvironmentTargetDependsOnCommandLineParserDefinition & generateRuntimeEnvironmentTargetDependsOn() const noexcept
+  {
+    return mGenerateRuntimeEnvironmentTargetDependsOnDefinition;
+  }
+
   /*! \brief Get the "Deploy Application" command
    */
   const DeployApplicationCommandLineParserDefinition & deployApplication() const noexcept
@@ -95,16 +133,26 @@ class CommandLineParserDefinition : public QObject
     return mDeployApplicationCommandLineParserDefinition;
   }
 
+  /*! \brief Get the "Serve" command
+   */
+  const ServeCommandLineParserDefinition & serve() const noexcept
+  {
+    return mServeCommandLineParserDefinition;
+  }
+
  private:
 
   void setApplicationDescription();
   void addGetSharedLibrariesTargetDependsOnCommand();
   void addDeployApplicationCommand();
+  void addServeCommand();
 
   Mdt::CommandLineParser::ParserDefinition mParserDefinition;
   CopySharedLibrariesTargetDependsOnCommandLineParserDefinition mCopySharedLibrariesTargetDependsOnDefinition;
+  GenerateRuntimeEnvironmentTargetDependsOnCommandLineParserDefinition mGenerateRuntimeEnvironmentTargetDependsOnDefinition;
   Mdt::CommandLineParser::ParserDefinitionCommand mGetSharedLibrariesTargetDependsOnCommand;
   DeployApplicationCommandLineParserDefinition mDeployApplicationCommandLineParserDefinition;
+  ServeCommandLineParserDefinition mServeCommandLineParserDefinition;
 };
 
 #endif // #ifndef COMMAND_LINE_PARSER_DEFINITION_H
@@ -69,3 +69,38 @@ Mdt::CommandLineParser::ParserDefinitionOption CommonCommandLineParserDefinition
 
   return option;
 }
+
+ParserDefinitionOption CommonCommandLineParserDefinitionOptions::makeRedistributionPolicyFileOption() noexcept
+{
+  const QString description = tr(
+    "Path to a file that defines which shared libraries are redistributed.\n"
+    "Each line is a rule of the form 'exclude pattern' or 'include pattern', "
+    "where pattern is a library name, or a glob like libnss_* .\n"
+    "Rules can be put in [all], [linux] or [windows] sections.\n"
+    "A include rule wins over a exclude rule, "
+    "and the rules of this file win over the built-in exclude lists."
+  );
+  ParserDefinitionOption option( QLatin1String("redistribution-policy-file"), description );
+  option.setValueName( QLatin1String("file") );
+
+  return option;
+}
+
+ParserDefinitionOption CommonCommandLineParserDefinitionOptions::makeDeployStoreOption() noexcept
+{
+  const QString description = tr(
+    "Path to a directory used as a content-addressed store for the shared libraries.\n"
+    "Each shared library is put once in the store, keyed by the hash of its content, "
+    "and linked to the destination (reflink if the file system supports it, otherwise hard link).\n"
+    "Shared libraries which RPATH has been changed are stored as a other content, "
+    "which is changed once per RPATH.\n"
+    "The store should be on the same file system as the destination, "
+    "otherwise the shared libraries are copied.\n"
+    "A hard linked shared library must not be changed in place (for example by strip), "
+    "because this also changes every other destination that shares it."
+  );
+  ParserDefinitionOption option( QLatin1String("deploy-store"), description );
+  option.setValueName( QLatin1String("directory") );
+
+  return option;
+}
@@ -42,6 +42,12 @@ class CommonCommandLineParserDefinitionOptions : public QObject
 
   static
   Mdt::CommandLineParser::ParserDefinitionOption makePathListSeparatorOption() noexcept;
+
+  static
+  Mdt::CommandLineParser::ParserDefinitionOption makeRedistributionPolicyFileOption() noexcept;
+
+  static
+  Mdt::CommandLineParser::ParserDefinitionOption makeDeployStoreOption() noexcept;
 };
 
 #endif // #ifndef COMMON_COMMAND_LINE_PARSER_DEFINITION_OPTIONS_H
@@ -72,4 +72,31 @@ void CopySharedLibrariesTargetDependsOnCommandLineParserDefinition::setup() noex
   mCommand.addOption( CommonCommandLineParserDefinitionOptions::makePathListSeparatorOption() );
 
   mCommand.addOption( CommonCommandLineParserDefinitionOptions::makeCompilerLocationOption() );
+
+  mCommand.addOption( CommonCommandLineParserDefinitionOptions::makeRedistributionPolicyFileOption() );
+
+  const QString pipelinedCopyOptionDescription = tr(
+    "Copy each shared library as soon as it is found, while the other dependencies are still searched.\n"
+    "If some dependencies could not be found, the shared libraries copied by this command are removed."
+  );
+  mCommand.addOption( QLatin1String("pipelined-copy"), pipelinedCopyOptionDescription );
+
+  const QString depFileOptionDescription = tr(
+    "Path to a depfile to write once the shared libraries have been copied.\n"
+    "It lists the target and each shared library that has been found, "
+    "as dependencies of the stamp file, using the Makefile syntax (understood by Make and Ninja).\n"
+    "Requires --stamp-file."
+  );
+  ParserDefinitionOption depFileOption( QLatin1String("depfile"), depFileOptionDescription );
+  depFileOption.setValueName( QLatin1String("file") );
+  mCommand.addOption(depFileOption);
+
+  const QString stampFileOptionDescription = tr(
+    "Path to a stamp file to write (or update) once the shared libraries have been copied."
+  );
+  ParserDefinitionOption stampFileOption( QLatin1String("stamp-file"), stampFileOptionDescription );
+  stampFileOption.setValueName( QLatin1String("file") );
+  mCommand.addOption(stampFileOption);
+
+  mCommand.addOption( CommonCommandLineParserDefinitionOptions::makeDeployStoreOption() );
 }
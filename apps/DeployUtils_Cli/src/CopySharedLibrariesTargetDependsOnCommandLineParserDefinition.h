@@ -113,6 +113,66 @@ class CopySharedLibrariesTargetDependsOnCommandLineParserDefinition : public QOb
     return mCommand.optionAt(5);
   }
 
+  /*! \brief Get the redistribution policy file option
+   *
+   * \pre setup must have been done before
+   * \sa setup()
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & redistributionPolicyFileOption() const noexcept
+  {
+    assert( mCommand.hasOptions() );
+
+    return mCommand.optionAt(6);
+  }
+
+  /*! \brief Get the pipelined copy option
+   *
+   * \pre setup must have been done before
+   * \sa setup()
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & pipelinedCopyOption() const noexcept
+  {
+    assert( mCommand.hasOptions() );
+
+    return mCommand.optionAt(7);
+  }
+
+  /*! \brief Get the depfile option
+   *
+   * \pre setup must have been done before
+   * \sa setup()
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & depFileOption() const noexcept
+  {
+    assert( mCommand.hasOptions() );
+
+    return mCommand.optionAt(8);
+  }
+
+  /*! \brief Get the stamp file option
+   *
+   * \pre setup must have been done before
+   * \sa setup()
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & stampFileOption() const noexcept
+  {
+    assert( mCommand.hasOptions() );
+
+    return mCommand.optionAt(9);
+  }
+
+  /*! \brief Get the deploy store option
+   *
+   * \pre setup must have been done before
+   * \sa setup()
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & deployStoreOption() const noexcept
+  {
+    assert( mCommand.hasOptions() );
+
+    return mCommand.optionAt(10);
+  }
+
   /*! \brief Get the internal parser definition command
    */
   const Mdt::CommandLineParser::ParserDefinitionCommand & command() const noexcept
@@ -38,8 +38,11 @@ void DeployApplicationCommandLineParserDefinition::setup() noexcept
   const QString description = tr(
     "Deploy a application on the base of given executable.\n"
     "The executable and the required dependencies will be copied to a deployable directory.\n"
+    "Several executables can be given, they are then deployed to the same directory, with the same options. "
+    "This is faster than deploying each one separately, because the dependencies they share are discovered once.\n"
     "Example:\n"
-    "%1 %2 ./myApp /path/to/myAppFolder"
+    "%1 %2 ./myApp /path/to/myAppFolder\n"
+    "%1 %2 ./myApp ./myAppTool /path/to/myAppFolder"
   ).arg( mApplicationName, mCommand.name() );
   mCommand.setDescription(description);
 
@@ -120,7 +123,42 @@ void DeployApplicationCommandLineParserDefinition::setup() noexcept
   qtPluginsSetOption.setValueName( QLatin1String("set") );
   mCommand.addOption(qtPluginsSetOption);
 
-  mCommand.addPositionalArgument( ValueType::File, QLatin1String("executable"), tr("Path to the application executable.") );
+  mCommand.addOption( CommonCommandLineParserDefinitionOptions::makeRedistributionPolicyFileOption() );
+
+  const QString ignoreDeployManifestOptionDescription = tr(
+    "At the end of each deploy, a manifest of the deployed files is written to the destination directory "
+    "(in the .mdtdeployutils sub-directory).\n"
+    "On next deploy of the same executables to the same destination, with the same options, "
+    "nothing is done if no file changed, otherwise only the files that changed are copied.\n"
+    "With this option, the manifest is ignored and all files are deployed again. "
+    "This can be required if a shared library has been added to a directory of the search path."
+  );
+  mCommand.addOption( QLatin1String("ignore-deploy-manifest"), ignoreDeployManifestOptionDescription );
+
+  const QString pruneOptionDescription = tr(
+    "Remove the files deployed by a previous deploy of the same executables "
+    "that are no longer required.\n"
+    "Only files listed in the deploy manifest are removed, "
+    "and files still required by a other application deployed to the same destination are kept."
+  );
+  mCommand.addOption( QLatin1String("prune"), pruneOptionDescription );
+
+  mCommand.addOption( CommonCommandLineParserDefinitionOptions::makeDeployStoreOption() );
+
+  const QString archiveOptionDescription = tr(
+    "Write the application to this archive instead of the destination directory.\n"
+    "The name of the destination directory is used as root directory in the archive, "
+    "and nothing is written to the destination directory.\n"
+    "Each file is read once and written to the archive, "
+    "RPATH being updated in memory.\n"
+    "A archive ending with .tar.zst (or .tzst) is compressed with zstd, using all cores "
+    "(zstd must be in the PATH), otherwise a plain tar archive is written."
+  );
+  ParserDefinitionOption archiveOption( QLatin1String("archive"), archiveOptionDescription );
+  archiveOption.setValueName( QLatin1String("file") );
+  mCommand.addOption(archiveOption);
+
+  mCommand.addPositionalArgument( ValueType::File, QLatin1String("executable"), tr("Path to the application executable. Can be given more than once.") );
 
   const QString destinationDirectoryDescription = tr(
     "Path to the destination directory.\n"
@@ -149,6 +149,66 @@ class DeployApplicationCommandLineParserDefinition : public QObject
     return mCommand.optionAt(8);
   }
 
+  /*! \brief Get the redistribution policy file option
+   *
+   * \pre setup must have been done before
+   * \sa setup()
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & redistributionPolicyFileOption() const noexcept
+  {
+    assert( mCommand.hasOptions() );
+
+    return mCommand.optionAt(9);
+  }
+
+  /*! \brief Get the ignore deploy manifest option
+   *
+   * \pre setup must have been done before
+   * \sa setup()
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & ignoreDeployManifestOption() const noexcept
+  {
+    assert( mCommand.hasOptions() );
+
+    return mCommand.optionAt(10);
+  }
+
+  /*! \brief Get the prune option
+   *
+   * \pre setup must have been done before
+   * \sa setup()
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & pruneOption() const noexcept
+  {
+    assert( mCommand.hasOptions() );
+
+    return mCommand.optionAt(11);
+  }
+
+  /*! \brief Get the deploy store option
+   *
+   * \pre setup must have been done before
+   * \sa setup()
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & deployStoreOption() const noexcept
+  {
+    assert( mCommand.hasOptions() );
+
+    return mCommand.optionAt(12);
+  }
+
+  /*! \brief Get the archive option
+   *
+   * \pre setup must have been done before
+   * \sa setup()
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & archiveOption() const noexcept
+  {
+    assert( mCommand.hasOptions() );
+
+    return mCommand.optionAt(13);
+  }
+
   /*! \brief Get the internal parser definition command
    */
   const Mdt::CommandLineParser::ParserDefinitionCommand & command() const noexcept
@@ -0,0 +1,97 @@
+/*******************************************************************************************
+ **
+ ** MdtDeployUtils - Tools to help deploy C/C++ application binaries and their dependencies.
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **
+ ***********************************************************************************************/
+#include "DeployUtilsClient.h"
+#include "DeployUtilsServerProtocol.h"
+#include "Mdt/DeployUtils/MessageLogger.h"
+#include <QLocalSocket>
+#include <QDataStream>
+#include <QDir>
+#include <QProcessEnvironment>
+#include <cassert>
+
+using namespace Mdt::DeployUtils;
+
+/* Time, in milliseconds, we wait for the server to accept the connection.
+ * Once connected, we wait as long as the server works.
+ */
+static constexpr int connectTimeoutMs = 1000;
+
+DeployUtilsClient::DeployUtilsClient(QObject *parent) noexcept
+ : QObject(parent)
+{
+}
+
+std::optional<int> DeployUtilsClient::forward(const QString & socketName, const QStringList & arguments)
+{
+  assert( !socketName.isEmpty() );
+  assert( MessageLogger::isInitialized() );
+
+  QLocalSocket socket;
+  socket.connectToServer(socketName);
+  if( !socket.waitForConnected(connectTimeoutMs) ){
+    return {};
+  }
+
+  QDataStream stream(&socket);
+  stream.setVersion(DeployUtilsServerProtocol::dataStreamVersion);
+
+  stream << DeployUtilsServerProtocol::magic
+         << DeployUtilsServerProtocol::protocolVersion
+         << QDir::currentPath()
+         << QProcessEnvironment::systemEnvironment().toStringList()
+         << arguments;
+  while( socket.bytesToWrite() > 0 ){
+    if( !socket.waitForBytesWritten(connectTimeoutMs) ){
+      const QString message = tr("sending the request to server '%1' failed: %2")
+                              .arg( socketName, socket.errorString() );
+      throw DeployUtilsServerError(message);
+    }
+  }
+
+  while(true){
+    stream.startTransaction();
+    quint8 type = 0;
+    stream >> type;
+    if( type == static_cast<quint8>(DeployUtilsServerProtocol::ReplyType::Finished) ){
+      qint32 exitCode = 0;
+      stream >> exitCode;
+      if( stream.commitTransaction() ){
+        return exitCode;
+      }
+    }else{
+      QString message;
+      stream >> message;
+      if( stream.commitTransaction() ){
+        if( type == static_cast<quint8>(DeployUtilsServerProtocol::ReplyType::Error) ){
+          showError(message);
+        }else{
+          showInfo(message);
+        }
+        continue;
+      }
+    }
+    if( !socket.waitForReadyRead(-1) ){
+      const QString message = tr("server '%1' disconnected before the command finished: %2")
+                              .arg( socketName, socket.errorString() );
+      throw DeployUtilsServerError(message);
+    }
+  }
+}
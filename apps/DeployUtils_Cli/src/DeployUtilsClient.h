@@ -0,0 +1,60 @@
+/*******************************************************************************************
+ **
+ ** MdtDeployUtils - Tools to help deploy C/C++ application binaries and their dependencies.
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **
+ ***********************************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_CLIENT_H
+#define MDT_DEPLOY_UTILS_CLIENT_H
+
+#include "DeployUtilsServerError.h"
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <optional>
+
+/*! \brief Client that forwards a command to a DeployUtilsServer
+ *
+ * \sa DeployUtilsServer
+ */
+class DeployUtilsClient : public QObject
+{
+  Q_OBJECT
+
+ public:
+
+  /*! \brief Constructor
+   */
+  explicit DeployUtilsClient(QObject *parent = nullptr) noexcept;
+
+  /*! \brief Send \a arguments to the server listening to \a socketName
+   *
+   * The messages sent back by the server are given to the MessageLogger.
+   *
+   * Returns the exit code of the command executed by the server,
+   * or nothing if the server could not be reached.
+   * In the later case, the caller should execute the command itself.
+   *
+   * \pre \a socketName must not be empty
+   * \pre a MessageLogger must be initialized
+   * \exception DeployUtilsServerError
+   *  Thrown if the server was reached, but the communication failed after.
+   */
+  std::optional<int> forward(const QString & socketName, const QStringList & arguments);
+};
+
+#endif // #ifndef MDT_DEPLOY_UTILS_CLIENT_H
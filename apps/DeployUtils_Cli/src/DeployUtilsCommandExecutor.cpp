@@ -0,0 +1,141 @@
+/*******************************************************************************************
+ **
+ ** MdtDeployUtils - Tools to help deploy C/C++ application binaries and their dependencies.
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **
+ ***********************************************************************************************/
+#include "DeployUtilsCommandExecutor.h"
+#include "Mdt/DeployUtils/LogLevel.h"
+#include "Mdt/DeployUtils/MessageLogger.h"
+#include "Mdt/DeployUtils/MessageLoggerSink.h"
+#include "Mdt/DeployUtils/CopySharedLibrariesTargetDependsOn.h"
+#include "Mdt/DeployUtils/CopySharedLibrariesTargetDependsOnRequest.h"
+#include "Mdt/DeployUtils/GenerateRuntimeEnvironmentTargetDependsOn.h"
+#include "Mdt/DeployUtils/GenerateRuntimeEnvironmentTargetDependsOnRequest.h"
+#include "Mdt/DeployUtils/DeployApplicationRequest.h"
+#include "Mdt/DeployUtils/DeployApplication.h"
+#include <QObject>
+#include <memory>
+#include <cassert>
+
+using namespace Mdt::DeployUtils;
+
+DeployUtilsCommandExecutor::DeployUtilsCommandExecutor(QObject *parent) noexcept
+ : QObject(parent)
+{
+}
+
+void DeployUtilsCommandExecutor::execute(const CommandLineParser & commandLineParser)
+{
+  assert( commandLineParser.processedCommand() != CommandLineCommand::Serve );
+
+  switch( commandLineParser.processedCommand() ){
+    case CommandLineCommand::CopySharedLibrariesTargetDependsOn:
+      copySharedLibrariesTargetDependsOn(commandLineParser);
+      break;
+    case CommandLineCommand::GenerateRuntimeEnvironmentTargetDependsOn:
+      generateRuntimeEnvironmentTargetDependsOn(commandLineParser);
+      break;
+    case CommandLineCommand::GetSharedLibrariesTargetDependsOn:
+      /// \todo to implement
+      break;
+    case CommandLineCommand::DeployApplication:
+      deployApplication(commandLineParser);
+      break;
+    case CommandLineCommand::Serve:
+    case CommandLineCommand::Unknown:
+      break;
+  }
+}
+
+void DeployUtilsCommandExecutor::copySharedLibrariesTargetDependsOn(const CommandLineParser & commandLineParser)
+{
+  assert( commandLineParser.processedCommand() == CommandLineCommand::CopySharedLibrariesTargetDependsOn );
+
+  const auto request = commandLineParser.copySharedLibrariesTargetDependsOnRequest();
+
+  CopySharedLibrariesTargetDependsOn csltdo;
+  csltdo.setMetadataCache(mMetadataCache);
+  csltdo.setFileStatBackend( commandLineParser.fileStatBackend() );
+
+  const LogLevel logLevel = commandLineParser.logLevel();
+  csltdo.setLogLevel(logLevel);
+  csltdo.setMessageSink( std::make_shared<MessageLoggerSink>(logLevel) );
+  if( shouldOutputStatusMessages(logLevel) ){
+    QObject::connect(&csltdo, &CopySharedLibrariesTargetDependsOn::statusMessage, MessageLogger::info);
+  }
+  if( shouldOutputVerboseMessages(logLevel) ){
+    QObject::connect(&csltdo, &CopySharedLibrariesTargetDependsOn::verboseMessage, MessageLogger::info);
+  }
+  if( shouldOutputDebugMessages(logLevel) ){
+    QObject::connect(&csltdo, &CopySharedLibrariesTargetDependsOn::debugMessage, MessageLogger::info);
+  }
+
+  csltdo.execute(request);
+}
+
+void DeployUtilsCommandExecutor::generateRuntimeEnvironmentTargetDependsOn(const CommandLineParser & commandLineParser)
+{
+  assert( commandLineParser.processedCommand() == CommandLineCommand::GenerateRuntimeEnvironmentTargetDependsOn );
+
+  const GenerateRuntimeEnvironmentTargetDependsOnRequest request = commandLineParser.generateRuntimeEnvironmentTargetDependsOnRequest();
+
+  GenerateRuntimeEnvironmentTargetDependsOn useCase;
+  useCase.setMetadataCache(mMetadataCache);
+  useCase.setFileStatBackend( commandLineParser.fileStatBackend() );
+
+  const LogLevel logLevel = commandLineParser.logLevel();
+  useCase.setLogLevel(logLevel);
+  useCase.setMessageSink( std::make_shared<MessageLoggerSink>(logLevel) );
+  if( shouldOutputStatusMessages(logLevel) ){
+    QObject::connect(&useCase, &GenerateRuntimeEnvironmentTargetDependsOn::statusMessage, MessageLogger::info);
+  }
+  if( shouldOutputVerboseMessages(logLevel) ){
+    QObject::connect(&useCase, &GenerateRuntimeEnvironmentTargetDependsOn::verboseMessage, MessageLogger::info);
+  }
+  if( shouldOutputDebugMessages(logLevel) ){
+    QObject::connect(&useCase, &GenerateRuntimeEnvironmentTargetDependsOn::debugMessage, MessageLogger::info);
+  }
+
+  useCase.execute(request);
+}
+
+void DeployUtilsCommandExecutor::deployApplication(const CommandLineParser & commandLineParser)
+{
+  assert( commandLineParser.processedCommand() == CommandLineCommand::DeployApplication );
+
+  DeployApplication useCase;
+  useCase.setMetadataCache(mMetadataCache);
+  useCase.setFileStatBackend( commandLineParser.fileStatBackend() );
+
+  const DeployApplicationRequest request = commandLineParser.deployApplicationRequest();
+
+  const LogLevel logLevel = commandLineParser.logLevel();
+  useCase.setLogLevel(logLevel);
+  useCase.setMessageSink( std::make_shared<MessageLoggerSink>(logLevel) );
+  if( shouldOutputStatusMessages(logLevel) ){
+    QObject::connect(&useCase, &DeployApplication::statusMessage, MessageLogger::info);
+  }
+  if( shouldOutputVerboseMessages(logLevel) ){
+    QObject::connect(&useCase, &DeployApplication::verboseMessage, MessageLogger::info);
+  }
+  if( shouldOutputDebugMessages(logLevel) ){
+    QObject::connect(&useCase, &DeployApplication::debugMessage, MessageLogger::info);
+  }
+
+  useCase.execute(request);
+}
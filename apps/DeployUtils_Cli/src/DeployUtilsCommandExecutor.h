@@ -0,0 +1,72 @@
+/*******************************************************************************************
+ **
+ ** MdtDeployUtils - Tools to help deploy C/C++ application binaries and their dependencies.
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **
+ ***********************************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_COMMAND_EXECUTOR_H
+#define MDT_DEPLOY_UTILS_COMMAND_EXECUTOR_H
+
+#include "CommandLineParser.h"
+#include "Mdt/DeployUtils/ExecutableFileMetadataCache.h"
+#include <QObject>
+#include <memory>
+
+/*! \brief Execute the command processed by a CommandLineParser
+ *
+ * Messages are sent to the MessageLogger,
+ * regarding the log level given on the command line.
+ *
+ * Used by DeployUtilsMain when executing a command locally,
+ * and by DeployUtilsServer for each request.
+ */
+class DeployUtilsCommandExecutor : public QObject
+{
+  Q_OBJECT
+
+ public:
+
+  /*! \brief Constructor
+   */
+  explicit DeployUtilsCommandExecutor(QObject *parent = nullptr) noexcept;
+
+  /*! \brief Set a cache for the metadata read from executables and shared libraries
+   *
+   * The server gives the same cache for each request.
+   */
+  void setMetadataCache(const std::shared_ptr<Mdt::DeployUtils::ExecutableFileMetadataCache> & cache) noexcept
+  {
+    mMetadataCache = cache;
+  }
+
+  /*! \brief Execute the command processed by \a commandLineParser
+   *
+   * \pre \a commandLineParser must not have processed the Serve command
+   * \exception std::exception
+   */
+  void execute(const CommandLineParser & commandLineParser);
+
+ private:
+
+  void copySharedLibrariesTargetDependsOn(const CommandLineParser & commandLineParser);
+  void generateRuntimeEnvironmentTargetDependsOn(const CommandLineParser & commandLineParser);
+  void deployApplication(const CommandLineParser & commandLineParser);
+
+  std::shared_ptr<Mdt::DeployUtils::ExecutableFileMetadataCache> mMetadataCache;
+};
+
+#endif // #ifndef MDT_DEPLOY_UTILS_COMMAND_EXECUTOR_H
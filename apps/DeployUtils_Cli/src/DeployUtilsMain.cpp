@@ -19,16 +19,16 @@
  **
  ****************************************************************************/
 #include "DeployUtilsMain.h"
-#include "Mdt/DeployUtils/LogLevel.h"
+#include "DeployUtilsCommandExecutor.h"
+#include "DeployUtilsServer.h"
+#include "DeployUtilsClient.h"
 #include "Mdt/DeployUtils/MessageLogger.h"
 #include "Mdt/DeployUtils/CMakeStyleMessageLogger.h"
-#include "Mdt/DeployUtils/CopySharedLibrariesTargetDependsOn.h"
-#include "Mdt/DeployUtils/CopySharedLibrariesTargetDependsOnRequest.h"
-#include "Mdt/DeployUtils/DeployApplicationRequest.h"
-#include "Mdt/DeployUtils/DeployApplication.h"
+#include "Mdt/DeployUtils/AsyncConsoleMessageLogger.h"
 #include <QLatin1String>
 #include <QCoreApplication>
 #include <QObject>
+#include <optional>
 #include <cassert>
 
 using namespace Mdt::DeployUtils;
@@ -55,70 +55,49 @@ int DeployUtilsMain::runMain()
     return 1;
   }
 
-  if( commandLineParser.messageLoggerBackend() == MessageLoggerBackend::CMake ){
+  if( commandLineParser.isAsyncLogger() ){
+    auto *backend = MessageLogger::setBackend<AsyncConsoleMessageLogger>();
+    if( commandLineParser.messageLoggerBackend() == MessageLoggerBackend::CMake ){
+      backend->setPrefixes( CMakeStyleMessageLogger::infoPrefix(), CMakeStyleMessageLogger::errorPrefix() );
+    }
+  }else if( commandLineParser.messageLoggerBackend() == MessageLoggerBackend::CMake ){
     MessageLogger::setBackend<CMakeStyleMessageLogger>();
   }
 
 //   assert( commandLineParser.processedCommand() != CommandLineCommand::Unknown );
 
   switch( commandLineParser.processedCommand() ){
-    case CommandLineCommand::CopySharedLibrariesTargetDependsOn:
-      copySharedLibrariesTargetDependsOn(commandLineParser);
-      break;
-    case CommandLineCommand::GetSharedLibrariesTargetDependsOn:
-      /// \todo to implement
-      break;
-    case CommandLineCommand::DeployApplication:
-      deployApplication(commandLineParser);
-      break;
+    case CommandLineCommand::Serve:
+      return serve(commandLineParser);
     case CommandLineCommand::Unknown:
       // Maybe just Bash completion
       return 0;
+    default:
+      break;
   }
 
-  return 0;
-}
-
-void DeployUtilsMain::copySharedLibrariesTargetDependsOn(const CommandLineParser & commandLineParser)
-{
-  assert( commandLineParser.processedCommand() == CommandLineCommand::CopySharedLibrariesTargetDependsOn );
-
-  const auto request = commandLineParser.copySharedLibrariesTargetDependsOnRequest();
-
-  CopySharedLibrariesTargetDependsOn csltdo;
-
-  const LogLevel logLevel = commandLineParser.logLevel();
-  if( shouldOutputStatusMessages(logLevel) ){
-    QObject::connect(&csltdo, &CopySharedLibrariesTargetDependsOn::statusMessage, MessageLogger::info);
-  }
-  if( shouldOutputVerboseMessages(logLevel) ){
-    QObject::connect(&csltdo, &CopySharedLibrariesTargetDependsOn::verboseMessage, MessageLogger::info);
-  }
-  if( shouldOutputDebugMessages(logLevel) ){
-    QObject::connect(&csltdo, &CopySharedLibrariesTargetDependsOn::debugMessage, MessageLogger::info);
+  if( !commandLineParser.serverName().isEmpty() ){
+    DeployUtilsClient client;
+    const std::optional<int> exitCode = client.forward( commandLineParser.serverName(), QCoreApplication::arguments() );
+    if(exitCode){
+      return *exitCode;
+    }
+    showInfo( tr("server %1 not reachable, executing locally").arg( commandLineParser.serverName() ) );
   }
 
-  csltdo.execute(request);
+  DeployUtilsCommandExecutor executor;
+  executor.execute(commandLineParser);
+
+  return 0;
 }
 
-void DeployUtilsMain::deployApplication(const CommandLineParser & commandLineParser)
+int DeployUtilsMain::serve(const CommandLineParser & commandLineParser)
 {
-  assert( commandLineParser.processedCommand() == CommandLineCommand::DeployApplication );
-
-  DeployApplication useCase;
+  assert( commandLineParser.processedCommand() == CommandLineCommand::Serve );
 
-  const DeployApplicationRequest request = commandLineParser.deployApplicationRequest();
+  DeployUtilsServer server;
+  server.listen( commandLineParser.serveSocketName() );
+  server.run( commandLineParser.serveIdleTimeoutSeconds() );
 
-  const LogLevel logLevel = commandLineParser.logLevel();
-  if( shouldOutputStatusMessages(logLevel) ){
-    QObject::connect(&useCase, &DeployApplication::statusMessage, MessageLogger::info);
-  }
-  if( shouldOutputVerboseMessages(logLevel) ){
-    QObject::connect(&useCase, &DeployApplication::verboseMessage, MessageLogger::info);
-  }
-  if( shouldOutputDebugMessages(logLevel) ){
-    QObject::connect(&useCase, &DeployApplication::debugMessage, MessageLogger::info);
-  }
-
-  useCase.execute(request);
+  return 0;
 }
@@ -39,8 +39,7 @@ class DeployUtilsMain : public Mdt::AbstractConsoleApplicationMainFunction
  private:
 
   int runMain() override;
-  void copySharedLibrariesTargetDependsOn(const CommandLineParser & commandLineParser);
-  void deployApplication(const CommandLineParser & commandLineParser);
+  int serve(const CommandLineParser & commandLineParser);
 };
 
 #endif // #ifndef MDT_DEPLOY_UTILS_MAIN_H
@@ -0,0 +1,272 @@
+/*******************************************************************************************
+ **
+ ** MdtDeployUtils - Tools to help deploy C/C++ application binaries and their dependencies.
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **
+ ***********************************************************************************************/
+#include "DeployUtilsServer.h"
+#include "DeployUtilsCommandExecutor.h"
+#include "CommandLineParser.h"
+#include "CommandLineCommand.h"
+#include "Mdt/DeployUtils/MessageLogger.h"
+#include "Mdt/DeployUtils/ConsoleMessageLogger.h"
+#include <QDataStream>
+#include <QDir>
+#include <QLatin1String>
+#include <exception>
+#include <cassert>
+
+using namespace Mdt::DeployUtils;
+
+/* Time, in milliseconds, we wait for a client
+ * to send its request or to read our replies
+ */
+static constexpr int clientTimeoutMs = 30000;
+
+/* We have no event loop while serving a request,
+ * so we have to write the buffered replies ourself.
+ * If the client does not read them, we give up
+ * (the client probably died)
+ */
+static void writePendingBytes(QLocalSocket & client)
+{
+  while( client.bytesToWrite() > 0 ){
+    if( !client.waitForBytesWritten(clientTimeoutMs) ){
+      return;
+    }
+  }
+}
+
+void DeployUtilsServerMessageLoggerBackend::info(const QString & message)
+{
+  if(mClient == nullptr){
+    ConsoleMessageLogger().info(message);
+    return;
+  }
+  sendMessage(DeployUtilsServerProtocol::ReplyType::Info, message);
+}
+
+void DeployUtilsServerMessageLoggerBackend::error(const QString & message)
+{
+  if(mClient == nullptr){
+    ConsoleMessageLogger().error(message);
+    return;
+  }
+  sendMessage(DeployUtilsServerProtocol::ReplyType::Error, message);
+}
+
+void DeployUtilsServerMessageLoggerBackend::sendMessage(DeployUtilsServerProtocol::ReplyType type, const QString & message)
+{
+  assert(mClient != nullptr);
+
+  QDataStream stream(mClient);
+  stream.setVersion(DeployUtilsServerProtocol::dataStreamVersion);
+  stream << static_cast<quint8>(type) << message;
+  writePendingBytes(*mClient);
+}
+
+
+DeployUtilsServer::DeployUtilsServer(QObject *parent)
+ : QObject(parent),
+   mMetadataCache( std::make_shared<ExecutableFileMetadataCache>() )
+{
+}
+
+void DeployUtilsServer::listen(const QString & socketName)
+{
+  assert( !socketName.isEmpty() );
+
+  /* QLocalServer::listen() fails if the socket file exists.
+   * We only remove it if no server answers on it.
+   */
+  QLocalSocket probe;
+  probe.connectToServer(socketName);
+  if( probe.waitForConnected(1000) ){
+    probe.disconnectFromServer();
+    const QString message = tr("a server is already listening to '%1'").arg(socketName);
+    throw DeployUtilsServerError(message);
+  }
+  QLocalServer::removeServer(socketName);
+
+  mServer.setSocketOptions(QLocalServer::UserAccessOption);
+  if( !mServer.listen(socketName) ){
+    const QString message = tr("could not listen to '%1': %2")
+                            .arg( socketName, mServer.errorString() );
+    throw DeployUtilsServerError(message);
+  }
+
+  showInfo( tr("listening to %1").arg( mServer.fullServerName() ) );
+}
+
+void DeployUtilsServer::run(int idleTimeoutSeconds)
+{
+  assert( mServer.isListening() );
+  assert( idleTimeoutSeconds >= 0 );
+  assert( MessageLogger::isInitialized() );
+
+  auto *loggerBackend = MessageLogger::setBackend<DeployUtilsServerMessageLoggerBackend>();
+
+  const int waitTimeoutMs = idleTimeoutSeconds > 0 ? idleTimeoutSeconds * 1000 : -1;
+
+  while( mServer.isListening() ){
+    bool timedOut = false;
+    if( !mServer.waitForNewConnection(waitTimeoutMs, &timedOut) ){
+      if(timedOut){
+        showInfo( tr("no request during %1 seconds, stopping").arg(idleTimeoutSeconds) );
+      }else{
+        showError( tr("waiting for a client failed: %1").arg( mServer.errorString() ) );
+      }
+      break;
+    }
+    while( mServer.hasPendingConnections() ){
+      QLocalSocket *client = mServer.nextPendingConnection();
+      assert(client != nullptr);
+      serveClient(*client, *loggerBackend);
+      delete client;
+    }
+  }
+
+  mServer.close();
+}
+
+void DeployUtilsServer::serveClient(QLocalSocket & client, DeployUtilsServerMessageLoggerBackend & loggerBackend)
+{
+  QString workingDirectory;
+  QStringList environment;
+  QStringList arguments;
+
+  if( !readRequest(client, workingDirectory, environment, arguments) ){
+    showError( tr("received a invalid request, ignoring it") );
+    client.abort();
+    return;
+  }
+
+  loggerBackend.setClient(&client);
+  const int exitCode = executeRequest(workingDirectory, environment, arguments);
+  sendFinished(client, exitCode);
+  loggerBackend.setClient(nullptr);
+
+  client.disconnectFromServer();
+  if( client.state() != QLocalSocket::UnconnectedState ){
+    client.waitForDisconnected(clientTimeoutMs);
+  }
+
+  const ExecutableFileMetadataCache & cache = *mMetadataCache;
+  showInfo(
+    tr("served %1 (exit code %2). metadata cache: %3 files, %4 hits, %5 misses, %6 stale")
+    .arg( arguments.mid(1).join( QLatin1Char(' ') ) )
+    .arg(exitCode)
+    .arg( cache.count() )
+    .arg( cache.hitCount() )
+    .arg( cache.missCount() )
+    .arg( cache.staleCount() )
+  );
+}
+
+bool DeployUtilsServer::readRequest(QLocalSocket & client, QString & workingDirectory, QStringList & environment, QStringList & arguments)
+{
+  QDataStream stream(&client);
+  stream.setVersion(DeployUtilsServerProtocol::dataStreamVersion);
+
+  quint32 magic = 0;
+  quint32 version = 0;
+  while(true){
+    stream.startTransaction();
+    stream >> magic >> version >> workingDirectory >> environment >> arguments;
+    if( stream.commitTransaction() ){
+      break;
+    }
+    if( !client.waitForReadyRead(clientTimeoutMs) ){
+      return false;
+    }
+  }
+
+  return (magic == DeployUtilsServerProtocol::magic) && (version == DeployUtilsServerProtocol::protocolVersion);
+}
+
+int DeployUtilsServer::executeRequest(const QString & workingDirectory, const QStringList & environment, const QStringList & arguments)
+{
+  const QString serverWorkingDirectory = QDir::currentPath();
+  if( !QDir::setCurrent(workingDirectory) ){
+    showError( tr("could not change to directory '%1'").arg(workingDirectory) );
+    return 1;
+  }
+
+  /* The command is executed with the environment of the client
+   * (for example, PATH is used to find shared libraries on Windows).
+   * Requests are served one at a time, so the process environment
+   * can be replaced, then restored.
+   */
+  const QProcessEnvironment serverEnvironment = QProcessEnvironment::systemEnvironment();
+  QProcessEnvironment clientEnvironment;
+  for(const QString & variable : environment){
+    // On Windows, some variables begins with a '=' (for example "=C:=C:\")
+    const int separatorIndex = variable.indexOf( QLatin1Char('='), 1 );
+    if(separatorIndex > 0){
+      clientEnvironment.insert( variable.left(separatorIndex), variable.mid(separatorIndex+1) );
+    }
+  }
+  setProcessEnvironment(clientEnvironment);
+
+  int exitCode = 0;
+  try{
+    CommandLineParser commandLineParser;
+    commandLineParser.process(arguments);
+
+    const CommandLineCommand command = commandLineParser.processedCommand();
+    if( (command == CommandLineCommand::Serve) || (command == CommandLineCommand::Unknown) ){
+      const QString message = tr("the server can not execute the %1 command")
+                              .arg( commandName(command) );
+      throw DeployUtilsServerError(message);
+    }
+
+    DeployUtilsCommandExecutor executor;
+    executor.setMetadataCache(mMetadataCache);
+    executor.execute(commandLineParser);
+  }catch(const std::exception & error){
+    showError(error);
+    exitCode = 1;
+  }
+
+  setProcessEnvironment(serverEnvironment);
+  QDir::setCurrent(serverWorkingDirectory);
+
+  return exitCode;
+}
+
+void DeployUtilsServer::setProcessEnvironment(const QProcessEnvironment & environment)
+{
+  const QStringList currentVariables = QProcessEnvironment::systemEnvironment().keys();
+  for(const QString & name : currentVariables){
+    if( !environment.contains(name) ){
+      qunsetenv( name.toLocal8Bit().constData() );
+    }
+  }
+
+  const QStringList variables = environment.keys();
+  for(const QString & name : variables){
+    qputenv( name.toLocal8Bit().constData(), environment.value(name).toLocal8Bit() );
+  }
+}
+
+void DeployUtilsServer::sendFinished(QLocalSocket & client, int exitCode)
+{
+  QDataStream stream(&client);
+  stream.setVersion(DeployUtilsServerProtocol::dataStreamVersion);
+  stream << static_cast<quint8>(DeployUtilsServerProtocol::ReplyType::Finished) << static_cast<qint32>(exitCode);
+  writePendingBytes(client);
+}
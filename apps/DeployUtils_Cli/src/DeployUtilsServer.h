@@ -0,0 +1,136 @@
+/*******************************************************************************************
+ **
+ ** MdtDeployUtils - Tools to help deploy C/C++ application binaries and their dependencies.
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **
+ ***********************************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_SERVER_H
+#define MDT_DEPLOY_UTILS_SERVER_H
+
+#include "DeployUtilsServerError.h"
+#include "DeployUtilsServerProtocol.h"
+#include "Mdt/DeployUtils/ExecutableFileMetadataCache.h"
+#include "Mdt/DeployUtils/AbstractMessageLoggerBackend.h"
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QProcessEnvironment>
+#include <memory>
+
+/*! \brief Message logger backend that sends the messages to the client being served
+ *
+ * If no client is being served, messages are written to the console.
+ */
+class DeployUtilsServerMessageLoggerBackend : public Mdt::DeployUtils::AbstractMessageLoggerBackend
+{
+ public:
+
+  /*! \brief Set the client to send the messages to
+   *
+   * Passing a nullptr writes the messages to the console.
+   */
+  void setClient(QLocalSocket *client) noexcept
+  {
+    mClient = client;
+  }
+
+  /*! \brief Log a information
+   */
+  void info(const QString & message) override;
+
+  /*! \brief Log a error
+   */
+  void error(const QString & message) override;
+
+ private:
+
+  void sendMessage(DeployUtilsServerProtocol::ReplyType type, const QString & message);
+
+  QLocalSocket *mClient = nullptr;
+};
+
+/*! \brief Server that executes mdtdeployutils commands sent by clients
+ *
+ * The server keeps a ExecutableFileMetadataCache between requests,
+ * so the executables and shared libraries that did not change
+ * are read only once.
+ *
+ * Requests are served one after the other.
+ * This keeps the use cases, that are not thread safe, simple,
+ * and is enough for CMake install scripts, that also run sequentially.
+ *
+ * The client parses the command line before sending it,
+ * so the help and the Bash completion never reach the server.
+ *
+ * \sa DeployUtilsClient
+ * \sa DeployUtilsServerProtocol
+ */
+class DeployUtilsServer : public QObject
+{
+  Q_OBJECT
+
+ public:
+
+  /*! \brief Constructor
+   */
+  explicit DeployUtilsServer(QObject *parent = nullptr);
+
+  /*! \brief Start listening to \a socketName
+   *
+   * If a stale socket file exists (for example after a crash),
+   * it is removed.
+   *
+   * \pre \a socketName must not be empty
+   * \exception DeployUtilsServerError
+   */
+  void listen(const QString & socketName);
+
+  /*! \brief Serve the requests until the server is idle for \a idleTimeoutSeconds
+   *
+   * If \a idleTimeoutSeconds is 0, this function never returns.
+   *
+   * \pre listen() must have been called successfully
+   * \pre \a idleTimeoutSeconds must be >= 0
+   * \pre a MessageLogger must be initialized
+   */
+  void run(int idleTimeoutSeconds);
+
+  /*! \brief Get the metadata cache shared by the requests
+   */
+  const Mdt::DeployUtils::ExecutableFileMetadataCache & metadataCache() const noexcept
+  {
+    return *mMetadataCache;
+  }
+
+ private:
+
+  void serveClient(QLocalSocket & client, DeployUtilsServerMessageLoggerBackend & loggerBackend);
+  static
+  bool readRequest(QLocalSocket & client, QString & workingDirectory, QStringList & environment, QStringList & arguments);
+  int executeRequest(const QString & workingDirectory, const QStringList & environment, const QStringList & arguments);
+  static
+  void setProcessEnvironment(const QProcessEnvironment & environment);
+  static
+  void sendFinished(QLocalSocket & client, int exitCode);
+
+  QLocalServer mServer;
+  std::shared_ptr<Mdt::DeployUtils::ExecutableFileMetadataCache> mMetadataCache;
+};
+
+#endif // #ifndef MDT_DEPLOY_UTILS_SERVER_H
@@ -0,0 +1,40 @@
+/*******************************************************************************************
+ **
+ ** MdtDeployUtils - Tools to help deploy C/C++ application binaries and their dependencies.
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **
+ ***********************************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_SERVER_ERROR_H
+#define MDT_DEPLOY_UTILS_SERVER_ERROR_H
+
+#include "Mdt/DeployUtils/QRuntimeError.h"
+
+/*! \brief Error thrown when the server or the client fails to communicate
+ */
+class DeployUtilsServerError : public Mdt::DeployUtils::QRuntimeError
+{
+   public:
+
+    /*! \brief Construct a error
+     */
+    explicit DeployUtilsServerError(const QString & what)
+     : QRuntimeError(what)
+    {
+    }
+};
+
+#endif // #ifndef MDT_DEPLOY_UTILS_SERVER_ERROR_H
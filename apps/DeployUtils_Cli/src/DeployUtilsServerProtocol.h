@@ -0,0 +1,68 @@
+/*******************************************************************************************
+ **
+ ** MdtDeployUtils - Tools to help deploy C/C++ application binaries and their dependencies.
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **
+ ***********************************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_SERVER_PROTOCOL_H
+#define MDT_DEPLOY_UTILS_SERVER_PROTOCOL_H
+
+#include <QDataStream>
+#include <QtGlobal>
+
+/*! \brief Protocol used between a mdtdeployutils client and the server
+ *
+ * The client sends a single request:
+ * - magic (quint32)
+ * - protocolVersion (quint32)
+ * - working directory (QString)
+ * - environment (QStringList), as returned by QProcessEnvironment::toStringList()
+ * - arguments (QStringList), as given to the client, including the program name
+ *
+ * The server then sends replies, each one being:
+ * - type (quint8, DeployUtilsServerProtocol::ReplyType)
+ * - for Info and Error: the message (QString)
+ * - for Finished: the exit code (qint32)
+ *
+ * After the Finished reply, the server closes the connection.
+ */
+namespace DeployUtilsServerProtocol{
+
+  /*! \brief Magic number that starts a request
+   */
+  constexpr quint32 magic = 0x4D445544;
+
+  /*! \brief Version of this protocol
+   */
+  constexpr quint32 protocolVersion = 2;
+
+  /*! \brief Version used for the data stream
+   */
+  constexpr QDataStream::Version dataStreamVersion = QDataStream::Qt_5_0;
+
+  /*! \brief Type of a reply
+   */
+  enum class ReplyType : quint8
+  {
+    Info = 1,     /*!< A information message */
+    Error = 2,    /*!< A error message */
+    Finished = 3  /*!< The command finished, followed by the exit code */
+  };
+
+} // namespace DeployUtilsServerProtocol{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_SERVER_PROTOCOL_H
@@ -0,0 +1,69 @@
+/*******************************************************************************************
+ **
+ ** MdtDeployUtils - Tools to help deploy C/C++ application binaries and their dependencies.
+ **
+ ** Copyright (C) 2020-2023 Philippe Steinmann.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **
+ ***********************************************************************************************/
+#include "GenerateRuntimeEnvironmentTargetDependsOnCommandLineParserDefinition.h"
+#include "CommonCommandLineParserDefinitionOptions.h"
+#include "CommandLineCommand.h"
+
+using namespace Mdt::CommandLineParser;
+
+GenerateRuntimeEnvironmentTargetDependsOnCommandLineParserDefinition::GenerateRuntimeEnvironmentTargetDependsOnCommandLineParserDefinition(QObject *parent) noexcept
+ : QObject(parent)
+{
+}
+
+void GenerateRuntimeEnvironmentTargetDependsOnCommandLineParserDefinition::setup() noexcept
+{
+  assert( !mApplicationName.trimmed().isEmpty() );
+
+  mCommand.setName( commandName(CommandLineCommand::GenerateRuntimeEnvironmentTargetDependsOn) );
+
+  const QString description = tr(
+    "Generate a environment file that lets a target find the shared libraries it depends on, without copying them.\n"
+    "The file contains a single line, like LD_LIBRARY_PATH=dir1:dir2 on Linux or PATH=dir1;dir2 on Windows, "
+    "that lists the directories in which the shared libraries have been found, "
+    "so that the loader picks the same files as if they had been copied next to the target.\n"
+    "This is intended to run tests from the build tree.\n"
+    "Example:\n"
+    "%1 %2 /home/me/dev/build/myapp/src/myapp /home/me/dev/build/myapp/src/myapp.env"
+  ).arg( mApplicationName, mCommand.name() );
+  mCommand.setDescription(description);
+
+  mCommand.addPositionalArgument( ValueType::File, QLatin1String("target"), tr("Path to a executable or a shared library.") );
+  mCommand.addPositionalArgument( ValueType::File, QLatin1String("environment-file"), tr("Path to the environment file to generate.") );
+  mCommand.addHelpOption();
+
+  mCommand.addOption( CommonCommandLineParserDefinitionOptions::makeSearchPrefixPathListOption() );
+
+  mCommand.addOption( CommonCommandLineParserDefinitionOptions::makePathListSeparatorOption() );
+
+  mCommand.addOption( CommonCommandLineParserDefinitionOptions::makeCompilerLocationOption() );
+
+  mCommand.addOption( CommonCommandLineParserDefinitionOptions::makeRedistributionPolicyFileOption() );
+
+  const QString depFileOptionDescription = tr(
+    "Path to a depfile to write once the environment file has been generated.\n"
+    "It lists the target and each shared library that has been found, "
+    "as dependencies of the environment file, using the Makefile syntax (understood by Make and Ninja)."
+  );
+  ParserDefinitionOption depFileOption( QLatin1String("depfile"), depFileOptionDescription );
+  depFileOption.setValueName( QLatin1String("file") );
+  mCommand.addOption(depFileOption);
+}
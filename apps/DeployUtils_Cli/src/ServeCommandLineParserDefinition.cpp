@@ -0,0 +1,68 @@
+/*******************************************************************************************
+ **
+ ** MdtDeployUtils - Tools to help deploy C/C++ application binaries and their dependencies.
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **
+ ***********************************************************************************************/
+#include "ServeCommandLineParserDefinition.h"
+#include "CommandLineCommand.h"
+#include <QLatin1String>
+
+using namespace Mdt::CommandLineParser;
+
+ServeCommandLineParserDefinition::ServeCommandLineParserDefinition(QObject *parent) noexcept
+ : QObject(parent)
+{
+}
+
+void ServeCommandLineParserDefinition::setup() noexcept
+{
+  assert( !mApplicationName.trimmed().isEmpty() );
+
+  mCommand.setName( commandName(CommandLineCommand::Serve) );
+
+  const QString description = tr(
+    "Run as a server that executes the commands sent by clients.\n"
+    "Informations read from executables and shared libraries are kept between requests, "
+    "so calling %1 many times (for example from CMake install scripts) "
+    "does not read the same files again and again. "
+    "A file that changed on the file system (size or modification time) is read again.\n"
+    "A client is %1 called with the --server option.\n"
+    "Requests are executed one after the other, in the working directory of the client, "
+    "but with the environment of the server (for example to locate the compiler).\n"
+    "Example:\n"
+    "%1 %2 /tmp/mdtdeployutils.socket &\n"
+    "%1 --server /tmp/mdtdeployutils.socket deploy-application ./myApp /path/to/myAppFolder"
+  ).arg( mApplicationName, mCommand.name() );
+  mCommand.setDescription(description);
+
+  mCommand.addHelpOption();
+
+  const QString idleTimeoutOptionDescription = tr(
+    "Stop the server if no request was received during given count of seconds. "
+    "By default, the server runs until it is killed."
+  );
+  ParserDefinitionOption idleTimeoutOption( QLatin1String("idle-timeout"), idleTimeoutOptionDescription );
+  idleTimeoutOption.setValueName( QLatin1String("seconds") );
+  mCommand.addOption(idleTimeoutOption);
+
+  const QString socketNameDescription = tr(
+    "Name of the local socket to listen to. "
+    "On Unix, this can be the path to the socket file."
+  );
+  mCommand.addPositionalArgument( ValueType::File, QLatin1String("socket"), socketNameDescription );
+}
@@ -0,0 +1,81 @@
+/*******************************************************************************************
+ **
+ ** MdtDeployUtils - Tools to help deploy C/C++ application binaries and their dependencies.
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **
+ ***********************************************************************************************/
+#ifndef SERVE_COMMAND_LINE_PARSER_DEFINITION_H
+#define SERVE_COMMAND_LINE_PARSER_DEFINITION_H
+
+#include "Mdt/CommandLineParser/ParserDefinitionCommand.h"
+#include "Mdt/CommandLineParser/ParserDefinitionOption.h"
+#include <QObject>
+#include <QString>
+#include <cassert>
+
+/*! \brief Command line parser definition for the serve command
+ */
+class ServeCommandLineParserDefinition : public QObject
+{
+  Q_OBJECT
+
+ public:
+
+  /*! \brief Construct a command line parser
+   */
+  explicit ServeCommandLineParserDefinition(QObject *parent = nullptr) noexcept;
+
+  /*! \brief Set application name
+   */
+  void setApplicationName(const QString & name) noexcept
+  {
+    mApplicationName = name;
+  }
+
+  /*! \brief Setup the definition
+   *
+   * \pre application name must have been set
+   * \sa setApplicationName()
+   */
+  void setup() noexcept;
+
+  /*! \brief Get the idle timeout option
+   *
+   * \pre setup must have been done before
+   * \sa setup()
+   */
+  const Mdt::CommandLineParser::ParserDefinitionOption & idleTimeoutOption() const noexcept
+  {
+    assert( mCommand.hasOptions() );
+
+    return mCommand.optionAt(1);
+  }
+
+  /*! \brief Get the internal parser definition command
+   */
+  const Mdt::CommandLineParser::ParserDefinitionCommand & command() const noexcept
+  {
+    return mCommand;
+  }
+
+ private:
+
+  QString mApplicationName;
+  Mdt::CommandLineParser::ParserDefinitionCommand mCommand;
+};
+
+#endif // #ifndef SERVE_COMMAND_LINE_PARSER_DEFINITION_H
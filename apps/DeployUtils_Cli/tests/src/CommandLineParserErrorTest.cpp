@@ -113,7 +113,6 @@ TEST_CASE("DeployApplication")
 {
   CommandLineParser parser;
   QStringList arguments = qStringListFromUtf8Strings({"mdtdeployutils","deploy-application"});
-  const QStringList positionalArguments = qStringListFromUtf8Strings({"/build/app","/tmp"});
 
   SECTION("qt-plugins-set - imageformats:jpeg:svg")
   {
@@ -143,9 +142,25 @@ TEST_CASE("DeployApplication")
     REQUIRE_THROWS_AS( parser.process(arguments), CommandLineParseError );
   }
 
-  SECTION("More than 2 positional arguments given")
+  SECTION("No positional argument given")
   {
-    arguments << positionalArguments << QLatin1String("/opt");
+    REQUIRE_THROWS_AS( parser.process(arguments), CommandLineParseError );
+  }
+}
+
+TEST_CASE("Serve")
+{
+  CommandLineParser parser;
+  QStringList arguments = qStringListFromUtf8Strings({"mdtdeployutils","serve"});
+
+  SECTION("socket name missing")
+  {
+    REQUIRE_THROWS_AS( parser.process(arguments), CommandLineParseError );
+  }
+
+  SECTION("idle-timeout is not a number")
+  {
+    arguments << qStringListFromUtf8Strings({"--idle-timeout","abc","/tmp/mdtdeployutils.socket"});
 
     REQUIRE_THROWS_AS( parser.process(arguments), CommandLineParseError );
   }
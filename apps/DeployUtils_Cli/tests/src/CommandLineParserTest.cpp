@@ -23,6 +23,7 @@
 #include "TestUtils.h"
 #include "CommandLineParser.h"
 #include "Mdt/DeployUtils/CopySharedLibrariesTargetDependsOnRequest.h"
+#include "Mdt/DeployUtils/GenerateRuntimeEnvironmentTargetDependsOnRequest.h"
 #include "Mdt/DeployUtils/MessageLogger.h"
 #include <QStringList>
 
@@ -48,6 +49,82 @@ TEST_CASE("Logger backend")
     parser.process(arguments);
     REQUIRE( parser.messageLoggerBackend() == MessageLoggerBackend::CMake );
   }
+
+  SECTION("by default, the logger is not async")
+  {
+    arguments << subCommandArguments;
+    parser.process(arguments);
+    REQUIRE( !parser.isAsyncLogger() );
+  }
+
+  SECTION("async CMake backend")
+  {
+    arguments << qStringListFromUtf8Strings({"--logger-backend","cmake","--async-logger"});
+    arguments << subCommandArguments;
+    parser.process(arguments);
+    REQUIRE( parser.messageLoggerBackend() == MessageLoggerBackend::CMake );
+    REQUIRE( parser.isAsyncLogger() );
+  }
+}
+
+TEST_CASE("server option")
+{
+  CommandLineParser parser;
+  QStringList arguments = qStringListFromUtf8Strings({"mdtdeployutils"});
+  const QStringList subCommandArguments = qStringListFromUtf8Strings({"copy-shared-libraries-target-depends-on","/tmp/lib.so","/tmp"});
+
+  SECTION("by default, no server")
+  {
+    arguments << subCommandArguments;
+    parser.process(arguments);
+    REQUIRE( parser.serverName().isEmpty() );
+  }
+
+  SECTION("forward to a server")
+  {
+    arguments << qStringListFromUtf8Strings({"--server","/tmp/mdtdeployutils.socket"});
+    arguments << subCommandArguments;
+    parser.process(arguments);
+    REQUIRE( parser.serverName() == QLatin1String("/tmp/mdtdeployutils.socket") );
+    REQUIRE( parser.processedCommand() == CommandLineCommand::CopySharedLibrariesTargetDependsOn );
+  }
+}
+
+TEST_CASE("file stat backend option")
+{
+  CommandLineParser parser;
+  QStringList arguments = qStringListFromUtf8Strings({"mdtdeployutils"});
+  const QStringList subCommandArguments = qStringListFromUtf8Strings({"copy-shared-libraries-target-depends-on","/tmp/lib.so","/tmp"});
+
+  SECTION("default backend")
+  {
+    arguments << subCommandArguments;
+    parser.process(arguments);
+    REQUIRE( parser.fileStatBackend() == FileStatBackend::Synchronous );
+  }
+
+  SECTION("sync")
+  {
+    arguments << qStringListFromUtf8Strings({"--file-stat-backend","sync"});
+    arguments << subCommandArguments;
+    parser.process(arguments);
+    REQUIRE( parser.fileStatBackend() == FileStatBackend::Synchronous );
+  }
+
+  SECTION("io_uring")
+  {
+    arguments << qStringListFromUtf8Strings({"--file-stat-backend","io_uring"});
+    arguments << subCommandArguments;
+    parser.process(arguments);
+    REQUIRE( parser.fileStatBackend() == FileStatBackend::IoUring );
+  }
+
+  SECTION("unknown backend")
+  {
+    arguments << qStringListFromUtf8Strings({"--file-stat-backend","aio"});
+    arguments << subCommandArguments;
+    REQUIRE_THROWS_AS( parser.process(arguments), CommandLineParseError );
+  }
 }
 
 TEST_CASE("log level option")
@@ -135,7 +212,10 @@ TEST_CASE("CopySharedLibrariesTargetDependsOn")
     request = parser.copySharedLibrariesTargetDependsOnRequest();
     REQUIRE( request.overwriteBehavior == OverwriteBehavior::Fail );
     REQUIRE( !request.removeRpath );
+    REQUIRE( !request.pipelinedCopy );
     REQUIRE( request.searchPrefixPathList.isEmpty() );
+    REQUIRE( request.depFilePath.isEmpty() );
+    REQUIRE( request.stampFilePath.isEmpty() );
   }
 
   SECTION("Specify overwrite-behavior")
@@ -156,6 +236,40 @@ TEST_CASE("CopySharedLibrariesTargetDependsOn")
     REQUIRE( request.removeRpath );
   }
 
+  SECTION("Specify pipelined copy")
+  {
+    arguments << qStringListFromUtf8Strings({"--pipelined-copy","/tmp/lib.so","/tmp"});
+    parser.process(arguments);
+
+    request = parser.copySharedLibrariesTargetDependsOnRequest();
+    REQUIRE( request.pipelinedCopy );
+  }
+
+  SECTION("Specify depfile and stamp file")
+  {
+    arguments << qStringListFromUtf8Strings({"--depfile","/tmp/app.d","--stamp-file","/tmp/app.stamp","/tmp/lib.so","/tmp"});
+    parser.process(arguments);
+
+    request = parser.copySharedLibrariesTargetDependsOnRequest();
+    REQUIRE( request.depFilePath == QLatin1String("/tmp/app.d") );
+    REQUIRE( request.stampFilePath == QLatin1String("/tmp/app.stamp") );
+  }
+
+  SECTION("Specify depfile without stamp file")
+  {
+    arguments << qStringListFromUtf8Strings({"--depfile","/tmp/app.d","/tmp/lib.so","/tmp"});
+    REQUIRE_THROWS_AS( parser.process(arguments), CommandLineParseError );
+  }
+
+  SECTION("Specify deploy store")
+  {
+    arguments << qStringListFromUtf8Strings({"--deploy-store","/tmp/store","/tmp/lib.so","/tmp"});
+    parser.process(arguments);
+
+    request = parser.copySharedLibrariesTargetDependsOnRequest();
+    REQUIRE( request.deployStoreDirectoryPath == QLatin1String("/tmp/store") );
+  }
+
   SECTION("Specify compiler location")
   {
     SECTION("from ENV")
@@ -216,6 +330,15 @@ TEST_CASE("CopySharedLibrariesTargetDependsOn")
     }
   }
 
+  SECTION("Specify redistribution-policy-file")
+  {
+    arguments << qStringListFromUtf8Strings({"--redistribution-policy-file","/src/policy.txt","/tmp/lib.so","/tmp"});
+    parser.process(arguments);
+
+    request = parser.copySharedLibrariesTargetDependsOnRequest();
+    REQUIRE( request.redistributionPolicyFilePath == QLatin1String("/src/policy.txt") );
+  }
+
   SECTION("Positional arguments")
   {
     arguments << qStringListFromUtf8Strings({"/tmp/lib.so","/tmp"});
@@ -227,6 +350,76 @@ TEST_CASE("CopySharedLibrariesTargetDependsOn")
   }
 }
 
+TEST_CASE("GenerateRuntimeEnvironmentTargetDependsOn")
+{
+  CommandLineParser parser;
+  QStringList arguments = qStringListFromUtf8Strings({"mdtdeployutils","generate-runtime-environment-target-depends-on"});
+  GenerateRuntimeEnvironmentTargetDependsOnRequest request;
+
+  SECTION("processed command")
+  {
+    arguments << qStringListFromUtf8Strings({"/tmp/app","/tmp/app.env"});
+    parser.process(arguments);
+
+    REQUIRE( parser.processedCommand() == CommandLineCommand::GenerateRuntimeEnvironmentTargetDependsOn );
+  }
+
+  SECTION("Default options")
+  {
+    arguments << qStringListFromUtf8Strings({"/tmp/app","/tmp/app.env"});
+    parser.process(arguments);
+
+    request = parser.generateRuntimeEnvironmentTargetDependsOnRequest();
+    REQUIRE( request.searchPrefixPathList.isEmpty() );
+    REQUIRE( request.redistributionPolicyFilePath.isEmpty() );
+    REQUIRE( request.depFilePath.isEmpty() );
+  }
+
+  SECTION("Specify search-prefix-path-list")
+  {
+    arguments << qStringListFromUtf8Strings({"--search-prefix-path-list","/opt;/tmp","--path-list-separator",";","/tmp/app","/tmp/app.env"});
+    parser.process(arguments);
+
+    request = parser.generateRuntimeEnvironmentTargetDependsOnRequest();
+    const QStringList expectedPaths = qStringListFromUtf8Strings({"/opt","/tmp"});
+    REQUIRE( request.searchPrefixPathList == expectedPaths );
+  }
+
+  SECTION("Specify redistribution-policy-file")
+  {
+    arguments << qStringListFromUtf8Strings({"--redistribution-policy-file","/src/policy.txt","/tmp/app","/tmp/app.env"});
+    parser.process(arguments);
+
+    request = parser.generateRuntimeEnvironmentTargetDependsOnRequest();
+    REQUIRE( request.redistributionPolicyFilePath == QLatin1String("/src/policy.txt") );
+  }
+
+  SECTION("Specify depfile")
+  {
+    arguments << qStringListFromUtf8Strings({"--depfile","/tmp/app.env.d","/tmp/app","/tmp/app.env"});
+    parser.process(arguments);
+
+    request = parser.generateRuntimeEnvironmentTargetDependsOnRequest();
+    REQUIRE( request.depFilePath == QLatin1String("/tmp/app.env.d") );
+  }
+
+  SECTION("Positional arguments")
+  {
+    arguments << qStringListFromUtf8Strings({"/tmp/app","/tmp/app.env"});
+    parser.process(arguments);
+
+    request = parser.generateRuntimeEnvironmentTargetDependsOnRequest();
+    REQUIRE( request.targetFilePath == QLatin1String("/tmp/app") );
+    REQUIRE( request.environmentFilePath == QLatin1String("/tmp/app.env") );
+  }
+
+  SECTION("Missing environment file")
+  {
+    arguments << qStringListFromUtf8Strings({"/tmp/app"});
+    REQUIRE_THROWS_AS( parser.process(arguments), CommandLineParseError );
+  }
+}
+
 TEST_CASE("DeployApplication")
 {
   CommandLineParser parser;
@@ -252,6 +445,8 @@ TEST_CASE("DeployApplication")
     REQUIRE( !request.removeRpath );
     REQUIRE( request.runtimeDestination == QLatin1String("bin") );
     REQUIRE( request.libraryDestination == QLatin1String("lib") );
+    REQUIRE( !request.ignoreDeployManifest );
+    REQUIRE( !request.pruneStaleFiles );
   }
 
   SECTION("Specify shlib-overwrite-behavior")
@@ -350,6 +545,57 @@ TEST_CASE("DeployApplication")
     REQUIRE( !request.qtPluginsSet.contains( QLatin1String("platforms"), QLatin1String("minimal") ) );
   }
 
+  SECTION("Specify redistribution-policy-file")
+  {
+    arguments << qStringListFromUtf8Strings({"--redistribution-policy-file","/src/policy.txt","/build/app","/tmp"});
+    parser.process(arguments);
+
+    request = parser.deployApplicationRequest();
+
+    REQUIRE( request.redistributionPolicyFilePath == QLatin1String("/src/policy.txt") );
+  }
+
+  SECTION("Specify to ignore the deploy manifest")
+  {
+    arguments << qStringListFromUtf8Strings({"--ignore-deploy-manifest","/build/app","/tmp"});
+    parser.process(arguments);
+
+    request = parser.deployApplicationRequest();
+
+    REQUIRE( request.ignoreDeployManifest );
+  }
+
+  SECTION("Specify prune")
+  {
+    arguments << qStringListFromUtf8Strings({"--prune","/build/app","/tmp"});
+    parser.process(arguments);
+
+    request = parser.deployApplicationRequest();
+
+    REQUIRE( request.pruneStaleFiles );
+  }
+
+  SECTION("Specify deploy store")
+  {
+    arguments << qStringListFromUtf8Strings({"--deploy-store","/tmp/store","/build/app","/tmp"});
+    parser.process(arguments);
+
+    request = parser.deployApplicationRequest();
+
+    REQUIRE( request.deployStoreDirectoryPath == QLatin1String("/tmp/store") );
+  }
+
+  SECTION("Specify archive")
+  {
+    arguments << qStringListFromUtf8Strings({"--archive","/tmp/app.tar.zst","/build/app","/tmp/app"});
+    parser.process(arguments);
+
+    request = parser.deployApplicationRequest();
+
+    REQUIRE( request.archiveFilePath == QLatin1String("/tmp/app.tar.zst") );
+    REQUIRE( request.destinationDirectoryPath == QLatin1String("/tmp/app") );
+  }
+
   SECTION("Positional arguments")
   {
     arguments << qStringListFromUtf8Strings({"/build/app","/tmp"});
@@ -358,6 +604,53 @@ TEST_CASE("DeployApplication")
 
     request = parser.deployApplicationRequest();
     REQUIRE( request.targetFilePath == QLatin1String("/build/app") );
+    REQUIRE( request.additionalTargetFilePathList.isEmpty() );
+    REQUIRE( request.destinationDirectoryPath == QLatin1String("/tmp") );
+  }
+
+  SECTION("Several targets")
+  {
+    arguments << qStringListFromUtf8Strings({"/build/app","/build/appTool","/build/appHelper","/tmp"});
+
+    parser.process(arguments);
+
+    request = parser.deployApplicationRequest();
+    REQUIRE( request.targetFilePath == QLatin1String("/build/app") );
+    REQUIRE( request.additionalTargetFilePathList == qStringListFromUtf8Strings({"/build/appTool","/build/appHelper"}) );
     REQUIRE( request.destinationDirectoryPath == QLatin1String("/tmp") );
   }
 }
+
+TEST_CASE("Serve")
+{
+  CommandLineParser parser;
+  QStringList arguments = qStringListFromUtf8Strings({"mdtdeployutils","serve"});
+
+  SECTION("processed command")
+  {
+    arguments << QLatin1String("/tmp/mdtdeployutils.socket");
+
+    parser.process(arguments);
+
+    REQUIRE( parser.processedCommand() == CommandLineCommand::Serve );
+  }
+
+  SECTION("Default options")
+  {
+    arguments << QLatin1String("/tmp/mdtdeployutils.socket");
+
+    parser.process(arguments);
+
+    REQUIRE( parser.serveSocketName() == QLatin1String("/tmp/mdtdeployutils.socket") );
+    REQUIRE( parser.serveIdleTimeoutSeconds() == 0 );
+  }
+
+  SECTION("Specify idle-timeout")
+  {
+    arguments << qStringListFromUtf8Strings({"--idle-timeout","120","/tmp/mdtdeployutils.socket"});
+
+    parser.process(arguments);
+
+    REQUIRE( parser.serveIdleTimeoutSeconds() == 120 );
+  }
+}
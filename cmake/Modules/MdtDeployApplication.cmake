@@ -21,6 +21,7 @@
 #     LIBRARY_DESTINATION <dir>
 #     [CONAN_BUILD_INFO_FILE_PATH <file-path>]
 #     [QT_PLUGINS_SET <set>]
+#     [REDISTRIBUTION_POLICY_FILE <file-path>]
 #     [EXPORT_NAME <export-name>]
 #     [EXPORT_NAMESPACE <export-namespace>]
 #     [NO_PACKAGE_CONFIG_FILE]
@@ -71,6 +72,9 @@
 # For platform plugins, we expressed plugins for Linux and Windows.
 # On Linux, only xcb, vnc and eglfs will be deployed. On Windows, only windows and direct2d plugins will be deployed.
 #
+# To tune which shared libraries are redistributed, a policy file can be given with ``REDISTRIBUTION_POLICY_FILE``.
+# For the format of this file, see :command:`mdt_install_shared_libraries_target_depends_on()`.
+#
 # To generate CMake exports, use ``EXPORT_NAME`` and ``EXPORT_NAMESPACE``.
 # If specified, a file, named ``${EXPORT_NAMESPACE}${EXPORT_NAME}.cmake``, will be generated.
 # This file will define a ``IMPORTED`` target, named ``${EXPORT_NAMESPACE}::${EXPORT_NAME}``.
@@ -135,6 +139,55 @@
 #     DEVELOPMENT_COMPONENT ${PROJECT_NAME}_Devel
 #   )
 #
+# Deploy several applications with a single call to mdtdeployutils
+# ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+#
+# .. command:: mdt_deploy_application_install_registered_requests
+#
+# By default, each :command:`mdt_deploy_application()` call
+# generates a install script that calls mdtdeployutils for its target.
+# For a project that deploys many applications,
+# the shared libraries they have in common are then inspected again and again.
+#
+# If ``MDT_DEPLOY_APPLICATION_REGISTER_REQUESTS`` is ``ON``
+# when :command:`mdt_deploy_application()` is called,
+# its install script only registers the request in a manifest.
+# A final install script then calls mdtdeployutils once
+# for each group of requests that have the same options,
+# giving all their targets at once.
+#
+# This final script is added by::
+#
+#   mdt_deploy_application_install_registered_requests()
+#
+# which must be called after all :command:`mdt_deploy_application()` calls,
+# typically at the end of the top level ``CMakeLists.txt``.
+# Install rules run in the order they are declared,
+# so the final script runs after all the requests have been registered.
+#
+# This order also holds for the install rules of subdirectories
+# only if policy ``CMP0082`` is ``NEW``
+# (which is the case with ``cmake_minimum_required(VERSION 3.14)`` or later).
+# With the ``OLD`` behavior, the install rules of a subdirectory
+# run after the ones of its parent directory,
+# so the final script would run before the requests of the subdirectories are registered.
+# :command:`mdt_deploy_application_install_registered_requests()`
+# emits a warning if ``CMP0082`` is not set to ``NEW``.
+#
+# The final script is installed as part of each ``RUNTIME_COMPONENT``
+# given to :command:`mdt_deploy_application()`.
+# Installing only some components deploys the applications of those components.
+#
+# Example:
+#
+# .. code-block:: cmake
+#
+#   set(MDT_DEPLOY_APPLICATION_REGISTER_REQUESTS ON)
+#
+#   add_subdirectory(apps)
+#
+#   mdt_deploy_application_install_registered_requests()
+#
 
 include(MdtDeployUtilsPackageConfigHelpers)
 include(MdtGenerateMdtdeployutilsInstallScript)
@@ -142,7 +195,7 @@ include(MdtGenerateMdtdeployutilsInstallScript)
 function(mdt_deploy_application)
 
   set(options NO_PACKAGE_CONFIG_FILE EXCLUDE_FROM_ALL)
-  set(oneValueArgs TARGET RUNTIME_DESTINATION LIBRARY_DESTINATION CONAN_BUILD_INFO_FILE_PATH QT_PLUGINS_SET EXPORT_NAME EXPORT_NAMESPACE EXPORT_DIRECTORY INSTALL_IS_UNIX_SYSTEM_WIDE RUNTIME_COMPONENT DEVELOPMENT_COMPONENT)
+  set(oneValueArgs TARGET RUNTIME_DESTINATION LIBRARY_DESTINATION CONAN_BUILD_INFO_FILE_PATH QT_PLUGINS_SET REDISTRIBUTION_POLICY_FILE EXPORT_NAME EXPORT_NAMESPACE EXPORT_DIRECTORY INSTALL_IS_UNIX_SYSTEM_WIDE RUNTIME_COMPONENT DEVELOPMENT_COMPONENT)
   set(multiValueArgs)
   cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
 
@@ -237,6 +290,21 @@ function(mdt_deploy_application)
   set(MDT_DEPLOY_APPLICATION_INSTALL_SCRIPT_LIBRARY_DESTINATION ${ARG_LIBRARY_DESTINATION})
   set(MDT_DEPLOY_APPLICATION_INSTALL_SCRIPT_QT_PLUGINS_SET ${ARG_QT_PLUGINS_SET})
 
+  set(MDT_DEPLOY_APPLICATION_INSTALL_SCRIPT_REQUESTS_MANIFEST)
+  if(MDT_DEPLOY_APPLICATION_REGISTER_REQUESTS)
+    _mdt_deploy_application_requests_manifest(MDT_DEPLOY_APPLICATION_INSTALL_SCRIPT_REQUESTS_MANIFEST)
+    if(ARG_RUNTIME_COMPONENT)
+      set_property(GLOBAL APPEND PROPERTY MDT_DEPLOY_APPLICATION_REGISTERED_REQUESTS_COMPONENTS ${ARG_RUNTIME_COMPONENT})
+    else()
+      set_property(GLOBAL APPEND PROPERTY MDT_DEPLOY_APPLICATION_REGISTERED_REQUESTS_COMPONENTS Unspecified)
+    endif()
+  endif()
+
+  set(MDT_DEPLOY_APPLICATION_INSTALL_SCRIPT_REDISTRIBUTION_POLICY_FILE)
+  if(ARG_REDISTRIBUTION_POLICY_FILE)
+    get_filename_component(MDT_DEPLOY_APPLICATION_INSTALL_SCRIPT_REDISTRIBUTION_POLICY_FILE "${ARG_REDISTRIBUTION_POLICY_FILE}" ABSOLUTE)
+  endif()
+
 #   message(VERBOSE "CMAKE_INSTALL_PREFIX: ${CMAKE_INSTALL_PREFIX}")
   message(DEBUG "MDT_DEPLOY_APPLICATION_INSTALL_CMAKE_PREFIX_PATH: ${MDT_DEPLOY_APPLICATION_INSTALL_CMAKE_PREFIX_PATH}")
 
@@ -248,3 +316,43 @@ function(mdt_deploy_application)
   )
 
 endfunction()
+
+
+function(mdt_deploy_application_install_registered_requests)
+
+  set(options)
+  set(oneValueArgs)
+  set(multiValueArgs)
+  cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+  if(ARG_UNPARSED_ARGUMENTS)
+    message(FATAL_ERROR "mdt_deploy_application_install_registered_requests(): unknown arguments passed: ${ARG_UNPARSED_ARGUMENTS}")
+  endif()
+
+  get_property(components GLOBAL PROPERTY MDT_DEPLOY_APPLICATION_REGISTERED_REQUESTS_COMPONENTS)
+  if(NOT components)
+    message(WARNING "mdt_deploy_application_install_registered_requests(): no request registered. Was MDT_DEPLOY_APPLICATION_REGISTER_REQUESTS set before calling mdt_deploy_application() ?")
+    return()
+  endif()
+  list(REMOVE_DUPLICATES components)
+
+  cmake_policy(GET CMP0082 installRulesOrderPolicy)
+  if(NOT installRulesOrderPolicy STREQUAL "NEW")
+    message(WARNING "mdt_deploy_application_install_registered_requests(): policy CMP0082 is not set to NEW, the requests registered in subdirectories will not be deployed. Use cmake_minimum_required(VERSION 3.14) or later, or set CMP0082 to NEW.")
+  endif()
+
+  _mdt_deploy_application_requests_manifest(MDT_DEPLOY_APPLICATION_INSTALL_SCRIPT_REQUESTS_MANIFEST)
+
+  mdt_generate_mdtdeployutils_install_script(
+    SCRIPT_NAME MdtDeployApplicationRegisteredRequestsInstallScript
+    INPUT_SCRIPT_FILE MdtDeployApplicationRegisteredRequestsInstallScript.cmake.in
+    COMPONENTS ${components}
+  )
+
+endfunction()
+
+# All the requests of a build tree are registered in the same manifest,
+# one per configuration (multi-config generators)
+function(_mdt_deploy_application_requests_manifest outVar)
+  set(${outVar} "${CMAKE_BINARY_DIR}/MdtDeployApplicationRequests-$<CONFIG>.cmake" PARENT_SCOPE)
+endfunction()
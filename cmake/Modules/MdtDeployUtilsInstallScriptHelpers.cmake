@@ -42,6 +42,17 @@ function(execute_mdtdeployutils)
   set(deployUtilsExecutable "${ARG_MDTDEPLOYUTILS_EXECUTABLE}")
   message(DEBUG "deployUtilsExecutable: ${deployUtilsExecutable}")
 
+  # If a server was started with mdtdeployutils serve <socket>
+  # and MDT_DEPLOY_UTILS_SERVER is set to <socket>,
+  # the commands are sent to it.
+  # It keeps the informations read from the binaries between the install scripts.
+  # If the server is not reachable, mdtdeployutils executes the command itself.
+  set(deployUtilsServer "$ENV{MDT_DEPLOY_UTILS_SERVER}")
+  if(deployUtilsServer)
+    message(DEBUG "mdtdeployutils will forward to server ${deployUtilsServer}")
+    list(PREPEND ARG_ARGUMENTS --server "${deployUtilsServer}")
+  endif()
+
   if(ARG_RUNTIME_ENV)
     if(WIN32)
       # ; have to be escaped, otherwise the environment will not be set properly
@@ -86,3 +97,140 @@ function(execute_mdtdeployutils)
   endif()
 
 endfunction()
+
+
+# Register a request to be executed later by execute_mdtdeployutils_registered_requests()
+#
+# The request is appended to MANIFEST_FILE, which is a CMake script.
+# Requests that have the same ARGUMENTS and DESTINATION
+# are grouped, and executed by calling mdtdeployutils once, with all their target files.
+#
+# The first request registered by a install removes MANIFEST_FILE,
+# so requests left by a previous install (that failed, or did not run the final script)
+# are not executed again, possibly to a other destination.
+function(mdt_register_mdtdeployutils_request)
+
+  set(options)
+  set(oneValueArgs MANIFEST_FILE TARGET_FILE DESTINATION)
+  set(multiValueArgs ARGUMENTS)
+  cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+  if(NOT ARG_MANIFEST_FILE)
+    message(FATAL_ERROR "mdt_register_mdtdeployutils_request(): mandatory argument MANIFEST_FILE missing")
+  endif()
+  if(NOT ARG_TARGET_FILE)
+    message(FATAL_ERROR "mdt_register_mdtdeployutils_request(): mandatory argument TARGET_FILE missing")
+  endif()
+  if(NOT ARG_DESTINATION)
+    message(FATAL_ERROR "mdt_register_mdtdeployutils_request(): mandatory argument DESTINATION missing")
+  endif()
+  if(NOT ARG_ARGUMENTS)
+    message(FATAL_ERROR "mdt_register_mdtdeployutils_request(): mandatory argument ARGUMENTS missing")
+  endif()
+  if(ARG_UNPARSED_ARGUMENTS)
+    message(FATAL_ERROR "mdt_register_mdtdeployutils_request(): unknown arguments passed: ${ARG_UNPARSED_ARGUMENTS}")
+  endif()
+
+  string(SHA1 requestKey "${ARG_ARGUMENTS}|${ARG_DESTINATION}")
+  set(requestPrefix "MDT_DEPLOY_UTILS_REQUEST_${requestKey}")
+
+  message(VERBOSE "registering ${ARG_TARGET_FILE} to ${ARG_MANIFEST_FILE}")
+  message(DEBUG "request key: ${requestKey}")
+
+  _mdt_mdtdeployutils_requests_manifest_is_from_this_install("${ARG_MANIFEST_FILE}" manifestIsFromThisInstall)
+  if(NOT manifestIsFromThisInstall)
+    message(DEBUG "removing requests left by a previous install in ${ARG_MANIFEST_FILE}")
+    file(REMOVE "${ARG_MANIFEST_FILE}")
+    _mdt_mark_mdtdeployutils_requests_manifest_from_this_install("${ARG_MANIFEST_FILE}")
+  endif()
+
+  file(APPEND "${ARG_MANIFEST_FILE}"
+    "list(APPEND MDT_DEPLOY_UTILS_REQUEST_KEYS ${requestKey})\n"
+    "set(${requestPrefix}_ARGUMENTS [==[${ARG_ARGUMENTS}]==])\n"
+    "set(${requestPrefix}_DESTINATION [==[${ARG_DESTINATION}]==])\n"
+    "list(APPEND ${requestPrefix}_TARGET_FILES [==[${ARG_TARGET_FILE}]==])\n"
+  )
+
+endfunction()
+
+
+# Execute the requests registered with mdt_register_mdtdeployutils_request()
+#
+# mdtdeployutils is called once for each group of requests,
+# with the target files given before the destination.
+#
+# Only the requests registered by the current install are executed.
+# The manifest is removed before executing them,
+# so a failed install does not leave requests for the next one.
+function(execute_mdtdeployutils_registered_requests)
+
+  set(options)
+  set(oneValueArgs MANIFEST_FILE MDTDEPLOYUTILS_EXECUTABLE)
+  set(multiValueArgs RUNTIME_ENV)
+  cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+  if(NOT ARG_MANIFEST_FILE)
+    message(FATAL_ERROR "execute_mdtdeployutils_registered_requests(): mandatory argument MANIFEST_FILE missing")
+  endif()
+  if(NOT ARG_MDTDEPLOYUTILS_EXECUTABLE)
+    message(FATAL_ERROR "execute_mdtdeployutils_registered_requests(): mandatory argument MDTDEPLOYUTILS_EXECUTABLE missing")
+  endif()
+  if(ARG_UNPARSED_ARGUMENTS)
+    message(FATAL_ERROR "execute_mdtdeployutils_registered_requests(): unknown arguments passed: ${ARG_UNPARSED_ARGUMENTS}")
+  endif()
+
+  # Can happen if this script is installed for several components
+  if(NOT EXISTS "${ARG_MANIFEST_FILE}")
+    message(VERBOSE "no request registered in ${ARG_MANIFEST_FILE}")
+    return()
+  endif()
+
+  # Left by a previous install that registered requests but did not execute them
+  _mdt_mdtdeployutils_requests_manifest_is_from_this_install("${ARG_MANIFEST_FILE}" manifestIsFromThisInstall)
+  if(NOT manifestIsFromThisInstall)
+    message(VERBOSE "ignoring requests left by a previous install in ${ARG_MANIFEST_FILE}")
+    file(REMOVE "${ARG_MANIFEST_FILE}")
+    return()
+  endif()
+
+  set(MDT_DEPLOY_UTILS_REQUEST_KEYS)
+  include("${ARG_MANIFEST_FILE}")
+  file(REMOVE "${ARG_MANIFEST_FILE}")
+
+  list(REMOVE_DUPLICATES MDT_DEPLOY_UTILS_REQUEST_KEYS)
+
+  foreach(requestKey IN LISTS MDT_DEPLOY_UTILS_REQUEST_KEYS)
+    set(requestPrefix "MDT_DEPLOY_UTILS_REQUEST_${requestKey}")
+    set(targetFiles ${${requestPrefix}_TARGET_FILES})
+    list(REMOVE_DUPLICATES targetFiles)
+
+    message(VERBOSE "executing registered request for ${targetFiles}")
+
+    execute_mdtdeployutils(
+      MDTDEPLOYUTILS_EXECUTABLE "${ARG_MDTDEPLOYUTILS_EXECUTABLE}"
+      RUNTIME_ENV "${ARG_RUNTIME_ENV}"
+      ARGUMENTS ${${requestPrefix}_ARGUMENTS}
+                ${targetFiles}
+                "${${requestPrefix}_DESTINATION}"
+    )
+  endforeach()
+
+endfunction()
+
+
+# A install runs all its scripts in the same CMake process,
+# so a global property tells if the manifest has been started by the current install
+function(_mdt_mdtdeployutils_requests_manifest_is_from_this_install manifestFile outVar)
+  string(SHA1 manifestKey "${manifestFile}")
+  get_property(isFromThisInstall GLOBAL PROPERTY MDT_DEPLOY_UTILS_REQUESTS_MANIFEST_${manifestKey}_STARTED)
+  if(isFromThisInstall)
+    set(${outVar} TRUE PARENT_SCOPE)
+  else()
+    set(${outVar} FALSE PARENT_SCOPE)
+  endif()
+endfunction()
+
+function(_mdt_mark_mdtdeployutils_requests_manifest_from_this_install manifestFile)
+  string(SHA1 manifestKey "${manifestFile}")
+  set_property(GLOBAL PROPERTY MDT_DEPLOY_UTILS_REQUESTS_MANIFEST_${manifestKey}_STARTED TRUE)
+endfunction()
@@ -22,12 +22,18 @@
 # Generate a script calling mdtdeployutils at install time::
 #
 #   mdt_generate_mdtdeployutils_install_script(
-#     TARGET <target>
+#     TARGET <target> | SCRIPT_NAME <name>
 #     INPUT_SCRIPT_FILE <file-name>
-#     [COMPONENT <name>]
+#     [COMPONENT <name> | COMPONENTS <name1> [<name2> ...]]
 #     [EXCLUDE_FROM_ALL]
 #   )
 #
+# If the script does not relate to a single target,
+# give ``SCRIPT_NAME`` instead of ``TARGET``.
+# It is used to name the generated script.
+#
+# With ``COMPONENTS``, the script is installed as part of each given component.
+#
 # Pass the input script to the ``INPUT_SCRIPT_FILE`` argument.
 # It must be the file name, like `MyScript.cmake.in`, not a full path.
 # This way it will be located properly if this function is called
@@ -145,16 +151,19 @@
 function(mdt_generate_mdtdeployutils_install_script)
 
   set(options EXCLUDE_FROM_ALL)
-  set(oneValueArgs TARGET INPUT_SCRIPT_FILE COMPONENT)
-  set(multiValueArgs)
+  set(oneValueArgs TARGET SCRIPT_NAME INPUT_SCRIPT_FILE COMPONENT)
+  set(multiValueArgs COMPONENTS)
   cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
 
-  if(NOT ARG_TARGET)
-    message(FATAL_ERROR "mdt_generate_mdtdeployutils_install_script(): no target provided")
+  if(NOT ARG_TARGET AND NOT ARG_SCRIPT_NAME)
+    message(FATAL_ERROR "mdt_generate_mdtdeployutils_install_script(): no target or script name provided")
   endif()
-  if(NOT TARGET ${ARG_TARGET})
+  if(ARG_TARGET AND NOT TARGET ${ARG_TARGET})
     message(FATAL_ERROR "mdt_generate_mdtdeployutils_install_script(): ${ARG_TARGET} is not a valid target")
   endif()
+  if(ARG_COMPONENT AND ARG_COMPONENTS)
+    message(FATAL_ERROR "mdt_generate_mdtdeployutils_install_script(): COMPONENT and COMPONENTS can not be used together")
+  endif()
   if(NOT ARG_INPUT_SCRIPT_FILE)
     message(FATAL_ERROR "mdt_generate_mdtdeployutils_install_script(): mandatory argument INPUT_SCRIPT_FILE missing")
   endif()
@@ -162,10 +171,7 @@ function(mdt_generate_mdtdeployutils_install_script)
     message(FATAL_ERROR "mdt_generate_mdtdeployutils_install_script(): unknown arguments passed: ${ARG_UNPARSED_ARGUMENTS}")
   endif()
 
-  set(componentArguments)
-  if(ARG_COMPONENT)
-    set(componentArguments COMPONENT ${ARG_COMPONENT})
-  endif()
+  set(components ${ARG_COMPONENT} ${ARG_COMPONENTS})
 
   # configure_file() does not support generator expression
   # file(GENERATE) supports generator expression, but not @ expension
@@ -186,7 +192,11 @@ function(mdt_generate_mdtdeployutils_install_script)
 
   message(DEBUG "inInstallScript: ${inInstallScript}")
 
-  set(intermediateInstallScript "${CMAKE_CURRENT_BINARY_DIR}/MdtDeployApplicationInstallScript-${ARG_TARGET}.cmake.intermediate")
+  if(ARG_TARGET)
+    set(intermediateInstallScript "${CMAKE_CURRENT_BINARY_DIR}/MdtDeployApplicationInstallScript-${ARG_TARGET}.cmake.intermediate")
+  else()
+    set(intermediateInstallScript "${CMAKE_CURRENT_BINARY_DIR}/${ARG_SCRIPT_NAME}.cmake.intermediate")
+  endif()
 
   message(DEBUG "intermediateInstallScript: ${intermediateInstallScript}")
 
@@ -202,13 +212,27 @@ function(mdt_generate_mdtdeployutils_install_script)
 
   configure_file("${inInstallScript}" "${intermediateInstallScript}" @ONLY)
 
-  set(installScript "${CMAKE_CURRENT_BINARY_DIR}/MdtDeployApplicationInstallScript-$<TARGET_FILE_BASE_NAME:${ARG_TARGET}>-$<CONFIG>.cmake")
-  file(GENERATE
-    OUTPUT "${installScript}"
-    INPUT "${intermediateInstallScript}"
-    TARGET ${ARG_TARGET}
-  )
+  if(ARG_TARGET)
+    set(installScript "${CMAKE_CURRENT_BINARY_DIR}/MdtDeployApplicationInstallScript-$<TARGET_FILE_BASE_NAME:${ARG_TARGET}>-$<CONFIG>.cmake")
+    file(GENERATE
+      OUTPUT "${installScript}"
+      INPUT "${intermediateInstallScript}"
+      TARGET ${ARG_TARGET}
+    )
+  else()
+    set(installScript "${CMAKE_CURRENT_BINARY_DIR}/${ARG_SCRIPT_NAME}-$<CONFIG>.cmake")
+    file(GENERATE
+      OUTPUT "${installScript}"
+      INPUT "${intermediateInstallScript}"
+    )
+  endif()
 
-  install(SCRIPT "${installScript}" ${componentArguments} ${excludeFromAllArgument})
+  if(components)
+    foreach(component IN LISTS components)
+      install(SCRIPT "${installScript}" COMPONENT ${component} ${excludeFromAllArgument})
+    endforeach()
+  else()
+    install(SCRIPT "${installScript}" ${excludeFromAllArgument})
+  endif()
 
 endfunction()
@@ -20,6 +20,7 @@
 #     DESTINATION <dir>
 #     [OVERWRITE_BEHAVIOR [KEEP|OVERWRITE|FAIL]]
 #     [REMOVE_RPATH [TRUE|FALSE]]
+#     [REDISTRIBUTION_POLICY_FILE <file-path>]
 #   )
 #
 # The shared libraries ``target`` depends on are copied to the location specified by ``DESTINATION``.
@@ -46,6 +47,34 @@
 # then dependencies will be searched in ``CMAKE_PREFIX_PATH``.
 # Some platform specific locations will also be used to find the libraries.
 #
+# Some shared libraries are never copied, because they are part of the system
+# (for example, ``libc.so.6`` on Linux, or ``KERNEL32.DLL`` on Windows).
+# If ``REDISTRIBUTION_POLICY_FILE`` is given, the rules it contains
+# are consulted before those built-in lists.
+# For the format of this file, see :command:`mdt_install_shared_libraries_target_depends_on()`.
+#
+# With the Ninja and Makefile generators (single configuration, CMake 3.20 or later),
+# the copy is a build step of its own, that has a depfile
+# listing ``target`` and every shared library that has been found.
+# The build system then skips this step
+# when neither ``target`` nor any of those shared libraries changed,
+# and runs it again when one of those shared libraries changed, even if ``target`` did not.
+# This step belongs to the ``<target>_copy_shared_libraries`` target, that is part of ``ALL``.
+# With other generators, or if ``MDT_SHARED_LIBRARIES_POST_BUILD`` is ``TRUE``,
+# the copy is a ``POST_BUILD`` step of ``target``,
+# that runs each time ``target`` is linked.
+#
+# .. note::
+#
+#   In previous versions, the copy was always a ``POST_BUILD`` step of ``target``.
+#   With the Ninja and Makefile generators, building only ``target``
+#   (for example ``cmake --build . --target myApp``)
+#   no longer copies the shared libraries:
+#   build ``<target>_copy_shared_libraries`` too
+#   (for example ``cmake --build . --target myApp myApp_copy_shared_libraries``),
+#   or set ``MDT_SHARED_LIBRARIES_POST_BUILD`` to ``TRUE``
+#   before calling this function to keep the previous behavior.
+#
 # Example:
 #
 # .. code-block:: cmake
@@ -75,6 +104,76 @@
 # the rpath informations is set to ``$ORIGIN`` for each shared library that has been copied.
 #
 #
+# Set the runtime environment of tests
+# ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+#
+# .. command:: mdt_set_tests_runtime_environment_target_depends_on
+#
+# Let tests find the shared libraries ``target`` depends on, without copying them::
+#
+#   mdt_set_tests_runtime_environment_target_depends_on(
+#     TARGET <target>
+#     TESTS <test> [<test>...]
+#     [REDISTRIBUTION_POLICY_FILE <file-path>]
+#   )
+#
+# Instead of copying the shared libraries ``target`` depends on,
+# the directories in which they have been found are listed
+# in the ``LD_LIBRARY_PATH`` (on Linux) or the ``PATH`` (on Windows)
+# environment variable of each test given by ``TESTS``.
+# This is intended to run tests in the build tree.
+#
+# The directories are ordered so that the loader picks the same files
+# as if the shared libraries had been copied by :command:`mdt_copy_shared_libraries_target_depends_on()`:
+# if a directory contains a other file with the same name as a library found in a other directory,
+# the directory of the library comes first.
+# The value of the variable in the environment of ``ctest``, if any, comes after those directories.
+#
+# The shared libraries are searched the same way as :command:`mdt_copy_shared_libraries_target_depends_on()` does,
+# and ``REDISTRIBUTION_POLICY_FILE`` has the same meaning.
+#
+# The directories are written to ``<target>.env``,
+# in the ``MdtRuntimeEnvironment`` subdirectory of the current binary directory.
+# With the Ninja and Makefile generators (single configuration, CMake 3.20 or later),
+# this file is generated by a build step of its own, that has a depfile,
+# and that belongs to the ``<target>_runtime_environment`` target (part of ``ALL``).
+# Building only ``target`` does not generate this file:
+# build ``<target>_runtime_environment`` too.
+# With other generators, or if ``MDT_SHARED_LIBRARIES_POST_BUILD`` is ``TRUE``,
+# it is generated by a ``POST_BUILD`` step of ``target``.
+# ``ctest`` reads this file each time it runs, so it is not required to re-run CMake
+# when the shared libraries ``target`` depends on changed.
+#
+# The tests given by ``TESTS`` must be defined in the current directory,
+# and testing must be enabled (see :command:`enable_testing()`).
+#
+# With ``ctest`` 3.22 or later, the directories are prepended
+# by the ``ENVIRONMENT_MODIFICATION`` property of the tests
+# (one ``path_list_prepend`` per directory),
+# so the ``ENVIRONMENT`` property set by the user
+# (for example ``QT_QPA_PLATFORM=offscreen``) is kept.
+# The ``ENVIRONMENT_MODIFICATION`` property is replaced.
+#
+# With older ``ctest``, the variable is set in the ``ENVIRONMENT`` property.
+# Its other entries are kept, but only the ones set
+# before calling :command:`mdt_set_tests_runtime_environment_target_depends_on()`.
+#
+# Example:
+#
+# .. code-block:: cmake
+#
+#   add_executable(myAppTest myAppTest.cpp)
+#   target_link_libraries(myAppTest PRIVATE Qt5::Core)
+#   target_link_libraries(myAppTest PRIVATE Mdt0::PlainText)
+#
+#   add_test(NAME MyAppTest COMMAND myAppTest)
+#
+#   mdt_set_tests_runtime_environment_target_depends_on(
+#     TARGET myAppTest
+#     TESTS MyAppTest
+#   )
+#
+#
 # Install shared libraries a target depends on
 # ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 #
@@ -88,6 +187,7 @@
 #     LIBRARY_DESTINATION <dir>
 #     [INSTALL_IS_UNIX_SYSTEM_WIDE [TRUE|FALSE]]
 #     [COMPONENT <component-name>]
+#     [REDISTRIBUTION_POLICY_FILE <file-path>]
 #     [EXCLUDE_FROM_ALL]
 #   )
 #
@@ -114,6 +214,29 @@
 # If ``INSTALL_IS_UNIX_SYSTEM_WIDE`` is ``TRUE``,
 # the rpath informations are removed for each shared library that has been installed.
 #
+# To decide which shared libraries have to be redistributed,
+# a redistribution policy file can be given with ``REDISTRIBUTION_POLICY_FILE``.
+# Its rules are consulted before the built-in exclude lists.
+# Example of such file:
+#
+# .. code-block:: none
+#
+#   # Applies to all platforms
+#   [all]
+#   exclude libmyvendorlib*
+#
+#   [linux]
+#   exclude libGL.so*
+#   include libstdc++.so.6
+#
+#   [windows]
+#   exclude MYVENDORLIB?.DLL
+#
+# Patterns can use ``*`` and ``?`` wildcards.
+# On Windows, patterns are case insensitive.
+# If a library matches a ``include`` rule, it will be redistributed,
+# even if it also matches a ``exclude`` rule.
+#
 # Example:
 #
 # .. code-block:: cmake
@@ -158,7 +281,7 @@ include(MdtGenerateMdtdeployutilsInstallScript)
 function(mdt_copy_shared_libraries_target_depends_on)
 
   set(options)
-  set(oneValueArgs TARGET DESTINATION OVERWRITE_BEHAVIOR REMOVE_RPATH)
+  set(oneValueArgs TARGET DESTINATION OVERWRITE_BEHAVIOR REMOVE_RPATH REDISTRIBUTION_POLICY_FILE)
   set(multiValueArgs)
   cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
 
@@ -207,20 +330,249 @@ function(mdt_copy_shared_libraries_target_depends_on)
     set(compilerLocationArguments --compiler-location "compiler-path=${CMAKE_CXX_COMPILER}")
   endif()
 
+  set(redistributionPolicyFile)
+  set(redistributionPolicyFileArguments)
+  if(ARG_REDISTRIBUTION_POLICY_FILE)
+    get_filename_component(redistributionPolicyFile "${ARG_REDISTRIBUTION_POLICY_FILE}" ABSOLUTE)
+    set(redistributionPolicyFileArguments --redistribution-policy-file "${redistributionPolicyFile}")
+  endif()
 
-  add_custom_command(
-    TARGET ${ARG_TARGET}
-    POST_BUILD
-    COMMAND ${deployUtilsExecutable} --logger-backend cmake copy-shared-libraries-target-depends-on
-              --overwrite-behavior ${overwriteBehaviorOption}
-              ${removeRpathOptionArgument}
-              --search-prefix-path-list "${CMAKE_PREFIX_PATH}"
-              --path-list-separator ";"
-              ${compilerLocationArguments}
-              $<TARGET_FILE:${ARG_TARGET}>
-              "${ARG_DESTINATION}"
-    VERBATIM
+  get_property(isMultiConfig GLOBAL PROPERTY GENERATOR_IS_MULTI_CONFIG)
+
+  # DEPFILE is supported by the Makefile generators since CMake 3.20
+  if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.20 AND NOT isMultiConfig AND CMAKE_GENERATOR MATCHES "Ninja|Makefiles" AND NOT MDT_SHARED_LIBRARIES_POST_BUILD)
+
+    set(stampDirectory "${CMAKE_CURRENT_BINARY_DIR}/MdtCopySharedLibraries")
+    set(stampFile "${stampDirectory}/${ARG_TARGET}.stamp")
+    set(depFile "${stampDirectory}/${ARG_TARGET}.d")
+
+    # The depfile only contains absolute paths,
+    # so the Ninja path transformation does not change anything
+    if(POLICY CMP0116)
+      cmake_policy(PUSH)
+      cmake_policy(SET CMP0116 NEW)
+    endif()
+
+    add_custom_command(
+      OUTPUT "${stampFile}"
+      COMMAND ${deployUtilsExecutable} --logger-backend cmake copy-shared-libraries-target-depends-on
+                --overwrite-behavior ${overwriteBehaviorOption}
+                ${removeRpathOptionArgument}
+                --search-prefix-path-list "${CMAKE_PREFIX_PATH}"
+                --path-list-separator ";"
+                ${compilerLocationArguments}
+                ${redistributionPolicyFileArguments}
+                --depfile "${depFile}"
+                --stamp-file "${stampFile}"
+                $<TARGET_FILE:${ARG_TARGET}>
+                "${ARG_DESTINATION}"
+      DEPENDS ${ARG_TARGET} ${redistributionPolicyFile}
+      DEPFILE "${depFile}"
+      COMMENT "Copying shared libraries ${ARG_TARGET} depends on"
+      VERBATIM
+    )
+
+    if(POLICY CMP0116)
+      cmake_policy(POP)
+    endif()
+
+    add_custom_target(${ARG_TARGET}_copy_shared_libraries ALL
+      DEPENDS "${stampFile}"
+    )
+
+  else()
+
+    add_custom_command(
+      TARGET ${ARG_TARGET}
+      POST_BUILD
+      COMMAND ${deployUtilsExecutable} --logger-backend cmake copy-shared-libraries-target-depends-on
+                --overwrite-behavior ${overwriteBehaviorOption}
+                ${removeRpathOptionArgument}
+                --search-prefix-path-list "${CMAKE_PREFIX_PATH}"
+                --path-list-separator ";"
+                ${compilerLocationArguments}
+                ${redistributionPolicyFileArguments}
+                $<TARGET_FILE:${ARG_TARGET}>
+                "${ARG_DESTINATION}"
+      VERBATIM
+    )
+
+  endif()
+
+endfunction()
+
+function(mdt_set_tests_runtime_environment_target_depends_on)
+
+  set(options)
+  set(oneValueArgs TARGET REDISTRIBUTION_POLICY_FILE)
+  set(multiValueArgs TESTS)
+  cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+  if(NOT ARG_TARGET)
+    message(FATAL_ERROR "mdt_set_tests_runtime_environment_target_depends_on(): no target provided")
+  endif()
+  if(NOT TARGET ${ARG_TARGET})
+    message(FATAL_ERROR "mdt_set_tests_runtime_environment_target_depends_on(): ${ARG_TARGET} is not a valid target")
+  endif()
+  if(NOT ARG_TESTS)
+    message(FATAL_ERROR "mdt_set_tests_runtime_environment_target_depends_on(): mandatory argument TESTS missing")
+  endif()
+  if(ARG_UNPARSED_ARGUMENTS)
+    message(FATAL_ERROR "mdt_set_tests_runtime_environment_target_depends_on(): unknown arguments passed: ${ARG_UNPARSED_ARGUMENTS}")
+  endif()
+
+  # We not use this function in MdtDeployUtils itself,
+  # so we can safely use the installed mdtdeployutils target
+  set(deployUtilsExecutable Mdt0::DeployUtilsExecutable)
+
+  set(compilerLocationArguments)
+  if(MSVC)
+    set(compilerLocationArguments --compiler-location "compiler-path=${CMAKE_CXX_COMPILER}")
+  endif()
+
+  set(redistributionPolicyFile)
+  set(redistributionPolicyFileArguments)
+  if(ARG_REDISTRIBUTION_POLICY_FILE)
+    get_filename_component(redistributionPolicyFile "${ARG_REDISTRIBUTION_POLICY_FILE}" ABSOLUTE)
+    set(redistributionPolicyFileArguments --redistribution-policy-file "${redistributionPolicyFile}")
+  endif()
+
+  set(environmentDirectory "${CMAKE_CURRENT_BINARY_DIR}/MdtRuntimeEnvironment")
+  set(environmentFile "${environmentDirectory}/${ARG_TARGET}.env")
+
+  get_property(isMultiConfig GLOBAL PROPERTY GENERATOR_IS_MULTI_CONFIG)
+
+  # DEPFILE is supported by the Makefile generators since CMake 3.20
+  if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.20 AND NOT isMultiConfig AND CMAKE_GENERATOR MATCHES "Ninja|Makefiles" AND NOT MDT_SHARED_LIBRARIES_POST_BUILD)
+
+    set(depFile "${environmentDirectory}/${ARG_TARGET}.env.d")
+
+    # The depfile only contains absolute paths,
+    # so the Ninja path transformation does not change anything
+    if(POLICY CMP0116)
+      cmake_policy(PUSH)
+      cmake_policy(SET CMP0116 NEW)
+    endif()
+
+    add_custom_command(
+      OUTPUT "${environmentFile}"
+      COMMAND ${deployUtilsExecutable} --logger-backend cmake generate-runtime-environment-target-depends-on
+                --search-prefix-path-list "${CMAKE_PREFIX_PATH}"
+                --path-list-separator ";"
+                ${compilerLocationArguments}
+                ${redistributionPolicyFileArguments}
+                --depfile "${depFile}"
+                $<TARGET_FILE:${ARG_TARGET}>
+                "${environmentFile}"
+      DEPENDS ${ARG_TARGET} ${redistributionPolicyFile}
+      DEPFILE "${depFile}"
+      COMMENT "Generating runtime environment for ${ARG_TARGET}"
+      VERBATIM
+    )
+
+    if(POLICY CMP0116)
+      cmake_policy(POP)
+    endif()
+
+    add_custom_target(${ARG_TARGET}_runtime_environment ALL
+      DEPENDS "${environmentFile}"
+    )
+
+  else()
+
+    add_custom_command(
+      TARGET ${ARG_TARGET}
+      POST_BUILD
+      COMMAND ${deployUtilsExecutable} --logger-backend cmake generate-runtime-environment-target-depends-on
+                --search-prefix-path-list "${CMAKE_PREFIX_PATH}"
+                --path-list-separator ";"
+                ${compilerLocationArguments}
+                ${redistributionPolicyFileArguments}
+                $<TARGET_FILE:${ARG_TARGET}>
+                "${environmentFile}"
+      VERBATIM
+    )
+
+  endif()
+
+  if(WIN32)
+    set(variableName PATH)
+    set(pathSeparator ";")
+  else()
+    set(variableName LD_LIBRARY_PATH)
+    set(pathSeparator ":")
+  endif()
+  set(tests ${ARG_TESTS})
+
+  # ctest older than 3.22 can only replace the ENVIRONMENT of the tests,
+  # so keep the entries it has now
+  set(testsEnvironmentFallback)
+  foreach(test IN LISTS tests)
+    get_test_property(${test} ENVIRONMENT testEnvironment)
+    if(NOT testEnvironment)
+      set(testEnvironment)
+    endif()
+    list(FILTER testEnvironment EXCLUDE REGEX "^${variableName}=")
+    if(testEnvironment)
+      string(APPEND testsEnvironmentFallback
+        "  set(testEnvironment [==[${testEnvironment}]==])\n"
+        "  set_tests_properties(${test} PROPERTIES ENVIRONMENT \"\${value};\${testEnvironment}\")\n"
+      )
+    else()
+      string(APPEND testsEnvironmentFallback
+        "  set_tests_properties(${test} PROPERTIES ENVIRONMENT \"\${value}\")\n"
+      )
+    endif()
+  endforeach()
+
+  # The environment file is read by ctest, each time it runs
+  set(testScriptTemplate [=[
+# Generated by mdt_set_tests_runtime_environment_target_depends_on()
+if(NOT EXISTS "@environmentFile@")
+  return()
+endif()
+
+file(READ "@environmentFile@" environment)
+string(STRIP "${environment}" environment)
+string(REGEX REPLACE "^@variableName@=" "" value "${environment}")
+if(value STREQUAL "")
+  return()
+endif()
+
+# Keep the ENVIRONMENT set by the user
+if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.22)
+  if(NOT "@pathSeparator@" STREQUAL ";")
+    string(REPLACE "@pathSeparator@" ";" value "${value}")
+  endif()
+  # Each path_list_prepend puts its directory first, so the last directory is prepended first
+  list(REVERSE value)
+  set(modifications)
+  foreach(directory IN LISTS value)
+    list(APPEND modifications "@variableName@=path_list_prepend:${directory}")
+  endforeach()
+  set_tests_properties(@tests@ PROPERTIES ENVIRONMENT_MODIFICATION "${modifications}")
+else()
+  if(NOT "$ENV{@variableName@}" STREQUAL "")
+    set(value "${value}@pathSeparator@$ENV{@variableName@}")
+  endif()
+  string(REPLACE ";" "\;" value "${value}")
+  set(value "@variableName@=${value}")
+@testsEnvironmentFallback@endif()
+]=])
+  string(CONFIGURE "${testScriptTemplate}" testScript @ONLY)
+  set(testScriptFile "${environmentDirectory}/${ARG_TARGET}.cmake")
+  file(WRITE "${testScriptFile}" "${testScript}")
+
+  # ctest includes the TEST_INCLUDE_FILES of a directory
+  # before the tests of this directory are defined,
+  # so set_tests_properties() would not find them.
+  # The subdirectories are processed after,
+  # so the script is attached to a generated subdirectory.
+  set(testScriptDirectory "${environmentDirectory}/${ARG_TARGET}")
+  file(WRITE "${testScriptDirectory}/CMakeLists.txt"
+    "set_property(DIRECTORY APPEND PROPERTY TEST_INCLUDE_FILES \"${testScriptFile}\")\n"
   )
+  add_subdirectory("${testScriptDirectory}" "${testScriptDirectory}-build")
 
 endfunction()
 
@@ -259,7 +611,7 @@ endfunction()
 function(mdt_install_shared_libraries_target_depends_on)
 
   set(options EXCLUDE_FROM_ALL)
-  set(oneValueArgs TARGET RUNTIME_DESTINATION LIBRARY_DESTINATION INSTALL_IS_UNIX_SYSTEM_WIDE COMPONENT)
+  set(oneValueArgs TARGET RUNTIME_DESTINATION LIBRARY_DESTINATION INSTALL_IS_UNIX_SYSTEM_WIDE COMPONENT REDISTRIBUTION_POLICY_FILE)
   set(multiValueArgs)
   cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
 
@@ -291,6 +643,11 @@ function(mdt_install_shared_libraries_target_depends_on)
 
   set(MDT_INSTALL_SHARED_LIBRARIES_SCRIPT_INSTALL_IS_UNIX_SYSTEM_WIDE ${ARG_INSTALL_IS_UNIX_SYSTEM_WIDE})
 
+  set(MDT_INSTALL_SHARED_LIBRARIES_SCRIPT_REDISTRIBUTION_POLICY_FILE)
+  if(ARG_REDISTRIBUTION_POLICY_FILE)
+    get_filename_component(MDT_INSTALL_SHARED_LIBRARIES_SCRIPT_REDISTRIBUTION_POLICY_FILE "${ARG_REDISTRIBUTION_POLICY_FILE}" ABSOLUTE)
+  endif()
+
   if(WIN32)
     set(MDT_INSTALL_SHARED_LIBRARIES_SCRIPT_DESTINATION "${ARG_RUNTIME_DESTINATION}")
   else()
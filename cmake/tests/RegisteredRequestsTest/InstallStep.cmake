@@ -0,0 +1,30 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Simulates a install that uses registered requests
+#
+# Must be called with:
+#  -DCMAKE_INSTALL_PREFIX=<prefix>
+#  -DMANIFEST_FILE=<file>
+#  -DFAIL_INSTALL=<ON|OFF>
+#
+# The registered requests call cmake -E echo instead of mdtdeployutils,
+# so the target file and the destination are printed.
+
+include("${CMAKE_CURRENT_LIST_DIR}/../../Modules/MdtDeployUtilsInstallScriptHelpers.cmake")
+
+mdt_register_mdtdeployutils_request(
+  MANIFEST_FILE "${MANIFEST_FILE}"
+  TARGET_FILE "testApp"
+  DESTINATION "${MDT_INSTALL_PREFIX_WITH_DESTDIR}"
+  ARGUMENTS -E echo
+)
+
+if(FAIL_INSTALL)
+  message(FATAL_ERROR "simulated install failure")
+endif()
+
+execute_mdtdeployutils_registered_requests(
+  MANIFEST_FILE "${MANIFEST_FILE}"
+  MDTDEPLOYUTILS_EXECUTABLE "${CMAKE_COMMAND}"
+)
@@ -0,0 +1,56 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Checks that the requests registered by a failed install
+# are not executed by the next install
+#
+# Must be called with:
+#  -DTEST_WORK_DIR=<directory>
+
+if(NOT TEST_WORK_DIR)
+  message(FATAL_ERROR "RegisteredRequestsTest: TEST_WORK_DIR missing")
+endif()
+
+set(manifestFile "${TEST_WORK_DIR}/MdtDeployApplicationRequests-Test.cmake")
+set(installStepScript "${CMAKE_CURRENT_LIST_DIR}/InstallStep.cmake")
+file(REMOVE "${manifestFile}")
+
+execute_process(
+  COMMAND "${CMAKE_COMMAND}"
+    -DCMAKE_INSTALL_PREFIX=/opt/firstPrefix
+    "-DMANIFEST_FILE=${manifestFile}"
+    -DFAIL_INSTALL=ON
+    -P "${installStepScript}"
+  RESULT_VARIABLE firstInstallResult
+  OUTPUT_QUIET
+  ERROR_QUIET
+)
+if(firstInstallResult EQUAL 0)
+  message(FATAL_ERROR "RegisteredRequestsTest: the first install should have failed")
+endif()
+if(NOT EXISTS "${manifestFile}")
+  message(FATAL_ERROR "RegisteredRequestsTest: the first install should have left its request in ${manifestFile}")
+endif()
+
+execute_process(
+  COMMAND "${CMAKE_COMMAND}"
+    -DCMAKE_INSTALL_PREFIX=/opt/secondPrefix
+    "-DMANIFEST_FILE=${manifestFile}"
+    -DFAIL_INSTALL=OFF
+    -P "${installStepScript}"
+  RESULT_VARIABLE secondInstallResult
+  OUTPUT_VARIABLE secondInstallOutput
+  ERROR_VARIABLE secondInstallError
+)
+if(NOT secondInstallResult EQUAL 0)
+  message(FATAL_ERROR "RegisteredRequestsTest: the second install failed: ${secondInstallError}")
+endif()
+if(NOT secondInstallOutput MATCHES "secondPrefix")
+  message(FATAL_ERROR "RegisteredRequestsTest: the request of the second install was not executed. Output: ${secondInstallOutput}")
+endif()
+if(secondInstallOutput MATCHES "firstPrefix")
+  message(FATAL_ERROR "RegisteredRequestsTest: the request of the failed install was executed again. Output: ${secondInstallOutput}")
+endif()
+if(EXISTS "${manifestFile}")
+  message(FATAL_ERROR "RegisteredRequestsTest: ${manifestFile} should have been removed")
+endif()
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "DiagnosticMessagesBenchmark.h"
+#include "Mdt/DeployUtils/SharedLibraryFinderLinux.h"
+#include "Mdt/DeployUtils/AbstractIsExistingValidSharedLibrary.h"
+#include "Mdt/DeployUtils/QtDistributionDirectory.h"
+#include "Mdt/DeployUtils/BinaryDependenciesFile.h"
+#include "Mdt/DeployUtils/PathList.h"
+#include "Mdt/DeployUtils/AbstractMessageSink.h"
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QLatin1String>
+#include <memory>
+
+using namespace Mdt::DeployUtils;
+
+/*
+ * Like a search path list:
+ * each library is searched in every directory,
+ * and only found in the last one.
+ * Files are not touched, so that only the lookup
+ * and the diagnostic messages are measured.
+ */
+static const int searchDirectoryCount = 64;
+static const int libraryCount = 256;
+
+class IsInLastSearchDirectory : public AbstractIsExistingValidSharedLibrary
+{
+ public:
+
+  explicit IsInLastSearchDirectory(const QString & directory)
+   : mDirectory(directory)
+  {
+  }
+
+ private:
+
+  bool doIsExistingValidSharedLibrary(const QFileInfo & libraryFile) const override
+  {
+    return libraryFile.absolutePath() == mDirectory;
+  }
+
+  QString mDirectory;
+};
+
+class CountingMessageSink : public AbstractMessageSink
+{
+ public:
+
+  void status(const QString &) override
+  {
+    ++count;
+  }
+
+  void verbose(const QString &) override
+  {
+    ++count;
+  }
+
+  void debug(const QString &) override
+  {
+    ++count;
+  }
+
+  int count = 0;
+};
+
+void DiagnosticMessagesBenchmark::initTestCase()
+{
+  for(int i = 0; i < searchDirectoryCount; ++i){
+    mSearchPathList.append( QLatin1String("/opt/bench/lib") + QString::number(i) );
+  }
+  for(int i = 0; i < libraryCount; ++i){
+    mLibraryNames.append( QLatin1String("libBench") + QString::number(i) + QLatin1String(".so") );
+  }
+}
+
+void DiagnosticMessagesBenchmark::cleanupTestCase()
+{
+}
+
+void DiagnosticMessagesBenchmark::findLibraries(LogLevel logLevel, bool useMessageSink)
+{
+  const auto isExistingValidShLibOp = std::make_shared<IsInLastSearchDirectory>( mSearchPathList.last() );
+  auto qtDistributionDirectory = std::make_shared<QtDistributionDirectory>();
+  const auto dependentFile = BinaryDependenciesFile::fromQFileInfo( QFileInfo( QLatin1String("/opt/bench/bin/app") ) );
+
+  /*
+   * Like the command line tool,
+   * messages are only received if the log level requires them
+   */
+  int messageCount = 0;
+  const auto countMessage = [&messageCount](const QString &){
+    ++messageCount;
+  };
+
+  SharedLibraryFinderLinux finder(isExistingValidShLibOp, qtDistributionDirectory);
+  finder.setSearchPathList( PathList::fromStringList(mSearchPathList) );
+  finder.setLogLevel(logLevel);
+  const auto messageSink = std::make_shared<CountingMessageSink>();
+  if(useMessageSink){
+    finder.setMessageSink(messageSink);
+  }
+  if( shouldOutputVerboseMessages(logLevel) ){
+    QObject::connect(&finder, &SharedLibraryFinderLinux::verboseMessage, countMessage);
+  }
+  if( shouldOutputDebugMessages(logLevel) ){
+    QObject::connect(&finder, &SharedLibraryFinderLinux::debugMessage, countMessage);
+  }
+
+  int foundCount = 0;
+
+  QBENCHMARK{
+    foundCount = 0;
+    for(const QString & libraryName : mLibraryNames){
+      const QFileInfo library = finder.findLibraryAbsolutePath(libraryName, dependentFile);
+      if( !library.filePath().isEmpty() ){
+        ++foundCount;
+      }
+    }
+  }
+
+  QCOMPARE(foundCount, libraryCount);
+  if(useMessageSink){
+    QCOMPARE(messageCount, 0);
+    QVERIFY(messageSink->count > 0);
+  }
+  if( !shouldOutputVerboseMessages(logLevel) ){
+    QCOMPARE(messageCount, 0);
+  }
+}
+
+/*
+ * Benchmarks
+ */
+
+void DiagnosticMessagesBenchmark::findLibrariesStatusLevel()
+{
+  findLibraries(LogLevel::Status);
+}
+
+void DiagnosticMessagesBenchmark::findLibrariesVerboseLevel()
+{
+  findLibraries(LogLevel::Verbose);
+}
+
+void DiagnosticMessagesBenchmark::findLibrariesDebugLevel()
+{
+  findLibraries(LogLevel::Debug);
+}
+
+void DiagnosticMessagesBenchmark::findLibrariesDebugLevelMessageSink()
+{
+  findLibraries(LogLevel::Debug, true);
+}
+
+
+/*
+ * Main
+ */
+
+int main(int argc, char **argv)
+{
+  QCoreApplication app(argc, argv);
+  DiagnosticMessagesBenchmark test;
+
+  return QTest::qExec(&test, argc, argv);
+}
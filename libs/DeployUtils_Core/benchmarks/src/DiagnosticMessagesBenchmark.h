@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "Mdt/DeployUtils/LogLevel.h"
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QtTest/QTest>
+
+class DiagnosticMessagesBenchmark : public QObject
+{
+ Q_OBJECT
+
+ private slots:
+
+  void initTestCase();
+  void cleanupTestCase();
+
+  void findLibrariesStatusLevel();
+  void findLibrariesVerboseLevel();
+  void findLibrariesDebugLevel();
+  void findLibrariesDebugLevelMessageSink();
+
+ private:
+
+  void findLibraries(Mdt::DeployUtils::LogLevel logLevel, bool useMessageSink = false);
+
+  QStringList mSearchPathList;
+  QStringList mLibraryNames;
+};
@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "FilePrefetcherBenchmark.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QByteArray>
+#include <QLatin1String>
+#include <QtEndian>
+#include <QtGlobal>
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <linux/magic.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // #ifdef Q_OS_LINUX
+
+using namespace Mdt::DeployUtils;
+
+/*
+ * A cold cache benchmark needs files that are not in the page cache.
+ * Dropping all caches (/proc/sys/vm/drop_caches) or using a loop mounted
+ * file system requires root privileges.
+ * Instead, the fixture files are evicted from the page cache
+ * with posix_fadvise(POSIX_FADV_DONTNEED), which works for any file we can open,
+ * but only on a file system backed by a device (not on a tmpfs).
+ *
+ * By default, the fixture is created in the temporary directory.
+ * If it is a tmpfs, set MDT_DEPLOYUTILS_BENCHMARK_DIR to a directory on a disk.
+ *
+ * The fixture files are minimal 64-bit ELF files:
+ * the file header and the program headers are in the head,
+ * the dynamic section is in the middle of the file
+ * and the section headers are at the end of the file,
+ * like in a typical shared library.
+ */
+
+static const int fixtureFileCount = 64;
+static const qint64 fixtureFileSize = 4*1024*1024;
+static const qint64 fixtureProgramHeadersOffset = 64;
+static const qint64 fixtureDynamicSectionOffset = 2*1024*1024;
+static const qint64 fixtureDynamicSectionSize = 4096;
+static const qint64 fixtureSectionHeaderSize = 64;
+static const qint64 fixtureSectionHeaderCount = 32;
+static const qint64 fixtureSectionHeadersOffset = fixtureFileSize - fixtureSectionHeaderSize * fixtureSectionHeaderCount;
+
+namespace{
+
+  QByteArray makeElfFixture()
+  {
+    QByteArray data(fixtureFileSize, 'A');
+    uchar *fileHeader = reinterpret_cast<uchar*>( data.data() );
+
+    // File header (ELF64, little endian)
+    std::fill(fileHeader, fileHeader + 64, 0);
+    fileHeader[0] = 0x7f;
+    fileHeader[1] = 'E';
+    fileHeader[2] = 'L';
+    fileHeader[3] = 'F';
+    fileHeader[4] = 2;
+    fileHeader[5] = 1;
+    fileHeader[6] = 1;
+    qToLittleEndian<quint16>(3, fileHeader + 16);
+    qToLittleEndian<quint16>(62, fileHeader + 18);
+    qToLittleEndian<quint32>(1, fileHeader + 20);
+    qToLittleEndian<quint64>(fixtureProgramHeadersOffset, fileHeader + 32);
+    qToLittleEndian<quint64>(fixtureSectionHeadersOffset, fileHeader + 40);
+    qToLittleEndian<quint16>(64, fileHeader + 52);
+    qToLittleEndian<quint16>(56, fileHeader + 54);
+    qToLittleEndian<quint16>(1, fileHeader + 56);
+    qToLittleEndian<quint16>(fixtureSectionHeaderSize, fileHeader + 58);
+    qToLittleEndian<quint16>(fixtureSectionHeaderCount, fileHeader + 60);
+    qToLittleEndian<quint16>(fixtureSectionHeaderCount - 1, fileHeader + 62);
+
+    // A single PT_DYNAMIC program header
+    uchar *programHeader = fileHeader + fixtureProgramHeadersOffset;
+    std::fill(programHeader, programHeader + 56, 0);
+    qToLittleEndian<quint32>(2, programHeader);
+    qToLittleEndian<quint64>(fixtureDynamicSectionOffset, programHeader + 8);
+    qToLittleEndian<quint64>(fixtureDynamicSectionSize, programHeader + 32);
+
+    return data;
+  }
+
+} // namespace{
+
+void FilePrefetcherBenchmark::initTestCase()
+{
+  if( !FilePrefetcher::isSupported() ){
+    QSKIP("prefetching files is not supported on this platform");
+  }
+
+  const QString benchmarkDirectory = QString::fromLocal8Bit( qgetenv("MDT_DEPLOYUTILS_BENCHMARK_DIR") );
+  if( benchmarkDirectory.isEmpty() ){
+    mFixtureDirectory = std::make_unique<QTemporaryDir>();
+  }else{
+    mFixtureDirectory = std::make_unique<QTemporaryDir>( benchmarkDirectory + QLatin1String("/FilePrefetcherBenchmark-XXXXXX") );
+  }
+  QVERIFY( mFixtureDirectory->isValid() );
+
+#ifdef Q_OS_LINUX
+  struct statfs fileSystem;
+  QVERIFY( ::statfs(QFile::encodeName( mFixtureDirectory->path() ).constData(), &fileSystem) == 0 );
+  if( fileSystem.f_type == TMPFS_MAGIC ){
+    QSKIP("the fixture directory is on a tmpfs, its files can not be evicted from the page cache (set MDT_DEPLOYUTILS_BENCHMARK_DIR to a directory on a disk)");
+  }
+#endif // #ifdef Q_OS_LINUX
+
+  const QByteArray data = makeElfFixture();
+  for(int i = 0; i < fixtureFileCount; ++i){
+    const QString filePath = mFixtureDirectory->path() + QLatin1String("/lib") + QString::number(i) + QLatin1String(".so");
+    QFile file(filePath);
+    QVERIFY( file.open(QIODevice::WriteOnly) );
+    QCOMPARE( file.write(data), fixtureFileSize );
+    file.close();
+    mFixtureFiles.append(filePath);
+  }
+}
+
+void FilePrefetcherBenchmark::cleanupTestCase()
+{
+  mFixtureDirectory.reset();
+}
+
+/*
+ * Benchmarks
+ */
+
+namespace{
+
+  /*
+   * Read the regions a executable file reader reads after the head:
+   * the dynamic section and the section headers
+   */
+  qint64 readElfRegions(const QString & filePath)
+  {
+    QFile file(filePath);
+    if( !file.open(QIODevice::ReadOnly) ){
+      return 0;
+    }
+
+    qint64 readSize = 0;
+    if( file.seek(fixtureDynamicSectionOffset) ){
+      readSize += file.read(fixtureDynamicSectionSize).size();
+    }
+    if( file.seek(fixtureSectionHeadersOffset) ){
+      readSize += file.read(fixtureSectionHeaderSize * fixtureSectionHeaderCount).size();
+    }
+
+    return readSize;
+  }
+
+} // namespace{
+
+static const qint64 elfRegionsSize = fixtureDynamicSectionSize + fixtureSectionHeaderSize * fixtureSectionHeaderCount;
+
+void FilePrefetcherBenchmark::readElfRegionsColdCache()
+{
+  const FilePrefetcher prefetcher;
+  qint64 readSize = 0;
+
+  dropFixtureFromPageCache();
+  readFixtureHeads(prefetcher);
+
+  QBENCHMARK_ONCE{
+    for(const QString & filePath : mFixtureFiles){
+      readSize += readElfRegions(filePath);
+    }
+  }
+
+  QCOMPARE( readSize, fixtureFileCount * elfRegionsSize );
+}
+
+void FilePrefetcherBenchmark::prefetchThenReadElfRegionsColdCache()
+{
+  FilePrefetcher prefetcher;
+  qint64 readSize = 0;
+
+  dropFixtureFromPageCache();
+  readFixtureHeads(prefetcher);
+
+  QBENCHMARK_ONCE{
+    for(const QString & filePath : mFixtureFiles){
+      prefetcher.prefetch(filePath);
+    }
+    for(const QString & filePath : mFixtureFiles){
+      readSize += readElfRegions(filePath);
+    }
+  }
+
+  QCOMPARE( prefetcher.prefetchCount(), static_cast<qint64>(fixtureFileCount) );
+  QCOMPARE( readSize, fixtureFileCount * elfRegionsSize );
+}
+
+void FilePrefetcherBenchmark::dropFixtureFromPageCache()
+{
+#ifdef Q_OS_LINUX
+  for(const QString & filePath : mFixtureFiles){
+    const int fd = ::open(QFile::encodeName(filePath).constData(), O_RDONLY | O_CLOEXEC);
+    QVERIFY(fd >= 0);
+    // Dirty pages are not evicted, make sure they are written first
+    const bool evicted = ( ::fdatasync(fd) == 0 ) && ( ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0 );
+    ::close(fd);
+    QVERIFY(evicted);
+  }
+#endif // #ifdef Q_OS_LINUX
+}
+
+/*
+ * The shared library finder reads the head of each file while validating it,
+ * before the file is prefetched
+ */
+void FilePrefetcherBenchmark::readFixtureHeads(const FilePrefetcher & prefetcher)
+{
+  for(const QString & filePath : mFixtureFiles){
+    QFile file(filePath);
+    QVERIFY( file.open(QIODevice::ReadOnly) );
+    QCOMPARE( file.read( prefetcher.headSize() ).size(), static_cast<int>( prefetcher.headSize() ) );
+  }
+}
+
+/*
+ * Main
+ */
+
+int main(int argc, char **argv)
+{
+  QCoreApplication app(argc, argv);
+  FilePrefetcherBenchmark test;
+
+  return QTest::qExec(&test, argc, argv);
+}
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "Mdt/DeployUtils/FilePrefetcher.h"
+#include <QObject>
+#include <QTemporaryDir>
+#include <QString>
+#include <QStringList>
+#include <QtTest/QTest>
+#include <memory>
+
+class FilePrefetcherBenchmark : public QObject
+{
+ Q_OBJECT
+
+ private slots:
+
+  void initTestCase();
+  void cleanupTestCase();
+
+  void readElfRegionsColdCache();
+  void prefetchThenReadElfRegionsColdCache();
+
+ private:
+
+  void dropFixtureFromPageCache();
+  void readFixtureHeads(const Mdt::DeployUtils::FilePrefetcher & prefetcher);
+
+  std::unique_ptr<QTemporaryDir> mFixtureDirectory;
+  QStringList mFixtureFiles;
+};
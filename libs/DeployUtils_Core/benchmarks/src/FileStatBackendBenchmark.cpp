@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "FileStatBackendBenchmark.h"
+#include "Mdt/DeployUtils/FileStatCache.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLatin1String>
+
+using namespace Mdt::DeployUtils;
+
+/*
+ * Like a search path list:
+ * each library is searched in every directory,
+ * and only found in the last one
+ */
+static const int searchDirectoryCount = 16;
+static const int libraryCount = 256;
+
+void FileStatBackendBenchmark::initTestCase()
+{
+  QVERIFY( mFixtureDirectory.isValid() );
+
+  const QDir root( mFixtureDirectory.path() );
+  QStringList directories;
+  for(int i = 0; i < searchDirectoryCount; ++i){
+    const QString name = QLatin1String("lib") + QString::number(i);
+    QVERIFY( root.mkdir(name) );
+    directories.append( root.absoluteFilePath(name) );
+  }
+
+  for(int i = 0; i < libraryCount; ++i){
+    const QString libraryName = QLatin1String("libBench") + QString::number(i) + QLatin1String(".so");
+    for(const QString & directory : directories){
+      mCandidates.append( QFileInfo(directory, libraryName).absoluteFilePath() );
+    }
+    QFile file( QFileInfo(directories.last(), libraryName).absoluteFilePath() );
+    QVERIFY( file.open(QIODevice::WriteOnly) );
+    file.write("\x7f" "ELF");
+    file.close();
+    ++mExistingFileCount;
+  }
+}
+
+void FileStatBackendBenchmark::cleanupTestCase()
+{
+}
+
+void FileStatBackendBenchmark::statCandidates(FileStatBackend backend)
+{
+  int existingFileCount = 0;
+
+  QBENCHMARK{
+    FileStatCache cache;
+    cache.setBackend(backend);
+    cache.statFiles(mCandidates);
+    existingFileCount = 0;
+    for(const QString & path : mCandidates){
+      if( cache.stat(path).exists ){
+        ++existingFileCount;
+      }
+    }
+  }
+
+  QCOMPARE(existingFileCount, mExistingFileCount);
+}
+
+/*
+ * Benchmarks
+ */
+
+void FileStatBackendBenchmark::statCandidatesSynchronous()
+{
+  statCandidates(FileStatBackend::Synchronous);
+}
+
+void FileStatBackendBenchmark::statCandidatesIoUring()
+{
+  if( !FileStatCache::isBackendAvailable(FileStatBackend::IoUring) ){
+    QSKIP("io_uring is not available on this host");
+  }
+
+  statCandidates(FileStatBackend::IoUring);
+}
+
+
+/*
+ * Main
+ */
+
+int main(int argc, char **argv)
+{
+  QCoreApplication app(argc, argv);
+  FileStatBackendBenchmark test;
+
+  return QTest::qExec(&test, argc, argv);
+}
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "Mdt/DeployUtils/FileStatBackend.h"
+#include <QObject>
+#include <QTemporaryDir>
+#include <QString>
+#include <QStringList>
+#include <QtTest/QTest>
+
+class FileStatBackendBenchmark : public QObject
+{
+ Q_OBJECT
+
+ private slots:
+
+  void initTestCase();
+  void cleanupTestCase();
+
+  void statCandidatesSynchronous();
+  void statCandidatesIoUring();
+
+ private:
+
+  void statCandidates(Mdt::DeployUtils::FileStatBackend backend);
+
+  QTemporaryDir mFixtureDirectory;
+  QStringList mCandidates;
+  int mExistingFileCount = 0;
+};
@@ -0,0 +1,90 @@
+##############################################################
+#  Copyright Philippe Steinmann 2023 - 2023.
+#  Distributed under the Boost Software License, Version 1.0.
+#  (See accompanying file LICENSE.txt or copy at
+#  https://www.boost.org/LICENSE_1_0.txt)
+##############################################################
+
+# Generate a C++ header that declares a compile time perfect hash set
+# (see Mdt/DeployUtils/Impl/PerfectHashLibraryNameSet.h)
+# from a list of library names.
+#
+# The input file has the format of the AppImage excludelist:
+# one library name per line, # starts a comment.
+#
+# Usage (script mode):
+#   cmake -DINPUT_FILE=<list.txt>
+#         -DOUTPUT_FILE=<header.h>
+#         -DVARIABLE_NAME=<name>
+#         [-DCASE_INSENSITIVE=ON]
+#         -P GenerateLibraryExcludeList.cmake
+#
+# If CASE_INSENSITIVE is ON, the keys are folded to lower case.
+
+foreach(requiredVariable INPUT_FILE OUTPUT_FILE VARIABLE_NAME)
+  if(NOT ${requiredVariable})
+    message(FATAL_ERROR "GenerateLibraryExcludeList: ${requiredVariable} is required")
+  endif()
+endforeach()
+
+file(STRINGS "${INPUT_FILE}" inputLines)
+
+set(libraryNames)
+foreach(line IN LISTS inputLines)
+  string(REGEX REPLACE "#.*$" "" line "${line}")
+  string(STRIP "${line}" line)
+  if("${line}" STREQUAL "")
+    continue()
+  endif()
+  if(CASE_INSENSITIVE)
+    string(TOLOWER "${line}" line)
+  endif()
+  list(APPEND libraryNames "${line}")
+endforeach()
+
+list(REMOVE_DUPLICATES libraryNames)
+list(LENGTH libraryNames libraryNamesCount)
+if(libraryNamesCount EQUAL 0)
+  message(FATAL_ERROR "GenerateLibraryExcludeList: ${INPUT_FILE} contains no library name")
+endif()
+
+if(CASE_INSENSITIVE)
+  set(caseSensitivity "Qt::CaseInsensitive")
+else()
+  set(caseSensitivity "Qt::CaseSensitive")
+endif()
+
+get_filename_component(headerName "${OUTPUT_FILE}" NAME_WE)
+get_filename_component(inputFileName "${INPUT_FILE}" NAME)
+string(REGEX REPLACE "([a-z0-9])([A-Z])" "\\1_\\2" headerGuard "${headerName}")
+string(TOUPPER "MDT_DEPLOY_UTILS_IMPL_${headerGuard}_H" headerGuard)
+
+set(keys)
+foreach(libraryName IN LISTS libraryNames)
+  string(APPEND keys "    std::string_view(\"${libraryName}\"),\n")
+endforeach()
+string(REGEX REPLACE ",\n$" "\n" keys "${keys}")
+
+set(content
+"/*
+ * Generated by GenerateLibraryExcludeList.cmake from ${inputFileName}
+ *
+ * Do not edit, edit ${inputFileName} instead.
+ */
+#ifndef ${headerGuard}
+#define ${headerGuard}
+
+#include \"Mdt/DeployUtils/Impl/PerfectHashLibraryNameSet.h\"
+
+static constexpr
+Mdt::DeployUtils::Impl::PerfectHashLibraryNameSet<${libraryNamesCount}, ${caseSensitivity}> ${VARIABLE_NAME}(
+  std::array<std::string_view, ${libraryNamesCount}>{
+${keys}  }
+);
+
+static_assert( ${VARIABLE_NAME}.isValid(), \"could not build the perfect hash table for ${VARIABLE_NAME}\" );
+
+#endif // #ifndef ${headerGuard}
+")
+
+file(WRITE "${OUTPUT_FILE}" "${content}")
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_ABSTRACT_MESSAGE_SINK_H
+#define MDT_DEPLOY_UTILS_ABSTRACT_MESSAGE_SINK_H
+
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Interface to receive the messages of core components directly
+   *
+   * Components like AbstractSharedLibraryFinder or BinaryDependencies
+   * emit their messages as Qt signals,
+   * which are relayed by each component that uses them.
+   * If a message sink is set, they write their messages
+   * directly to it instead, without any signal in between.
+   *
+   * The sink is called from the thread that produces the message,
+   * which does not need a Qt event loop.
+   * If a sink is shared by components that run in different threads,
+   * it has to be thread safe.
+   *
+   * \sa SignalMessageSink
+   * \sa MessageLoggerSink
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT AbstractMessageSink
+  {
+   public:
+
+    AbstractMessageSink() = default;
+    virtual ~AbstractMessageSink() noexcept = default;
+
+    AbstractMessageSink(const AbstractMessageSink &) = delete;
+    AbstractMessageSink & operator=(const AbstractMessageSink &) = delete;
+    AbstractMessageSink(AbstractMessageSink &&) = delete;
+    AbstractMessageSink & operator=(AbstractMessageSink &&) = delete;
+
+    /*! \brief Write a status message
+     */
+    virtual void status(const QString & message) = 0;
+
+    /*! \brief Write a verbose message
+     */
+    virtual void verbose(const QString & message) = 0;
+
+    /*! \brief Write a debug message
+     */
+    virtual void debug(const QString & message) = 0;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_ABSTRACT_MESSAGE_SINK_H
@@ -20,7 +20,10 @@
  ****************************************************************************/
 #include "AbstractSharedLibraryFinder.h"
 #include "AbstractIsExistingValidSharedLibrary.h"
+#include "LibraryLookupMissCache.h"
+#include "FindDependencyError.h"
 #include "FileInfoUtils.h"
+#include <algorithm>
 
 
 namespace Mdt{ namespace DeployUtils{
@@ -34,10 +37,66 @@ OperatingSystem AbstractSharedLibraryFinder::operatingSystem() const noexcept
   return os;
 }
 
+void AbstractSharedLibraryFinder::buildSearchPathIndex()
+{
+  Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive;
+  if( operatingSystem() == OperatingSystem::Windows ){
+    caseSensitivity = Qt::CaseInsensitive;
+  }
+
+  mSearchPathIndex = std::make_shared<const SearchPathIndex>(
+    SearchPathIndex::fromDirectories( mSearchPathList.toStringList(), caseSensitivity )
+  );
+
+  emitDebugMessage([this](){
+    return tr("indexed %1 files in %2 directories of the search path list")
+           .arg( mSearchPathIndex->fileCount() )
+           .arg( mSearchPathIndex->directoryCount() );
+  });
+}
+
+QStringList AbstractSharedLibraryFinder::searchPathCandidateDirectories(const QString & libraryName) const noexcept
+{
+  assert( !libraryName.trimmed().isEmpty() );
+
+  if( !hasSearchPathIndex() ){
+    return mSearchPathList.toStringList();
+  }
+
+  return mSearchPathIndex->directoriesContaining(libraryName);
+}
+
+QStringList AbstractSharedLibraryFinder::lookupCandidateDirectories(const QString & libraryName, const BinaryDependenciesFile & dependentFile) const noexcept
+{
+  assert( !libraryName.trimmed().isEmpty() );
+
+  QStringList directories = lookupSearchDirectories(dependentFile);
+  if( !hasSearchPathIndex() ){
+    return directories;
+  }
+
+  const auto isKnownToNotContainLibrary = [this, &libraryName](const QString & directory){
+    return mSearchPathIndex->isIndexedDirectory(directory) && !mSearchPathIndex->directoryContains(directory, libraryName);
+  };
+  directories.erase( std::remove_if(directories.begin(), directories.end(), isKnownToNotContainLibrary), directories.end() );
+
+  return directories;
+}
+
+void AbstractSharedLibraryFinder::setRedistributionPolicy(const LibraryRedistributionPolicy & policy)
+{
+  mRedistributionPolicyMatcher = Impl::LibraryRedistributionPolicyMatcher::compile( policy, operatingSystem() );
+}
+
 bool AbstractSharedLibraryFinder::libraryShouldBeDistributed(const QString & libraryName) const noexcept
 {
   assert( !libraryName.trimmed().isEmpty() );
 
+  const auto policyAction = mRedistributionPolicyMatcher.match(libraryName);
+  if(policyAction){
+    return *policyAction == LibraryRedistributionPolicyAction::Include;
+  }
+
   return doLibraryShouldBeDistributed(libraryName);
 }
 
@@ -46,7 +105,30 @@ QFileInfo AbstractSharedLibraryFinder::findLibraryAbsolutePath(const QString & l
   assert( !libraryName.trimmed().isEmpty() );
   assert( libraryShouldBeDistributed(libraryName) );
 
-  const QFileInfo library = doFindLibraryAbsolutePath(libraryName, dependentFile);
+  if(mLookupMissCache.get() == nullptr){
+    const QFileInfo library = doFindLibraryAbsolutePath(libraryName, dependentFile);
+    assert( fileInfoIsAbsolutePath(library) );
+    return library;
+  }
+
+  const QString searchContext = lookupSearchContext(dependentFile);
+  if( mLookupMissCache->isKnownMiss(libraryName, searchContext) ){
+    emitDebugMessage([&libraryName](){
+      return tr(" %1 was already not found in the same search paths").arg(libraryName);
+    });
+    const QString message = tr("could not find the absolute path for %1")
+                            .arg(libraryName);
+    throw FindDependencyError(message);
+  }
+
+  const qint64 probeCountBeforeLookup = mProbeCount;
+  QFileInfo library;
+  try{
+    library = doFindLibraryAbsolutePath(libraryName, dependentFile);
+  }catch(const FindDependencyError &){
+    mLookupMissCache->addMiss(libraryName, searchContext, mProbeCount - probeCountBeforeLookup);
+    throw;
+  }
   assert( fileInfoIsAbsolutePath(library) );
 
   return library;
@@ -56,6 +138,8 @@ bool AbstractSharedLibraryFinder::validateIsExistingValidSharedLibrary(const QFi
 {
   assert( fileInfoIsAbsolutePath(libraryFile) );
 
+  ++mProbeCount;
+
   if( !mIsExistingValidShLibOp->isExistingValidSharedLibrary(libraryFile) ){
     return false;
   }
@@ -66,6 +150,11 @@ bool AbstractSharedLibraryFinder::validateIsExistingValidSharedLibrary(const QFi
   return true;
 }
 
+QStringList AbstractSharedLibraryFinder::doLookupSearchDirectories(const BinaryDependenciesFile &) const noexcept
+{
+  return mSearchPathList.toStringList();
+}
+
 bool AbstractSharedLibraryFinder::validateSpecificSharedLibrary(const QFileInfo &)
 {
   return true;
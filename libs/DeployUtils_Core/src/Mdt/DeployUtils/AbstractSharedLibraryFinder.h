@@ -25,9 +25,16 @@
 #include "PathList.h"
 #include "RPath.h"
 #include "OperatingSystem.h"
+#include "LogLevel.h"
+#include "AbstractMessageSink.h"
+#include "LibraryRedistributionPolicy.h"
+#include "SearchPathIndex.h"
+#include "Mdt/DeployUtils/Impl/LibraryRedistributionPolicyMatcher.h"
 #include "mdt_deployutilscore_export.h"
 #include <QObject>
 #include <QString>
+#include <QStringList>
+#include <QLatin1Char>
 #include <QFileInfo>
 #include <memory>
 #include <cassert>
@@ -35,6 +42,7 @@
 namespace Mdt{ namespace DeployUtils{
 
   class AbstractIsExistingValidSharedLibrary;
+  class LibraryLookupMissCache;
 
   /*! \brief Interface to implement a shared library finder
    *
@@ -66,11 +74,62 @@ namespace Mdt{ namespace DeployUtils{
      */
     OperatingSystem operatingSystem() const noexcept;
 
+    /*! \brief Set the log level
+     *
+     * Verbose and debug messages are only built (and emitted)
+     * if \a level requires them.
+     * Finding a library can probe hundreds of files,
+     * so building a message for each probe that nobody outputs
+     * is not negligible.
+     *
+     * By default, the log level is LogLevel::Debug,
+     * so every message is emitted.
+     */
+    void setLogLevel(LogLevel level) noexcept
+    {
+      mLogLevel = level;
+    }
+
+    /*! \brief Get the log level
+     */
+    LogLevel logLevel() const noexcept
+    {
+      return mLogLevel;
+    }
+
+    /*! \brief Set a message sink
+     *
+     * If \a sink is set, messages are written to it directly
+     * instead of being emitted as signals.
+     *
+     * \sa AbstractMessageSink
+     */
+    void setMessageSink(const std::shared_ptr<AbstractMessageSink> & sink) noexcept
+    {
+      mMessageSink = sink;
+    }
+
+    /*! \brief Get the message sink
+     *
+     * Returns a null pointer if no message sink has been set.
+     *
+     * \sa setMessageSink()
+     */
+    AbstractMessageSink *messageSink() const noexcept
+    {
+      return mMessageSink.get();
+    }
+
     /*! \brief Set a custom list of paths where this finder locates shared libraries
+     *
+     * The search path index, if any, is cleared.
+     *
+     * \sa buildSearchPathIndex()
      */
     void setSearchPathList(const PathList & pathList) noexcept
     {
       mSearchPathList = pathList;
+      mSearchPathIndex.reset();
     }
 
     /*! \brief Get the list of paths where this finder locates shared libraries
@@ -80,12 +139,178 @@ namespace Mdt{ namespace DeployUtils{
       return mSearchPathList;
     }
 
+    /*! \brief Build a index of the files in the search path list
+     *
+     * By default, to find a library in the search path list,
+     * a file is probed in each directory.
+     * Once the index is built,
+     * only the directories that contain a file named like the library are probed.
+     *
+     * The index must be built again after the search path list changed.
+     *
+     * \note Files that are created in the directories of the search path list
+     * after the index has been built are not found.
+     *
+     * \sa SearchPathIndex
+     * \sa searchPathCandidateDirectories()
+     */
+    void buildSearchPathIndex();
+
+    /*! \brief Check if a index of the search path list has been built
+     *
+     * \sa buildSearchPathIndex()
+     */
+    bool hasSearchPathIndex() const noexcept
+    {
+      return mSearchPathIndex.get() != nullptr;
+    }
+
+    /*! \brief Get the index of the search path list
+     *
+     * \pre a index of the search path list must have been built
+     * \sa hasSearchPathIndex()
+     */
+    const SearchPathIndex & searchPathIndex() const noexcept
+    {
+      assert( hasSearchPathIndex() );
+
+      return *mSearchPathIndex;
+    }
+
+    /*! \brief Get a shared pointer to the index of the search path list
+     *
+     * Returns a null pointer if no index has been built.
+     *
+     * \sa setSearchPathIndex()
+     */
+    const std::shared_ptr<const SearchPathIndex> & sharedSearchPathIndex() const noexcept
+    {
+      return mSearchPathIndex;
+    }
+
+    /*! \brief Set a index of the search path list built by a other finder
+     *
+     * This avoids to list the directories of the search path list again,
+     * for example when finding dependencies several times with the same search path list.
+     *
+     * \pre \a index must have been built from the current search path list
+     * \sa buildSearchPathIndex()
+     * \sa sharedSearchPathIndex()
+     */
+    void setSearchPathIndex(const std::shared_ptr<const SearchPathIndex> & index) noexcept
+    {
+      mSearchPathIndex = index;
+    }
+
+    /*! \brief Get the directories of the search path list where \a libraryName could be
+     *
+     * If a index of the search path list has been built,
+     * returns the directories that contain a file named \a libraryName
+     * (regardless of case for operating systems that ignore it).
+     * Otherwise, returns the whole search path list.
+     *
+     * \pre \a libraryName must not be empty
+     * \sa buildSearchPathIndex()
+     */
+    QStringList searchPathCandidateDirectories(const QString & libraryName) const noexcept;
+
+    /*! \brief Set the redistribution policy
+     *
+     * The rules of \a policy that apply to the operating system
+     * this finder targets are compiled once,
+     * then consulted by libraryShouldBeDistributed()
+     * before the built-in rules of this finder.
+     *
+     * \sa LibraryRedistributionPolicy
+     */
+    void setRedistributionPolicy(const LibraryRedistributionPolicy & policy);
+
+    /*! \brief Set a redistribution policy already compiled
+     *
+     * \pre \a matcher must have been compiled for the operating system this finder targets
+     * \sa setRedistributionPolicy()
+     * \sa redistributionPolicyMatcher()
+     */
+    void setRedistributionPolicyMatcher(const Impl::LibraryRedistributionPolicyMatcher & matcher) noexcept
+    {
+      mRedistributionPolicyMatcher = matcher;
+    }
+
+    /*! \brief Get the compiled redistribution policy
+     */
+    const Impl::LibraryRedistributionPolicyMatcher & redistributionPolicyMatcher() const noexcept
+    {
+      return mRedistributionPolicyMatcher;
+    }
+
     /*! \brief Check if given \a libraryName should be distributed
+     *
+     * If a redistribution policy has been set,
+     * and one of its rules matches \a libraryName ,
+     * this rule decides.
+     * Otherwise, the built-in rules of the concrete finder decide.
      *
      * \pre \a libraryName must not be empty
+     * \sa setRedistributionPolicy()
      */
     bool libraryShouldBeDistributed(const QString & libraryName) const noexcept;
 
+    /*! \brief Set a cache of libraries that could not be found
+     *
+     * By default, a missing library is searched again
+     * each time findLibraryAbsolutePath() is called.
+     * If a cache is set, a library that could not be found
+     * is not searched again in the same search context.
+     *
+     * \sa LibraryLookupMissCache
+     * \sa lookupSearchContext()
+     */
+    void setLookupMissCache(const std::shared_ptr<LibraryLookupMissCache> & cache) noexcept
+    {
+      mLookupMissCache = cache;
+    }
+
+    /*! \brief Get the cache of libraries that could not be found
+     *
+     * Returns a null pointer if no cache has been set.
+     */
+    const std::shared_ptr<LibraryLookupMissCache> & lookupMissCache() const noexcept
+    {
+      return mLookupMissCache;
+    }
+
+    /*! \brief Get the ordered list of directories where to find a library that \a dependentFile depends on
+     *
+     * These are the directories that are tried by findLibraryAbsolutePath().
+     *
+     * \sa lookupSearchContext()
+     */
+    QStringList lookupSearchDirectories(const BinaryDependenciesFile & dependentFile) const noexcept
+    {
+      return doLookupSearchDirectories(dependentFile);
+    }
+
+    /*! \brief Get the directories where findLibraryAbsolutePath() could find \a libraryName
+     *
+     * Returns the directories of lookupSearchDirectories(),
+     * without those that are known by the search path index
+     * to not contain a file named \a libraryName .
+     *
+     * \pre \a libraryName must not be empty
+     * \sa buildSearchPathIndex()
+     */
+    QStringList lookupCandidateDirectories(const QString & libraryName, const BinaryDependenciesFile & dependentFile) const noexcept;
+
+    /*! \brief Get the search context to find a library that \a dependentFile depends on
+     *
+     * The search context is made of the ordered list of directories
+     * that are tried by findLibraryAbsolutePath().
+     */
+    QString lookupSearchContext(const BinaryDependenciesFile & dependentFile) const noexcept
+    {
+      return lookupSearchDirectories(dependentFile).join( QLatin1Char('\n') );
+    }
+
     /*! \brief Find the absolute path for given \a libraryName
      *
      * \a dependentFile is the file that has \a libraryName as direct dependency.
@@ -110,12 +335,67 @@ namespace Mdt{ namespace DeployUtils{
      */
     bool validateIsExistingValidSharedLibrary(const QFileInfo & libraryFile);
 
+    /*! \brief Get the count of files that have been probed by this finder
+     *
+     * \sa validateIsExistingValidSharedLibrary()
+     */
+    qint64 probeCount() const noexcept
+    {
+      return mProbeCount;
+    }
+
    signals:
 
     void statusMessage(const QString & message) const;
     void verboseMessage(const QString & message) const;
     void debugMessage(const QString & message) const;
 
+   protected:
+
+    /*! \brief Emit the message made by \a makeMessage if the log level requires verbose messages
+     *
+     * \a makeMessage is only called if the message is emitted.
+     * If a message sink is set, the message is written to it
+     * instead of being emitted as signal.
+     *
+     * \sa setLogLevel()
+     * \sa setMessageSink()
+     */
+    template<typename MakeMessage>
+    void emitVerboseMessage(const MakeMessage & makeMessage) const
+    {
+      if( !shouldOutputVerboseMessages(mLogLevel) ){
+        return;
+      }
+      if(mMessageSink.get() != nullptr){
+        mMessageSink->verbose( makeMessage() );
+      }else{
+        emit verboseMessage( makeMessage() );
+      }
+    }
+
+    /*! \brief Emit the message made by \a makeMessage if the log level requires debug messages
+     *
+     * \a makeMessage is only called if the message is emitted.
+     * If a message sink is set, the message is written to it
+     * instead of being emitted as signal.
+     *
+     * \sa setLogLevel()
+     * \sa setMessageSink()
+     */
+    template<typename MakeMessage>
+    void emitDebugMessage(const MakeMessage & makeMessage) const
+    {
+      if( !shouldOutputDebugMessages(mLogLevel) ){
+        return;
+      }
+      if(mMessageSink.get() != nullptr){
+        mMessageSink->debug( makeMessage() );
+      }else{
+        emit debugMessage( makeMessage() );
+      }
+    }
+
    private:
 
     /*! \brief Check if given library is valid reagarding library specific criteria
@@ -130,6 +410,18 @@ namespace Mdt{ namespace DeployUtils{
     virtual
     OperatingSystem doOperatingSystem() const noexcept = 0;
 
+    /*! \brief Get the ordered list of directories where to find a library that \a dependentFile depends on
+     *
+     * Used to build the search context.
+     * The default implementation returns the search path list.
+     * Must be implemented if the concrete finder also uses \a dependentFile
+     * to find libraries (for example its rpath).
+     *
+     * \sa lookupSearchDirectories()
+     */
+    virtual
+    QStringList doLookupSearchDirectories(const BinaryDependenciesFile & dependentFile) const noexcept;
+
     /*! \brief Check if given \a libraryName should be distributed
      *
      * This method has to be implemented by the concrete class.
@@ -158,6 +450,12 @@ namespace Mdt{ namespace DeployUtils{
 
     const std::shared_ptr<const AbstractIsExistingValidSharedLibrary> mIsExistingValidShLibOp;
     PathList mSearchPathList;
+    std::shared_ptr<const SearchPathIndex> mSearchPathIndex;
+    std::shared_ptr<LibraryLookupMissCache> mLookupMissCache;
+    qint64 mProbeCount = 0;
+    LogLevel mLogLevel = LogLevel::Debug;
+    std::shared_ptr<AbstractMessageSink> mMessageSink;
+    Impl::LibraryRedistributionPolicyMatcher mRedistributionPolicyMatcher;
   };
 
 }} // namespace Mdt{ namespace DeployUtils{
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "AsyncConsoleMessageLogger.h"
+#include <QByteArray>
+#include <iostream>
+#include <utility>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+AsyncConsoleMessageLogger::AsyncConsoleMessageLogger()
+ : AsyncConsoleMessageLogger(std::cout, std::cerr)
+{
+}
+
+AsyncConsoleMessageLogger::AsyncConsoleMessageLogger(std::ostream & out, std::ostream & err)
+ : mOut(out),
+   mErr(err)
+{
+  mThread = std::thread(&AsyncConsoleMessageLogger::run, this);
+}
+
+AsyncConsoleMessageLogger::~AsyncConsoleMessageLogger() noexcept
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIsClosed = true;
+  }
+  mQueueChanged.notify_one();
+  mThread.join();
+}
+
+void AsyncConsoleMessageLogger::setPrefixes(const QString & infoPrefix, const QString & errorPrefix)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  mInfoPrefix = infoPrefix;
+  mErrorPrefix = errorPrefix;
+}
+
+void AsyncConsoleMessageLogger::info(const QString & message)
+{
+  enqueue(mInfoPrefix, message, false);
+}
+
+void AsyncConsoleMessageLogger::error(const QString & message)
+{
+  enqueue(mErrorPrefix, message, true);
+  flush();
+}
+
+void AsyncConsoleMessageLogger::flush() noexcept
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+
+  mBatchWritten.wait(lock, [this](){
+    return mQueue.empty() && !mIsWriting;
+  });
+}
+
+int AsyncConsoleMessageLogger::batchCount() const noexcept
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  return mBatchCount;
+}
+
+void AsyncConsoleMessageLogger::enqueue(const QString & prefix, const QString & message, bool isError)
+{
+  /*
+   * The line is built by the calling thread,
+   * so that the writer thread only has to copy bytes
+   */
+  Line line;
+  line.text = QString(prefix + message).toLocal8Bit().toStdString();
+  line.text.push_back('\n');
+  line.isError = isError;
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQueue.push_back( std::move(line) );
+  }
+  mQueueChanged.notify_one();
+}
+
+void AsyncConsoleMessageLogger::run() noexcept
+{
+  std::deque<Line> batch;
+
+  while(true){
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mQueueChanged.wait(lock, [this](){
+        return mIsClosed || !mQueue.empty();
+      });
+      if( mQueue.empty() ){
+        assert(mIsClosed);
+        return;
+      }
+      batch.swap(mQueue);
+      mIsWriting = true;
+    }
+
+    writeBatch(batch);
+    batch.clear();
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mIsWriting = false;
+      ++mBatchCount;
+    }
+    mBatchWritten.notify_all();
+  }
+}
+
+void AsyncConsoleMessageLogger::writeBatch(const std::deque<Line> & batch) noexcept
+{
+  /*
+   * Consecutive lines that go to the same stream are written at once.
+   * Informations are flushed before a error is written,
+   * so that both keep their order on a terminal.
+   */
+  std::string buffer;
+  bool bufferIsError = false;
+
+  const auto writeBuffer = [this, &buffer, &bufferIsError](){
+    if( buffer.empty() ){
+      return;
+    }
+    std::ostream & stream = bufferIsError ? mErr : mOut;
+    stream.write( buffer.data(), static_cast<std::streamsize>( buffer.size() ) );
+    stream.flush();
+    buffer.clear();
+  };
+
+  for(const Line & line : batch){
+    if( line.isError != bufferIsError ){
+      writeBuffer();
+      bufferIsError = line.isError;
+    }
+    buffer.append(line.text);
+  }
+  writeBuffer();
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_ASYNC_CONSOLE_MESSAGE_LOGGER_H
+#define MDT_DEPLOY_UTILS_ASYNC_CONSOLE_MESSAGE_LOGGER_H
+
+#include "AbstractMessageLoggerBackend.h"
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <iosfwd>
+#include <string>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Console logger backend that writes from a background thread
+   *
+   * ConsoleMessageLogger flushes the output for each message.
+   * With thousands of messages (for example at DEBUG log level),
+   * those flushes become noticeable,
+   * mostly when the output is captured (like with CMake execute_process()).
+   *
+   * This backend queues the messages,
+   * and a writer thread writes them in batches,
+   * with one flush per batch.
+   *
+   * Each message is queued as a complete line,
+   * so lines are never mixed if several threads log at the same time.
+   *
+   * Errors are written before error() returns,
+   * after the informations that have been queued before them.
+   * The remaining messages are written when this backend is destroyed
+   * (which MessageLogger does at exit).
+   *
+   * \sa MessageLogger
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT AsyncConsoleMessageLogger : public AbstractMessageLoggerBackend
+  {
+   public:
+
+    /*! \brief Construct a logger that writes to stdout and stderr
+     */
+    explicit AsyncConsoleMessageLogger();
+
+    /*! \brief Construct a logger that writes informations to \a out and errors to \a err
+     *
+     * \a out and \a err must outlive this logger.
+     */
+    explicit AsyncConsoleMessageLogger(std::ostream & out, std::ostream & err);
+
+    /*! \brief Write the remaining messages and stop the writer thread
+     */
+    ~AsyncConsoleMessageLogger() noexcept;
+
+    /*! \brief Set the prefixes written before each information and each error
+     *
+     * For example, to imitate CMakeStyleMessageLogger:
+     * \code
+     * auto *backend = MessageLogger::setBackend<AsyncConsoleMessageLogger>();
+     * backend->setPrefixes( CMakeStyleMessageLogger::infoPrefix(), CMakeStyleMessageLogger::errorPrefix() );
+     * \endcode
+     *
+     * Should be called before anything is logged.
+     */
+    void setPrefixes(const QString & infoPrefix, const QString & errorPrefix);
+
+    /*! \brief Log a information
+     *
+     * The information is queued and written later by the writer thread.
+     */
+    void info(const QString & message) override;
+
+    /*! \brief Log a error
+     *
+     * Returns once the error,
+     * and every information queued before it, have been written.
+     */
+    void error(const QString & message) override;
+
+    /*! \brief Wait until every queued message has been written
+     */
+    void flush() noexcept;
+
+    /*! \brief Get the count of batches written so far
+     */
+    int batchCount() const noexcept;
+
+   private:
+
+    struct Line
+    {
+      std::string text;
+      bool isError;
+    };
+
+    void enqueue(const QString & prefix, const QString & message, bool isError);
+    void run() noexcept;
+    void writeBatch(const std::deque<Line> & batch) noexcept;
+
+    std::ostream & mOut;
+    std::ostream & mErr;
+    QString mInfoPrefix;
+    QString mErrorPrefix;
+
+    std::thread mThread;
+    mutable std::mutex mMutex;
+    std::condition_variable mQueueChanged;
+    std::condition_variable mBatchWritten;
+    std::deque<Line> mQueue;
+    bool mIsWriting = false;
+    bool mIsClosed = false;
+    int mBatchCount = 0;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_ASYNC_CONSOLE_MESSAGE_LOGGER_H
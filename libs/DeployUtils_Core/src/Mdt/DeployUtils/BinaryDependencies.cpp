@@ -27,9 +27,13 @@
 #include "FileInfoUtils.h"
 #include "Mdt/DeployUtils/Impl/BinaryDependencies/Graph.h"
 #include "IsExistingValidSharedLibrary.h"
+#include "FileStatCache.h"
+#include "LibraryLookupMissCache.h"
+#include "FilePrefetcher.h"
 #include "Mdt/DeployUtils/Platform.h"
 #include <QDir>
 #include <memory>
+#include <utility>
 #include <cassert>
 
 using Mdt::ExecutableFile::ExecutableFileReader;
@@ -47,6 +51,38 @@ void BinaryDependencies::setCompilerFinder(const std::shared_ptr<CompilerFinder>
   assert( compilerFinder->hasInstallDir() );
 
   mCompilerFinder = compilerFinder;
+  mSearchSetup.reset();
+}
+
+void BinaryDependencies::setRedistributionPolicy(const LibraryRedistributionPolicy & policy) noexcept
+{
+  mRedistributionPolicy = policy;
+  mSearchSetup.reset();
+}
+
+void BinaryDependencies::setMetadataCache(const std::shared_ptr<ExecutableFileMetadataCache> & cache) noexcept
+{
+  mMetadataCache = cache;
+}
+
+void BinaryDependencies::setLookupMissCache(const std::shared_ptr<LibraryLookupMissCache> & cache) noexcept
+{
+  mLookupMissCache = cache;
+}
+
+void BinaryDependencies::setFileStatBackend(FileStatBackend backend) noexcept
+{
+  mFileStatBackend = backend;
+}
+
+void BinaryDependencies::setLogLevel(LogLevel level) noexcept
+{
+  mLogLevel = level;
+}
+
+void BinaryDependencies::setMessageSink(const std::shared_ptr<AbstractMessageSink> & sink) noexcept
+{
+  mMessageSink = sink;
 }
 
 BinaryDependenciesResult
@@ -59,17 +95,26 @@ BinaryDependencies::findDependencies(const QFileInfo & binaryFilePath,
 
   ExecutableFileReader reader;
   std::shared_ptr<AbstractSharedLibraryFinder> shLibFinder;
+  const auto fileStatCache = makeFileStatCache();
 
-  const Platform platform = setupFindDependencies(reader, shLibFinder, searchFirstPathPrefixList, qtDistributionDirectory, binaryFilePath);
+  const Platform platform = setupFindDependencies(reader, shLibFinder, fileStatCache, searchFirstPathPrefixList, qtDistributionDirectory, binaryFilePath);
 
   using Impl::BinaryDependencies::Graph;
 
   Graph graph(platform);
+  connect(&graph, &Graph::sharedLibraryFound, this, &BinaryDependencies::sharedLibraryFound);
   connect(&graph, &Graph::verboseMessage, this, &BinaryDependencies::verboseMessage);
   connect(&graph, &Graph::debugMessage, this, &BinaryDependencies::debugMessage);
+  graph.setMetadataCache(mMetadataCache);
+  graph.setFileStatCache(fileStatCache);
+  if( FilePrefetcher::isSupported() ){
+    graph.setFilePrefetcher( std::make_shared<FilePrefetcher>() );
+  }
 
   graph.addTarget(binaryFilePath);
   graph.findTransitiveDependencies(*shLibFinder, reader);
+  emitFileStatCacheMessage(*fileStatCache);
+  emitLookupMissCacheMessage( *shLibFinder->lookupMissCache() );
 
   return graph.getResult(binaryFilePath);
 }
@@ -84,25 +129,48 @@ BinaryDependencies::findDependencies(const QFileInfoList & binaryFilePathList,
 
   ExecutableFileReader reader;
   std::shared_ptr<AbstractSharedLibraryFinder> shLibFinder;
+  const auto fileStatCache = makeFileStatCache();
 
   const QFileInfo & firstBinaryFilePath = binaryFilePathList.at(0);
 
-  const Platform platform = setupFindDependencies(reader, shLibFinder, searchFirstPathPrefixList, qtDistributionDirectory, firstBinaryFilePath);
+  const Platform platform = setupFindDependencies(reader, shLibFinder, fileStatCache, searchFirstPathPrefixList, qtDistributionDirectory, firstBinaryFilePath);
 
   using Impl::BinaryDependencies::Graph;
 
   Graph graph(platform);
+  connect(&graph, &Graph::sharedLibraryFound, this, &BinaryDependencies::sharedLibraryFound);
   connect(&graph, &Graph::verboseMessage, this, &BinaryDependencies::verboseMessage);
   connect(&graph, &Graph::debugMessage, this, &BinaryDependencies::debugMessage);
+  graph.setMetadataCache(mMetadataCache);
+  graph.setFileStatCache(fileStatCache);
+  if( FilePrefetcher::isSupported() ){
+    graph.setFilePrefetcher( std::make_shared<FilePrefetcher>() );
+  }
 
   graph.addTargets(binaryFilePathList);
   graph.findTransitiveDependencies(*shLibFinder, reader);
+  emitFileStatCacheMessage(*fileStatCache);
+  emitLookupMissCacheMessage( *shLibFinder->lookupMissCache() );
 
   return graph.getResultList(binaryFilePathList);
 }
 
+std::shared_ptr<FileStatCache> BinaryDependencies::makeFileStatCache() const
+{
+  auto cache = std::make_shared<FileStatCache>();
+
+  cache->setBackend(mFileStatBackend);
+  if( cache->backend() != mFileStatBackend ){
+    const QString msg = tr("io_uring is not available on this host, files will be stat'ed synchronously");
+    outputVerboseMessage(msg);
+  }
+
+  return cache;
+}
+
 Platform BinaryDependencies::setupFindDependencies(Mdt::ExecutableFile::ExecutableFileReader & reader,
                                                    std::shared_ptr<AbstractSharedLibraryFinder> & shLibFinder,
+                                                   const std::shared_ptr<FileStatCache> & fileStatCache,
                                                    const PathList & searchFirstPathPrefixList,
                                                    std::shared_ptr<QtDistributionDirectory> & qtDistributionDirectory,
                                                    const QFileInfo & target)
@@ -123,40 +191,157 @@ Platform BinaryDependencies::setupFindDependencies(Mdt::ExecutableFile::Executab
     throw FindDependencyError(message);
   }
 
-  const auto isExistingValidShLibOp = std::make_shared<const IsExistingValidSharedLibrary>(reader, platform);
+  const auto isExistingValidShLibOp = std::make_shared<IsExistingValidSharedLibrary>(reader, platform);
+  isExistingValidShLibOp->setMetadataCache(mMetadataCache);
+  isExistingValidShLibOp->setFileStatCache(fileStatCache);
 
   if( platform.operatingSystem() == OperatingSystem::Linux ){
-
     shLibFinder = std::make_shared<SharedLibraryFinderLinux>(isExistingValidShLibOp, qtDistributionDirectory);
-    SharedLibraryFinderLinux *shLibFinderLinux = static_cast<SharedLibraryFinderLinux*>( shLibFinder.get() );
-    shLibFinderLinux->buildSearchPathList( searchFirstPathPrefixList, platform.processorISA() );
-
   }else if( platform.operatingSystem() == OperatingSystem::Windows ){
-
     shLibFinder = std::make_shared<SharedLibraryFinderWindows>(isExistingValidShLibOp, qtDistributionDirectory);
-    SharedLibraryFinderWindows *shLibFinderWindows = static_cast<SharedLibraryFinderWindows*>( shLibFinder.get() );
-    shLibFinderWindows->buildSearchPathList(target, searchFirstPathPrefixList, platform.processorISA(), mCompilerFinder);
-
   }
   assert( shLibFinder.get() != nullptr );
 
+  shLibFinder->setLogLevel(mLogLevel);
+  shLibFinder->setMessageSink(mMessageSink);
+
   connect(shLibFinder.get(), &AbstractSharedLibraryFinder::statusMessage, this, &BinaryDependencies::message);
   connect(shLibFinder.get(), &AbstractSharedLibraryFinder::verboseMessage, this, &BinaryDependencies::verboseMessage);
   connect(shLibFinder.get(), &AbstractSharedLibraryFinder::debugMessage, this, &BinaryDependencies::debugMessage);
 
-  emitSearchPathListMessage( shLibFinder->searchPathList() );
+  setupSearch(*shLibFinder, platform, searchFirstPathPrefixList, target);
+
+  if(mLookupMissCache.get() != nullptr){
+    shLibFinder->setLookupMissCache(mLookupMissCache);
+  }else{
+    shLibFinder->setLookupMissCache( std::make_shared<LibraryLookupMissCache>() );
+  }
 
   return platform;
 }
 
+bool BinaryDependencies::searchSetupMatches(const Platform & platform,
+                                            const PathList & searchFirstPathPrefixList,
+                                            const QString & targetDirectory) const noexcept
+{
+  if(mSearchSetup.get() == nullptr){
+    return false;
+  }
+  if( mSearchSetup->operatingSystem != platform.operatingSystem() ){
+    return false;
+  }
+  if( mSearchSetup->processorISA != platform.processorISA() ){
+    return false;
+  }
+  if( mSearchSetup->targetDirectory != targetDirectory ){
+    return false;
+  }
+
+  return mSearchSetup->searchFirstPathPrefixList == searchFirstPathPrefixList.toStringList();
+}
+
+void BinaryDependencies::setupSearch(AbstractSharedLibraryFinder & shLibFinder,
+                                     const Platform & platform,
+                                     const PathList & searchFirstPathPrefixList,
+                                     const QFileInfo & target)
+{
+  /*
+   * On Windows, the directory of the target is part of the search path list
+   */
+  QString targetDirectory;
+  if( platform.operatingSystem() == OperatingSystem::Windows ){
+    targetDirectory = target.absolutePath();
+  }
+
+  if( searchSetupMatches(platform, searchFirstPathPrefixList, targetDirectory) ){
+    shLibFinder.setSearchPathList(mSearchSetup->searchPathList);
+    shLibFinder.setSearchPathIndex(mSearchSetup->searchPathIndex);
+    shLibFinder.setRedistributionPolicyMatcher(mSearchSetup->redistributionPolicyMatcher);
+    emitSearchPathListMessage( shLibFinder.searchPathList() );
+    return;
+  }
+
+  if( platform.operatingSystem() == OperatingSystem::Linux ){
+    auto & shLibFinderLinux = static_cast<SharedLibraryFinderLinux&>(shLibFinder);
+    shLibFinderLinux.buildSearchPathList( searchFirstPathPrefixList, platform.processorISA() );
+  }else if( platform.operatingSystem() == OperatingSystem::Windows ){
+    auto & shLibFinderWindows = static_cast<SharedLibraryFinderWindows&>(shLibFinder);
+    shLibFinderWindows.buildSearchPathList(target, searchFirstPathPrefixList, platform.processorISA(), mCompilerFinder);
+  }
+
+  emitSearchPathListMessage( shLibFinder.searchPathList() );
+
+  /*
+   * With a long list of prefixes (for example with Conan),
+   * the search path list can have hundreds of directories.
+   * Listing each of them once is cheaper
+   * than probing each of them for each library.
+   */
+  shLibFinder.buildSearchPathIndex();
+
+  if( !mRedistributionPolicy.isEmpty() ){
+    shLibFinder.setRedistributionPolicy(mRedistributionPolicy);
+  }
+
+  auto setup = std::make_unique<SearchSetup>();
+  setup->operatingSystem = platform.operatingSystem();
+  setup->processorISA = platform.processorISA();
+  setup->searchFirstPathPrefixList = searchFirstPathPrefixList.toStringList();
+  setup->targetDirectory = targetDirectory;
+  setup->searchPathList = shLibFinder.searchPathList();
+  setup->searchPathIndex = shLibFinder.sharedSearchPathIndex();
+  setup->redistributionPolicyMatcher = shLibFinder.redistributionPolicyMatcher();
+  mSearchSetup = std::move(setup);
+}
+
 void BinaryDependencies::emitSearchPathListMessage(const PathList & pathList) const
 {
+  if( !shouldOutputVerboseMessages(mLogLevel) ){
+    return;
+  }
+
   const QString startMessage = tr("search path list:");
-  emit verboseMessage(startMessage);
+  outputVerboseMessage(startMessage);
 
   for(const QString & path : pathList){
     const QString msg = tr(" %1").arg(path);
-    emit verboseMessage(msg);
+    outputVerboseMessage(msg);
+  }
+}
+
+void BinaryDependencies::emitFileStatCacheMessage(const FileStatCache & cache) const
+{
+  const QString msg = tr("stat'ed %1 files (%2 batches), %3 stats taken from the cache")
+                      .arg( cache.statCount() )
+                      .arg( cache.batchCount() )
+                      .arg( cache.hitCount() );
+  outputDebugMessage(msg);
+}
+
+void BinaryDependencies::emitLookupMissCacheMessage(const LibraryLookupMissCache & cache) const
+{
+  const QString msg = tr("%1 missing libraries known, %2 lookups answered without searching them again (%3 probes saved)")
+                      .arg( cache.count() )
+                      .arg( cache.hitCount() )
+                      .arg( cache.savedProbeCount() );
+  outputDebugMessage(msg);
+}
+
+void BinaryDependencies::outputVerboseMessage(const QString & message) const
+{
+  if(mMessageSink.get() != nullptr){
+    mMessageSink->verbose(message);
+  }else{
+    emit verboseMessage(message);
+  }
+}
+
+void BinaryDependencies::outputDebugMessage(const QString & message) const
+{
+  if(mMessageSink.get() != nullptr){
+    mMessageSink->debug(message);
+  }else{
+    emit debugMessage(message);
   }
 }
 
@@ -29,6 +29,14 @@
 #include "CompilerFinder.h"
 #include "BuildType.h"
 #include "Platform.h"
+#include "LibraryRedistributionPolicy.h"
+#include "ExecutableFileMetadataCache.h"
+#include "FileStatBackend.h"
+#include "LogLevel.h"
+#include "AbstractMessageSink.h"
+#include "OperatingSystem.h"
+#include "SearchPathIndex.h"
+#include "Mdt/DeployUtils/Impl/LibraryRedistributionPolicyMatcher.h"
 #include "mdt_deployutilscore_export.h"
 #include <Mdt/ExecutableFile/ExecutableFileReader.h>
 #include <QObject>
@@ -36,13 +44,22 @@
 #include <QFileInfoList>
 #include <QString>
 #include <QStringList>
+#include <memory>
 
 namespace Mdt{ namespace DeployUtils{
 
   class QtDistributionDirectory;
   class AbstractSharedLibraryFinder;
+  class FileStatCache;
+  class LibraryLookupMissCache;
 
   /*! \brief Find dependencies for a executable or a library
+   *
+   * The search path list, its index and the compiled redistribution policy
+   * are built on the first search, then reused by the next searches
+   * while the platform and the search inputs do not change.
+   * Directories or files created in the search path list after the first search
+   * are not seen by the next ones.
    */
   class MDT_DEPLOYUTILSCORE_EXPORT BinaryDependencies : public QObject
   {
@@ -61,6 +78,72 @@ namespace Mdt{ namespace DeployUtils{
      */
     void setCompilerFinder(const std::shared_ptr<CompilerFinder> & compilerFinder) noexcept;
 
+    /*! \brief Set the redistribution policy
+     *
+     * \sa AbstractSharedLibraryFinder::setRedistributionPolicy()
+     */
+    void setRedistributionPolicy(const LibraryRedistributionPolicy & policy) noexcept;
+
+    /*! \brief Set a metadata cache
+     *
+     * By default, each file is read every time dependencies are searched.
+     * If a cache is set, the informations read from files
+     * (platform, direct dependencies, rpath)
+     * are taken from \a cache when the file did not change.
+     *
+     * \sa ExecutableFileMetadataCache
+     */
+    void setMetadataCache(const std::shared_ptr<ExecutableFileMetadataCache> & cache) noexcept;
+
+    /*! \brief Set a cache of libraries that could not be found
+     *
+     * By default, a cache is created for each call of findDependencies(),
+     * so a missing library is searched once per search context during a call.
+     * Setting a cache allows to share it between calls
+     * (for example to find the dependencies of the executables, then of the Qt plugins).
+     *
+     * The cache does not detect changes on the file system,
+     * so it should only be shared for a run.
+     *
+     * \sa LibraryLookupMissCache
+     */
+    void setLookupMissCache(const std::shared_ptr<LibraryLookupMissCache> & cache) noexcept;
+
+    /*! \brief Set the backend used to stat files
+     *
+     * By default, each candidate file is stat'ed synchronously
+     * while searching a library.
+     * With FileStatBackend::IoUring, the candidate files of all the libraries
+     * to search in a pass are stat'ed in batches using io_uring.
+     *
+     * If \a backend is not available on this host,
+     * the synchronous backend is used.
+     *
+     * \sa FileStatCache
+     */
+    void setFileStatBackend(FileStatBackend backend) noexcept;
+
+    /*! \brief Set the log level
+     *
+     * Verbose and debug messages are only built (and emitted)
+     * if \a level requires them.
+     * By default, the log level is LogLevel::Debug.
+     *
+     * \sa AbstractSharedLibraryFinder::setLogLevel()
+     */
+    void setLogLevel(LogLevel level) noexcept;
+
+    /*! \brief Set a message sink
+     *
+     * If \a sink is set, this object and the components it uses
+     * to find dependencies write their verbose and debug messages
+     * directly to it, instead of emitting them as signals.
+     *
+     * \sa AbstractMessageSink
+     * \sa AbstractSharedLibraryFinder::setMessageSink()
+     */
+    void setMessageSink(const std::shared_ptr<AbstractMessageSink> & sink) noexcept;
+
     /*! \brief Find dependencies for a executable or a shared library
      *
      * At first, the target platform will be determined by \a binaryFilePath .
@@ -100,21 +183,65 @@ namespace Mdt{ namespace DeployUtils{
 
    signals:
 
+    /*! \brief Emitted while finding dependencies, as soon as the absolute path of a library to redistribute has been found
+     *
+     * The library is then part of the result,
+     * unless finding the dependencies fails.
+     */
+    void sharedLibraryFound(const QFileInfo & library) const;
+
     void message(const QString & message) const;
     void verboseMessage(const QString & message) const;
     void debugMessage(const QString & message) const;
 
    private:
 
+    std::shared_ptr<FileStatCache> makeFileStatCache() const;
+
     Platform setupFindDependencies(Mdt::ExecutableFile::ExecutableFileReader & reader,
                                    std::shared_ptr<AbstractSharedLibraryFinder> & shLibFinder,
+                                   const std::shared_ptr<FileStatCache> & fileStatCache,
                                    const PathList & searchFirstPathPrefixList,
                                    std::shared_ptr<QtDistributionDirectory> & qtDistributionDirectory,
                                    const QFileInfo & target);
 
+    /*! \internal Search path list and redistribution policy of the last search
+     *
+     * Building the search path list, indexing its directories
+     * and compiling the redistribution policy is done once,
+     * then reused while the platform and the search inputs are the same.
+     */
+    struct SearchSetup
+    {
+      OperatingSystem operatingSystem = OperatingSystem::Unknown;
+      ProcessorISA processorISA = ProcessorISA::Unknown;
+      QStringList searchFirstPathPrefixList;
+      QString targetDirectory;
+      PathList searchPathList;
+      std::shared_ptr<const SearchPathIndex> searchPathIndex;
+      Impl::LibraryRedistributionPolicyMatcher redistributionPolicyMatcher;
+    };
+
+    bool searchSetupMatches(const Platform & platform, const PathList & searchFirstPathPrefixList, const QString & targetDirectory) const noexcept;
+    void setupSearch(AbstractSharedLibraryFinder & shLibFinder,
+                     const Platform & platform,
+                     const PathList & searchFirstPathPrefixList,
+                     const QFileInfo & target);
+
     void emitSearchPathListMessage(const PathList & pathList) const;
+    void emitFileStatCacheMessage(const FileStatCache & cache) const;
+    void emitLookupMissCacheMessage(const LibraryLookupMissCache & cache) const;
+    void outputVerboseMessage(const QString & message) const;
+    void outputDebugMessage(const QString & message) const;
 
     std::shared_ptr<CompilerFinder> mCompilerFinder;
+    LibraryRedistributionPolicy mRedistributionPolicy;
+    std::shared_ptr<ExecutableFileMetadataCache> mMetadataCache;
+    std::shared_ptr<LibraryLookupMissCache> mLookupMissCache;
+    FileStatBackend mFileStatBackend = FileStatBackend::Synchronous;
+    LogLevel mLogLevel = LogLevel::Debug;
+    std::shared_ptr<AbstractMessageSink> mMessageSink;
+    std::unique_ptr<SearchSetup> mSearchSetup;
   };
 
 }} // namespace Mdt{ namespace DeployUtils{
@@ -127,4 +127,18 @@ getLibrariesToRedistributeFilePathList(const BinaryDependenciesResult & result)
   return libraries;
 }
 
+QStringList
+getFoundLibrariesFilePathList(const BinaryDependenciesResult & result) noexcept
+{
+  QStringList libraries;
+
+  for(const BinaryDependenciesResultLibrary & library : result){
+    if( library.isFound() ){
+      libraries.push_back( library.absoluteFilePath() );
+    }
+  }
+
+  return libraries;
+}
+
 }} // namespace Mdt{ namespace DeployUtils{
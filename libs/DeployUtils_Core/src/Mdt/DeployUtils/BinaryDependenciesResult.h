@@ -211,6 +211,14 @@ namespace Mdt{ namespace DeployUtils{
   QStringList
   getLibrariesToRedistributeFilePathList(const BinaryDependenciesResult & result) noexcept;
 
+  /*! \internal Get a list of file path of libraries that have been found in given result
+   *
+   * Libraries that are not redistributed are also in the returned list.
+   */
+  MDT_DEPLOYUTILSCORE_EXPORT
+  QStringList
+  getFoundLibrariesFilePathList(const BinaryDependenciesResult & result) noexcept;
+
 }} // namespace Mdt{ namespace DeployUtils{
 
 #endif // #ifndef MDT_DEPLOY_UTILS_BINARY_DEPENDENCIES_RESULT_H
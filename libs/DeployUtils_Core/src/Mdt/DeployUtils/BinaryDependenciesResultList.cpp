@@ -8,6 +8,7 @@
  ****************************************************************************/
 #include "BinaryDependenciesResultList.h"
 #include "Impl/BinaryDependencies/FileComparison.h"
+#include <QSet>
 #include <algorithm>
 #include <cassert>
 
@@ -48,40 +49,34 @@ BinaryDependenciesResultList::findResultForTargetName(const QString & name) cons
   return *it;
 }
 
-bool listContainsLibrary(const std::vector<BinaryDependenciesResultLibrary> & list,
-                         const BinaryDependenciesResultLibrary & library,
-                         OperatingSystem os) noexcept
-{
-  const QString name = library.libraryName();
-  const auto pred = [&name, os](const BinaryDependenciesResultLibrary & library){
-    return Impl::BinaryDependencies::fileNamesAreEqual(library.libraryName(), name, os);
-  };
-
-  const auto it = std::find_if(list.cbegin(), list.cend(), pred);
-
-  return it != list.cend();
-}
-
-void addLibrariesToList(const std::vector<BinaryDependenciesResultLibrary> & libraries,
-                        std::vector<BinaryDependenciesResultLibrary> & list,
-                        OperatingSystem os) noexcept
-{
-  for(const BinaryDependenciesResultLibrary & library : libraries){
-    if( !listContainsLibrary(list, library, os) ){
-      list.push_back(library);
-    }
-  }
-}
-
-
 std::vector<BinaryDependenciesResultLibrary>
 getLibrariesToRedistribute(const BinaryDependenciesResultList & resultList) noexcept
 {
+  using Impl::BinaryDependencies::fileNameComparisonKey;
+
+  const OperatingSystem os = resultList.operatingSystem();
+
   std::vector<BinaryDependenciesResultLibrary> libraries;
+  /*
+   * Many results share most of their libraries
+   * (think about Qt plugins that all depend on Qt5Core),
+   * so we use a hash set to not search the list for each library
+   */
+  QSet<QString> libraryKeys;
 
   for(const BinaryDependenciesResult & result : resultList){
     assert( result.isSolved() );
-    addLibrariesToList( getLibrariesToRedistribute(result), libraries, resultList.operatingSystem() );
+    for(const BinaryDependenciesResultLibrary & library : result){
+      if( !library.isToRedistribute() ){
+        continue;
+      }
+      assert( library.isFound() );
+      const QString key = fileNameComparisonKey(library.libraryName(), os);
+      if( !libraryKeys.contains(key) ){
+        libraryKeys.insert(key);
+        libraries.push_back(library);
+      }
+    }
   }
 
   return libraries;
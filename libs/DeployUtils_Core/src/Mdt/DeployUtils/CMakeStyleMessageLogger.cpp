@@ -26,12 +26,12 @@ namespace Mdt{ namespace DeployUtils{
 
 void CMakeStyleMessageLogger::info(const QString & message)
 {
-  std::cout << "-- " << message.toLocal8Bit().toStdString() << std::endl;
+  std::cout << infoPrefix().data() << message.toLocal8Bit().toStdString() << std::endl;
 }
 
 void CMakeStyleMessageLogger::error(const QString & message)
 {
-  std::cerr << "[CMake style ERROR]: " << message.toLocal8Bit().toStdString() << std::endl;
+  std::cerr << errorPrefix().data() << message.toLocal8Bit().toStdString() << std::endl;
 }
 
 }} // namespace Mdt{ namespace DeployUtils{
@@ -23,6 +23,7 @@
 
 #include "AbstractMessageLoggerBackend.h"
 #include "mdt_deployutilscore_export.h"
+#include <QLatin1String>
 
 namespace Mdt{ namespace DeployUtils{
 
@@ -42,6 +43,22 @@ namespace Mdt{ namespace DeployUtils{
     /*! \brief Log a error
      */
     void error(const QString & message) override;
+
+    /*! \brief Get the prefix written before each information
+     */
+    static
+    QLatin1String infoPrefix() noexcept
+    {
+      return QLatin1String("-- ");
+    }
+
+    /*! \brief Get the prefix written before each error
+     */
+    static
+    QLatin1String errorPrefix() noexcept
+    {
+      return QLatin1String("[CMake style ERROR]: ");
+    }
   };
 
 }} // namespace Mdt{ namespace DeployUtils{
@@ -23,12 +23,22 @@ void CopiedExecutableFile::setSourceFileRPath(const RPath & rpath) noexcept
   mRPath = rpath;
 }
 
+void CopiedExecutableFile::setSha256(const QString & sha256) noexcept
+{
+  assert( sha256.length() == 64 );
+
+  mSha256 = sha256;
+}
+
 CopiedExecutableFile
 CopiedExecutableFile::fromCopierFileAndFileToInstall(const FileCopierFile & copierFile, const ExecutableFileToInstall & fileToInstall) noexcept
 {
   assert( copierFile.hasBeenCopied() );
 
-  return CopiedExecutableFile( copierFile.sourceFileInfo(), copierFile.destinationFileInfo(), fileToInstall.rPath() );
+  CopiedExecutableFile copiedFile( copierFile.sourceFileInfo(), copierFile.destinationFileInfo(), fileToInstall.rPath() );
+  copiedFile.mSha256 = copierFile.sha256();
+
+  return copiedFile;
 }
 
 CopiedExecutableFile::CopiedExecutableFile(const QFileInfo & sourcePath, const QFileInfo & destinationPath, const RPath & rpath) noexcept
@@ -60,6 +60,21 @@ namespace Mdt{ namespace DeployUtils{
       return mRPath;
     }
 
+    /*! \brief Set the SHA-256 of the destination file
+     *
+     * \pre \a sha256 must be a SHA-256 as hexadecimal string
+     */
+    void setSha256(const QString & sha256) noexcept;
+
+    /*! \brief Get the SHA-256 of the destination file, as hexadecimal string
+     *
+     * \sa FileCopierFile::sha256()
+     */
+    const QString & sha256() const noexcept
+    {
+      return mSha256;
+    }
+
     /*! \brief Construct from given files
      *
      * \pre \a copierFile must have been copied
@@ -74,6 +89,7 @@ namespace Mdt{ namespace DeployUtils{
     QFileInfo mSourceFileInfo;
     QFileInfo mDestinationFileInfo;
     RPath mRPath;
+    QString mSha256;
   };
 
   /*! \internal
@@ -20,8 +20,13 @@
  ****************************************************************************/
 #include "CopySharedLibrariesTargetDependsOn.h"
 #include "SharedLibrariesDeployer.h"
+#include "DeployStore.h"
 #include "QtDistributionDirectory.h"
 #include "PathList.h"
+#include "LibraryRedistributionPolicyReader.h"
+#include "DepFileWriter.h"
+#include <QFileInfo>
+#include <QStringList>
 #include <memory>
 #include <cassert>
 
@@ -31,6 +36,7 @@ void CopySharedLibrariesTargetDependsOn::execute(const CopySharedLibrariesTarget
 {
   assert( !request.targetFilePath.trimmed().isEmpty() );
   assert( !request.destinationDirectoryPath.trimmed().isEmpty() );
+  assert( request.depFilePath.isEmpty() || !request.stampFilePath.isEmpty() );
 
   auto qtDistributionDirectory = std::make_shared<QtDistributionDirectory>();
 
@@ -42,12 +48,46 @@ void CopySharedLibrariesTargetDependsOn::execute(const CopySharedLibrariesTarget
   shLibDeployer.setSearchPrefixPathList( PathList::fromStringList(request.searchPrefixPathList) );
   shLibDeployer.setOverwriteBehavior(request.overwriteBehavior);
   shLibDeployer.setRemoveRpath(request.removeRpath);
+  shLibDeployer.setPipelinedCopy(request.pipelinedCopy);
+  shLibDeployer.setMetadataCache(mMetadataCache);
+  shLibDeployer.setFileStatBackend(mFileStatBackend);
+  shLibDeployer.setLogLevel(mLogLevel);
+  shLibDeployer.setMessageSink(mMessageSink);
+
+  if( !request.deployStoreDirectoryPath.isEmpty() ){
+    shLibDeployer.setDeployStore( std::make_shared<DeployStore>( QFileInfo(request.deployStoreDirectoryPath).absoluteFilePath() ) );
+  }
 
   if( !request.compilerLocation.isNull() ){
     shLibDeployer.setCompilerLocation(request.compilerLocation);
   }
 
-  shLibDeployer.copySharedLibrariesTargetDependsOn(request.targetFilePath, request.destinationDirectoryPath);
+  if( !request.redistributionPolicyFilePath.isEmpty() ){
+    LibraryRedistributionPolicyReader policyReader;
+    connect(&policyReader, &LibraryRedistributionPolicyReader::verboseMessage, this, &CopySharedLibrariesTargetDependsOn::verboseMessage);
+    const QFileInfo policyFile( QFileInfo(request.redistributionPolicyFilePath).absoluteFilePath() );
+    shLibDeployer.setRedistributionPolicy( policyReader.readFile(policyFile) );
+  }
+
+  const BinaryDependenciesResult dependencies
+    = shLibDeployer.copySharedLibrariesTargetDependsOn(request.targetFilePath, request.destinationDirectoryPath);
+
+  /*
+   * The depfile and the stamp are only written once everything succeeded,
+   * otherwise the build system would skip the next run
+   */
+  DepFileWriter depFileWriter;
+  connect(&depFileWriter, &DepFileWriter::verboseMessage, this, &CopySharedLibrariesTargetDependsOn::verboseMessage);
+
+  if( !request.depFilePath.isEmpty() ){
+    const QString stampFilePath = QFileInfo(request.stampFilePath).absoluteFilePath();
+    const QStringList dependencyFilePaths = QStringList{dependencies.target().absoluteFilePath()} + getFoundLibrariesFilePathList(dependencies);
+    depFileWriter.writeDepFile( QFileInfo(request.depFilePath).absoluteFilePath(), stampFilePath, dependencyFilePaths );
+  }
+
+  if( !request.stampFilePath.isEmpty() ){
+    depFileWriter.writeStampFile( QFileInfo(request.stampFilePath).absoluteFilePath() );
+  }
 }
 
 }} // namespace Mdt{ namespace DeployUtils{
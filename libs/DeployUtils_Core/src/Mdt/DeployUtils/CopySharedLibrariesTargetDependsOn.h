@@ -22,10 +22,16 @@
 #define MDT_DEPLOY_UTILS_COPY_SHARED_LIBRARIES_TARGET_DEPENDS_ON_H
 
 #include "CopySharedLibrariesTargetDependsOnRequest.h"
+#include "ExecutableFileMetadataCache.h"
+#include "FileStatBackend.h"
+#include "LogLevel.h"
+#include "AbstractMessageSink.h"
+#include "BinaryDependenciesResult.h"
 #include "mdt_deployutilscore_export.h"
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <memory>
 
 namespace Mdt{ namespace DeployUtils{
 
@@ -70,6 +76,19 @@ namespace Mdt{ namespace DeployUtils{
    * \note This is mostly required for MSVC
    * \sa CompilerFinder
    *
+   * If \a redistributionPolicyFilePath is set,
+   * its rules decide which shared libraries are redistributed,
+   * before the built-in exclude lists.
+   * \sa LibraryRedistributionPolicyReader
+   *
+   * If \a depFilePath is set, a depfile is written once the copy succeeded.
+   * It lists the target and every shared library that has been found,
+   * as dependencies of \a stampFilePath .
+   * If \a stampFilePath is set, the stamp file is written (or updated) last.
+   * This lets a build system skip the copy
+   * when neither the target nor any of its dependencies changed.
+   * \sa DepFileWriter
+   *
    * \sa SharedLibrariesDeployer
    *
    * \todo Should also require full path to tools, like ldd, objdump, etc..
@@ -88,18 +107,57 @@ namespace Mdt{ namespace DeployUtils{
     {
     }
 
+    /*! \brief Set a metadata cache
+     *
+     * \sa BinaryDependencies::setMetadataCache()
+     */
+    void setMetadataCache(const std::shared_ptr<ExecutableFileMetadataCache> & cache) noexcept
+    {
+      mMetadataCache = cache;
+    }
+
+    /*! \brief Set the backend used to stat files
+     *
+     * \sa BinaryDependencies::setFileStatBackend()
+     */
+    void setFileStatBackend(FileStatBackend backend) noexcept
+    {
+      mFileStatBackend = backend;
+    }
+
+    /*! \brief Set the log level
+     *
+     * \sa BinaryDependencies::setLogLevel()
+     */
+    void setLogLevel(LogLevel level) noexcept
+    {
+      mLogLevel = level;
+    }
+
+    /*! \brief Set a message sink
+     *
+     * \sa BinaryDependencies::setMessageSink()
+     */
+    void setMessageSink(const std::shared_ptr<AbstractMessageSink> & sink) noexcept
+    {
+      mMessageSink = sink;
+    }
+
     /*! \brief Copy shared libraries a target depends on to a destination directory
      *
      * \pre request's \a targetFilePath must be specified
      * \pre request's \a destinationDirectoryPath must be specified
+     * \pre if request's \a depFilePath is specified, \a stampFilePath must also be specified
      * \todo tools must also be specified
      *
      * \exception FindCompilerError
      * \exception FileOpenError
      * \exception ExecutableFileReadError
+     * \exception ReadLibraryRedistributionPolicyError
      * \exception FindDependencyError
      * \exception FileCopyError
      * \exception ExecutableFileWriteError
+     * \exception WriteDepFileError
      */
     void execute(const CopySharedLibrariesTargetDependsOnRequest & request);
 
@@ -108,6 +166,13 @@ namespace Mdt{ namespace DeployUtils{
     void statusMessage(const QString & message) const;
     void verboseMessage(const QString & message) const;
     void debugMessage(const QString & message) const;
+
+   private:
+
+    std::shared_ptr<ExecutableFileMetadataCache> mMetadataCache;
+    FileStatBackend mFileStatBackend = FileStatBackend::Synchronous;
+    LogLevel mLogLevel = LogLevel::Debug;
+    std::shared_ptr<AbstractMessageSink> mMessageSink;
   };
 
 }} // namespace Mdt{ namespace DeployUtils{
@@ -35,12 +35,24 @@ namespace Mdt{ namespace DeployUtils{
   {
     OverwriteBehavior overwriteBehavior = OverwriteBehavior::Fail;
     bool removeRpath = false;
+    bool pipelinedCopy = false;
 //     CompilerLocationType compilerLocationType = CompilerLocationType::Undefined;
 //     QString compilerLocationValue;
     CompilerLocationRequest compilerLocation;
     QStringList searchPrefixPathList;
+    QString redistributionPolicyFilePath;
     QString targetFilePath;
     QString destinationDirectoryPath;
+    QString depFilePath;
+    QString stampFilePath;
+
+    /*! \brief Directory of a deploy store to link the shared libraries from
+     *
+     * If empty, the shared libraries are copied.
+     *
+     * \sa DeployStore
+     */
+    QString deployStoreDirectoryPath;
   };
 
 }} // namespace Mdt{ namespace DeployUtils{
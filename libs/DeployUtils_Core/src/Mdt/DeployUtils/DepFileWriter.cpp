@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "DepFileWriter.h"
+#include <QSaveFile>
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+#include <QSet>
+#include <QLatin1String>
+#include <QLatin1Char>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+DepFileWriter::DepFileWriter(QObject *parent) noexcept
+ : QObject(parent)
+{
+}
+
+void DepFileWriter::writeDepFile(const QString & depFilePath, const QString & outputFilePath, const QStringList & dependencyFilePaths)
+{
+  assert( QDir::isAbsolutePath(depFilePath) );
+  assert( QDir::isAbsolutePath(outputFilePath) );
+
+  emit verboseMessage(
+    tr("writing depfile %1")
+    .arg(depFilePath)
+  );
+
+  writeFile( depFilePath, makeDepFileContent(outputFilePath, dependencyFilePaths) );
+}
+
+void DepFileWriter::writeStampFile(const QString & stampFilePath)
+{
+  assert( QDir::isAbsolutePath(stampFilePath) );
+
+  emit verboseMessage(
+    tr("writing stamp file %1")
+    .arg(stampFilePath)
+  );
+
+  writeFile( stampFilePath, QByteArray() );
+}
+
+QByteArray DepFileWriter::makeDepFileContent(const QString & outputFilePath, const QStringList & dependencyFilePaths)
+{
+  QByteArray content = QFile::encodeName( escapeMakefilePath(outputFilePath) );
+  content += ':';
+
+  QSet<QString> writtenPaths;
+  for(const QString & path : dependencyFilePaths){
+    if( writtenPaths.contains(path) ){
+      continue;
+    }
+    writtenPaths.insert(path);
+    content += " \\\n  ";
+    content += QFile::encodeName( escapeMakefilePath(path) );
+  }
+  content += '\n';
+
+  return content;
+}
+
+QString DepFileWriter::escapeMakefilePath(const QString & path)
+{
+  QString escapedPath;
+  escapedPath.reserve( path.size() );
+
+  for( const QChar c : QDir::fromNativeSeparators(path) ){
+    if( (c == QLatin1Char(' ')) || (c == QLatin1Char('#')) ){
+      escapedPath += QLatin1Char('\\');
+    }else if( c == QLatin1Char('$') ){
+      escapedPath += QLatin1Char('$');
+    }
+    escapedPath += c;
+  }
+
+  return escapedPath;
+}
+
+void DepFileWriter::writeFile(const QString & filePath, const QByteArray & content)
+{
+  const QString directoryPath = QFileInfo(filePath).absolutePath();
+  if( !QDir().mkpath(directoryPath) ){
+    const QString msg = tr("writing %1 failed: could not create directory %2")
+                        .arg(filePath, directoryPath);
+    throw WriteDepFileError(msg);
+  }
+
+  QSaveFile file(filePath);
+  if( !file.open(QIODevice::WriteOnly) ){
+    const QString msg = tr("writing %1 failed: %2")
+                        .arg( filePath, file.errorString() );
+    throw WriteDepFileError(msg);
+  }
+
+  file.write(content);
+
+  if( !file.commit() ){
+    const QString msg = tr("writing %1 failed: %2")
+                        .arg( filePath, file.errorString() );
+    throw WriteDepFileError(msg);
+  }
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_DEP_FILE_WRITER_H
+#define MDT_DEPLOY_UTILS_DEP_FILE_WRITER_H
+
+#include "WriteDepFileError.h"
+#include "mdt_deployutilscore_export.h"
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Write a depfile and a stamp file for a build system
+   *
+   * A depfile lists the files a output depends on,
+   * using the Makefile syntax understood by Make and Ninja:
+   * \code
+   * /build/myapp_shared_libraries.stamp: \
+   *   /build/myapp \
+   *   /opt/qt/lib/libQt5Core.so.5
+   * \endcode
+   *
+   * This way, the build system can skip a step
+   * when neither its output nor any of its dependencies changed.
+   *
+   * \sa https://cmake.org/cmake/help/latest/command/add_custom_command.html (DEPFILE)
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT DepFileWriter : public QObject
+  {
+    Q_OBJECT
+
+   public:
+
+    /*! \brief Constructor
+     */
+    explicit DepFileWriter(QObject *parent = nullptr) noexcept;
+
+    /*! \brief Write a depfile to \a depFilePath
+     *
+     * Missing parent directories are created.
+     *
+     * \pre \a depFilePath must be a absolute path
+     * \pre \a outputFilePath must be a absolute path
+     * \exception WriteDepFileError
+     * \sa makeDepFileContent()
+     */
+    void writeDepFile(const QString & depFilePath, const QString & outputFilePath, const QStringList & dependencyFilePaths);
+
+    /*! \brief Write (or update) the stamp file \a stampFilePath
+     *
+     * The file is allways rewritten,
+     * so that its modification time is the time of the last successful run.
+     *
+     * Missing parent directories are created.
+     *
+     * \pre \a stampFilePath must be a absolute path
+     * \exception WriteDepFileError
+     */
+    void writeStampFile(const QString & stampFilePath);
+
+    /*! \brief Get the content of a depfile
+     *
+     * Each path is escaped (see escapeMakefilePath()).
+     * Duplicate dependencies are only listed once.
+     */
+    static
+    QByteArray makeDepFileContent(const QString & outputFilePath, const QStringList & dependencyFilePaths);
+
+    /*! \brief Escape \a path for a Makefile style rule
+     *
+     * Native separators are converted to '/',
+     * spaces and '#' are escaped with a backslash,
+     * and '$' is doubled.
+     */
+    static
+    QString escapeMakefilePath(const QString & path);
+
+   signals:
+
+    void verboseMessage(const QString & message) const;
+
+   private:
+
+    static
+    void writeFile(const QString & filePath, const QByteArray & content);
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_DEP_FILE_WRITER_H
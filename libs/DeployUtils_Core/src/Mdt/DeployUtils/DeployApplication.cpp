@@ -33,6 +33,11 @@
 #include "QtConf.h"
 #include "QtConfWriter.h"
 #include "DestinationDirectoryQtConf.h"
+#include "DestinationArchive.h"
+#include "LibraryRedistributionPolicyReader.h"
+#include "DeployManifestReader.h"
+#include "DeployManifestWriter.h"
+#include "FileHashCache.h"
 #include <Mdt/ExecutableFile/ExecutableFileReader.h>
 #include <Mdt/ExecutableFile/ExecutableFileWriter.h>
 #include <QLatin1String>
@@ -40,6 +45,9 @@
 #include <QStringBuilder>
 #include <QStringList>
 #include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
 #include <cassert>
 
 using Mdt::ExecutableFile::ExecutableFileReader;
@@ -61,21 +69,14 @@ void DeployApplication::execute(const DeployApplicationRequest & request)
   assert( !request.runtimeDestination.trimmed().isEmpty() );
   assert( !request.libraryDestination.trimmed().isEmpty() );
 
+  const QStringList targetFilePathList = targetFilePathListFromRequest(request);
+
   emit statusMessage(
     tr("Deploy application for executable %1")
-    .arg(request.targetFilePath)
+    .arg( targetFilePathList.join( QLatin1String(", ") ) )
   );
 
-  ExecutableFileReader reader;
-  reader.openFile(request.targetFilePath);
-  mPlatform = reader.getFilePlatform();
-  reader.close();
-
-  if( mPlatform.operatingSystem() == OperatingSystem::Unknown ){
-    const QString message = tr("'%1' targets a operating system that is not supported")
-                            .arg(request.targetFilePath);
-    throw FindDependencyError(message);
-  }
+  readPlatform(targetFilePathList);
 
   if( QDir::isAbsolutePath(request.runtimeDestination) ){
     const QString message = tr("runtime destination must not be a absolute path, given: ")
@@ -104,32 +105,96 @@ void DeployApplication::execute(const DeployApplicationRequest & request)
     .arg( osName( mPlatform.operatingSystem() ) )
   );
 
-  setupShLibDeployer(request);
+  const QString manifestFilePath = DeployManifest::manifestFilePath( QFileInfo( destination.path() ).absoluteFilePath(), targetFilePathList );
+  const QString requestKey = deployManifestRequestKey(request, targetFilePathList);
 
-  const BinaryDependenciesResult librariesExecutableDependsOn = mShLibDeployer->findSharedLibrariesTargetDependsOn(request.targetFilePath);
-  if( !librariesExecutableDependsOn.isSolved() ){
-    throwApplicationDependenciesNotSolvedError(librariesExecutableDependsOn);
+  /*
+   * A archive is allways written from scratch
+   */
+  std::shared_ptr<const DeployManifest> previousManifest;
+  if( request.archiveFilePath.isEmpty() ){
+    previousManifest = readPreviousDeployManifest(manifestFilePath);
   }
 
-  const QtPluginFileList qtPlugins = getRequiredQtPlugins(librariesExecutableDependsOn, request);
+  std::shared_ptr<const DeployManifest> reusableManifest;
+  if( previousManifest && !request.ignoreDeployManifest ){
+    if( previousManifest->requestKey() == requestKey ){
+      if( previousManifest->isUpToDate() ){
+        emit statusMessage(
+          tr("Destination is up to date, nothing to deploy")
+        );
+        return;
+      }
+      reusableManifest = previousManifest;
+    }else{
+      emit verboseMessage(
+        tr("deploy parameters changed since previous deploy, all files will be deployed again")
+      );
+    }
+  }
+
+  setupShLibDeployer(request);
+  mShLibDeployer->setDeployManifest(reusableManifest);
+
+  /*
+   * Libraries that are missing are typically searched
+   * for many dependent files, and again for the Qt plugins.
+   * The cache lives for this deploy only,
+   * the file system can change between deploys
+   */
+  const auto lookupMissCache = std::make_shared<LibraryLookupMissCache>();
+  mShLibDeployer->setLookupMissCache(lookupMissCache);
+
+  /*
+   * All targets are given at once,
+   * so the dependencies they share are discovered only once
+   */
+  const BinaryDependenciesResultList librariesExecutablesDependsOn
+    = mShLibDeployer->findSharedLibrariesTargetsDependsOn( toAbsoluteFileInfoList(targetFilePathList) );
+  if( !librariesExecutablesDependsOn.isSolved() ){
+    emitLookupMissCacheSummary(*lookupMissCache);
+    throwApplicationDependenciesNotSolvedError(librariesExecutablesDependsOn);
+  }
+
+  const QtPluginFileList qtPlugins = getRequiredQtPlugins(librariesExecutablesDependsOn, request);
 
   BinaryDependenciesResultList libraries = findSharedLibrariesQtPluginsDependsOn(qtPlugins);
+  emitLookupMissCacheSummary(*lookupMissCache);
   if( !libraries.isSolved() ){
     throwQtPluginsDependenciesNotSolvedError(libraries);
   }
 
-  libraries.addResult(librariesExecutableDependsOn);
+  for(const BinaryDependenciesResult & result : librariesExecutablesDependsOn){
+    libraries.addResult(result);
+  }
   assert( libraries.isSolved() );
 
+  if( !request.archiveFilePath.isEmpty() ){
+    writeArchive(request, targetFilePathList, libraries, qtPlugins, destination);
+    return;
+  }
+
   makeDirectoryStructure(destination);
 
-  installExecutable( request, destination.structure() );
+  for(const QString & targetFilePath : targetFilePathList){
+    installExecutable( targetFilePath, request, destination.structure() );
+  }
 
   installSharedLibraries(libraries);
 
   installQtPlugins(qtPlugins, destination, request.shLibOverwriteBehavior);
 
   writeQtConfFile(destination);
+
+  if(!previousManifest){
+    previousManifest = std::make_shared<const DeployManifest>();
+  }
+
+  const DeployManifest manifest = makeDeployManifest(requestKey, targetFilePathList, libraries, qtPlugins, destination, *previousManifest);
+
+  pruneStaleFiles(*previousManifest, manifest, manifestFilePath, request.pruneStaleFiles);
+
+  writeDeployManifest(manifest, manifestFilePath);
 }
 
 DestinationDirectoryStructure
@@ -159,6 +224,35 @@ DeployApplication::destinationDirectoryStructureFromRuntimeAndLibraryDestination
   return structure;
 }
 
+QString DeployApplication::deployManifestRequestKey(const DeployApplicationRequest & request, const QStringList & targetFilePathList) noexcept
+{
+  QStringList key;
+
+  QStringList targets;
+  for(const QString & targetFilePath : targetFilePathList){
+    targets.append( QFileInfo(targetFilePath).absoluteFilePath() );
+  }
+  key.append( QLatin1String("targets=") + targets.join( QLatin1Char(',') ) );
+  key.append( QLatin1String("runtimeDestination=") + request.runtimeDestination );
+  key.append( QLatin1String("libraryDestination=") + request.libraryDestination );
+  key.append( QLatin1String("searchPrefixPathList=") + request.searchPrefixPathList.join( QLatin1Char(',') ) );
+  key.append( QLatin1String("removeRpath=") + QString::number(request.removeRpath ? 1 : 0) );
+  key.append( QLatin1String("compilerLocation=") + QString::number( static_cast<int>( request.compilerLocation.type() ) )
+              + QLatin1Char(':') + request.compilerLocation.value() );
+  key.append( QLatin1String("qtPluginsSet=") + request.qtPluginsSet.toString() );
+
+  QString redistributionPolicy;
+  if( !request.redistributionPolicyFilePath.isEmpty() ){
+    const QFileInfo policyFile(request.redistributionPolicyFilePath);
+    redistributionPolicy = policyFile.absoluteFilePath()
+                           % QLatin1Char(':') % QString::number( policyFile.size() )
+                           % QLatin1Char(':') % QString::number( policyFile.lastModified().toMSecsSinceEpoch() );
+  }
+  key.append( QLatin1String("redistributionPolicy=") + redistributionPolicy );
+
+  return key.join( QLatin1Char('\n') );
+}
+
 QString DeployApplication::getMissingLibrariesListText(const BinaryDependenciesResult & result) const noexcept
 {
   assert( !result.isSolved() );
@@ -199,6 +293,52 @@ void DeployApplication::throwApplicationDependenciesNotSolvedError(const BinaryD
   throw FindDependencyError(msg);
 }
 
+void DeployApplication::throwApplicationDependenciesNotSolvedError(const BinaryDependenciesResultList & resultList) const
+{
+  assert( !resultList.isSolved() );
+
+  for(const BinaryDependenciesResult & result : resultList){
+    if( !result.isSolved() ){
+      throwApplicationDependenciesNotSolvedError(result);
+    }
+  }
+
+  /*
+   * The list is not solved, but each result is.
+   * Should not happen, but the caller relies on a throw
+   */
+  const QString msg = tr("some shared libraries the applications depends on could not be found");
+  throw FindDependencyError(msg);
+}
+
+void DeployApplication::readPlatform(const QStringList & targetFilePathList)
+{
+  assert( !targetFilePathList.isEmpty() );
+
+  mPlatform = Platform();
+
+  for(const QString & targetFilePath : targetFilePathList){
+    ExecutableFileReader reader;
+    reader.openFile(targetFilePath);
+    const Platform platform = reader.getFilePlatform();
+    reader.close();
+
+    if( platform.operatingSystem() == OperatingSystem::Unknown ){
+      const QString message = tr("'%1' targets a operating system that is not supported")
+                              .arg(targetFilePath);
+      throw FindDependencyError(message);
+    }
+
+    if( mPlatform.isNull() ){
+      mPlatform = platform;
+    }else if( (platform.operatingSystem() != mPlatform.operatingSystem()) || (platform.processorISA() != mPlatform.processorISA()) ){
+      const QString message = tr("'%1' does not target the same platform than '%2', they can not be deployed together")
+                              .arg( targetFilePath, targetFilePathList.at(0) );
+      throw DeployApplicationError(message);
+    }
+  }
+}
+
 void DeployApplication::setupShLibDeployer(const DeployApplicationRequest & request)
 {
   if(mShLibDeployer.get() == nullptr){
@@ -211,11 +351,42 @@ void DeployApplication::setupShLibDeployer(const DeployApplicationRequest & requ
   mShLibDeployer->setSearchPrefixPathList( PathList::fromStringList(request.searchPrefixPathList) );
   mShLibDeployer->setOverwriteBehavior(request.shLibOverwriteBehavior);
   mShLibDeployer->setRemoveRpath(request.removeRpath);
+  /*
+   * Without a cache shared between runs, a cache is used for this deploy,
+   * so that the deploy manifest gets the RPATH of the deployed files
+   * from the metadata read while finding the dependencies
+   */
+  if(mMetadataCache){
+    mShLibDeployer->setMetadataCache(mMetadataCache);
+  }else{
+    mShLibDeployer->setMetadataCache( std::make_shared<ExecutableFileMetadataCache>() );
+  }
+  mShLibDeployer->setFileStatBackend(mFileStatBackend);
+  mShLibDeployer->setLogLevel(mLogLevel);
+  mShLibDeployer->setMessageSink(mMessageSink);
+
+  if( request.deployStoreDirectoryPath.isEmpty() ){
+    mShLibDeployer->setDeployStore(nullptr);
+  }else{
+    mShLibDeployer->setDeployStore( std::make_shared<DeployStore>( QFileInfo(request.deployStoreDirectoryPath).absoluteFilePath() ) );
+  }
+
+  // Collects the SHA-256 computed while copying, for the deploy manifest
+  mShLibDeployer->setFileHashCache( std::make_shared<FileHashCache>() );
 
   /// \todo else: clear compiler finder !
   if( !request.compilerLocation.isNull() ){
     mShLibDeployer->setCompilerLocation(request.compilerLocation);
   }
+
+  if( request.redistributionPolicyFilePath.isEmpty() ){
+    mShLibDeployer->setRedistributionPolicy( LibraryRedistributionPolicy() );
+  }else{
+    LibraryRedistributionPolicyReader policyReader;
+    connect(&policyReader, &LibraryRedistributionPolicyReader::verboseMessage, this, &DeployApplication::verboseMessage);
+    const QFileInfo policyFile( QFileInfo(request.redistributionPolicyFilePath).absoluteFilePath() );
+    mShLibDeployer->setRedistributionPolicy( policyReader.readFile(policyFile) );
+  }
 }
 
 void DeployApplication::makeDirectoryStructure(const DestinationDirectory & destination)
@@ -243,10 +414,11 @@ void DeployApplication::makeDirectoryStructure(const DestinationDirectory & dest
   }
 }
 
-void DeployApplication::installExecutable(const DeployApplicationRequest & request, const DestinationDirectoryStructure & destinationStructure)
+void DeployApplication::installExecutable(const QString & targetFilePath, const DeployApplicationRequest & request,
+                                          const DestinationDirectoryStructure & destinationStructure)
 {
   assert( !mBinDirDestinationPath.isEmpty() );
-  assert( !request.targetFilePath.isEmpty() );
+  assert( !targetFilePath.isEmpty() );
   assert( !destinationStructure.isNull() );
 
   ExecutableFileInstaller installer(mPlatform);
@@ -254,7 +426,7 @@ void DeployApplication::installExecutable(const DeployApplicationRequest & reque
   connect(&installer, &ExecutableFileInstaller::verboseMessage, this, &DeployApplication::verboseMessage);
   connect(&installer, &ExecutableFileInstaller::debugMessage, this, &DeployApplication::debugMessage);
 
-  const auto fileToInstall = ExecutableFileToInstall::fromFilePath(request.targetFilePath);
+  const auto fileToInstall = ExecutableFileToInstall::fromFilePath(targetFilePath);
 
   RPath installRpath;
   if(!request.removeRpath){
@@ -262,6 +434,9 @@ void DeployApplication::installExecutable(const DeployApplicationRequest & reque
   }
 
   installer.setOverwriteBehavior(OverwriteBehavior::Overwrite);
+  installer.setDeployManifest( mShLibDeployer->deployManifest() );
+  installer.setFileHashCache( mShLibDeployer->fileHashCache() );
+  installer.setMetadataCache( mShLibDeployer->metadataCache() );
   installer.install(fileToInstall, mBinDirDestinationPath, installRpath);
 }
 
@@ -274,7 +449,7 @@ void DeployApplication::installSharedLibraries(const BinaryDependenciesResultLis
 }
 
 
-QtPluginFileList DeployApplication::getRequiredQtPlugins(const BinaryDependenciesResult & libraries, const DeployApplicationRequest & request)
+QtPluginFileList DeployApplication::getRequiredQtPlugins(const BinaryDependenciesResultList & libraries, const DeployApplicationRequest & request)
 {
   assert( libraries.isSolved() );
   assert( mShLibDeployer.get() != nullptr );
@@ -284,7 +459,10 @@ QtPluginFileList DeployApplication::getRequiredQtPlugins(const BinaryDependencie
     tr("get Qt libraries out from dependencies (will be used to know which Qt plugins are required)")
   );
 
-  const QStringList librariesToRedistribute = getLibrariesToRedistributeFilePathList(libraries);
+  QStringList librariesToRedistribute;
+  for(const BinaryDependenciesResultLibrary & library : getLibrariesToRedistribute(libraries)){
+    librariesToRedistribute.append( library.absoluteFilePath() );
+  }
 
   const QtSharedLibraryFileList qtSharedLibraries = QtSharedLibrary::getQtSharedLibraries(librariesToRedistribute);
 
@@ -337,6 +515,282 @@ void DeployApplication::writeQtConfFile(const DestinationDirectory & destination
   writer.writeConfToDirectory( conf, destination.executablesDirectoryPath() );
 }
 
+void DeployApplication::writeArchive(const DeployApplicationRequest & request, const QStringList & targetFilePathList,
+                                     const BinaryDependenciesResultList & libraries, const QtPluginFileList & qtPlugins,
+                                     const DestinationDirectory & destination)
+{
+  assert( !request.archiveFilePath.isEmpty() );
+  assert( !destination.structure().isNull() );
+  assert( !mPlatform.isNull() );
+
+  const QString archiveFilePath = QFileInfo(request.archiveFilePath).absoluteFilePath();
+  const DestinationDirectoryStructure & structure = destination.structure();
+
+  emit statusMessage(
+    tr("writing archive %1")
+    .arg(archiveFilePath)
+  );
+
+  DestinationArchive archive(destination, mPlatform);
+  connect(&archive, &DestinationArchive::statusMessage, this, &DeployApplication::statusMessage);
+  connect(&archive, &DestinationArchive::verboseMessage, this, &DeployApplication::verboseMessage);
+  connect(&archive, &DestinationArchive::debugMessage, this, &DeployApplication::debugMessage);
+
+  archive.open(archiveFilePath);
+
+  RPath executableRPath;
+  if(!request.removeRpath){
+    executableRPath.appendPath( structure.executablesToSharedLibrariesRelativePath() );
+  }
+  for(const QString & targetFilePath : targetFilePathList){
+    archive.addExecutable(QFileInfo(targetFilePath).absoluteFilePath(), executableRPath);
+  }
+
+  RPath libraryRPath;
+  if(!request.removeRpath){
+    libraryRPath.appendPath( QLatin1String(".") );
+  }
+  for(const BinaryDependenciesResultLibrary & library : getLibrariesToRedistribute(libraries)){
+    archive.addSharedLibrary(library, libraryRPath);
+  }
+
+  RPath qtPluginRPath;
+  qtPluginRPath.appendPath( structure.qtPluginsToSharedLibrariesRelativePath() );
+  for(const QtPluginFile & plugin : qtPlugins){
+    archive.addQtPlugin(plugin, qtPluginRPath);
+  }
+
+  QtConf conf;
+  setQtConfPathEntries(conf, structure);
+  archive.addQtConf(conf);
+
+  archive.close();
+}
+
+std::shared_ptr<const DeployManifest> DeployApplication::readPreviousDeployManifest(const QString & manifestFilePath)
+{
+  const QFileInfo manifestFile(manifestFilePath);
+  if( !manifestFile.isFile() ){
+    return {};
+  }
+
+  DeployManifestReader reader;
+  connect(&reader, &DeployManifestReader::verboseMessage, this, &DeployApplication::verboseMessage);
+
+  /*
+   * A unreadable manifest is not a error,
+   * it only costs a full deploy
+   */
+  try{
+    return std::make_shared<const DeployManifest>( reader.readFile(manifestFile) );
+  }catch(const ReadDeployManifestError & error){
+    emit verboseMessage(
+      tr("ignoring previous deploy manifest: %1")
+      .arg( error.whatQString() )
+    );
+  }
+
+  return {};
+}
+
+DeployManifest DeployApplication::makeDeployManifest(const QString & requestKey,
+                                                     const QStringList & targetFilePathList, const BinaryDependenciesResultList & libraries,
+                                                     const QtPluginFileList & qtPlugins, const DestinationDirectory & destination,
+                                                     const DeployManifest & previousManifest)
+{
+  assert( !mBinDirDestinationPath.isEmpty() );
+  assert( !mLibDirDestinationPath.isEmpty() );
+
+  emit verboseMessage(
+    tr("update deploy manifest")
+  );
+
+  DeployManifest manifest;
+  manifest.setDestinationDirectoryPath( QFileInfo( destination.path() ).absoluteFilePath() );
+  manifest.setRequestKey(requestKey);
+
+  for(const QString & targetFilePath : targetFilePathList){
+    addDeployedFileToManifest(manifest, targetFilePath, mBinDirDestinationPath, previousManifest);
+  }
+
+  for(const BinaryDependenciesResultLibrary & library : getLibrariesToRedistribute(libraries)){
+    addDeployedFileToManifest(manifest, library.absoluteFilePath(), mLibDirDestinationPath, previousManifest);
+  }
+
+  for(const QtPluginFile & plugin : qtPlugins){
+    const QString pluginDirectoryPath = QDir::cleanPath( destination.qtPluginsRootDirectoryPath() % QLatin1Char('/') % plugin.directoryName() );
+    addDeployedFileToManifest(manifest, plugin.absoluteFilePath(), pluginDirectoryPath, previousManifest);
+  }
+
+  const QString qtConfFilePath = QDir::cleanPath( destination.executablesDirectoryPath() + QLatin1String("/qt.conf") );
+  manifest.addDeployedFile( QFileInfo(qtConfFilePath).absoluteFilePath(), QString(), QStringList(), previousManifest, mShLibDeployer->fileHashCache().get() );
+
+  return manifest;
+}
+
+void DeployApplication::writeDeployManifest(const DeployManifest & manifest, const QString & manifestFilePath)
+{
+  DeployManifestWriter writer;
+  connect(&writer, &DeployManifestWriter::verboseMessage, this, &DeployApplication::verboseMessage);
+
+  writer.writeFile(manifest, manifestFilePath);
+}
+
+void DeployApplication::addDeployedFileToManifest(DeployManifest & manifest, const QString & sourceFilePath,
+                                                  const QString & destinationDirectoryPath, const DeployManifest & previousManifest)
+{
+  assert( !mPlatform.isNull() );
+
+  const QString destinationFilePath = QFileInfo( FileCopier::getDestinationFilePath(sourceFilePath, destinationDirectoryPath) ).absoluteFilePath();
+
+  QStringList rpath;
+  if( mPlatform.supportsRPath() ){
+    /*
+     * The files deployed by this run are in the metadata cache,
+     * with the RPATH they have been given
+     * (see ExecutableFileMetadataCache::insertCopiedFile()).
+     * Only the files that have not been copied are read again.
+     */
+    RPath runPath;
+    const auto & metadataCache = mShLibDeployer->metadataCache();
+    std::optional<ExecutableFileMetadata> metadata;
+    if(metadataCache){
+      metadata = metadataCache->find( QFileInfo(destinationFilePath) );
+    }
+    if( metadata && metadata->hasDependencies ){
+      runPath = metadata->runPath;
+    }else{
+      ExecutableFileReader reader;
+      reader.openFile(QFileInfo(destinationFilePath), mPlatform);
+      runPath = reader.getRunPath();
+      reader.close();
+    }
+    for(int i = 0; i < runPath.entriesCount(); ++i){
+      rpath.append( runPath.entryAt(i).path() );
+    }
+  }
+
+  manifest.addDeployedFile( destinationFilePath, sourceFilePath, rpath, previousManifest, mShLibDeployer->fileHashCache().get() );
+
+  /*
+   * If the shared library has been deployed as a link to the real file
+   * (see FileCopier::setPreserveSymLinks()),
+   * the real file is also listed, so that it is pruned with its link
+   */
+  const QFileInfo destinationFile(destinationFilePath);
+  if( destinationFile.isSymLink() ){
+    const QFileInfo targetFile( destinationFile.symLinkTarget() );
+    if( targetFile.absolutePath() == destinationFile.absolutePath() ){
+      manifest.addDeployedFile( targetFile.absoluteFilePath(), QFileInfo(sourceFilePath).canonicalFilePath(),
+                                rpath, previousManifest, mShLibDeployer->fileHashCache().get() );
+    }
+  }
+}
+
+void DeployApplication::pruneStaleFiles(const DeployManifest & previousManifest, const DeployManifest & manifest,
+                                        const QString & manifestFilePath, bool remove)
+{
+  std::vector<DeployManifestEntry> staleEntries;
+  for(const DeployManifestEntry & entry : previousManifest.entries()){
+    if( !manifest.findEntry(entry.filePath).has_value() ){
+      staleEntries.push_back(entry);
+    }
+  }
+
+  if( staleEntries.empty() ){
+    return;
+  }
+
+  if(!remove){
+    for(const DeployManifestEntry & entry : staleEntries){
+      emit verboseMessage(
+        tr("%1 is no longer required (use the prune option to remove it)")
+        .arg(entry.filePath)
+      );
+    }
+    return;
+  }
+
+  /*
+   * Other applications can be deployed to the same destination,
+   * a file they list is not stale
+   */
+  const auto filesRequiredByOthers = readFilesListedInOtherDeployManifests(manifestFilePath);
+  if( !filesRequiredByOthers.has_value() ){
+    emit statusMessage(
+      tr("stale files are not removed, because a other deploy manifest in the destination could not be read")
+    );
+    return;
+  }
+
+  emit statusMessage(
+    tr("removing files that are no longer required")
+  );
+
+  for(const DeployManifestEntry & entry : staleEntries){
+    if( filesRequiredByOthers->contains(entry.filePath) ){
+      emit verboseMessage(
+        tr(" keep %1 (required by a other application)")
+        .arg(entry.filePath)
+      );
+      continue;
+    }
+    const QString filePath = previousManifest.absoluteFilePath(entry);
+    if( !QFileInfo::exists(filePath) ){
+      continue;
+    }
+    emit verboseMessage(
+      tr(" remove %1")
+      .arg(filePath)
+    );
+    QFile file(filePath);
+    if( !file.remove() ){
+      const QString message = tr("could not remove %1: %2")
+                              .arg( filePath, file.errorString() );
+      throw DeployApplicationError(message);
+    }
+  }
+}
+
+std::optional< QSet<QString> > DeployApplication::readFilesListedInOtherDeployManifests(const QString & manifestFilePath)
+{
+  const QFileInfo manifestFile(manifestFilePath);
+  const QDir manifestsDirectory = manifestFile.absoluteDir();
+
+  DeployManifestReader reader;
+  QSet<QString> files;
+
+  const QFileInfoList otherManifests = manifestsDirectory.entryInfoList({QLatin1String("*.json")}, QDir::Files);
+  for(const QFileInfo & otherManifest : otherManifests){
+    if( otherManifest.fileName() == manifestFile.fileName() ){
+      continue;
+    }
+    try{
+      for( const DeployManifestEntry & entry : reader.readFile(otherManifest).entries() ){
+        files.insert(entry.filePath);
+      }
+    }catch(const ReadDeployManifestError & error){
+      emit verboseMessage( error.whatQString() );
+      return {};
+    }
+  }
+
+  return files;
+}
+
+void DeployApplication::emitLookupMissCacheSummary(const LibraryLookupMissCache & cache) const
+{
+  if( cache.hitCount() == 0 ){
+    return;
+  }
+
+  emit verboseMessage(
+    tr("%1 lookups of missing libraries answered without searching them again, %2 probes saved")
+    .arg( cache.hitCount() )
+    .arg( cache.savedProbeCount() )
+  );
+}
+
 QString DeployApplication::osName(OperatingSystem os) noexcept
 {
   assert(os != OperatingSystem::Unknown);
@@ -353,4 +807,29 @@ QString DeployApplication::osName(OperatingSystem os) noexcept
   return QString();
 }
 
+QStringList DeployApplication::targetFilePathListFromRequest(const DeployApplicationRequest & request) noexcept
+{
+  QStringList targetFilePathList;
+
+  targetFilePathList.append(request.targetFilePath);
+  for(const QString & targetFilePath : request.additionalTargetFilePathList){
+    if( !targetFilePathList.contains(targetFilePath) ){
+      targetFilePathList.append(targetFilePath);
+    }
+  }
+
+  return targetFilePathList;
+}
+
+QFileInfoList DeployApplication::toAbsoluteFileInfoList(const QStringList & filePathList) noexcept
+{
+  QFileInfoList fileInfoList;
+
+  for(const QString & filePath : filePathList){
+    fileInfoList.append( QFileInfo( QFileInfo(filePath).absoluteFilePath() ) );
+  }
+
+  return fileInfoList;
+}
+
 }} // namespace Mdt{ namespace DeployUtils{
@@ -33,11 +33,21 @@
 #include "QtPluginFile.h"
 #include "DestinationDirectoryStructure.h"
 #include "BinaryDependenciesResult.h"
+#include "BinaryDependenciesResultList.h"
+#include "ExecutableFileMetadataCache.h"
+#include "FileStatBackend.h"
+#include "LogLevel.h"
+#include "AbstractMessageSink.h"
+#include "LibraryLookupMissCache.h"
+#include "DeployManifest.h"
 #include "mdt_deployutilscore_export.h"
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <QFileInfo>
+#include <QSet>
 #include <memory>
+#include <optional>
 
 namespace Mdt{ namespace DeployUtils{
 
@@ -64,6 +74,17 @@ namespace Mdt{ namespace DeployUtils{
    * \sa BinaryDependencies
    * \sa CopySharedLibrariesTargetDependsOn
    *
+   * At the end of each deploy, a manifest of the deployed files
+   * is written to the destination directory.
+   * When the same targets are deployed again to the same destination,
+   * with the same request parameters:
+   * - if nothing changed, nothing is done
+   * - otherwise, only the files that changed are copied again
+   *
+   * If \a pruneStaleFiles is true, the files that are listed in the previous manifest,
+   * but that are no longer required, are removed.
+   * \sa DeployManifest
+   *
    * \todo document the diretctory structure
    */
   class MDT_DEPLOYUTILSCORE_EXPORT DeployApplication : public QObject
@@ -76,7 +97,47 @@ namespace Mdt{ namespace DeployUtils{
      */
     explicit DeployApplication(QObject *parent = nullptr);
 
+    /*! \brief Set a metadata cache
+     *
+     * \sa BinaryDependencies::setMetadataCache()
+     */
+    void setMetadataCache(const std::shared_ptr<ExecutableFileMetadataCache> & cache) noexcept
+    {
+      mMetadataCache = cache;
+    }
+
+    /*! \brief Set the backend used to stat files
+     *
+     * \sa BinaryDependencies::setFileStatBackend()
+     */
+    void setFileStatBackend(FileStatBackend backend) noexcept
+    {
+      mFileStatBackend = backend;
+    }
+
+    /*! \brief Set the log level
+     *
+     * \sa BinaryDependencies::setLogLevel()
+     */
+    void setLogLevel(LogLevel level) noexcept
+    {
+      mLogLevel = level;
+    }
+
+    /*! \brief Set a message sink
+     *
+     * \sa BinaryDependencies::setMessageSink()
+     */
+    void setMessageSink(const std::shared_ptr<AbstractMessageSink> & sink) noexcept
+    {
+      mMessageSink = sink;
+    }
+
     /*! \brief Deploy a application to a destination directory
+     *
+     * If \a request has additional targets,
+     * they are deployed to the same destination.
+     * All targets must be for the same platform.
      *
      * \pre request's \a targetFilePath must be specified
      * \pre request's \a destinationDirectoryPath must be specified
@@ -96,6 +157,16 @@ namespace Mdt{ namespace DeployUtils{
     DestinationDirectoryStructure
     destinationDirectoryStructureFromRuntimeAndLibraryDestination(const DeployApplicationRequest & request, OperatingSystem os) noexcept;
 
+    /*! \internal Get the key that represents given request in a deploy manifest
+     *
+     * Only the parameters that change the deployed files are part of the key.
+     * If the redistribution policy file changes, the key also changes.
+     *
+     * \sa DeployManifest::setRequestKey()
+     */
+    static
+    QString deployManifestRequestKey(const DeployApplicationRequest & request, const QStringList & targetFilePathList) noexcept;
+
    signals:
 
     void statusMessage(const QString & message) const;
@@ -106,29 +177,59 @@ namespace Mdt{ namespace DeployUtils{
 
     QString getMissingLibrariesListText(const BinaryDependenciesResult & result) const noexcept;
     void throwApplicationDependenciesNotSolvedError(const BinaryDependenciesResult & result) const;
+    void throwApplicationDependenciesNotSolvedError(const BinaryDependenciesResultList & resultList) const;
     void throwQtPluginsDependenciesNotSolvedError(const BinaryDependenciesResultList & resultList) const;
 
     void setupShLibDeployer(const DeployApplicationRequest & request);
     void makeDirectoryStructure(const DestinationDirectory & destination);
-    void installExecutable(const DeployApplicationRequest & request, const DestinationDirectoryStructure & destinationStructure);
+    void readPlatform(const QStringList & targetFilePathList);
+    void installExecutable(const QString & targetFilePath, const DeployApplicationRequest & request,
+                           const DestinationDirectoryStructure & destinationStructure);
 
     void installSharedLibraries(const BinaryDependenciesResultList & libraries);
 
-    QtPluginFileList getRequiredQtPlugins(const BinaryDependenciesResult & libraries, const DeployApplicationRequest & request);
+    QtPluginFileList getRequiredQtPlugins(const BinaryDependenciesResultList & libraries, const DeployApplicationRequest & request);
     BinaryDependenciesResultList findSharedLibrariesQtPluginsDependsOn(const QtPluginFileList & plugins);
 
     void installQtPlugins(const QtPluginFileList & plugins, const DestinationDirectory & destination, OverwriteBehavior overwriteBehavior);
 
     void writeQtConfFile(const DestinationDirectory & destination);
 
+    void writeArchive(const DeployApplicationRequest & request, const QStringList & targetFilePathList,
+                      const BinaryDependenciesResultList & libraries, const QtPluginFileList & qtPlugins,
+                      const DestinationDirectory & destination);
+
+    std::shared_ptr<const DeployManifest> readPreviousDeployManifest(const QString & manifestFilePath);
+    DeployManifest makeDeployManifest(const QString & requestKey,
+                                      const QStringList & targetFilePathList, const BinaryDependenciesResultList & libraries,
+                                      const QtPluginFileList & qtPlugins, const DestinationDirectory & destination,
+                                      const DeployManifest & previousManifest);
+    void addDeployedFileToManifest(DeployManifest & manifest, const QString & sourceFilePath,
+                                   const QString & destinationDirectoryPath, const DeployManifest & previousManifest);
+    void writeDeployManifest(const DeployManifest & manifest, const QString & manifestFilePath);
+    void pruneStaleFiles(const DeployManifest & previousManifest, const DeployManifest & manifest,
+                         const QString & manifestFilePath, bool remove);
+    std::optional< QSet<QString> > readFilesListedInOtherDeployManifests(const QString & manifestFilePath);
+    void emitLookupMissCacheSummary(const LibraryLookupMissCache & cache) const;
+
     static
     QString osName(OperatingSystem os) noexcept;
 
+    static
+    QStringList targetFilePathListFromRequest(const DeployApplicationRequest & request) noexcept;
+
+    static
+    QFileInfoList toAbsoluteFileInfoList(const QStringList & filePathList) noexcept;
+
     Platform mPlatform;
     QString mBinDirDestinationPath;
     QString mLibDirDestinationPath;
     std::shared_ptr<QtDistributionDirectory> mQtDistributionDirectory;
     std::shared_ptr<SharedLibrariesDeployer> mShLibDeployer;
+    std::shared_ptr<ExecutableFileMetadataCache> mMetadataCache;
+    FileStatBackend mFileStatBackend = FileStatBackend::Synchronous;
+    LogLevel mLogLevel = LogLevel::Debug;
+    std::shared_ptr<AbstractMessageSink> mMessageSink;
   };
 
 }} // namespace Mdt{ namespace DeployUtils{
@@ -36,14 +36,59 @@ namespace Mdt{ namespace DeployUtils{
   struct MDT_DEPLOYUTILSCORE_EXPORT DeployApplicationRequest
   {
     QString targetFilePath;
+
+    /*! \brief Other executables to deploy with targetFilePath
+     *
+     * They are deployed to the same destination, using the same options.
+     * The dependencies of all targets are discovered in one pass,
+     * so a library shared by several targets is inspected once.
+     */
+    QStringList additionalTargetFilePathList;
+
     QString destinationDirectoryPath;
     QStringList searchPrefixPathList;
     CompilerLocationRequest compilerLocation;
     OverwriteBehavior shLibOverwriteBehavior = OverwriteBehavior::Fail;
     bool removeRpath = false;
     QtPluginsSet qtPluginsSet;
+    QString redistributionPolicyFilePath;
     QString runtimeDestination = QLatin1String("bin");
     QString libraryDestination = QLatin1String("lib");
+
+    /*! \brief Do not use the manifest of a previous deploy
+     *
+     * All files are deployed again.
+     * This can be required if a library has been added
+     * to a directory of the search path.
+     *
+     * \sa DeployManifest
+     */
+    bool ignoreDeployManifest = false;
+
+    /*! \brief Remove files of a previous deploy that are no longer required
+     *
+     * Only files listed in the manifest of the previous deploy are removed.
+     */
+    bool pruneStaleFiles = false;
+
+    /*! \brief Directory of a deploy store to link the shared libraries from
+     *
+     * If empty, the shared libraries are copied.
+     *
+     * \sa DeployStore
+     */
+    QString deployStoreDirectoryPath;
+
+    /*! \brief Archive to deploy to, instead of the destination directory
+     *
+     * If not empty, nothing is written to the destination directory,
+     * its name is used as root directory in the archive.
+     * A .tar.zst (or .tzst) archive is compressed with zstd,
+     * otherwise a plain tar archive is written.
+     *
+     * \sa DestinationArchive
+     */
+    QString archiveFilePath;
   };
 
 }} // namespace Mdt{ namespace DeployUtils{
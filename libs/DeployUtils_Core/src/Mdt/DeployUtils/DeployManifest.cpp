@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "DeployManifest.h"
+#include <QDir>
+#include <QFile>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QLatin1String>
+#include <QLatin1Char>
+#include <QStringBuilder>
+#include <algorithm>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+namespace{
+
+  struct FileStamp
+  {
+    qint64 size = -1;
+    qint64 lastModified = -1;
+  };
+
+  FileStamp readFileStamp(const QString & filePath) noexcept
+  {
+    // Make sure to not get informations cached by a other QFileInfo
+    const QFileInfo fileInfo(filePath);
+
+    FileStamp stamp;
+    if( !fileInfo.isFile() ){
+      return stamp;
+    }
+    stamp.size = fileInfo.size();
+    stamp.lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    return stamp;
+  }
+
+} // namespace{
+
+void DeployManifest::setDestinationDirectoryPath(const QString & path) noexcept
+{
+  assert( QDir::isAbsolutePath(path) );
+
+  mDestinationDirectoryPath = QDir::cleanPath(path);
+}
+
+void DeployManifest::addEntry(const DeployManifestEntry & entry) noexcept
+{
+  assert( !entry.filePath.isEmpty() );
+
+  const auto it = mEntryIndexByFilePath.constFind(entry.filePath);
+  if( it != mEntryIndexByFilePath.constEnd() ){
+    mEntries[*it] = entry;
+    return;
+  }
+
+  mEntryIndexByFilePath.insert( entry.filePath, mEntries.size() );
+  mEntries.push_back(entry);
+}
+
+void DeployManifest::addDeployedFile(const QString & destinationFilePath, const QString & sourceFilePath,
+                                     const QStringList & rpath, const DeployManifest & previous,
+                                     FileHashCache *hashCache)
+{
+  assert( !mDestinationDirectoryPath.isEmpty() );
+  assert( QDir::isAbsolutePath(destinationFilePath) );
+
+  DeployManifestEntry entry;
+  entry.filePath = relativeFilePath(destinationFilePath);
+
+  if( !sourceFilePath.isEmpty() ){
+    const FileStamp sourceStamp = readFileStamp(sourceFilePath);
+    entry.sourceFilePath = QFileInfo(sourceFilePath).absoluteFilePath();
+    entry.sourceSize = sourceStamp.size;
+    entry.sourceLastModified = sourceStamp.lastModified;
+  }
+
+  const FileStamp stamp = readFileStamp(destinationFilePath);
+  entry.size = stamp.size;
+  entry.lastModified = stamp.lastModified;
+  entry.rpath = rpath;
+
+  /*
+   * Hashing is the expensive part,
+   * so reuse the previous hash if the deployed file was not touched,
+   * or the one computed while it was copied
+   */
+  const auto previousEntry = previous.findEntry(entry.filePath);
+  if( previousEntry.has_value() && (previousEntry->size == entry.size) && (previousEntry->lastModified == entry.lastModified) ){
+    entry.sha256 = previousEntry->sha256;
+  }else if(hashCache != nullptr){
+    entry.sha256 = hashCache->findSha256(destinationFilePath);
+  }
+  if( entry.sha256.isEmpty() ){
+    entry.sha256 = fileSha256(destinationFilePath);
+  }
+
+  addEntry(entry);
+}
+
+std::optional<DeployManifestEntry> DeployManifest::findEntry(const QString & filePath) const noexcept
+{
+  const auto it = mEntryIndexByFilePath.constFind(filePath);
+  if( it == mEntryIndexByFilePath.constEnd() ){
+    return {};
+  }
+
+  return mEntries[*it];
+}
+
+bool DeployManifest::isUpToDate() const
+{
+  assert( !mDestinationDirectoryPath.isEmpty() );
+
+  if( isEmpty() ){
+    return false;
+  }
+
+  const auto isUpToDate = [this](const DeployManifestEntry & entry){
+    return entryIsUpToDate(entry);
+  };
+
+  return std::all_of(mEntries.cbegin(), mEntries.cend(), isUpToDate);
+}
+
+bool DeployManifest::fileIsUpToDate(const QFileInfo & sourceFile, const QString & destinationFilePath) const
+{
+  assert( !mDestinationDirectoryPath.isEmpty() );
+
+  const auto entry = findEntry( relativeFilePath(destinationFilePath) );
+  if( !entry.has_value() ){
+    return false;
+  }
+  if( entry->sourceFilePath != sourceFile.absoluteFilePath() ){
+    return false;
+  }
+
+  return entryIsUpToDate(*entry);
+}
+
+bool DeployManifest::entryIsUpToDate(const DeployManifestEntry & entry) const
+{
+  assert( !mDestinationDirectoryPath.isEmpty() );
+
+  if( !entry.isGenerated() && !sourceIsUnchanged(entry) ){
+    return false;
+  }
+
+  return destinationIsUnchanged(entry);
+}
+
+QString DeployManifest::absoluteFilePath(const DeployManifestEntry & entry) const noexcept
+{
+  assert( !mDestinationDirectoryPath.isEmpty() );
+
+  return QDir::cleanPath( mDestinationDirectoryPath % QLatin1Char('/') % entry.filePath );
+}
+
+QString DeployManifest::relativeFilePath(const QString & absoluteFilePath) const noexcept
+{
+  assert( !mDestinationDirectoryPath.isEmpty() );
+
+  return QDir(mDestinationDirectoryPath).relativeFilePath(absoluteFilePath);
+}
+
+QString DeployManifest::manifestsDirectoryName() noexcept
+{
+  return QLatin1String(".mdtdeployutils");
+}
+
+QString DeployManifest::manifestFilePath(const QString & destinationDirectoryPath, const QStringList & targetFilePathList) noexcept
+{
+  assert( QDir::isAbsolutePath(destinationDirectoryPath) );
+  assert( !targetFilePathList.isEmpty() );
+
+  /*
+   * Use the file names, not the paths,
+   * so that deploying the same application from a other build directory
+   * finds its manifest (and the files it can prune)
+   */
+  QStringList targetFileNames;
+  for(const QString & targetFilePath : targetFilePathList){
+    targetFileNames.append( QFileInfo(targetFilePath).fileName() );
+  }
+  targetFileNames.sort();
+  targetFileNames.removeDuplicates();
+
+  const QByteArray key = targetFileNames.join( QLatin1Char('|') ).toUtf8();
+  const QString fileName = QString::fromLatin1( QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex() )
+                         % QLatin1String(".json");
+
+  return QDir::cleanPath( destinationDirectoryPath % QLatin1Char('/') % manifestsDirectoryName() % QLatin1Char('/') % fileName );
+}
+
+QString DeployManifest::fileSha256(const QString & filePath) noexcept
+{
+  QFile file(filePath);
+  if( !file.open(QIODevice::ReadOnly) ){
+    return QString();
+  }
+
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  if( !hash.addData(&file) ){
+    return QString();
+  }
+
+  return QString::fromLatin1( hash.result().toHex() );
+}
+
+bool DeployManifest::sourceIsUnchanged(const DeployManifestEntry & entry) const noexcept
+{
+  assert( !entry.isGenerated() );
+
+  const FileStamp stamp = readFileStamp(entry.sourceFilePath);
+  if(stamp.size < 0){
+    return false;
+  }
+
+  return (stamp.size == entry.sourceSize) && (stamp.lastModified == entry.sourceLastModified);
+}
+
+bool DeployManifest::destinationIsUnchanged(const DeployManifestEntry & entry) const noexcept
+{
+  const QString filePath = absoluteFilePath(entry);
+
+  const FileStamp stamp = readFileStamp(filePath);
+  if( (stamp.size < 0) || (stamp.size != entry.size) ){
+    return false;
+  }
+  if(stamp.lastModified == entry.lastModified){
+    return true;
+  }
+
+  // The file was touched, maybe its content is still the same
+  if( entry.sha256.isEmpty() ){
+    return false;
+  }
+
+  return fileSha256(filePath) == entry.sha256;
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
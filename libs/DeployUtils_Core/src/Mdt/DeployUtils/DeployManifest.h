@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_DEPLOY_MANIFEST_H
+#define MDT_DEPLOY_UTILS_DEPLOY_MANIFEST_H
+
+#include "FileHashCache.h"
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <QStringList>
+#include <QFileInfo>
+#include <QHash>
+#include <QtGlobal>
+#include <vector>
+#include <optional>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief A file listed in a DeployManifest
+   */
+  struct MDT_DEPLOYUTILSCORE_EXPORT DeployManifestEntry
+  {
+    /*! \brief Path of the deployed file
+     *
+     * This path is relative to the destination directory,
+     * and uses / as separator.
+     */
+    QString filePath;
+
+    /*! \brief Absolute path of the file that was copied
+     *
+     * Is empty for files generated while deploying (like qt.conf)
+     */
+    QString sourceFilePath;
+
+    qint64 sourceSize = -1;
+    qint64 sourceLastModified = -1;
+
+    qint64 size = -1;
+    qint64 lastModified = -1;
+
+    /*! \brief SHA-256 of the deployed file, as hexadecimal string
+     */
+    QString sha256;
+
+    /*! \brief RPATH of the deployed file
+     *
+     * Is empty for files that have no RPATH,
+     * or on platforms that do not support RPATH.
+     */
+    QStringList rpath;
+
+    /*! \brief Check if this entry is a generated file
+     */
+    bool isGenerated() const noexcept
+    {
+      return sourceFilePath.isEmpty();
+    }
+  };
+
+  /*! \brief List of the files deployed by a DeployApplication request
+   *
+   * A manifest is written to the destination directory
+   * at the end of each deploy.
+   * It is used on next deploy of the same targets
+   * to the same destination to:
+   * - do nothing if no source, no deployed file and no request parameter changed
+   * - only copy the files that changed
+   * - find the files that are no longer required
+   *
+   * A source file is considered unchanged
+   * if its size and its last modification time did not change.
+   * A deployed file is considered unchanged if its size did not change
+   *  and, either its last modification time did not change,
+   *  or its content still has the same SHA-256.
+   *
+   * Note that the dependencies are not searched again
+   * for a up to date destination.
+   * If a library has been added to a directory
+   * that comes before the one it was found in the search path,
+   * the manifest must be ignored to take it into account.
+   *
+   * \sa DeployManifestReader
+   * \sa DeployManifestWriter
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT DeployManifest
+  {
+   public:
+
+    /*! \brief Set the destination directory path
+     *
+     * The entries are relative to this directory.
+     * It is not stored in the manifest file,
+     * so a deployed directory can be moved.
+     *
+     * \pre \a path must be a absolute path
+     * \sa DeployManifestReader::readFile()
+     */
+    void setDestinationDirectoryPath(const QString & path) noexcept;
+
+    /*! \brief Get the destination directory path
+     */
+    const QString & destinationDirectoryPath() const noexcept
+    {
+      return mDestinationDirectoryPath;
+    }
+
+    /*! \brief Set the request key
+     *
+     * The key is a text that represents the parameters
+     * of the deploy request this manifest was made for
+     * (destinations, search paths, rpath handling, ..).
+     *
+     * \sa DeployApplication::deployManifestRequestKey()
+     */
+    void setRequestKey(const QString & key) noexcept
+    {
+      mRequestKey = key;
+    }
+
+    /*! \brief Get the request key
+     */
+    const QString & requestKey() const noexcept
+    {
+      return mRequestKey;
+    }
+
+    /*! \brief Add a entry
+     *
+     * If a entry exists for the same file path, it is replaced.
+     *
+     * \pre \a entry 's file path must not be empty
+     */
+    void addEntry(const DeployManifestEntry & entry) noexcept;
+
+    /*! \brief Add a deployed file
+     *
+     * The stamps of the source and of the deployed file are read,
+     * and the SHA-256 of the deployed file is computed,
+     * except if \a previous contains a entry for this file
+     * that is still up to date,
+     * or if \a hashCache knows it
+     * (for example because it was computed while copying the file).
+     *
+     * \a sourceFilePath is empty for a generated file.
+     *
+     * \pre the destination directory path must have been set
+     * \pre \a destinationFilePath must be a absolute path to a existing file
+     *   in the destination directory
+     */
+    void addDeployedFile(const QString & destinationFilePath, const QString & sourceFilePath,
+                         const QStringList & rpath, const DeployManifest & previous,
+                         FileHashCache *hashCache = nullptr);
+
+    /*! \brief Find the entry for given file path
+     *
+     * \a filePath is relative to the destination directory
+     */
+    std::optional<DeployManifestEntry> findEntry(const QString & filePath) const noexcept;
+
+    /*! \brief Get the entries of this manifest
+     */
+    const std::vector<DeployManifestEntry> & entries() const noexcept
+    {
+      return mEntries;
+    }
+
+    /*! \brief Get the count of entries of this manifest
+     */
+    int entriesCount() const noexcept
+    {
+      return static_cast<int>( mEntries.size() );
+    }
+
+    /*! \brief Check if this manifest is empty
+     */
+    bool isEmpty() const noexcept
+    {
+      return mEntries.empty();
+    }
+
+    /*! \brief Check if all files in this manifest are up to date
+     *
+     * Returns false for a empty manifest.
+     *
+     * \pre the destination directory path must have been set
+     */
+    bool isUpToDate() const;
+
+    /*! \brief Check if \a destinationFilePath is a up to date copy of \a sourceFile
+     *
+     * \pre the destination directory path must have been set
+     */
+    bool fileIsUpToDate(const QFileInfo & sourceFile, const QString & destinationFilePath) const;
+
+    /*! \brief Check if given entry is up to date
+     *
+     * \pre the destination directory path must have been set
+     */
+    bool entryIsUpToDate(const DeployManifestEntry & entry) const;
+
+    /*! \brief Get the absolute path of given entry
+     *
+     * \pre the destination directory path must have been set
+     */
+    QString absoluteFilePath(const DeployManifestEntry & entry) const noexcept;
+
+    /*! \brief Get the path relative to the destination directory of \a absoluteFilePath
+     *
+     * \pre the destination directory path must have been set
+     */
+    QString relativeFilePath(const QString & absoluteFilePath) const noexcept;
+
+    /*! \brief Get the directory, relative to a destination, where manifests are stored
+     */
+    static
+    QString manifestsDirectoryName() noexcept;
+
+    /*! \brief Get the manifest file path for given targets and destination
+     *
+     * Each set of targets has its own manifest,
+     * so deploying different applications to the same destination
+     * does not invalidate their manifests.
+     *
+     * \pre \a destinationDirectoryPath must be a absolute path
+     * \pre \a targetFilePathList must not be empty
+     */
+    static
+    QString manifestFilePath(const QString & destinationDirectoryPath, const QStringList & targetFilePathList) noexcept;
+
+    /*! \brief Compute the SHA-256 of given file
+     *
+     * Returns a empty string if the file could not be read
+     */
+    static
+    QString fileSha256(const QString & filePath) noexcept;
+
+   private:
+
+    bool sourceIsUnchanged(const DeployManifestEntry & entry) const noexcept;
+    bool destinationIsUnchanged(const DeployManifestEntry & entry) const noexcept;
+
+    QString mDestinationDirectoryPath;
+    QString mRequestKey;
+    std::vector<DeployManifestEntry> mEntries;
+    QHash<QString, std::size_t> mEntryIndexByFilePath;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_DEPLOY_MANIFEST_H
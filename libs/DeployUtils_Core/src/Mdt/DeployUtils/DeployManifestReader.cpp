@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "DeployManifestReader.h"
+#include "DeployManifestWriter.h"
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonValue>
+#include <QVariant>
+#include <QDir>
+#include <QLatin1String>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+DeployManifestReader::DeployManifestReader(QObject *parent) noexcept
+ : QObject(parent)
+{
+}
+
+DeployManifest DeployManifestReader::readFile(const QFileInfo & filePath)
+{
+  assert( !filePath.filePath().isEmpty() );
+  assert( filePath.isAbsolute() );
+  assert( filePath.isFile() );
+
+  const QString path = filePath.absoluteFilePath();
+
+  emit verboseMessage(
+    tr("reading deploy manifest %1")
+    .arg(path)
+  );
+
+  QFile file(path);
+  if( !file.open(QIODevice::ReadOnly) ){
+    const QString msg = tr("reading %1 failed: %2")
+                        .arg( path, file.errorString() );
+    throw ReadDeployManifestError(msg);
+  }
+
+  QJsonParseError parseError;
+  const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+  if( document.isNull() ){
+    const QString msg = tr("reading %1 failed: %2")
+                        .arg( path, parseError.errorString() );
+    throw ReadDeployManifestError(msg);
+  }
+
+  const QJsonObject root = document.object();
+  if( root.value( QLatin1String("version") ).toInt() != DeployManifestWriter::formatVersion() ){
+    const QString msg = tr("reading %1 failed: unsupported manifest version")
+                        .arg(path);
+    throw ReadDeployManifestError(msg);
+  }
+
+  DeployManifest manifest;
+  // The manifest is in <destination>/<manifests directory>/
+  manifest.setDestinationDirectoryPath( QDir::cleanPath( filePath.absolutePath() + QLatin1String("/..") ) );
+  manifest.setRequestKey( root.value( QLatin1String("request") ).toString() );
+
+  const QJsonArray files = root.value( QLatin1String("files") ).toArray();
+  for(const QJsonValue & value : files){
+    const QJsonObject file = value.toObject();
+    DeployManifestEntry entry;
+    entry.filePath = file.value( QLatin1String("path") ).toString();
+    if( entry.filePath.isEmpty() ){
+      const QString msg = tr("reading %1 failed: a file entry has no path")
+                          .arg(path);
+      throw ReadDeployManifestError(msg);
+    }
+    entry.sourceFilePath = file.value( QLatin1String("source") ).toString();
+    entry.sourceSize = file.value( QLatin1String("sourceSize") ).toVariant().toLongLong();
+    entry.sourceLastModified = file.value( QLatin1String("sourceLastModified") ).toVariant().toLongLong();
+    entry.size = file.value( QLatin1String("size") ).toVariant().toLongLong();
+    entry.lastModified = file.value( QLatin1String("lastModified") ).toVariant().toLongLong();
+    entry.sha256 = file.value( QLatin1String("sha256") ).toString();
+    entry.rpath = file.value( QLatin1String("rpath") ).toVariant().toStringList();
+    manifest.addEntry(entry);
+  }
+
+  return manifest;
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_DEPLOY_MANIFEST_READER_H
+#define MDT_DEPLOY_UTILS_DEPLOY_MANIFEST_READER_H
+
+#include "DeployManifest.h"
+#include "ReadDeployManifestError.h"
+#include "mdt_deployutilscore_export.h"
+#include <QObject>
+#include <QString>
+#include <QFileInfo>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Helper to read a DeployManifest
+   *
+   * \sa DeployManifestWriter
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT DeployManifestReader : public QObject
+  {
+    Q_OBJECT
+
+   public:
+
+    /*! \brief Constructor
+     */
+    explicit DeployManifestReader(QObject *parent = nullptr) noexcept;
+
+    /*! \brief Read from given file
+     *
+     * The destination directory of the returned manifest
+     * is deduced from the location of \a filePath .
+     *
+     * \pre \a filePath must be a absolute path to a file
+     * \exception ReadDeployManifestError
+     * \sa DeployManifest::manifestFilePath()
+     */
+    DeployManifest readFile(const QFileInfo & filePath);
+
+   signals:
+
+    void verboseMessage(const QString & message) const;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_DEPLOY_MANIFEST_READER_H
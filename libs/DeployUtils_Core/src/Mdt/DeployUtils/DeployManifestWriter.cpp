@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "DeployManifestWriter.h"
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDir>
+#include <QFileInfo>
+#include <QLatin1String>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+DeployManifestWriter::DeployManifestWriter(QObject *parent) noexcept
+ : QObject(parent)
+{
+}
+
+void DeployManifestWriter::writeFile(const DeployManifest & manifest, const QString & filePath)
+{
+  assert( QDir::isAbsolutePath(filePath) );
+
+  emit verboseMessage(
+    tr("writing deploy manifest %1")
+    .arg(filePath)
+  );
+
+  QJsonArray files;
+  for(const DeployManifestEntry & entry : manifest.entries()){
+    QJsonObject file;
+    file.insert( QLatin1String("path"), entry.filePath );
+    if( !entry.isGenerated() ){
+      file.insert( QLatin1String("source"), entry.sourceFilePath );
+      file.insert( QLatin1String("sourceSize"), entry.sourceSize );
+      file.insert( QLatin1String("sourceLastModified"), entry.sourceLastModified );
+    }
+    file.insert( QLatin1String("size"), entry.size );
+    file.insert( QLatin1String("lastModified"), entry.lastModified );
+    file.insert( QLatin1String("sha256"), entry.sha256 );
+    if( !entry.rpath.isEmpty() ){
+      file.insert( QLatin1String("rpath"), QJsonArray::fromStringList(entry.rpath) );
+    }
+    files.append(file);
+  }
+
+  QJsonObject root;
+  root.insert( QLatin1String("version"), formatVersion() );
+  root.insert( QLatin1String("request"), manifest.requestKey() );
+  root.insert( QLatin1String("files"), files );
+
+  const QString directoryPath = QFileInfo(filePath).absolutePath();
+  if( !QDir().mkpath(directoryPath) ){
+    const QString msg = tr("writing %1 failed: could not create directory %2")
+                        .arg(filePath, directoryPath);
+    throw WriteDeployManifestError(msg);
+  }
+
+  QSaveFile file(filePath);
+  if( !file.open(QIODevice::WriteOnly) ){
+    const QString msg = tr("writing %1 failed: %2")
+                        .arg( filePath, file.errorString() );
+    throw WriteDeployManifestError(msg);
+  }
+
+  file.write( QJsonDocument(root).toJson(QJsonDocument::Indented) );
+
+  if( !file.commit() ){
+    const QString msg = tr("writing %1 failed: %2")
+                        .arg( filePath, file.errorString() );
+    throw WriteDeployManifestError(msg);
+  }
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_DEPLOY_MANIFEST_WRITER_H
+#define MDT_DEPLOY_UTILS_DEPLOY_MANIFEST_WRITER_H
+
+#include "DeployManifest.h"
+#include "WriteDeployManifestError.h"
+#include "mdt_deployutilscore_export.h"
+#include <QObject>
+#include <QString>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Helper to write a DeployManifest
+   *
+   * The manifest is written as a JSON document.
+   *
+   * \sa DeployManifestReader
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT DeployManifestWriter : public QObject
+  {
+    Q_OBJECT
+
+   public:
+
+    /*! \brief Constructor
+     */
+    explicit DeployManifestWriter(QObject *parent = nullptr) noexcept;
+
+    /*! \brief Write \a manifest to given \a filePath
+     *
+     * Missing parent directories are created.
+     * The file is first written to a temporary file,
+     * then renamed, so a interrupted write does not leave
+     * a truncated manifest.
+     *
+     * \pre \a filePath must be a absolute path
+     * \exception WriteDeployManifestError
+     */
+    void writeFile(const DeployManifest & manifest, const QString & filePath);
+
+    /*! \brief Get the version of the manifest format
+     */
+    static constexpr
+    int formatVersion() noexcept
+    {
+      return 1;
+    }
+
+   signals:
+
+    void verboseMessage(const QString & message) const;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_DEPLOY_MANIFEST_WRITER_H
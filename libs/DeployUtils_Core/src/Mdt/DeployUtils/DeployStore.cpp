@@ -0,0 +1,310 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "DeployStore.h"
+#include "DeployManifest.h"
+#include "FileCopier.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QLatin1String>
+#include <QLatin1Char>
+#include <QStringBuilder>
+#include <cassert>
+
+#ifdef Q_OS_LINUX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <linux/fs.h>
+#endif // #ifdef Q_OS_LINUX
+
+namespace Mdt{ namespace DeployUtils{
+
+DeployStore::DeployStore(const QString & rootDirectoryPath) noexcept
+ : mRootDirectoryPath( QDir::cleanPath(rootDirectoryPath) )
+{
+  assert( QDir::isAbsolutePath(rootDirectoryPath) );
+}
+
+QString DeployStore::objectFilePath(const QString & sha256) const noexcept
+{
+  assert( sha256.length() == 64 );
+
+  return mRootDirectoryPath % QLatin1String("/objects/") % sha256.left(2) % QLatin1Char('/') % sha256;
+}
+
+QString DeployStore::addFile(const QString & filePath)
+{
+  assert( QDir::isAbsolutePath(filePath) );
+
+  const QString sha256 = fileSha256(filePath);
+  const QString storeFilePath = objectFilePath(sha256);
+
+  if( QFileInfo::exists(storeFilePath) ){
+    ++mReusedFileCount;
+    return sha256;
+  }
+
+  createObjectFile(filePath, storeFilePath);
+  ++mAddedFileCount;
+
+  return sha256;
+}
+
+DeployStoreLinkType DeployStore::linkFile(const QString & sha256, const QString & destinationFilePath)
+{
+  assert( QDir::isAbsolutePath(destinationFilePath) );
+  assert( !QFileInfo::exists(destinationFilePath) );
+
+  const QString storeFilePath = objectFilePath(sha256);
+  assert( QFileInfo::exists(storeFilePath) );
+
+  if( reflinkFile(storeFilePath, destinationFilePath) ){
+    return DeployStoreLinkType::Reflink;
+  }
+  if( hardLinkFile(storeFilePath, destinationFilePath) ){
+    return DeployStoreLinkType::HardLink;
+  }
+
+  QFile storeFile(storeFilePath);
+  if( !storeFile.copy(destinationFilePath) ){
+    const QString msg = QCoreApplication::translate("Mdt::DeployUtils::DeployStore",
+                                                    "Could not copy '%1' from the deploy store to '%2': %3")
+                        .arg( storeFilePath, destinationFilePath, storeFile.errorString() );
+    throw FileCopyError(msg);
+  }
+
+  return DeployStoreLinkType::Copy;
+}
+
+DeployStoreLinkType DeployStore::deployFile(const QString & sourceFilePath, const QString & destinationFilePath)
+{
+  const QString sha256 = addFile(sourceFilePath);
+
+  return linkFile(sha256, destinationFilePath);
+}
+
+QString DeployStore::findPatchedFile(const QString & sourceSha256, const QString & patchKey) const noexcept
+{
+  QFile indexFile( patchedFileIndexPath(sourceSha256, patchKey) );
+  if( !indexFile.open(QIODevice::ReadOnly) ){
+    return QString();
+  }
+
+  const QString sha256 = QString::fromLatin1( indexFile.read(64) );
+  if( sha256.length() != 64 ){
+    return QString();
+  }
+  // The store file could have been removed, for example by hand
+  if( !QFileInfo::exists( objectFilePath(sha256) ) ){
+    return QString();
+  }
+
+  return sha256;
+}
+
+QString DeployStore::addPatchedFile(const QString & sourceSha256, const QString & patchKey, const QString & patchedFilePath)
+{
+  assert( QFileInfo::exists(patchedFilePath) );
+
+  /*
+   * The patched file is a temporary file:
+   * its path can be reused later for a other content,
+   * maybe with the same size and time stamp
+   */
+  mHashedFiles.remove(patchedFilePath);
+  const QString sha256 = addFile(patchedFilePath);
+  mHashedFiles.remove(patchedFilePath);
+
+  const QString indexFilePath = patchedFileIndexPath(sourceSha256, patchKey);
+  FileCopier::createDirectory( QFileInfo(indexFilePath).absolutePath() );
+
+  const QString newIndexFilePath = temporaryFilePath(indexFilePath);
+  QFile indexFile(newIndexFilePath);
+  if( !indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate) || (indexFile.write( sha256.toLatin1() ) != 64) || !indexFile.flush() ){
+    const QString msg = QCoreApplication::translate("Mdt::DeployUtils::DeployStore",
+                                                    "Could not add '%1' to the deploy store: %2")
+                        .arg( patchedFilePath, indexFile.errorString() );
+    indexFile.remove();
+    throw FileCopyError(msg);
+  }
+  indexFile.close();
+  replaceFile(newIndexFilePath, indexFilePath);
+
+  return sha256;
+}
+
+DeployStoreLinkType DeployStore::relinkFile(const QString & sha256, const QString & filePath)
+{
+  assert( QDir::isAbsolutePath(filePath) );
+  assert( QFileInfo::exists(filePath) );
+
+  const QString linkFilePath = temporaryFilePath(filePath);
+  const DeployStoreLinkType linkType = linkFile(sha256, linkFilePath);
+  replaceFile(linkFilePath, filePath);
+
+  return linkType;
+}
+
+void DeployStore::removeUnusedFile(const QString & sha256) noexcept
+{
+#ifdef Q_OS_LINUX
+  const QByteArray storeFilePath = QFile::encodeName( objectFilePath(sha256) );
+
+  struct stat status;
+  if( ::stat(storeFilePath.constData(), &status) != 0 ){
+    return;
+  }
+  if(status.st_nlink == 1){
+    ::unlink( storeFilePath.constData() );
+  }
+#else
+  Q_UNUSED(sha256)
+#endif // #ifdef Q_OS_LINUX
+}
+
+QString DeployStore::patchedFileIndexPath(const QString & sourceSha256, const QString & patchKey) const noexcept
+{
+  assert( sourceSha256.length() == 64 );
+
+  const QByteArray patchKeyHash = QCryptographicHash::hash(patchKey.toUtf8(), QCryptographicHash::Sha256).toHex();
+
+  return mRootDirectoryPath % QLatin1String("/patched/") % sourceSha256.left(2) % QLatin1Char('/')
+       % sourceSha256 % QLatin1Char('-') % QString::fromLatin1(patchKeyHash);
+}
+
+QString DeployStore::fileSha256(const QString & filePath)
+{
+  const QFileInfo fileInfo(filePath);
+  const qint64 size = fileInfo.size();
+  const qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+  const auto it = mHashedFiles.constFind(filePath);
+  if( (it != mHashedFiles.cend()) && (it->size == size) && (it->lastModified == lastModified) ){
+    return it->sha256;
+  }
+
+  HashedFile hashedFile;
+  hashedFile.size = size;
+  hashedFile.lastModified = lastModified;
+  hashedFile.sha256 = DeployManifest::fileSha256(filePath);
+  if( hashedFile.sha256.isEmpty() ){
+    const QString msg = QCoreApplication::translate("Mdt::DeployUtils::DeployStore",
+                                                    "Could not read '%1' to add it to the deploy store")
+                        .arg(filePath);
+    throw FileCopyError(msg);
+  }
+  mHashedFiles.insert(filePath, hashedFile);
+
+  return hashedFile.sha256;
+}
+
+void DeployStore::createObjectFile(const QString & filePath, const QString & storeFilePath)
+{
+  FileCopier::createDirectory( QFileInfo(storeFilePath).absolutePath() );
+
+  /*
+   * A other process could add the same content at the same time.
+   * Writing to a temporary file first
+   * makes sure nobody links to a incomplete file.
+   */
+  const QString copyFilePath = temporaryFilePath(storeFilePath);
+  QFile file(filePath);
+  if( !file.copy(copyFilePath) ){
+    const QString msg = QCoreApplication::translate("Mdt::DeployUtils::DeployStore",
+                                                    "Could not add '%1' to the deploy store: %2")
+                        .arg( filePath, file.errorString() );
+    throw FileCopyError(msg);
+  }
+
+  if( QFileInfo::exists(storeFilePath) ){
+    QFile::remove(copyFilePath);
+    return;
+  }
+  replaceFile(copyFilePath, storeFilePath);
+}
+
+bool DeployStore::reflinkFile(const QString & sourceFilePath, const QString & destinationFilePath) noexcept
+{
+#if defined(Q_OS_LINUX) && defined(FICLONE)
+  const int sourceFd = ::open(QFile::encodeName(sourceFilePath).constData(), O_RDONLY | O_CLOEXEC);
+  if(sourceFd < 0){
+    return false;
+  }
+
+  struct stat status;
+  if( ::fstat(sourceFd, &status) != 0 ){
+    ::close(sourceFd);
+    return false;
+  }
+
+  const QByteArray destination = QFile::encodeName(destinationFilePath);
+  const int destinationFd = ::open(destination.constData(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, status.st_mode & 0777);
+  if(destinationFd < 0){
+    ::close(sourceFd);
+    return false;
+  }
+
+  const bool ok = ( ::ioctl(destinationFd, FICLONE, sourceFd) == 0 );
+
+  ::close(destinationFd);
+  ::close(sourceFd);
+  if(!ok){
+    ::unlink( destination.constData() );
+  }
+
+  return ok;
+#else
+  Q_UNUSED(sourceFilePath)
+  Q_UNUSED(destinationFilePath)
+  return false;
+#endif // #if defined(Q_OS_LINUX) && defined(FICLONE)
+}
+
+bool DeployStore::hardLinkFile(const QString & sourceFilePath, const QString & destinationFilePath) noexcept
+{
+#ifdef Q_OS_LINUX
+  return ::link( QFile::encodeName(sourceFilePath).constData(), QFile::encodeName(destinationFilePath).constData() ) == 0;
+#else
+  Q_UNUSED(sourceFilePath)
+  Q_UNUSED(destinationFilePath)
+  return false;
+#endif // #ifdef Q_OS_LINUX
+}
+
+QString DeployStore::temporaryFilePath(const QString & filePath) noexcept
+{
+  return filePath % QLatin1String(".tmp-") % QString::number( QCoreApplication::applicationPid() );
+}
+
+void DeployStore::replaceFile(const QString & newFilePath, const QString & filePath)
+{
+#ifdef Q_OS_LINUX
+  const bool ok = ( ::rename( QFile::encodeName(newFilePath).constData(), QFile::encodeName(filePath).constData() ) == 0 );
+#else
+  QFile::remove(filePath);
+  const bool ok = QFile::rename(newFilePath, filePath);
+#endif // #ifdef Q_OS_LINUX
+
+  if(!ok){
+    QFile::remove(newFilePath);
+    const QString msg = QCoreApplication::translate("Mdt::DeployUtils::DeployStore",
+                                                    "Could not replace '%1'")
+                        .arg(filePath);
+    throw FileCopyError(msg);
+  }
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_DEPLOY_STORE_H
+#define MDT_DEPLOY_UTILS_DEPLOY_STORE_H
+
+#include "FileCopyError.h"
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <QHash>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief How a file of a DeployStore has been placed to its destination
+   */
+  enum class DeployStoreLinkType
+  {
+    Reflink,  /*!< The destination shares the blocks of the store file, but is a distinct file (copy-on-write) */
+    HardLink, /*!< The destination is a other name of the store file */
+    Copy      /*!< The destination is a full copy of the store file */
+  };
+
+  /*! \brief Content-addressed store of deployed files
+   *
+   * When the same libraries are deployed to many destinations
+   * (for example one per product variant or per test bundle),
+   * copying each of them to each destination
+   * costs disk space and time.
+   *
+   * A deploy store keeps a single copy of each file content,
+   * named by its SHA-256, in a root directory.
+   * Each destination then gets a link to this copy:
+   * - a reflink if the file system supports it (Btrfs, XFS, ...)
+   * - otherwise a hard link, if the store and the destination are on the same file system
+   * - otherwise a plain copy
+   *
+   * \warning A hard linked destination is a other name of the store file.
+   * Changing it in place (for example strip, a other tool that changes its RPATH,
+   * or a sed on the deployed file) also changes the store file,
+   * and silently changes every other destination that shares it.
+   * Such a destination must be replaced, not changed in place
+   * (see FileCopier::replaceFileContent()).
+   *
+   * To deploy a changed variant of a file (for example with a other RPATH),
+   * change it once, outside the destination, and add it with addPatchedFile():
+   * the changed content becomes a other file in the store,
+   * that is found again by findPatchedFile() from the content of the unchanged file
+   * and a key that describes the change.
+   * Each destination is then linked to it with relinkFile(),
+   * so the change is only done once per store.
+   *
+   * A store can be shared by several processes:
+   * a file is first written to a temporary file,
+   * then renamed to its final name.
+   *
+   * A store is not thread safe.
+   *
+   * \note Reflinks and hard links are only supported on Linux for now.
+   *  On other platforms, files are copied.
+   * \sa FileCopier::setDeployStore()
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT DeployStore
+  {
+   public:
+
+    /*! \brief Construct a store in \a rootDirectoryPath
+     *
+     * The root directory is created when the first file is added.
+     *
+     * \pre \a rootDirectoryPath must be a absolute path
+     */
+    explicit DeployStore(const QString & rootDirectoryPath) noexcept;
+
+    /*! \brief Get the root directory path
+     */
+    const QString & rootDirectoryPath() const noexcept
+    {
+      return mRootDirectoryPath;
+    }
+
+    /*! \brief Get the path of the store file that has the content \a sha256
+     *
+     * \pre \a sha256 must be a SHA-256 as hexadecimal string
+     */
+    QString objectFilePath(const QString & sha256) const noexcept;
+
+    /*! \brief Add the content of \a filePath to this store
+     *
+     * Returns the SHA-256 of the content.
+     * If this content is allready in this store, nothing is written.
+     *
+     * The SHA-256 of a file is only computed once per store instance,
+     * as long as its size and last modification time do not change.
+     *
+     * \pre \a filePath must be a absolute path to a existing file
+     * \exception FileCopyError
+     */
+    QString addFile(const QString & filePath);
+
+    /*! \brief Create \a destinationFilePath from the store file that has the content \a sha256
+     *
+     * \pre \a sha256 must be in this store
+     * \pre \a destinationFilePath must not exist
+     * \exception FileCopyError
+     */
+    DeployStoreLinkType linkFile(const QString & sha256, const QString & destinationFilePath);
+
+    /*! \brief Deploy \a sourceFilePath to \a destinationFilePath through this store
+     *
+     * Adds the content of \a sourceFilePath to this store,
+     * then creates \a destinationFilePath from it.
+     *
+     * \pre \a sourceFilePath must be a absolute path to a existing file
+     * \pre \a destinationFilePath must not exist
+     * \exception FileCopyError
+     * \sa addFile()
+     * \sa linkFile()
+     */
+    DeployStoreLinkType deployFile(const QString & sourceFilePath, const QString & destinationFilePath);
+
+    /*! \brief Find the changed variant of the content \a sourceSha256
+     *
+     * Returns the SHA-256 of the content that has been added
+     * with addPatchedFile() for \a sourceSha256 and \a patchKey ,
+     * or a empty string if there is none.
+     *
+     * \pre \a sourceSha256 must be a SHA-256 as hexadecimal string
+     * \sa addPatchedFile()
+     */
+    QString findPatchedFile(const QString & sourceSha256, const QString & patchKey) const noexcept;
+
+    /*! \brief Add the changed variant \a patchedFilePath of the content \a sourceSha256
+     *
+     * The content of \a patchedFilePath is added to this store,
+     * and is recorded as the variant of \a sourceSha256
+     * that is described by \a patchKey (for example a RPATH).
+     *
+     * \a patchedFilePath is typically a temporary file,
+     * so its SHA-256 is not kept for later calls.
+     *
+     * Returns the SHA-256 of the content of \a patchedFilePath .
+     *
+     * \pre \a sourceSha256 must be a SHA-256 as hexadecimal string
+     * \pre \a patchedFilePath must be a existing file
+     * \exception FileCopyError
+     * \sa findPatchedFile()
+     */
+    QString addPatchedFile(const QString & sourceSha256, const QString & patchKey, const QString & patchedFilePath);
+
+    /*! \brief Replace \a filePath with the store file that has the content \a sha256
+     *
+     * The link is first created with a temporary name,
+     * then renamed to \a filePath ,
+     * so the file that \a filePath was is not changed.
+     *
+     * \pre \a sha256 must be in this store
+     * \pre \a filePath must be a absolute path to a existing file
+     * \exception FileCopyError
+     * \sa linkFile()
+     */
+    DeployStoreLinkType relinkFile(const QString & sha256, const QString & filePath);
+
+    /*! \brief Remove the store file that has the content \a sha256 if no destination links to it
+     *
+     * Used for a content that has been added,
+     * but that was then replaced by a changed variant in its destination.
+     *
+     * A store file can only be known as not linked if it has no other hard link.
+     * A destination that is a reflink or a copy does not depend on the store file,
+     * so removing it never changes a destination.
+     *
+     * \note On other platforms than Linux, nothing is removed.
+     * \pre \a sha256 must be a SHA-256 as hexadecimal string
+     */
+    void removeUnusedFile(const QString & sha256) noexcept;
+
+    /*! \brief Get the count of contents that have been written to this store
+     */
+    int addedFileCount() const noexcept
+    {
+      return mAddedFileCount;
+    }
+
+    /*! \brief Get the count of contents that where allready in this store
+     */
+    int reusedFileCount() const noexcept
+    {
+      return mReusedFileCount;
+    }
+
+   private:
+
+    struct HashedFile
+    {
+      qint64 size = -1;
+      qint64 lastModified = -1;
+      QString sha256;
+    };
+
+    QString patchedFileIndexPath(const QString & sourceSha256, const QString & patchKey) const noexcept;
+    QString fileSha256(const QString & filePath);
+    void createObjectFile(const QString & filePath, const QString & storeFilePath);
+
+    static
+    bool reflinkFile(const QString & sourceFilePath, const QString & destinationFilePath) noexcept;
+
+    static
+    bool hardLinkFile(const QString & sourceFilePath, const QString & destinationFilePath) noexcept;
+
+    static
+    QString temporaryFilePath(const QString & filePath) noexcept;
+
+    static
+    void replaceFile(const QString & newFilePath, const QString & filePath);
+
+    QString mRootDirectoryPath;
+    QHash<QString, HashedFile> mHashedFiles;
+    int mAddedFileCount = 0;
+    int mReusedFileCount = 0;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_DEPLOY_STORE_H
@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "DestinationArchive.h"
+#include "QtConfWriter.h"
+#include <Mdt/ExecutableFile/ExecutableFileReader.h>
+#include <Mdt/ExecutableFile/ExecutableFileWriter.h>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QStringList>
+#include <QStringBuilder>
+#include <QLatin1String>
+#include <QLatin1Char>
+#include <cassert>
+
+using Mdt::ExecutableFile::ExecutableFileReader;
+using Mdt::ExecutableFile::ExecutableFileWriter;
+
+namespace Mdt{ namespace DeployUtils{
+
+DestinationArchive::DestinationArchive(const DestinationDirectory & destination, const Platform & platform, QObject *parent)
+ : QObject(parent),
+   mStructure( destination.structure() ),
+   mPlatform(platform),
+   mRootEntryPath( rootEntryPathFromDestination(destination) )
+{
+  assert( !mStructure.isNull() );
+  assert( !mPlatform.isNull() );
+
+  connect(&mWriter, &TarArchiveWriter::verboseMessage, this, &DestinationArchive::verboseMessage);
+
+  if( mPlatform.supportsRPath() ){
+    mSystemWideLocations = PathList::getSystemLibraryKnownPathList(mPlatform);
+  }
+}
+
+void DestinationArchive::open(const QString & archiveFilePath)
+{
+  assert( QDir::isAbsolutePath(archiveFilePath) );
+
+  mAddedDirectories.clear();
+  mAddedFiles.clear();
+
+  mWriter.open(archiveFilePath);
+
+  addDirectory( mStructure.executablesDirectory() );
+  addDirectory( mStructure.sharedLibrariesDirectory() );
+}
+
+void DestinationArchive::addExecutable(const QString & sourceFilePath, const RPath & rpath)
+{
+  assert( QDir::isAbsolutePath(sourceFilePath) );
+
+  addFile( sourceFilePath, mStructure.executablesDirectory(), readRPath(sourceFilePath), rpath );
+}
+
+void DestinationArchive::addSharedLibrary(const BinaryDependenciesResultLibrary & library, const RPath & rpath)
+{
+  addFile( library.absoluteFilePath(), mStructure.sharedLibrariesDirectory(), library.rPath(), rpath );
+}
+
+void DestinationArchive::addQtPlugin(const QtPluginFile & plugin, const RPath & rpath)
+{
+  const QString directory = mStructure.qtPluginsRootDirectory() % QLatin1Char('/') % plugin.directoryName();
+
+  addFile( plugin.absoluteFilePath(), directory, readRPath( plugin.absoluteFilePath() ), rpath );
+}
+
+void DestinationArchive::addQtConf(const QtConf & conf)
+{
+  const QString confEntryPath = entryPath( mStructure.executablesDirectory() % QLatin1String("/qt.conf") );
+
+  emit verboseMessage(
+    tr("add %1 to the archive")
+    .arg(confEntryPath)
+  );
+
+  mWriter.addFileData( confEntryPath, QtConfWriter::makeConfFileContent(conf) );
+  mAddedFiles.insert(confEntryPath);
+}
+
+void DestinationArchive::close()
+{
+  mWriter.close();
+
+  emit verboseMessage(
+    tr("archive contains %1 files (%2 bytes before compression)")
+    .arg( mAddedFiles.count() )
+    .arg( mWriter.writtenByteCount() )
+  );
+}
+
+QString DestinationArchive::rootEntryPathFromDestination(const DestinationDirectory & destination) noexcept
+{
+  return QFileInfo( QDir::cleanPath( destination.path() ) ).fileName();
+}
+
+void DestinationArchive::addFile(const QString & sourceFilePath, const QString & directory, const RPath & sourceRPath, const RPath & rpath)
+{
+  const QFileInfo sourceFile(sourceFilePath);
+  const QString fileEntryPath = entryPath( directory % QLatin1Char('/') % sourceFile.fileName() );
+
+  /*
+   * A library can be required by several executables or plugins
+   */
+  if( mAddedFiles.contains(fileEntryPath) ){
+    return;
+  }
+
+  addDirectory(directory);
+
+  if( mPlatform.supportsRPath() && hasToUpdateRpath(sourceFilePath, sourceRPath, rpath) ){
+    emit verboseMessage(
+      tr("add %1 to the archive (update rpath in memory)")
+      .arg(fileEntryPath)
+    );
+
+    if( !mPatchedFile.copyFrom(sourceFilePath) ){
+      const QString msg = tr("could not copy %1 to update its rpath")
+                          .arg(sourceFilePath);
+      throw WriteArchiveError(msg);
+    }
+
+    ExecutableFileWriter writer;
+    connect(&writer, &ExecutableFileWriter::message, this, &DestinationArchive::verboseMessage);
+    connect(&writer, &ExecutableFileWriter::verboseMessage, this, &DestinationArchive::verboseMessage);
+    writer.openFile(QFileInfo( mPatchedFile.filePath() ), mPlatform);
+    writer.setRunPath(rpath);
+    writer.close();
+
+    QFile patchedFile( mPatchedFile.filePath() );
+    if( !patchedFile.open(QIODevice::ReadOnly) ){
+      const QString msg = tr("could not read %1 after updating its rpath: %2")
+                          .arg( sourceFilePath, patchedFile.errorString() );
+      throw WriteArchiveError(msg);
+    }
+    mWriter.addFile( fileEntryPath, patchedFile, patchedFile.size(),
+                     TarArchiveWriter::modeFromPermissions( sourceFile.permissions() ),
+                     sourceFile.lastModified().toSecsSinceEpoch() );
+  }else{
+    emit verboseMessage(
+      tr("add %1 to the archive")
+      .arg(fileEntryPath)
+    );
+    mWriter.addFile(fileEntryPath, sourceFilePath);
+  }
+
+  mAddedFiles.insert(fileEntryPath);
+}
+
+void DestinationArchive::addDirectory(const QString & directory)
+{
+  /*
+   * Parent directories are added first,
+   * so that extracting the archive creates them with the expected permissions
+   */
+  QString path;
+  const QStringList parts = entryPath(directory).split( QLatin1Char('/'), QString::SkipEmptyParts );
+  for(const QString & part : parts){
+    if( path.isEmpty() ){
+      path = part;
+    }else{
+      path = path % QLatin1Char('/') % part;
+    }
+    if( !mAddedDirectories.contains(path) ){
+      emit debugMessage(
+        tr("add directory %1 to the archive")
+        .arg(path)
+      );
+      mWriter.addDirectory(path);
+      mAddedDirectories.insert(path);
+    }
+  }
+}
+
+bool DestinationArchive::hasToUpdateRpath(const QString & sourceFilePath, const RPath & sourceRPath, const RPath & rpath) const
+{
+  if(sourceRPath == rpath){
+    return false;
+  }
+  if( sourceRPath.isEmpty() ){
+    if( !mSystemWideLocations.containsPath( QFileInfo(sourceFilePath).absolutePath() ) ){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+RPath DestinationArchive::readRPath(const QString & sourceFilePath) const
+{
+  if( !mPlatform.supportsRPath() ){
+    return RPath();
+  }
+
+  ExecutableFileReader reader;
+  reader.openFile(QFileInfo(sourceFilePath), mPlatform);
+  const RPath rpath = reader.getRunPath();
+  reader.close();
+
+  return rpath;
+}
+
+QString DestinationArchive::entryPath(const QString & directory) const noexcept
+{
+  if( mRootEntryPath.isEmpty() ){
+    return QDir::cleanPath(directory);
+  }
+
+  return QDir::cleanPath( mRootEntryPath % QLatin1Char('/') % directory );
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
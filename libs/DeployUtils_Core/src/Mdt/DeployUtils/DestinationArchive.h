@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_DESTINATION_ARCHIVE_H
+#define MDT_DEPLOY_UTILS_DESTINATION_ARCHIVE_H
+
+#include "DestinationDirectory.h"
+#include "DestinationDirectoryStructure.h"
+#include "TarArchiveWriter.h"
+#include "BinaryDependenciesResultLibrary.h"
+#include "QtPluginFile.h"
+#include "QtConf.h"
+#include "Platform.h"
+#include "RPath.h"
+#include "PathList.h"
+#include "WriteArchiveError.h"
+#include "Mdt/DeployUtils/Impl/InMemoryFile.h"
+#include "mdt_deployutilscore_export.h"
+#include <QObject>
+#include <QString>
+#include <QSet>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Deploy to a archive instead of a directory
+   *
+   * The layout of the archive is the one of a destination directory:
+   * \code
+   * myapp/
+   *   bin/
+   *     myapp
+   *     qt.conf
+   *   lib/
+   *     libQt5Core.so.5
+   *   plugins/
+   *     platforms/
+   *       libqxcb.so
+   * \endcode
+   * where the root directory is named after the destination directory
+   * (myapp here), and the sub-directories come from its structure.
+   *
+   * Each file is read once from its source and written to the archive.
+   * If its RPATH has to be changed, this is done on a copy in memory
+   * (see Impl::InMemoryFile), so nothing is written to a intermediate directory.
+   *
+   * \sa TarArchiveWriter
+   * \sa DestinationDirectory
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT DestinationArchive : public QObject
+  {
+    Q_OBJECT
+
+   public:
+
+    /*! \brief Construct a archive for \a destination
+     *
+     * \pre the structure of \a destination must not be null
+     * \pre \a platform must not be null
+     */
+    explicit DestinationArchive(const DestinationDirectory & destination, const Platform & platform, QObject *parent = nullptr);
+
+    /*! \brief Get the root directory of the entries in the archive
+     *
+     * \sa rootEntryPathFromDestination()
+     */
+    const QString & rootEntryPath() const noexcept
+    {
+      return mRootEntryPath;
+    }
+
+    /*! \brief Open \a archiveFilePath for writing
+     *
+     * \pre \a archiveFilePath must be a absolute path
+     * \exception WriteArchiveError
+     * \sa TarArchiveWriter::open()
+     */
+    void open(const QString & archiveFilePath);
+
+    /*! \brief Add a executable to the executables directory
+     *
+     * On platforms that support RPATH,
+     * the RPATH of the executable is set to \a rpath if required.
+     *
+     * \pre \a sourceFilePath must be a absolute path
+     * \exception WriteArchiveError
+     */
+    void addExecutable(const QString & sourceFilePath, const RPath & rpath);
+
+    /*! \brief Add a shared library to the shared libraries directory
+     *
+     * \exception WriteArchiveError
+     * \sa addExecutable()
+     */
+    void addSharedLibrary(const BinaryDependenciesResultLibrary & library, const RPath & rpath);
+
+    /*! \brief Add a Qt plugin to its directory under the Qt plugins root directory
+     *
+     * \exception WriteArchiveError
+     * \sa addExecutable()
+     */
+    void addQtPlugin(const QtPluginFile & plugin, const RPath & rpath);
+
+    /*! \brief Add a qt.conf file to the executables directory
+     *
+     * \exception WriteArchiveError
+     */
+    void addQtConf(const QtConf & conf);
+
+    /*! \brief Finish the archive
+     *
+     * \exception WriteArchiveError
+     * \sa TarArchiveWriter::close()
+     */
+    void close();
+
+    /*! \brief Get the count of files that have been added
+     */
+    int fileCount() const noexcept
+    {
+      return mAddedFiles.count();
+    }
+
+    /*! \brief Get the root directory of the entries in the archive for \a destination
+     *
+     * This is the name of the destination directory,
+     * for example myapp for /tmp/myapp .
+     */
+    static
+    QString rootEntryPathFromDestination(const DestinationDirectory & destination) noexcept;
+
+   signals:
+
+    void statusMessage(const QString & message) const;
+    void verboseMessage(const QString & message) const;
+    void debugMessage(const QString & message) const;
+
+   private:
+
+    void addFile(const QString & sourceFilePath, const QString & directory, const RPath & sourceRPath, const RPath & rpath);
+    void addDirectory(const QString & directory);
+    bool hasToUpdateRpath(const QString & sourceFilePath, const RPath & sourceRPath, const RPath & rpath) const;
+    RPath readRPath(const QString & sourceFilePath) const;
+    QString entryPath(const QString & directory) const noexcept;
+
+    DestinationDirectoryStructure mStructure;
+    Platform mPlatform;
+    QString mRootEntryPath;
+    PathList mSystemWideLocations;
+    TarArchiveWriter mWriter;
+    Impl::InMemoryFile mPatchedFile;
+    QSet<QString> mAddedDirectories;
+    QSet<QString> mAddedFiles;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_DESTINATION_ARCHIVE_H
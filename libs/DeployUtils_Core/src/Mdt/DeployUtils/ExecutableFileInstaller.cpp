@@ -10,6 +10,8 @@
 #include "FileInfoUtils.h"
 #include "FileCopier.h"
 #include "FileCopierFile.h"
+#include "FileCopyError.h"
+#include "Impl/InMemoryFile.h"
 #include <Mdt/ExecutableFile/ExecutableFileReader.h>
 #include <Mdt/ExecutableFile/ExecutableFileWriter.h>
 #include <cassert>
@@ -32,12 +34,29 @@ void ExecutableFileInstaller::setOverwriteBehavior(OverwriteBehavior overwriteBe
   mOverwriteBehavior = overwriteBehavior;
 }
 
+void ExecutableFileInstaller::setDeployManifest(const std::shared_ptr<const DeployManifest> & manifest) noexcept
+{
+  mDeployManifest = manifest;
+}
+
+void ExecutableFileInstaller::setFileHashCache(const std::shared_ptr<FileHashCache> & cache) noexcept
+{
+  mFileHashCache = cache;
+}
+
+void ExecutableFileInstaller::setMetadataCache(const std::shared_ptr<ExecutableFileMetadataCache> & cache) noexcept
+{
+  mMetadataCache = cache;
+}
+
 void ExecutableFileInstaller::install(const ExecutableFileToInstall & file, const QFileInfo & directoryPath, const RPath & installRPath)
 {
   assert( fileInfoIsAbsolutePath(directoryPath) );
 
   FileCopier fileCopier;
   fileCopier.setOverwriteBehavior(mOverwriteBehavior);
+  fileCopier.setDeployManifest(mDeployManifest);
+  fileCopier.setFileHashCache(mFileHashCache);
   connect(&fileCopier, &FileCopier::verboseMessage, this, &ExecutableFileInstaller::verboseMessage);
 
   const QString directoryPathStr = directoryPath.absoluteFilePath();
@@ -48,7 +67,8 @@ void ExecutableFileInstaller::install(const ExecutableFileToInstall & file, cons
     if( file.haveToReadRPathFromFile() ){
       readRPathFromSourceFile(copiedFile);
     }
-    setRPathToCopiedFiles({copiedFile}, installRPath);
+    CopiedExecutableFileList copiedFiles{copiedFile};
+    setRPathToCopiedFiles(copiedFiles, installRPath);
   }
 }
 
@@ -75,7 +95,7 @@ void ExecutableFileInstaller::readRPathFromSourceFile(CopiedExecutableFile & fil
   reader.close();
 }
 
-void ExecutableFileInstaller::setRPathToCopiedFiles(const CopiedExecutableFileList & copiedFiles, const RPath & rpath)
+void ExecutableFileInstaller::setRPathToCopiedFiles(CopiedExecutableFileList & copiedFiles, const RPath & rpath)
 {
   assert( mPlatform.supportsRPath() );
 
@@ -93,12 +113,30 @@ void ExecutableFileInstaller::setRPathToCopiedFiles(const CopiedExecutableFileLi
 
   const PathList systemWideLocations = PathList::getSystemLibraryKnownPathList(mPlatform);
 
-  for(const CopiedExecutableFile & copiedFile : copiedFiles){
-    if( hasToUpdateRpath(copiedFile, rpath, systemWideLocations) ){
-      const QString msg = tr(" update rpath for %1").arg( copiedFile.destinationFileInfo().absoluteFilePath() );
+  Impl::InMemoryFile patchedFile;
+
+  for(CopiedExecutableFile & copiedFile : copiedFiles){
+    const bool rpathHasToBeUpdated = hasToUpdateRpath(copiedFile, rpath, systemWideLocations);
+    if(rpathHasToBeUpdated){
+      const QString destinationFilePath = copiedFile.destinationFileInfo().absoluteFilePath();
+      const QString msg = tr(" update rpath for %1").arg(destinationFilePath);
       emit verboseMessage(msg);
-      writer.openFile(copiedFile.destinationFileInfo(), mPlatform);
+      // Changed in memory, so the SHA-256 is computed while the destination is replaced
+      if( !patchedFile.copyFrom(destinationFilePath) ){
+        const QString copyMsg = tr("could not copy %1 to update its rpath").arg(destinationFilePath);
+        throw FileCopyError(copyMsg);
+      }
+      writer.openFile(QFileInfo( patchedFile.filePath() ), mPlatform);
       writer.setRunPath(rpath);
+      writer.close();
+      copiedFile.setSha256( FileCopier::replaceFileContent(patchedFile.filePath(), destinationFilePath) );
+      if(mFileHashCache){
+        mFileHashCache->insert( destinationFilePath, copiedFile.sha256() );
+      }
+    }
+    if(mMetadataCache){
+      const RPath & runPath = rpathHasToBeUpdated ? rpath : copiedFile.sourceFileRPath();
+      mMetadataCache->insertCopiedFile( copiedFile.sourceFileInfo(), copiedFile.destinationFileInfo(), runPath );
     }
     writer.close();
   }
@@ -15,10 +15,14 @@
 #include "Platform.h"
 #include "RPath.h"
 #include "PathList.h"
+#include "DeployManifest.h"
+#include "FileHashCache.h"
+#include "ExecutableFileMetadataCache.h"
 #include "mdt_deployutilscore_export.h"
 #include <QObject>
 #include <QFileInfo>
 #include <QString>
+#include <memory>
 
 namespace Mdt{ namespace DeployUtils{
 
@@ -53,6 +57,33 @@ namespace Mdt{ namespace DeployUtils{
       return mOverwriteBehavior;
     }
 
+    /*! \brief Set the manifest of a previous deploy
+     *
+     * If set, a file that is up to date is not installed again.
+     *
+     * \sa FileCopier::setDeployManifest()
+     */
+    void setDeployManifest(const std::shared_ptr<const DeployManifest> & manifest) noexcept;
+
+    /*! \brief Set a file hash cache
+     *
+     * If set, the SHA-256 of each installed file
+     * is inserted to \a cache , once its RPATH has been changed.
+     *
+     * \sa FileCopier::setFileHashCache()
+     */
+    void setFileHashCache(const std::shared_ptr<FileHashCache> & cache) noexcept;
+
+    /*! \brief Set a metadata cache
+     *
+     * If \a cache is set, the metadata of each installed file,
+     * with the RPATH it has once installed, is inserted to it,
+     * provided that the metadata of the source file is in \a cache .
+     *
+     * \sa ExecutableFileMetadataCache::insertCopiedFile()
+     */
+    void setMetadataCache(const std::shared_ptr<ExecutableFileMetadataCache> & cache) noexcept;
+
     /*! \brief Install given file to given directory
      *
      * If given directory does not exist it will be created.
@@ -92,12 +123,19 @@ namespace Mdt{ namespace DeployUtils{
     void readRPathFromSourceFile(CopiedExecutableFile & file);
 
     /*! \brief Set given rpath to given copied files
+     *
+     * The RPATH of each file is changed in memory,
+     * then the file is replaced,
+     * so that its SHA-256 is computed while it is written.
      *
      * \pre current platform must support RPath
      */
-    void setRPathToCopiedFiles(const CopiedExecutableFileList & copiedFiles, const RPath & rpath);
+    void setRPathToCopiedFiles(CopiedExecutableFileList & copiedFiles, const RPath & rpath);
 
     OverwriteBehavior mOverwriteBehavior = OverwriteBehavior::Fail;
+    std::shared_ptr<const DeployManifest> mDeployManifest;
+    std::shared_ptr<FileHashCache> mFileHashCache;
+    std::shared_ptr<ExecutableFileMetadataCache> mMetadataCache;
     Platform mPlatform;
   };
 
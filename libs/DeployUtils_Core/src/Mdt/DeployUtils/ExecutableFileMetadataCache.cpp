@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "ExecutableFileMetadataCache.h"
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+std::optional<ExecutableFileMetadata> ExecutableFileMetadataCache::find(const QFileInfo & file, FileStatCache *statCache)
+{
+  assert( !file.filePath().isEmpty() );
+  assert( file.isAbsolute() );
+
+  const QString path = file.absoluteFilePath();
+
+  const auto it = mEntries.find(path);
+  if( it == mEntries.end() ){
+    ++mMissCount;
+    return {};
+  }
+
+  if( !(it->stamp == fileStamp(path, statCache)) ){
+    mEntries.erase(it);
+    ++mStaleCount;
+    ++mMissCount;
+    return {};
+  }
+
+  ++mHitCount;
+
+  return it->metadata;
+}
+
+bool ExecutableFileMetadataCache::hasUpToDateDependencies(const QFileInfo & file, FileStatCache *statCache) const
+{
+  assert( !file.filePath().isEmpty() );
+  assert( file.isAbsolute() );
+
+  const QString path = file.absoluteFilePath();
+
+  const auto it = mEntries.constFind(path);
+  if( it == mEntries.cend() ){
+    return false;
+  }
+  if( !it->metadata.hasDependencies ){
+    return false;
+  }
+
+  return it->stamp == fileStamp(path, statCache);
+}
+
+void ExecutableFileMetadataCache::insert(const QFileInfo & file, const ExecutableFileMetadata & metadata, FileStatCache *statCache)
+{
+  assert( !file.filePath().isEmpty() );
+  assert( file.isAbsolute() );
+
+  const QString path = file.absoluteFilePath();
+
+  Entry entry;
+  entry.stamp = fileStamp(path, statCache);
+  entry.metadata = metadata;
+
+  mEntries.insert(path, entry);
+}
+
+void ExecutableFileMetadataCache::insertCopiedFile(const QFileInfo & sourceFile, const QFileInfo & destinationFile, const RPath & runPath)
+{
+  assert( !sourceFile.filePath().isEmpty() );
+  assert( !destinationFile.filePath().isEmpty() );
+  assert( destinationFile.isAbsolute() );
+
+  const QString sourcePath = sourceFile.absoluteFilePath();
+
+  const auto it = mEntries.constFind(sourcePath);
+  if( it == mEntries.cend() ){
+    return;
+  }
+  if( !it->metadata.hasDependencies ){
+    return;
+  }
+  if( !(it->stamp == fileStamp(sourcePath, nullptr)) ){
+    return;
+  }
+
+  ExecutableFileMetadata metadata = it->metadata;
+  metadata.runPath = runPath;
+
+  insert(destinationFile, metadata);
+}
+
+void ExecutableFileMetadataCache::clear() noexcept
+{
+  mEntries.clear();
+  mHitCount = 0;
+  mMissCount = 0;
+  mStaleCount = 0;
+}
+
+ExecutableFileMetadataCache::FileStamp ExecutableFileMetadataCache::fileStamp(const QString & absoluteFilePath, FileStatCache *statCache) noexcept
+{
+  /*
+   * The QFileInfo given by the caller can have cached
+   * its informations a long time ago,
+   * so we stat the file again here
+   * (or take the stat done during this run)
+   */
+  FileStat stat;
+  if(statCache != nullptr){
+    stat = statCache->stat(absoluteFilePath);
+  }else{
+    stat = FileStatCache::statFile(absoluteFilePath);
+  }
+
+  FileStamp stamp;
+  if( !stat.exists ){
+    return stamp;
+  }
+  stamp.size = stat.size;
+  stamp.lastModified = stat.lastModified;
+
+  return stamp;
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
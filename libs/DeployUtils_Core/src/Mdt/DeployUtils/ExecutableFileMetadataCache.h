@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_EXECUTABLE_FILE_METADATA_CACHE_H
+#define MDT_DEPLOY_UTILS_EXECUTABLE_FILE_METADATA_CACHE_H
+
+#include "Platform.h"
+#include "RPath.h"
+#include "FileStatCache.h"
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <QStringList>
+#include <QFileInfo>
+#include <QHash>
+#include <QtGlobal>
+#include <optional>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Metadata read from a executable or a shared library
+   *
+   * \sa ExecutableFileMetadataCache
+   */
+  struct MDT_DEPLOYUTILSCORE_EXPORT ExecutableFileMetadata
+  {
+    /*! \brief True if the file is a executable or a shared library
+     */
+    bool isExecutableOrSharedLibrary = false;
+
+    /*! \brief Platform of the file
+     */
+    Platform platform;
+
+    /*! \brief True if neededSharedLibraries and runPath have been read
+     *
+     * Checking if a file is a valid shared library
+     * does not require to read its dependencies.
+     */
+    bool hasDependencies = false;
+
+    /*! \brief Direct dependencies of the file
+     */
+    QStringList neededSharedLibraries;
+
+    /*! \brief Run path of the file
+     */
+    RPath runPath;
+  };
+
+  /*! \brief Cache of metadata read from executables and shared libraries
+   *
+   * Reading a executable file to get its platform,
+   * its direct dependencies and its run path
+   * is what costs the most while finding dependencies.
+   *
+   * When the same files are processed again and again
+   * (for example by a long running server),
+   * this cache avoids to read them again.
+   *
+   * Each entry is stamped with the size and the last modification time
+   * of the file when it was inserted.
+   * If the file has changed on the file system,
+   * the entry is discarded on next lookup.
+   *
+   * By default, no cache is used, each run reads the files.
+   *
+   * \sa BinaryDependencies::setMetadataCache()
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT ExecutableFileMetadataCache
+  {
+   public:
+
+    /*! \brief Get the metadata for \a file
+     *
+     * Returns the metadata if it is in this cache
+     * and the file did not change since it was inserted.
+     * Otherwise, nothing is returned.
+     *
+     * If \a statCache is not null,
+     * the stat to check if the file changed is taken from it.
+     *
+     * \pre \a file must be a absolute file path
+     */
+    std::optional<ExecutableFileMetadata> find(const QFileInfo & file, FileStatCache *statCache = nullptr);
+
+    /*! \brief Check if the dependencies of \a file are in this cache
+     *
+     * Returns true if \a file is in this cache,
+     * its dependencies have been read
+     * and the file did not change since it was inserted.
+     *
+     * Unlike find(), this function does not count as a lookup,
+     * and does not discard a entry if the file changed.
+     *
+     * If \a statCache is not null,
+     * the stat to check if the file changed is taken from it.
+     *
+     * \pre \a file must be a absolute file path
+     */
+    bool hasUpToDateDependencies(const QFileInfo & file, FileStatCache *statCache = nullptr) const;
+
+    /*! \brief Insert the metadata for \a file
+     *
+     * If a entry exists for \a file , it is replaced.
+     *
+     * If \a statCache is not null,
+     * the stat to stamp the entry is taken from it.
+     *
+     * \pre \a file must be a absolute file path
+     */
+    void insert(const QFileInfo & file, const ExecutableFileMetadata & metadata, FileStatCache *statCache = nullptr);
+
+    /*! \brief Insert the metadata for \a destinationFile , copied from \a sourceFile
+     *
+     * \a destinationFile gets the metadata of \a sourceFile ,
+     * with \a runPath as run path.
+     * This way, the run path of a deployed file is known
+     * without reading it again.
+     *
+     * Does nothing if \a sourceFile is not in this cache
+     * (or changed since it was inserted).
+     * This function does not count as a lookup.
+     *
+     * Must be called once \a destinationFile has been written.
+     *
+     * \pre \a sourceFile must not be empty
+     * \pre \a destinationFile must be a absolute file path
+     */
+    void insertCopiedFile(const QFileInfo & sourceFile, const QFileInfo & destinationFile, const RPath & runPath);
+
+    /*! \brief Get the count of entries in this cache
+     */
+    int count() const noexcept
+    {
+      return mEntries.count();
+    }
+
+    /*! \brief Check if this cache is empty
+     */
+    bool isEmpty() const noexcept
+    {
+      return mEntries.isEmpty();
+    }
+
+    /*! \brief Get the count of lookups that returned a entry
+     */
+    qint64 hitCount() const noexcept
+    {
+      return mHitCount;
+    }
+
+    /*! \brief Get the count of lookups that returned nothing
+     *
+     * This includes the entries that have been discarded
+     * because the file changed.
+     */
+    qint64 missCount() const noexcept
+    {
+      return mMissCount;
+    }
+
+    /*! \brief Get the count of entries discarded because the file changed
+     */
+    qint64 staleCount() const noexcept
+    {
+      return mStaleCount;
+    }
+
+    /*! \brief Remove all entries from this cache
+     */
+    void clear() noexcept;
+
+   private:
+
+    struct FileStamp
+    {
+      qint64 size = -1;
+      qint64 lastModified = -1;
+
+      bool operator==(const FileStamp & other) const noexcept
+      {
+        return (size == other.size) && (lastModified == other.lastModified);
+      }
+    };
+
+    struct Entry
+    {
+      FileStamp stamp;
+      ExecutableFileMetadata metadata;
+    };
+
+    static
+    FileStamp fileStamp(const QString & absoluteFilePath, FileStatCache *statCache) noexcept;
+
+    QHash<QString, Entry> mEntries;
+    qint64 mHitCount = 0;
+    qint64 mMissCount = 0;
+    qint64 mStaleCount = 0;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_EXECUTABLE_FILE_METADATA_CACHE_H
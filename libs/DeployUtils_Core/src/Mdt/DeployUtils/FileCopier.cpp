@@ -25,8 +25,16 @@
 #include <QLatin1String>
 #include <QLatin1Char>
 #include <QDateTime>
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QCoreApplication>
+#include <QStringBuilder>
 #include <cassert>
 
+#ifdef Q_OS_LINUX
+#include <stdio.h>
+#endif // #ifdef Q_OS_LINUX
+
 // #include <QDebug>
 
 namespace Mdt{ namespace DeployUtils{
@@ -59,12 +67,41 @@ void FileCopier::setOverwriteBehavior(OverwriteBehavior behavior) noexcept
   mOverwriteBehavior = behavior;
 }
 
+void FileCopier::setDeployManifest(const std::shared_ptr<const DeployManifest> & manifest) noexcept
+{
+  mDeployManifest = manifest;
+}
+
+void FileCopier::setDeployStore(const std::shared_ptr<DeployStore> & store) noexcept
+{
+  mDeployStore = store;
+}
+
+void FileCopier::setFileHashCache(const std::shared_ptr<FileHashCache> & cache) noexcept
+{
+  mFileHashCache = cache;
+}
+
+void FileCopier::setPreserveSymLinks(bool preserve) noexcept
+{
+  mPreserveSymLinks = preserve;
+}
+
 FileCopierFile FileCopier::copyFile(const QFileInfo & sourceFileInfo, const QString & destinationDirectoryPath)
 {
   assert( isExistingDirectory(destinationDirectoryPath) );
   assert( sourceFileInfo.exists() );
   assert( sourceFileInfo.isFile() );
 
+  if( mPreserveSymLinks && sourceFileInfo.isSymLink() ){
+    return copySymLinkedFile(sourceFileInfo, destinationDirectoryPath);
+  }
+
+  return copyRegularFile(sourceFileInfo, destinationDirectoryPath);
+}
+
+FileCopierFile FileCopier::copyRegularFile(const QFileInfo & sourceFileInfo, const QString & destinationDirectoryPath)
+{
   FileCopierFile copierFile;
 
   const auto destinationFilePath = getDestinationFilePath(sourceFileInfo, destinationDirectoryPath);
@@ -72,7 +109,21 @@ FileCopierFile FileCopier::copyFile(const QFileInfo & sourceFileInfo, const QStr
   copierFile.setSourceFileInfo(sourceFileInfo);
   copierFile.setDestinationFileInfo(destinationFilePath);
 
+  /*
+   * Several names can lead to the same file (libfoo.so.1 and libfoo.so.1.2).
+   * It is only copied for the first one,
+   * so that its RPATH is also only changed once.
+   */
+  if( mCopiedFilePaths.contains(destinationFilePath) ){
+    return copierFile;
+  }
+
   if( copierFile.destinationFileInfo().exists() ){
+    if( mDeployManifest && mDeployManifest->fileIsUpToDate(sourceFileInfo, destinationFilePath) ){
+      const QString upToDateMsg = tr("%1 is up to date").arg( copierFile.destinationFileInfo().absoluteFilePath() );
+      emit verboseMessage(upToDateMsg);
+      return copierFile;
+    }
     if( mOverwriteBehavior == OverwriteBehavior::Keep ){
       return copierFile;
     }
@@ -97,21 +148,46 @@ FileCopierFile FileCopier::copyFile(const QFileInfo & sourceFileInfo, const QStr
     }
   }
 
-  const QString copyFileMsg = tr("Copy %1 to %2").arg( sourceFileInfo.fileName(), destinationDirectoryPath );
-  emit verboseMessage(copyFileMsg);
-
-  QFile sourceFile( sourceFileInfo.absoluteFilePath() );
-  if( !sourceFile.copy(destinationFilePath) ){
-    const QString msg = tr("Could not copy file '%1' to '%2': %3")
-                        .arg( sourceFileInfo.absoluteFilePath(), destinationDirectoryPath, sourceFile.errorString() );
-    throw FileCopyError(msg);
+  if(mDeployStore){
+    const QString linkFileMsg = tr("Link %1 to %2 from the deploy store").arg( sourceFileInfo.fileName(), destinationDirectoryPath );
+    emit verboseMessage(linkFileMsg);
+    // The store is content addressed, so it allready knows the SHA-256
+    const QString sha256 = mDeployStore->addFile( sourceFileInfo.absoluteFilePath() );
+    mDeployStore->linkFile(sha256, destinationFilePath);
+    copierFile.setSha256(sha256);
+    copierFile.setAsLinkedFromDeployStore();
+  }else{
+    const QString copyFileMsg = tr("Copy %1 to %2").arg( sourceFileInfo.fileName(), destinationDirectoryPath );
+    emit verboseMessage(copyFileMsg);
+    // Permissions like QFile::copy()
+    copierFile.setSha256( copyFileContent( sourceFileInfo.absoluteFilePath(), destinationFilePath, sourceFileInfo.permissions() ) );
   }
 
   copierFile.setAsBeenCopied();
+  if(mFileHashCache){
+    mFileHashCache->insert( destinationFilePath, copierFile.sha256() );
+  }
+  if(mPreserveSymLinks){
+    mCopiedFilePaths.insert(destinationFilePath);
+  }
 
   return copierFile;
 }
 
+QStringList FileCopier::getDestinationFilePathList(const QFileInfo & sourceFileInfo, const QString & destinationDirectoryPath) const noexcept
+{
+  QStringList filePathList{ getDestinationFilePath(sourceFileInfo, destinationDirectoryPath) };
+
+  if( mPreserveSymLinks && sourceFileInfo.isSymLink() ){
+    const QString targetDestinationFilePath = getDestinationFilePath( QFileInfo( sourceFileInfo.canonicalFilePath() ), destinationDirectoryPath );
+    if( !filePathList.contains(targetDestinationFilePath) ){
+      filePathList.append(targetDestinationFilePath);
+    }
+  }
+
+  return filePathList;
+}
+
 void FileCopier::copyFiles(const QStringList & sourceFilePathList, const QString & destinationDirectoryPath)
 {
   createDirectory(destinationDirectoryPath);
@@ -132,14 +208,172 @@ bool FileCopier::isExistingDirectory(const QString & directoryPath) noexcept
   return false;
 }
 
+bool FileCopier::isExistingFileOrSymLink(const QString & filePath) noexcept
+{
+  const QFileInfo fi(filePath);
+
+  // exists() returns false for a dangling link
+  return fi.exists() || fi.isSymLink();
+}
+
 QString FileCopier::getDestinationFilePath(const QString & sourceFilePath, const QString & destinationDirectoryPath) noexcept
 {
   return getDestinationFilePath( QFileInfo(sourceFilePath), destinationDirectoryPath );
 }
 
+QString FileCopier::replaceFileContent(const QString & sourceFilePath, const QString & destinationFilePath)
+{
+  assert( QDir::isAbsolutePath(destinationFilePath) );
+  assert( QFileInfo::exists(destinationFilePath) );
+
+  const QFileInfo destinationFileInfo(destinationFilePath);
+  const QString newFilePath = destinationFilePath % QLatin1String(".tmp-") % QString::number( QCoreApplication::applicationPid() );
+
+  const QString sha256 = copyFileContent( sourceFilePath, newFilePath, destinationFileInfo.permissions() );
+
+#ifdef Q_OS_LINUX
+  const bool ok = ( ::rename( QFile::encodeName(newFilePath).constData(), QFile::encodeName(destinationFilePath).constData() ) == 0 );
+#else
+  QFile::remove(destinationFilePath);
+  const bool ok = QFile::rename(newFilePath, destinationFilePath);
+#endif // #ifdef Q_OS_LINUX
+  if(!ok){
+    QFile::remove(newFilePath);
+    const QString msg = tr("Could not replace '%1'")
+                        .arg(destinationFilePath);
+    throw FileCopyError(msg);
+  }
+
+  return sha256;
+}
+
 QString FileCopier::getDestinationFilePath(const QFileInfo & sourceFile, const QString & destinationDirectoryPath) noexcept
 {
   return QDir::cleanPath( destinationDirectoryPath + QLatin1Char('/') + sourceFile.fileName() );
 }
 
+FileCopierFile FileCopier::copySymLinkedFile(const QFileInfo & sourceFileInfo, const QString & destinationDirectoryPath)
+{
+  assert( sourceFileInfo.isSymLink() );
+
+  // Resolves the whole chain, for example libfoo.so.1 -> libfoo.so.1.2 -> libfoo.so.1.2.3
+  const QFileInfo targetFileInfo( sourceFileInfo.canonicalFilePath() );
+
+  /*
+   * A link to a file that has the same name, in a other directory,
+   * gives nothing to preserve
+   */
+  if( targetFileInfo.fileName() == sourceFileInfo.fileName() ){
+    return copyRegularFile(sourceFileInfo, destinationDirectoryPath);
+  }
+
+  const QString linkFilePath = getDestinationFilePath(sourceFileInfo, destinationDirectoryPath);
+  const QString targetDestinationFilePath = getDestinationFilePath(targetFileInfo, destinationDirectoryPath);
+
+  FileCopierFile copierFile;
+  copierFile.setSourceFileInfo(sourceFileInfo);
+  copierFile.setDestinationFileInfo(linkFilePath);
+
+  if( linkFilePath == sourceFileInfo.absoluteFilePath() ){
+    return copierFile;
+  }
+
+  const QFileInfo linkFileInfo(linkFilePath);
+  const bool isExpectedLink = linkFileInfo.isSymLink() && (QDir::cleanPath( linkFileInfo.symLinkTarget() ) == targetDestinationFilePath);
+  if( isExistingFileOrSymLink(linkFilePath) && !isExpectedLink ){
+    if( mOverwriteBehavior == OverwriteBehavior::Keep ){
+      return copierFile;
+    }
+    if( mOverwriteBehavior == OverwriteBehavior::Fail ){
+      const QString msg = tr("Copy file '%1' to '%2' failed because the destination file exists (overwrite behavior is Fail)")
+                          .arg( sourceFileInfo.absoluteFilePath(), linkFilePath );
+      throw FileCopyError(msg);
+    }
+    assert( mOverwriteBehavior == OverwriteBehavior::Overwrite );
+    if( !QFile::remove(linkFilePath) ){
+      const QString msg = tr("Could not remove destination file '%1'")
+                          .arg(linkFilePath);
+      throw FileCopyError(msg);
+    }
+  }
+
+  const FileCopierFile targetCopierFile = copyRegularFile(targetFileInfo, destinationDirectoryPath);
+  copierFile.setDestinationFileInfo( targetCopierFile.destinationFileInfo() );
+  copierFile.setDestinationSymLinkFileInfo(linkFilePath);
+  if( targetCopierFile.hasBeenCopied() ){
+    copierFile.setSha256( targetCopierFile.sha256() );
+    copierFile.setAsBeenCopied();
+    if( targetCopierFile.isLinkedFromDeployStore() ){
+      copierFile.setAsLinkedFromDeployStore();
+    }
+  }
+
+  if(!isExpectedLink){
+    const QString linkMsg = tr("Link %1 to %2").arg( sourceFileInfo.fileName(), targetFileInfo.fileName() );
+    emit verboseMessage(linkMsg);
+    // Relative, so the destination can be moved
+    if( !QFile::link(targetFileInfo.fileName(), linkFilePath) ){
+      const QString msg = tr("Could not create link '%1' to '%2'")
+                          .arg( linkFilePath, targetFileInfo.fileName() );
+      throw FileCopyError(msg);
+    }
+  }
+
+  if( mFileHashCache && copierFile.hasBeenCopied() ){
+    mFileHashCache->insert( linkFilePath, copierFile.sha256() );
+  }
+
+  return copierFile;
+}
+
+QString FileCopier::copyFileContent(const QString & sourceFilePath, const QString & destinationFilePath, QFileDevice::Permissions permissions)
+{
+  QFile sourceFile(sourceFilePath);
+  if( !sourceFile.open(QIODevice::ReadOnly) ){
+    const QString msg = tr("Could not copy file '%1' to '%2': %3")
+                        .arg( sourceFilePath, destinationFilePath, sourceFile.errorString() );
+    throw FileCopyError(msg);
+  }
+
+  QFile destinationFile(destinationFilePath);
+  if( !destinationFile.open(QIODevice::WriteOnly) ){
+    const QString msg = tr("Could not copy file '%1' to '%2': %3")
+                        .arg( sourceFilePath, destinationFilePath, destinationFile.errorString() );
+    throw FileCopyError(msg);
+  }
+
+  /*
+   * Hash the bytes while they are written,
+   * so the destination file has not to be read again
+   */
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  QByteArray buffer(1024 * 1024, Qt::Uninitialized);
+  qint64 readSize = 0;
+  while( (readSize = sourceFile.read( buffer.data(), buffer.size() )) > 0 ){
+    if( destinationFile.write(buffer.constData(), readSize) != readSize ){
+      const QString msg = tr("Could not copy file '%1' to '%2': %3")
+                          .arg( sourceFilePath, destinationFilePath, destinationFile.errorString() );
+      destinationFile.remove();
+      throw FileCopyError(msg);
+    }
+    hash.addData( buffer.constData(), static_cast<int>(readSize) );
+  }
+  if( (readSize < 0) || !destinationFile.flush() ){
+    const QString msg = tr("Could not copy file '%1' to '%2': %3")
+                        .arg( sourceFilePath, destinationFilePath,
+                              readSize < 0 ? sourceFile.errorString() : destinationFile.errorString() );
+    destinationFile.remove();
+    throw FileCopyError(msg);
+  }
+  destinationFile.close();
+
+  if( !destinationFile.setPermissions(permissions) ){
+    const QString msg = tr("Could not set permissions of '%1': %2")
+                        .arg( destinationFilePath, destinationFile.errorString() );
+    throw FileCopyError(msg);
+  }
+
+  return QString::fromLatin1( hash.result().toHex() );
+}
+
 }} // namespace Mdt{ namespace DeployUtils{
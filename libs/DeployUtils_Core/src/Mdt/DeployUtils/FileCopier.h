@@ -24,11 +24,17 @@
 #include "FileCopyError.h"
 #include "FileCopierFile.h"
 #include "OverwriteBehavior.h"
+#include "DeployManifest.h"
+#include "DeployStore.h"
+#include "FileHashCache.h"
 #include "mdt_deployutilscore_export.h"
 #include <QObject>
 #include <QString>
 #include <QStringList>
 #include <QFileInfo>
+#include <QFileDevice>
+#include <QSet>
+#include <memory>
 
 namespace Mdt{ namespace DeployUtils{
 
@@ -73,6 +79,72 @@ namespace Mdt{ namespace DeployUtils{
       return mOverwriteBehavior;
     }
 
+    /*! \brief Set the manifest of a previous deploy
+     *
+     * If set, a file that the manifest reports as a up to date copy
+     * of the source is not copied again.
+     * In this case, FileCopierFile::hasBeenCopied() returns false,
+     * like for a kept file.
+     *
+     * By default, no manifest is used.
+     *
+     * \sa DeployManifest::fileIsUpToDate()
+     */
+    void setDeployManifest(const std::shared_ptr<const DeployManifest> & manifest) noexcept;
+
+    /*! \brief Set a deploy store
+     *
+     * If set, copyFile() places each source file in \a store once,
+     * then links the destination file to it, instead of copying it.
+     *
+     * By default, no deploy store is used.
+     *
+     * \sa DeployStore
+     */
+    void setDeployStore(const std::shared_ptr<DeployStore> & store) noexcept;
+
+    /*! \brief Set a file hash cache
+     *
+     * If set, the SHA-256 of each copied file
+     * is inserted to \a cache .
+     *
+     * By default, no cache is used.
+     *
+     * \sa FileHashCache
+     */
+    void setFileHashCache(const std::shared_ptr<FileHashCache> & cache) noexcept;
+
+    /*! \brief Preserve symbolic links to shared libraries
+     *
+     * A shared library is often found by its SONAME,
+     * which is a symbolic link to the real file:
+     * \code
+     * libfoo.so.1 -> libfoo.so.1.2.3
+     * \endcode
+     *
+     * If \a preserve is true, copyFile() copies the real file once,
+     * under its own name,
+     * and creates a relative link with the name of the source file to it.
+     * Copying a other name that leads to the same real file
+     * (for example libfoo.so.1.2) then only creates a link.
+     *
+     * By default, links are followed and the content is copied
+     * under the name of the source file.
+     *
+     * \note Should only be enabled for platforms that support symbolic links
+     * (not for Windows)
+     */
+    void setPreserveSymLinks(bool preserve) noexcept;
+
+    /*! \brief Check if symbolic links are preserved
+     *
+     * \sa setPreserveSymLinks()
+     */
+    bool preserveSymLinks() const noexcept
+    {
+      return mPreserveSymLinks;
+    }
+
     /*! \brief Copy given source file to given destination directory
      *
      * If the source file allready exists in the destination location,
@@ -83,6 +155,23 @@ namespace Mdt{ namespace DeployUtils{
      * - If \a overwriteBehavior is OverwriteBehavior::Overwrite, the destination file will replaced.
      * - If \a overwriteBehavior is OverwriteBehavior::Fail, a fatal error is thrown.
      *
+     * If the destination file is up to date, regarding the deploy manifest,
+     * it is not changed, whatever \a overwriteBehavior is.
+     *
+     * If a deploy store is set, the destination file is linked to the store
+     * instead of being copied (see setDeployStore()).
+     *
+     * The SHA-256 of the destination file is computed
+     * while it is copied, without reading it again
+     * (see FileCopierFile::sha256()).
+     *
+     * If \a sourceFileInfo is a symbolic link, and links are preserved,
+     * the returned destination file is the real file,
+     * and FileCopierFile::destinationSymLinkFileInfo() is the created link
+     * (see setPreserveSymLinks()).
+     * The real file is only reported as copied the first time it is copied
+     * by this copier.
+     *
      * \pre \a sourceFileInfo must refer to a existing file
      * \pre \a destinationDirectoryPath must be a existing directory
      * \exception FileCopyError
@@ -103,11 +192,49 @@ namespace Mdt{ namespace DeployUtils{
     static
     bool isExistingDirectory(const QString & directoryPath) noexcept;
 
+    /*! \brief Check if \a filePath is a existing file or a symbolic link
+     *
+     * Unlike QFileInfo::exists(), returns true for a dangling link.
+     */
+    static
+    bool isExistingFileOrSymLink(const QString & filePath) noexcept;
+
+    /*! \brief Get the paths of the files that copyFile() can create for \a sourceFileInfo
+     *
+     * This is the destination file path and, if \a sourceFileInfo is a symbolic link
+     * that is preserved, the destination path of the real file.
+     *
+     * \sa setPreserveSymLinks()
+     */
+    QStringList getDestinationFilePathList(const QFileInfo & sourceFileInfo, const QString & destinationDirectoryPath) const noexcept;
+
     /*! \brief Get the destination file path from \a sourceFilePath and \a destinationDirectoryPath
      */
     static
     QString getDestinationFilePath(const QString & sourceFilePath, const QString & destinationDirectoryPath) noexcept;
 
+    /*! \brief Replace the content of \a destinationFilePath with the content of \a sourceFilePath
+     *
+     * Used for a copied file that has been changed in a other place
+     * (for example its RPATH, changed in memory).
+     *
+     * The new content is written to a temporary file,
+     * then renamed to \a destinationFilePath .
+     * If \a destinationFilePath is a hard link (for example to a deploy store),
+     * the other names of the file are not changed.
+     * The permissions of \a destinationFilePath are kept.
+     *
+     * Returns the SHA-256 of the new content,
+     * computed while it is written.
+     *
+     * \pre \a sourceFilePath must be a existing file
+     * \pre \a destinationFilePath must be a absolute path to a existing file
+     * \exception FileCopyError
+     * \sa FileCopierFile::sha256()
+     */
+    static
+    QString replaceFileContent(const QString & sourceFilePath, const QString & destinationFilePath);
+
    signals:
 
 //     void message(const QString & message) const;
@@ -118,7 +245,17 @@ namespace Mdt{ namespace DeployUtils{
     static
     QString getDestinationFilePath(const QFileInfo & sourceFile, const QString & destinationDirectoryPath) noexcept;
 
+    FileCopierFile copyRegularFile(const QFileInfo & sourceFileInfo, const QString & destinationDirectoryPath);
+    FileCopierFile copySymLinkedFile(const QFileInfo & sourceFileInfo, const QString & destinationDirectoryPath);
+    static
+    QString copyFileContent(const QString & sourceFilePath, const QString & destinationFilePath, QFileDevice::Permissions permissions);
+
     OverwriteBehavior mOverwriteBehavior = OverwriteBehavior::Fail;
+    bool mPreserveSymLinks = false;
+    std::shared_ptr<const DeployManifest> mDeployManifest;
+    std::shared_ptr<DeployStore> mDeployStore;
+    std::shared_ptr<FileHashCache> mFileHashCache;
+    QSet<QString> mCopiedFilePaths;
   };
 
 }} // namespace Mdt{ namespace DeployUtils{
@@ -38,4 +38,18 @@ void FileCopierFile::setDestinationFileInfo(const QFileInfo & file) noexcept
   mDestinationFileInfo = file;
 }
 
+void FileCopierFile::setDestinationSymLinkFileInfo(const QFileInfo & file) noexcept
+{
+  assert( fileInfoIsAbsolutePath(file) );
+
+  mDestinationSymLinkFileInfo = file;
+}
+
+void FileCopierFile::setSha256(const QString & sha256) noexcept
+{
+  assert( sha256.length() == 64 );
+
+  mSha256 = sha256;
+}
+
 }} // namespace Mdt{ namespace DeployUtils{
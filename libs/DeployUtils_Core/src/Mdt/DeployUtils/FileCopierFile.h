@@ -23,6 +23,7 @@
 
 #include "mdt_deployutilscore_export.h"
 #include <QFileInfo>
+#include <QString>
 #include <vector>
 
 namespace Mdt{ namespace DeployUtils{
@@ -77,6 +78,32 @@ namespace Mdt{ namespace DeployUtils{
       return mDestinationFileInfo.absoluteFilePath();
     }
 
+    /*! \brief Set the destination symbolic link file info
+     *
+     * \pre \a file must have its absolute file path set
+     * \sa fileInfoIsAbsolutePath()
+     */
+    void setDestinationSymLinkFileInfo(const QFileInfo & file) noexcept;
+
+    /*! \brief Get the symbolic link created in the destination
+     *
+     * Is empty if the source file has been copied
+     * to a regular file of the same name.
+     *
+     * \sa FileCopier::setPreserveSymLinks()
+     */
+    const QFileInfo & destinationSymLinkFileInfo() const noexcept
+    {
+      return mDestinationSymLinkFileInfo;
+    }
+
+    /*! \brief Check if a symbolic link to the destination file has been created
+     */
+    bool hasDestinationSymLink() const noexcept
+    {
+      return !mDestinationSymLinkFileInfo.filePath().isEmpty();
+    }
+
     /*! \brief Mark this file as been copied
      */
     void setAsBeenCopied() noexcept
@@ -91,11 +118,51 @@ namespace Mdt{ namespace DeployUtils{
       return mHasBeenCopied;
     }
 
+    /*! \brief Mark this file as been linked from a deploy store
+     */
+    void setAsLinkedFromDeployStore() noexcept
+    {
+      mIsLinkedFromDeployStore = true;
+    }
+
+    /*! \brief Returns true if the destination file has been linked from a deploy store
+     *
+     * The SHA-256 of the destination file is then
+     * the name of the deploy store file.
+     *
+     * \sa FileCopier::setDeployStore()
+     */
+    bool isLinkedFromDeployStore() const noexcept
+    {
+      return mIsLinkedFromDeployStore;
+    }
+
+    /*! \brief Set the SHA-256 of the destination file
+     *
+     * \pre \a sha256 must be a SHA-256 as hexadecimal string
+     */
+    void setSha256(const QString & sha256) noexcept;
+
+    /*! \brief Get the SHA-256 of the destination file, as hexadecimal string
+     *
+     * It is computed while copying the file,
+     * so it is empty if the file has not been copied.
+     *
+     * \sa FileCopier::copyFile()
+     */
+    const QString & sha256() const noexcept
+    {
+      return mSha256;
+    }
+
    private:
 
     bool mHasBeenCopied = false;
+    bool mIsLinkedFromDeployStore = false;
     QFileInfo mSourceFileInfo;
     QFileInfo mDestinationFileInfo;
+    QFileInfo mDestinationSymLinkFileInfo;
+    QString mSha256;
   };
 
 }} // namespace Mdt{ namespace DeployUtils{
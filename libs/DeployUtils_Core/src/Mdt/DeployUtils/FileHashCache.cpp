@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "FileHashCache.h"
+#include "FileStatCache.h"
+#include <QDir>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+void FileHashCache::insert(const QString & filePath, const QString & sha256) noexcept
+{
+  assert( QDir::isAbsolutePath(filePath) );
+  assert( sha256.length() == 64 );
+
+  const QString path = QDir::cleanPath(filePath);
+
+  Entry entry = fileStamp(path);
+  entry.sha256 = sha256;
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  mEntries.insert(path, entry);
+}
+
+QString FileHashCache::findSha256(const QString & filePath) noexcept
+{
+  assert( QDir::isAbsolutePath(filePath) );
+
+  const QString path = QDir::cleanPath(filePath);
+  const Entry stamp = fileStamp(path);
+
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  const auto it = mEntries.find(path);
+  if( it == mEntries.end() ){
+    return QString();
+  }
+  if( (it->size != stamp.size) || (it->lastModified != stamp.lastModified) ){
+    mEntries.erase(it);
+    return QString();
+  }
+
+  return it->sha256;
+}
+
+int FileHashCache::count() const noexcept
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  return mEntries.count();
+}
+
+void FileHashCache::clear() noexcept
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  mEntries.clear();
+}
+
+FileHashCache::Entry FileHashCache::fileStamp(const QString & absoluteFilePath) noexcept
+{
+  const FileStat stat = FileStatCache::statFile(absoluteFilePath);
+
+  Entry stamp;
+  if( !stat.exists ){
+    return stamp;
+  }
+  stamp.size = stat.size;
+  stamp.lastModified = stat.lastModified;
+
+  return stamp;
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
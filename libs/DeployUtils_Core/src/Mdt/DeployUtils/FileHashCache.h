@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_FILE_HASH_CACHE_H
+#define MDT_DEPLOY_UTILS_FILE_HASH_CACHE_H
+
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <QHash>
+#include <QtGlobal>
+#include <mutex>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief SHA-256 of deployed files, known without reading them again
+   *
+   * FileCopier computes the SHA-256 of each file while copying it.
+   * If a file is changed after the copy (for example its RPATH),
+   * its SHA-256 is computed while the changed file is written
+   * (see FileCopier::replaceFileContent()).
+   *
+   * This cache keeps those SHA-256,
+   * so that the deploy manifest can be made
+   * without reading each deployed file again.
+   *
+   * Each entry is stamped with the size and the last modification time
+   * of the file when it was inserted.
+   * If the file has changed on the file system since,
+   * the entry is discarded on next lookup.
+   *
+   * A cache can be shared by several threads.
+   *
+   * \sa FileCopier::setFileHashCache()
+   * \sa DeployManifest::addDeployedFile()
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT FileHashCache
+  {
+   public:
+
+    /*! \brief Insert the SHA-256 of \a filePath
+     *
+     * If a entry exists for \a filePath , it is replaced.
+     *
+     * \pre \a filePath must be a absolute file path
+     * \pre \a sha256 must be a SHA-256 as hexadecimal string
+     */
+    void insert(const QString & filePath, const QString & sha256) noexcept;
+
+    /*! \brief Get the SHA-256 of \a filePath
+     *
+     * Returns a empty string if \a filePath is not in this cache,
+     * or if the file changed since it was inserted.
+     *
+     * \pre \a filePath must be a absolute file path
+     */
+    QString findSha256(const QString & filePath) noexcept;
+
+    /*! \brief Get the count of entries in this cache
+     */
+    int count() const noexcept;
+
+    /*! \brief Check if this cache is empty
+     */
+    bool isEmpty() const noexcept
+    {
+      return count() == 0;
+    }
+
+    /*! \brief Remove all entries from this cache
+     */
+    void clear() noexcept;
+
+   private:
+
+    struct Entry
+    {
+      qint64 size = -1;
+      qint64 lastModified = -1;
+      QString sha256;
+    };
+
+    static
+    Entry fileStamp(const QString & absoluteFilePath) noexcept;
+
+    mutable std::mutex mMutex;
+    QHash<QString, Entry> mEntries;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_FILE_HASH_CACHE_H
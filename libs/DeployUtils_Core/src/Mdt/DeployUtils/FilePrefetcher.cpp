@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "FilePrefetcher.h"
+#include <QDir>
+#include <QFile>
+#include <algorithm>
+#include <vector>
+#include <cassert>
+
+#ifdef Q_OS_LINUX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // #ifdef Q_OS_LINUX
+
+namespace Mdt{ namespace DeployUtils{
+
+#ifdef Q_OS_LINUX
+namespace{
+
+  struct FileRegion
+  {
+    qint64 offset = 0;
+    qint64 size = 0;
+  };
+
+  quint64 readUnsigned(const unsigned char * data, int size, bool littleEndian) noexcept
+  {
+    quint64 value = 0;
+    for(int i = 0; i < size; ++i){
+      const int index = littleEndian ? size - 1 - i : i;
+      value = (value << 8) | data[index];
+    }
+
+    return value;
+  }
+
+  /*! \internal Read \a size bytes at \a offset
+   *
+   * Must only be used for regions that are in the head,
+   * which is allready in the page cache.
+   */
+  bool readRegion(int fd, qint64 offset, unsigned char *buffer, qint64 size) noexcept
+  {
+    return ::pread( fd, buffer, static_cast<size_t>(size), static_cast<off_t>(offset) ) == static_cast<ssize_t>(size);
+  }
+
+  /*! \internal Get the ELF regions that are read by the parser
+   *
+   * Returns the dynamic section and the section headers.
+   * Those are located from the file header and the program headers,
+   * which must be in the head (their bytes are not read otherwise).
+   * Returns a empty list if the file is not a ELF file.
+   */
+  std::vector<FileRegion> elfRegionsToPrefetch(int fd, qint64 headSize) noexcept
+  {
+    std::vector<FileRegion> regions;
+
+    unsigned char fileHeader[64];
+    if( (headSize < 64) || !readRegion(fd, 0, fileHeader, 64) ){
+      return regions;
+    }
+    if( (fileHeader[0] != 0x7f) || (fileHeader[1] != 'E') || (fileHeader[2] != 'L') || (fileHeader[3] != 'F') ){
+      return regions;
+    }
+
+    const bool is64Bit = fileHeader[4] == 2;
+    const bool littleEndian = fileHeader[5] == 1;
+    const int addressSize = is64Bit ? 8 : 4;
+
+    const qint64 programHeadersOffset = static_cast<qint64>( readUnsigned(fileHeader + (is64Bit ? 32 : 28), addressSize, littleEndian) );
+    const qint64 sectionHeadersOffset = static_cast<qint64>( readUnsigned(fileHeader + (is64Bit ? 40 : 32), addressSize, littleEndian) );
+    const qint64 programHeaderSize = static_cast<qint64>( readUnsigned(fileHeader + (is64Bit ? 54 : 42), 2, littleEndian) );
+    const qint64 programHeaderCount = static_cast<qint64>( readUnsigned(fileHeader + (is64Bit ? 56 : 44), 2, littleEndian) );
+    const qint64 sectionHeaderSize = static_cast<qint64>( readUnsigned(fileHeader + (is64Bit ? 58 : 46), 2, littleEndian) );
+    const qint64 sectionHeaderCount = static_cast<qint64>( readUnsigned(fileHeader + (is64Bit ? 60 : 48), 2, littleEndian) );
+
+    if( sectionHeadersOffset > 0 ){
+      regions.push_back( {sectionHeadersOffset, sectionHeaderSize * sectionHeaderCount} );
+    }
+
+    /*
+     * The dynamic section is given by the PT_DYNAMIC program header
+     */
+    const qint64 minimumProgramHeaderSize = is64Bit ? 56 : 32;
+    const qint64 programHeadersSize = programHeaderSize * programHeaderCount;
+    if( (programHeaderSize < minimumProgramHeaderSize) || (programHeadersOffset <= 0) ){
+      return regions;
+    }
+    if( (programHeadersOffset + programHeadersSize) > headSize ){
+      return regions;
+    }
+    std::vector<unsigned char> programHeaders( static_cast<size_t>(programHeadersSize) );
+    if( !readRegion(fd, programHeadersOffset, programHeaders.data(), programHeadersSize) ){
+      return regions;
+    }
+    const quint64 dynamicSegmentType = 2;
+    for(qint64 i = 0; i < programHeaderCount; ++i){
+      const unsigned char *programHeader = programHeaders.data() + i * programHeaderSize;
+      if( readUnsigned(programHeader, 4, littleEndian) != dynamicSegmentType ){
+        continue;
+      }
+      const qint64 offset = static_cast<qint64>( readUnsigned(programHeader + (is64Bit ? 8 : 4), addressSize, littleEndian) );
+      const qint64 size = static_cast<qint64>( readUnsigned(programHeader + (is64Bit ? 32 : 16), addressSize, littleEndian) );
+      regions.push_back( {offset, size} );
+      break;
+    }
+
+    return regions;
+  }
+
+} // namespace{
+#endif // #ifdef Q_OS_LINUX
+
+void FilePrefetcher::setHeadSize(qint64 size) noexcept
+{
+  assert( size > 0 );
+
+  mHeadSize = size;
+}
+
+void FilePrefetcher::setTailSize(qint64 size) noexcept
+{
+  assert( size >= 0 );
+
+  mTailSize = size;
+}
+
+bool FilePrefetcher::prefetch(const QString & absoluteFilePath) noexcept
+{
+  assert( QDir::isAbsolutePath(absoluteFilePath) );
+
+#ifdef Q_OS_LINUX
+  const int fd = ::open(QFile::encodeName(absoluteFilePath).constData(), O_RDONLY | O_CLOEXEC);
+  if(fd < 0){
+    return false;
+  }
+
+  struct stat status;
+  if( ::fstat(fd, &status) != 0 ){
+    ::close(fd);
+    return false;
+  }
+
+  /*
+   * The head has allready been read by the shared library finder
+   * (it checks that the file is a valid shared library),
+   * so only the regions beyond it are prefetched.
+   *
+   * The pages requested by POSIX_FADV_WILLNEED
+   * are read in the page cache even after the file is closed
+   */
+  const qint64 fileSize = status.st_size;
+  std::vector<FileRegion> regions = elfRegionsToPrefetch(fd, std::min(fileSize, mHeadSize));
+  if(mTailSize > 0){
+    const qint64 tailOffset = std::max(qint64(0), fileSize - mTailSize);
+    regions.push_back( {tailOffset, fileSize - tailOffset} );
+  }
+  for(const FileRegion & region : regions){
+    // Values read from a corrupted file can be out of the file
+    if( (region.offset < 0) || (region.size <= 0) || (region.offset >= fileSize) ){
+      continue;
+    }
+    const qint64 begin = std::max(region.offset, mHeadSize);
+    const qint64 end = region.offset + std::min(region.size, fileSize - region.offset);
+    if(begin < end){
+      ::posix_fadvise( fd, static_cast<off_t>(begin), static_cast<off_t>(end - begin), POSIX_FADV_WILLNEED );
+    }
+  }
+
+  ::close(fd);
+  ++mPrefetchCount;
+
+  return true;
+#else
+  Q_UNUSED(absoluteFilePath)
+  return false;
+#endif // #ifdef Q_OS_LINUX
+}
+
+bool FilePrefetcher::isSupported() noexcept
+{
+#ifdef Q_OS_LINUX
+  return true;
+#else
+  return false;
+#endif // #ifdef Q_OS_LINUX
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_FILE_PREFETCHER_H
+#define MDT_DEPLOY_UTILS_FILE_PREFETCHER_H
+
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <QtGlobal>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Ask the operating system to read the regions of files ahead
+   *
+   * While finding dependencies, the path of a library is known
+   * some time before it is parsed:
+   * the libraries a file depends on are all located,
+   * then each of them is read.
+   *
+   * On a cold cache (network file system, container overlay, ...)
+   * each read stalls until the data comes from the disk.
+   * Prefetching the regions the parser will read
+   * as soon as the path is known lets the operating system
+   * load them in its page cache in the background.
+   *
+   * The head of the file is not prefetched:
+   * the shared library finder allready read it
+   * to check that the file is a valid shared library.
+   * Only the regions beyond the head are prefetched:
+   * for a ELF file, the dynamic section and the section headers
+   * (located from the file header and the program headers,
+   * which are in the head),
+   * and the tail of the file (section names for a typical ELF file).
+   *
+   * Prefetching is only a hint, failing to prefetch a file is not a error.
+   *
+   * \note Currently, prefetching is only supported on Linux,
+   * using posix_fadvise() with POSIX_FADV_WILLNEED .
+   * On other platforms, prefetch() does nothing.
+   *
+   * \sa BinaryDependencies
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT FilePrefetcher
+  {
+   public:
+
+    /*! \brief Set the size of the region at the beginning of each file that is not prefetched
+     *
+     * This region is considered allready in the page cache
+     * (including the read-ahead of the operating system).
+     *
+     * \pre \a size must be > 0
+     */
+    void setHeadSize(qint64 size) noexcept;
+
+    /*! \brief Get the size of the region at the beginning of each file that is not prefetched
+     */
+    qint64 headSize() const noexcept
+    {
+      return mHeadSize;
+    }
+
+    /*! \brief Set the size of the region to prefetch at the end of each file
+     *
+     * \pre \a size must be >= 0
+     */
+    void setTailSize(qint64 size) noexcept;
+
+    /*! \brief Get the size of the region to prefetch at the end of each file
+     */
+    qint64 tailSize() const noexcept
+    {
+      return mTailSize;
+    }
+
+    /*! \brief Prefetch the regions of \a absoluteFilePath that are beyond the head
+     *
+     * Returns true if the prefetch could be requested,
+     * false if prefetching is not supported or the file could not be opened.
+     *
+     * \pre \a absoluteFilePath must be a absolute file path
+     */
+    bool prefetch(const QString & absoluteFilePath) noexcept;
+
+    /*! \brief Get the count of files for which a prefetch has been requested
+     */
+    qint64 prefetchCount() const noexcept
+    {
+      return mPrefetchCount;
+    }
+
+    /*! \brief Check if prefetching is supported on the platform this library was built for
+     */
+    static
+    bool isSupported() noexcept;
+
+   private:
+
+    qint64 mHeadSize = 128*1024;
+    qint64 mTailSize = 64*1024;
+    qint64 mPrefetchCount = 0;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_FILE_PREFETCHER_H
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_FILE_STAT_BACKEND_H
+#define MDT_DEPLOY_UTILS_FILE_STAT_BACKEND_H
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Backend used to stat files
+   *
+   * \sa FileStatCache
+   */
+  enum class FileStatBackend
+  {
+    Synchronous,  /*!< Each file is stat'ed by a system call */
+    IoUring       /*!< Batches of files are stat'ed using io_uring (Linux only) */
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_FILE_STAT_BACKEND_H
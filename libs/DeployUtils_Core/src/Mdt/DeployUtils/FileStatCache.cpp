@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "FileStatCache.h"
+#include "Impl/IoUringFileStat.h"
+#include <QDir>
+#include <QDateTime>
+#include <QSet>
+#include <vector>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+FileStatCache::FileStatCache() noexcept
+{
+}
+
+FileStatCache::~FileStatCache() noexcept
+{
+}
+
+void FileStatCache::setBackend(FileStatBackend backend) noexcept
+{
+  if(backend == FileStatBackend::Synchronous){
+    mIoUring.reset();
+    return;
+  }
+  assert(backend == FileStatBackend::IoUring);
+
+  if(mIoUring){
+    return;
+  }
+  mIoUring = std::make_unique<Impl::IoUringFileStat>();
+  if( !mIoUring->isValid() ){
+    mIoUring.reset();
+  }
+}
+
+FileStatBackend FileStatCache::backend() const noexcept
+{
+  if(mIoUring){
+    return FileStatBackend::IoUring;
+  }
+  return FileStatBackend::Synchronous;
+}
+
+FileStat FileStatCache::stat(const QString & absoluteFilePath)
+{
+  assert( QDir::isAbsolutePath(absoluteFilePath) );
+
+  auto it = mStats.find(absoluteFilePath);
+  if( it != mStats.end() ){
+    ++mHitCount;
+    return *it;
+  }
+
+  ++mStatCount;
+  it = mStats.insert( absoluteFilePath, statFile(absoluteFilePath) );
+
+  return *it;
+}
+
+void FileStatCache::statFiles(const QStringList & absoluteFilePaths)
+{
+  QStringList pathsToStat;
+  QSet<QString> pathsToStatSet;
+  for(const QString & path : absoluteFilePaths){
+    assert( QDir::isAbsolutePath(path) );
+    if( mStats.contains(path) || pathsToStatSet.contains(path) ){
+      continue;
+    }
+    pathsToStat.append(path);
+    pathsToStatSet.insert(path);
+  }
+
+  if( pathsToStat.isEmpty() ){
+    return;
+  }
+
+  if(!mIoUring){
+    statFilesSynchronously(pathsToStat);
+    return;
+  }
+
+  std::vector<FileStat> stats;
+  if( !mIoUring->statFiles(pathsToStat, stats) ){
+    mIoUring.reset();
+    statFilesSynchronously(pathsToStat);
+    return;
+  }
+  assert( static_cast<int>( stats.size() ) == pathsToStat.count() );
+
+  ++mBatchCount;
+  mStatCount += pathsToStat.count();
+  for(int i = 0; i < pathsToStat.count(); ++i){
+    mStats.insert( pathsToStat.at(i), stats[static_cast<size_t>(i)] );
+  }
+}
+
+void FileStatCache::clear() noexcept
+{
+  mStats.clear();
+  mStatCount = 0;
+  mHitCount = 0;
+  mBatchCount = 0;
+}
+
+bool FileStatCache::isBackendAvailable(FileStatBackend backend) noexcept
+{
+  if(backend == FileStatBackend::Synchronous){
+    return true;
+  }
+  assert(backend == FileStatBackend::IoUring);
+
+  if( !Impl::IoUringFileStat::isSupported() ){
+    return false;
+  }
+
+  return Impl::IoUringFileStat().isValid();
+}
+
+FileStat FileStatCache::statFile(const QString & absoluteFilePath) noexcept
+{
+  assert( QDir::isAbsolutePath(absoluteFilePath) );
+
+  // A fresh QFileInfo, so we get no informations cached by a other one
+  const QFileInfo fileInfo(absoluteFilePath);
+
+  FileStat stat;
+  if( !fileInfo.exists() ){
+    return stat;
+  }
+  stat.exists = true;
+  stat.isFile = fileInfo.isFile();
+  stat.size = fileInfo.size();
+  stat.lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+  return stat;
+}
+
+void FileStatCache::statFilesSynchronously(const QStringList & absoluteFilePaths)
+{
+  for(const QString & path : absoluteFilePaths){
+    ++mStatCount;
+    mStats.insert( path, statFile(path) );
+  }
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
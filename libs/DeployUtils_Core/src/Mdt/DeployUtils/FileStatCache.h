@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_FILE_STAT_CACHE_H
+#define MDT_DEPLOY_UTILS_FILE_STAT_CACHE_H
+
+#include "FileStatBackend.h"
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <QStringList>
+#include <QFileInfo>
+#include <QHash>
+#include <QtGlobal>
+#include <memory>
+
+namespace Mdt{ namespace DeployUtils{
+
+  namespace Impl{
+    class IoUringFileStat;
+  } // namespace Impl{
+
+  /*! \brief Result of a stat of a file
+   *
+   * \sa FileStatCache
+   */
+  struct MDT_DEPLOYUTILSCORE_EXPORT FileStat
+  {
+    /*! \brief True if the file exists
+     */
+    bool exists = false;
+
+    /*! \brief True if the file exists and is a regular file (or a link to it)
+     */
+    bool isFile = false;
+
+    /*! \brief Size of the file, -1 if it does not exist
+     */
+    qint64 size = -1;
+
+    /*! \brief Last modification time in ms since epoch, -1 if the file does not exist
+     */
+    qint64 lastModified = -1;
+  };
+
+  /*! \brief Cache of stats of files for a run
+   *
+   * While finding dependencies, the same file is checked
+   * many times (does it exist, what is its size and modification time
+   * to validate a ExecutableFileMetadataCache entry, ...).
+   * Each of those checks is a stat on the file system.
+   *
+   * With this cache, shared by the parts that need it,
+   * each path is stat'ed at most once.
+   *
+   * This cache does not detect changes on the file system,
+   * so it should only live for a run
+   * (unlike ExecutableFileMetadataCache, that can live for the whole process).
+   *
+   * The files that will probably be needed soon
+   * (for example, the next candidate path of each library to find)
+   * can be stat'ed at once with statFiles().
+   * With the FileStatBackend::IoUring backend,
+   * those are submitted to the kernel in batches.
+   *
+   * \sa BinaryDependencies
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT FileStatCache
+  {
+   public:
+
+    /*! \brief Construct a empty cache using the synchronous backend
+     */
+    FileStatCache() noexcept;
+
+    /*! \brief Destruct this cache
+     */
+    ~FileStatCache() noexcept;
+
+    FileStatCache(const FileStatCache &) = delete;
+    FileStatCache & operator=(const FileStatCache &) = delete;
+    FileStatCache(FileStatCache &&) = delete;
+    FileStatCache & operator=(FileStatCache &&) = delete;
+
+    /*! \brief Set the backend used by statFiles()
+     *
+     * If \a backend is not available on this host,
+     * the synchronous backend is used.
+     *
+     * \sa backend()
+     * \sa isBackendAvailable()
+     */
+    void setBackend(FileStatBackend backend) noexcept;
+
+    /*! \brief Get the backend used by statFiles()
+     *
+     * Returns the backend that is really used,
+     * which can be different from the one passed to setBackend().
+     */
+    FileStatBackend backend() const noexcept;
+
+    /*! \brief Get the stat for \a absoluteFilePath
+     *
+     * The file is stat'ed if it is not already in this cache.
+     *
+     * \pre \a absoluteFilePath must be a absolute file path
+     */
+    FileStat stat(const QString & absoluteFilePath);
+
+    /*! \brief Get the stat for \a file
+     *
+     * \pre \a file must be a absolute file path
+     * \sa stat(const QString &)
+     */
+    FileStat stat(const QFileInfo & file)
+    {
+      return stat( file.absoluteFilePath() );
+    }
+
+    /*! \brief Stat the files in \a absoluteFilePaths that are not already in this cache
+     *
+     * Does not return anything,
+     * the stats are then taken from this cache by stat().
+     *
+     * If the io_uring backend fails while processing a batch,
+     * the remaining files are stat'ed synchronously
+     * and the synchronous backend is used from now.
+     *
+     * \pre each path in \a absoluteFilePaths must be a absolute file path
+     */
+    void statFiles(const QStringList & absoluteFilePaths);
+
+    /*! \brief Remove the stat for \a absoluteFilePath from this cache
+     *
+     * Should be called after \a absoluteFilePath has been written.
+     */
+    void invalidate(const QString & absoluteFilePath) noexcept
+    {
+      mStats.remove(absoluteFilePath);
+    }
+
+    /*! \brief Get the count of files in this cache
+     */
+    int count() const noexcept
+    {
+      return mStats.count();
+    }
+
+    /*! \brief Check if this cache is empty
+     */
+    bool isEmpty() const noexcept
+    {
+      return mStats.isEmpty();
+    }
+
+    /*! \brief Get the count of stats done on the file system
+     */
+    qint64 statCount() const noexcept
+    {
+      return mStatCount;
+    }
+
+    /*! \brief Get the count of stats that have been taken from this cache
+     */
+    qint64 hitCount() const noexcept
+    {
+      return mHitCount;
+    }
+
+    /*! \brief Get the count of batches submitted by statFiles()
+     */
+    qint64 batchCount() const noexcept
+    {
+      return mBatchCount;
+    }
+
+    /*! \brief Clear this cache
+     *
+     * Also resets the statistics.
+     * The backend is not changed.
+     */
+    void clear() noexcept;
+
+    /*! \brief Check if \a backend can be used on this host
+     *
+     * The synchronous backend is always available.
+     * For the io_uring backend, a submission queue is set up,
+     * which can fail for example on old kernels
+     * or in containers that forbid io_uring.
+     */
+    static
+    bool isBackendAvailable(FileStatBackend backend) noexcept;
+
+    /*! \brief Stat given file
+     *
+     * Does not use any cache.
+     *
+     * \pre \a absoluteFilePath must be a absolute file path
+     */
+    static
+    FileStat statFile(const QString & absoluteFilePath) noexcept;
+
+   private:
+
+    void statFilesSynchronously(const QStringList & absoluteFilePaths);
+
+    QHash<QString, FileStat> mStats;
+    qint64 mStatCount = 0;
+    qint64 mHitCount = 0;
+    qint64 mBatchCount = 0;
+    std::unique_ptr<Impl::IoUringFileStat> mIoUring;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_FILE_STAT_CACHE_H
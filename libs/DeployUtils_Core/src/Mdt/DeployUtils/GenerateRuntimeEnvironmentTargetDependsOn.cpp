@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "GenerateRuntimeEnvironmentTargetDependsOn.h"
+#include "SharedLibrariesDeployer.h"
+#include "QtDistributionDirectory.h"
+#include "PathList.h"
+#include "LibraryRedistributionPolicyReader.h"
+#include "RuntimeEnvironment.h"
+#include "RuntimeEnvironmentWriter.h"
+#include "DepFileWriter.h"
+#include "FindDependencyError.h"
+#include <QFileInfo>
+#include <QStringList>
+#include <QLatin1String>
+#include <memory>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+void GenerateRuntimeEnvironmentTargetDependsOn::execute(const GenerateRuntimeEnvironmentTargetDependsOnRequest & request)
+{
+  assert( !request.targetFilePath.trimmed().isEmpty() );
+  assert( !request.environmentFilePath.trimmed().isEmpty() );
+
+  auto qtDistributionDirectory = std::make_shared<QtDistributionDirectory>();
+
+  SharedLibrariesDeployer shLibDeployer(qtDistributionDirectory);
+  connect(&shLibDeployer, &SharedLibrariesDeployer::statusMessage, this, &GenerateRuntimeEnvironmentTargetDependsOn::statusMessage);
+  connect(&shLibDeployer, &SharedLibrariesDeployer::verboseMessage, this, &GenerateRuntimeEnvironmentTargetDependsOn::verboseMessage);
+  connect(&shLibDeployer, &SharedLibrariesDeployer::debugMessage, this, &GenerateRuntimeEnvironmentTargetDependsOn::debugMessage);
+
+  shLibDeployer.setSearchPrefixPathList( PathList::fromStringList(request.searchPrefixPathList) );
+  shLibDeployer.setMetadataCache(mMetadataCache);
+  shLibDeployer.setFileStatBackend(mFileStatBackend);
+  shLibDeployer.setLogLevel(mLogLevel);
+  shLibDeployer.setMessageSink(mMessageSink);
+
+  if( !request.compilerLocation.isNull() ){
+    shLibDeployer.setCompilerLocation(request.compilerLocation);
+  }
+
+  if( !request.redistributionPolicyFilePath.isEmpty() ){
+    LibraryRedistributionPolicyReader policyReader;
+    connect(&policyReader, &LibraryRedistributionPolicyReader::verboseMessage, this, &GenerateRuntimeEnvironmentTargetDependsOn::verboseMessage);
+    const QFileInfo policyFile( QFileInfo(request.redistributionPolicyFilePath).absoluteFilePath() );
+    shLibDeployer.setRedistributionPolicy( policyReader.readFile(policyFile) );
+  }
+
+  const QFileInfo target( QFileInfo(request.targetFilePath).absoluteFilePath() );
+  const BinaryDependenciesResult dependencies = shLibDeployer.findSharedLibrariesTargetDependsOn(target);
+  if( !dependencies.isSolved() ){
+    throwDependenciesNotSolvedError(dependencies);
+  }
+
+  const RuntimeEnvironment environment = RuntimeEnvironment::fromDependencies(dependencies);
+
+  emit statusMessage(
+    tr("generating runtime environment for %1")
+    .arg( target.fileName() )
+  );
+
+  const QString environmentFilePath = QFileInfo(request.environmentFilePath).absoluteFilePath();
+
+  RuntimeEnvironmentWriter environmentWriter;
+  connect(&environmentWriter, &RuntimeEnvironmentWriter::verboseMessage, this, &GenerateRuntimeEnvironmentTargetDependsOn::verboseMessage);
+  environmentWriter.writeFile(environment, environmentFilePath);
+
+  if( !request.depFilePath.isEmpty() ){
+    DepFileWriter depFileWriter;
+    connect(&depFileWriter, &DepFileWriter::verboseMessage, this, &GenerateRuntimeEnvironmentTargetDependsOn::verboseMessage);
+    const QStringList dependencyFilePaths = QStringList{target.absoluteFilePath()} + getFoundLibrariesFilePathList(dependencies);
+    depFileWriter.writeDepFile( QFileInfo(request.depFilePath).absoluteFilePath(), environmentFilePath, dependencyFilePaths );
+  }
+}
+
+void GenerateRuntimeEnvironmentTargetDependsOn::throwDependenciesNotSolvedError(const BinaryDependenciesResult & dependencies) const
+{
+  assert( !dependencies.isSolved() );
+
+  QStringList missingLibraries;
+  for(const BinaryDependenciesResultLibrary & library : dependencies){
+    if( library.isMissing() ){
+      missingLibraries.append( library.libraryName() );
+    }
+  }
+
+  const QString msg = tr("some shared libraries could not be found for %1: %2")
+                      .arg( dependencies.target().fileName(), missingLibraries.join( QLatin1String(", ") ) );
+  throw FindDependencyError(msg);
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
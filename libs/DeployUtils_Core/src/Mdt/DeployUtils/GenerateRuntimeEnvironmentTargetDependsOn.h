@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_GENERATE_RUNTIME_ENVIRONMENT_TARGET_DEPENDS_ON_H
+#define MDT_DEPLOY_UTILS_GENERATE_RUNTIME_ENVIRONMENT_TARGET_DEPENDS_ON_H
+
+#include "GenerateRuntimeEnvironmentTargetDependsOnRequest.h"
+#include "ExecutableFileMetadataCache.h"
+#include "FileStatBackend.h"
+#include "LogLevel.h"
+#include "AbstractMessageSink.h"
+#include "BinaryDependenciesResult.h"
+#include "mdt_deployutilscore_export.h"
+#include <QObject>
+#include <QString>
+#include <memory>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Generate the environment to run a target without copying the shared libraries it depends on
+   *
+   * Some variables that figure here are taken from GenerateRuntimeEnvironmentTargetDependsOnRequest .
+   *
+   * The shared libraries the target depends on are found
+   * the same way CopySharedLibrariesTargetDependsOn does,
+   * but, instead of copying the ones that have to be redistributed,
+   * the directories where they are found are written to \a environmentFilePath .
+   * For example, on Linux:
+   * \code
+   * LD_LIBRARY_PATH=/opt/qt/lib:/home/me/build/libs
+   * \endcode
+   *
+   * The directories are ordered so that the loader finds
+   * the same files that would have been copied.
+   * \sa RuntimeEnvironment::fromLibraries()
+   *
+   * If \a depFilePath is set, a depfile is also written.
+   * It lists the target and every shared library that has been found,
+   * as dependencies of \a environmentFilePath .
+   * \sa DepFileWriter
+   *
+   * This is mainly useful to run tests in the build tree.
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT GenerateRuntimeEnvironmentTargetDependsOn : public QObject
+  {
+   Q_OBJECT
+
+  public:
+
+    /*! \brief Constructor
+     */
+    explicit GenerateRuntimeEnvironmentTargetDependsOn(QObject *parent = nullptr)
+     : QObject(parent)
+    {
+    }
+
+    /*! \brief Set a metadata cache
+     *
+     * \sa BinaryDependencies::setMetadataCache()
+     */
+    void setMetadataCache(const std::shared_ptr<ExecutableFileMetadataCache> & cache) noexcept
+    {
+      mMetadataCache = cache;
+    }
+
+    /*! \brief Set the backend used to stat files
+     *
+     * \sa BinaryDependencies::setFileStatBackend()
+     */
+    void setFileStatBackend(FileStatBackend backend) noexcept
+    {
+      mFileStatBackend = backend;
+    }
+
+    /*! \brief Set the log level
+     *
+     * \sa BinaryDependencies::setLogLevel()
+     */
+    void setLogLevel(LogLevel level) noexcept
+    {
+      mLogLevel = level;
+    }
+
+    /*! \brief Set a message sink
+     *
+     * \sa BinaryDependencies::setMessageSink()
+     */
+    void setMessageSink(const std::shared_ptr<AbstractMessageSink> & sink) noexcept
+    {
+      mMessageSink = sink;
+    }
+
+    /*! \brief Generate the runtime environment for a target
+     *
+     * \pre request's \a targetFilePath must be specified
+     * \pre request's \a environmentFilePath must be specified
+     *
+     * \exception FindCompilerError
+     * \exception FileOpenError
+     * \exception ExecutableFileReadError
+     * \exception ReadLibraryRedistributionPolicyError
+     * \exception FindDependencyError
+     * \exception WriteRuntimeEnvironmentError
+     * \exception WriteDepFileError
+     */
+    void execute(const GenerateRuntimeEnvironmentTargetDependsOnRequest & request);
+
+   signals:
+
+    void statusMessage(const QString & message) const;
+    void verboseMessage(const QString & message) const;
+    void debugMessage(const QString & message) const;
+
+   private:
+
+    void throwDependenciesNotSolvedError(const BinaryDependenciesResult & dependencies) const;
+
+    std::shared_ptr<ExecutableFileMetadataCache> mMetadataCache;
+    FileStatBackend mFileStatBackend = FileStatBackend::Synchronous;
+    LogLevel mLogLevel = LogLevel::Debug;
+    std::shared_ptr<AbstractMessageSink> mMessageSink;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_GENERATE_RUNTIME_ENVIRONMENT_TARGET_DEPENDS_ON_H
@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_GENERATE_RUNTIME_ENVIRONMENT_TARGET_DEPENDS_ON_REQUEST_H
+#define MDT_DEPLOY_UTILS_GENERATE_RUNTIME_ENVIRONMENT_TARGET_DEPENDS_ON_REQUEST_H
+
+#include "CompilerLocationRequest.h"
+#include "mdt_deployutilscore_export.h"
+#include <QStringList>
+#include <QString>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief DTO for GenerateRuntimeEnvironmentTargetDependsOn
+   */
+  struct MDT_DEPLOYUTILSCORE_EXPORT GenerateRuntimeEnvironmentTargetDependsOnRequest
+  {
+    CompilerLocationRequest compilerLocation;
+    QStringList searchPrefixPathList;
+    QString redistributionPolicyFilePath;
+    QString targetFilePath;
+    QString environmentFilePath;
+    QString depFilePath;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_GENERATE_RUNTIME_ENVIRONMENT_TARGET_DEPENDS_ON_REQUEST_H
@@ -10,54 +10,66 @@
 #define MDT_DEPLOY_UTILS_IMPL_BINARY_DEPENDENCIES_DISCOVERED_DEPENDENCIES_LIST_H
 
 #include "GraphFile.h"
-#include "FileComparison.h"
-
-// #include "Mdt/DeployUtils/FileInfoUtils.h"
-
-#include "Mdt/DeployUtils/OperatingSystem.h"
+#include "GraphDef.h"
+#include "LibraryNameTable.h"
 #include <QString>
 #include <QStringList>
 #include <vector>
-#include <algorithm>
+#include <unordered_set>
+#include <utility>
 #include <cassert>
 
 namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependencies{
 
   /*! \internal Helper class to store discovered dependencies while building a binary dependencies graph
+   *
+   * The dependent file is referenced by its vertex in the graph,
+   * the file names are stored as ids of a LibraryNameTable .
    */
   class DiscoveredDependencies
   {
    public:
 
     /*! \brief Constructor
+     *
+     * \pre \a dependencies must not be empty
      */
     explicit
-    DiscoveredDependencies(const GraphFile & file, const QStringList & dependencies) noexcept
-     : mDependentFileName( file.fileName() ),
-       mDependenciesFileNames(dependencies)
+    DiscoveredDependencies(VertexDescriptor dependentVertex, LibraryNameId dependentFileNameId,
+                           std::vector<LibraryNameId> && dependencies) noexcept
+     : mDependentVertex(dependentVertex),
+       mDependentFileNameId(dependentFileNameId),
+       mDependenciesFileNameIds( std::move(dependencies) )
+    {
+      assert( !mDependenciesFileNameIds.empty() );
+    }
+
+    /*! \brief Get the vertex of the dependent file
+     */
+    VertexDescriptor dependentVertex() const noexcept
     {
-      assert( file.hasFileName() );
-      assert( !dependencies.isEmpty() );
+      return mDependentVertex;
     }
 
-    /*! \brief Get the dependent file name
+    /*! \brief Get the dependent file name id
      */
-    const QString & dependentFileName() const noexcept
+    LibraryNameId dependentFileNameId() const noexcept
     {
-      return mDependentFileName;
+      return mDependentFileNameId;
     }
 
-    /*! \brief Get the list of dependencies of this file
+    /*! \brief Get the list of dependencies ids of this file
      */
-    const QStringList & dependenciesFileNames() const noexcept
+    const std::vector<LibraryNameId> & dependenciesFileNameIds() const noexcept
     {
-      return mDependenciesFileNames;
+      return mDependenciesFileNameIds;
     }
 
    private:
 
-    QString mDependentFileName;
-    QStringList mDependenciesFileNames;
+    VertexDescriptor mDependentVertex;
+    LibraryNameId mDependentFileNameId;
+    std::vector<LibraryNameId> mDependenciesFileNameIds;
   };
 
   /*! \internal Helper class to store a list discovered dependencies while building a binary dependencies graph
@@ -72,13 +84,22 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
 
     /*! \brief Construct a list
      *
-     * \pre \a os must be valid
+     * The names of the discovered files are added to \a libraryNameTable ,
+     * which must be the one of the graph the dependencies will be added to.
+     *
+     * \sa Graph::libraryNameTable()
      */
     explicit
-    DiscoveredDependenciesList(OperatingSystem os) noexcept
-     : mOs(os)
+    DiscoveredDependenciesList(LibraryNameTable & libraryNameTable) noexcept
+     : mLibraryNameTable(libraryNameTable)
     {
-      assert( mOs != OperatingSystem::Unknown );
+    }
+
+    /*! \brief Get the library name table of this list
+     */
+    const LibraryNameTable & libraryNameTable() const noexcept
+    {
+      return mLibraryNameTable;
     }
 
     /*! \brief Check if this list is empty
@@ -134,56 +155,66 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
       return cend();
     }
 
-    /*! \brief Check if this list contains given dependent file
+    /*! \brief Get the dependent file name of the element at \a index
      *
-     * \pre \a file must have its file name
+     * \pre \a index must be in valid range
      */
-    bool containsDependentFile(const GraphFile & file) const noexcept
+    const QString & dependentFileNameAt(size_t index) const noexcept
     {
-      assert( file.hasFileName() );
+      assert( index < size() );
 
-      const QString fileName = file.fileName();
-      const OperatingSystem os = mOs;
-      const auto pred = [&fileName, os](const DiscoveredDependencies & dependencies){
-        return fileNamesAreEqual(dependencies.dependentFileName(), fileName, os);
-      };
+      return mLibraryNameTable.name( mList[index].dependentFileNameId() );
+    }
 
-      const auto it = std::find_if(cbegin(), cend(), pred);
+    /*! \brief Get the dependencies file names of the element at \a index
+     *
+     * \pre \a index must be in valid range
+     */
+    QStringList dependenciesFileNamesAt(size_t index) const noexcept
+    {
+      assert( index < size() );
 
-      return it != cend();
+      return mLibraryNameTable.names( mList[index].dependenciesFileNameIds() );
+    }
+
+    /*! \brief Check if this list contains given dependent vertex
+     */
+    bool containsDependentVertex(VertexDescriptor v) const noexcept
+    {
+      return mDependentVertices.find(v) != mDependentVertices.cend();
     }
 
     /*! \brief Set the direct dependencies for given file
      *
-     * Design choice:
-     * Here we pass a file as the one depending on given dependencies.
-     * This requires later to find the vertex associated with this file
-     * by searching by file name.
-     * But notice that this search has to be done anyway for given dependencies.
-     * They are just file names extracted from a executable (wich can be a shared library).
-     * So, it should be check if this overheat is significant before brining a vertex here !
+     * \a dependentVertex is the vertex of \a file in the graph.
+     * It is passed to Graph::addDependencies(),
+     * so the dependent file has not to be searched again.
+     *
+     * The names of each dependency are added
+     * to the library name table.
      *
      * \note If given file already exists in this list,
      * nothing is done.
      * It is assumed that the same file will have the same dependencies.
      *
-     * \pre \a file must have its file name
+     * \pre \a file must have its name id
+     * \sa GraphFile::hasNameId()
      * \pre each file name in \a dependencies must not be empty
      * \note It is allowed that \a dependencies is a empty list,
      * in which case nothing is added
      */
-    void setDirectDependenciesFileNames(const GraphFile & file, const QStringList & dependencies) noexcept
+    void setDirectDependenciesFileNames(VertexDescriptor dependentVertex, const GraphFile & file, const QStringList & dependencies) noexcept
     {
-      assert( file.hasFileName() );
+      assert( file.hasNameId() );
 
-      if( containsDependentFile(file) ){
+      if( dependencies.isEmpty() ){
         return;
       }
-      if( dependencies.isEmpty() ){
+      if( !mDependentVertices.insert(dependentVertex).second ){
         return;
       }
 
-      mList.emplace_back(file, dependencies);
+      mList.emplace_back( dependentVertex, file.nameId(), mLibraryNameTable.intern(dependencies) );
     }
 
     /*! \brief clear this list
@@ -191,12 +222,14 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
     void clear() noexcept
     {
       mList.clear();
+      mDependentVertices.clear();
     }
 
    private:
 
-    OperatingSystem mOs;
+    LibraryNameTable & mLibraryNameTable;
     std::vector<DiscoveredDependencies> mList;
+    std::unordered_set<VertexDescriptor> mDependentVertices;
   };
 
 }}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependencies{
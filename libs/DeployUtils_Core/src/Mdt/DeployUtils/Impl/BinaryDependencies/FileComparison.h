@@ -37,6 +37,26 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
     return QString::compare(a, b, cs) == 0;
   }
 
+  /*! \internal Get a key to compare given file name in a hash table
+   *
+   * Two file names have the same key if fileNamesAreEqual() returns true for them.
+   *
+   * \pre \a fileName must not be empty
+   * \pre \a os must be valid
+   */
+  inline
+  QString fileNameComparisonKey(const QString & fileName, OperatingSystem os) noexcept
+  {
+    assert( !fileName.trimmed().isEmpty() );
+    assert( os != OperatingSystem::Unknown );
+
+    if(os == OperatingSystem::Windows){
+      return fileName.toCaseFolded();
+    }
+
+    return fileName;
+  }
+
 }}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependencies{
 
 #endif // #ifndef MDT_DEPLOY_UTILS_IMPL_BINARY_DEPENDENCIES_FILE_COMPARISON_H
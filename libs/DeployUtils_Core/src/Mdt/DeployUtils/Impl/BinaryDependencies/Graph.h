@@ -13,12 +13,17 @@
 #include "GraphBuildVisitor.h"
 #include "FileComparison.h"
 #include "DiscoveredDependenciesList.h"
+#include "LibraryNameTable.h"
 #include "GraphResultVisitor.h"
+#include "GraphTransitiveClosure.h"
 #include "Mdt/DeployUtils/Platform.h"
 #include "Mdt/DeployUtils/AbstractSharedLibraryFinder.h"
 #include "Mdt/DeployUtils/BinaryDependenciesResult.h"
 #include "Mdt/DeployUtils/BinaryDependenciesResultList.h"
 #include "Mdt/DeployUtils/FileInfoUtils.h"
+#include "Mdt/DeployUtils/ExecutableFileMetadataCache.h"
+#include "Mdt/DeployUtils/FileStatCache.h"
+#include "Mdt/DeployUtils/FilePrefetcher.h"
 #include "mdt_deployutilscore_export.h"
 #include <QObject>
 #include <QString>
@@ -26,6 +31,7 @@
 #include <QFileInfoList>
 #include <boost/graph/breadth_first_search.hpp>
 #include <optional>
+#include <memory>
 #include <vector>
 #include <algorithm>
 #include <cassert>
@@ -139,7 +145,7 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
    * we should process starting from \a app .
    *
    * \code
-   * DiscoveredDependenciesList discoveredDependenciesList(os);
+   * DiscoveredDependenciesList discoveredDependenciesList( graph.libraryNameTable() );
    * // Reference the discovered dependencies, because the visitor must be cheep to copy
    * GraphBuildVisitor visitor(discoveredDependenciesList,...,...);
    * graph.addFile(target);
@@ -163,7 +169,9 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
    *
    * This solution works.
    * The complexity is not so good.
-   * - we have to find vertices by file names over and over.
+   * - we have to find vertices by file names over and over
+   *   (each name is added once to a LibraryNameTable ,
+   *   then vertices are found by name id, which is a index).
    * - we traverse the entier graph over and over
    *
    * But, keep in mind that this graph should not be huge
@@ -210,13 +218,73 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
      */
     explicit
     Graph(const Platform & platform) noexcept
-    : mPlatform(platform)
+    : mPlatform(platform),
+      mLibraryNameTable( platform.operatingSystem() )
     {
       assert( !mPlatform.isNull() );
     }
 
     /// \todo disable copy
 
+    /*! \brief Set a metadata cache
+     *
+     * If set, findTransitiveDependencies() will take
+     * the direct dependencies and rpath of files from \a cache if possible,
+     * and put the ones it reads to it.
+     *
+     * \sa ExecutableFileMetadataCache
+     */
+    void setMetadataCache(const std::shared_ptr<ExecutableFileMetadataCache> & cache) noexcept
+    {
+      mMetadataCache = cache;
+    }
+
+    /*! \brief Set a file stat cache
+     *
+     * If set, findTransitiveDependencies() will use it
+     * to validate the entries of the metadata cache.
+     * It should be the same as the one used by the shared library finder,
+     * so each file is stat'ed at most once.
+     *
+     * If \a cache uses the io_uring backend,
+     * findTransitiveDependencies() also stat's the candidate files
+     * of all the libraries to find in a batch before each pass.
+     *
+     * \sa FileStatCache
+     */
+    void setFileStatCache(const std::shared_ptr<FileStatCache> & cache) noexcept
+    {
+      mFileStatCache = cache;
+    }
+
+    /*! \brief Set a file prefetcher
+     *
+     * If set, findTransitiveDependencies() will prefetch each library
+     * as soon as its path is found, before it is read.
+     *
+     * \sa FilePrefetcher
+     */
+    void setFilePrefetcher(const std::shared_ptr<FilePrefetcher> & prefetcher) noexcept
+    {
+      mFilePrefetcher = prefetcher;
+    }
+
+    /*! \brief Get the library name table of this graph
+     *
+     * Each file of this graph has its name in this table.
+     */
+    LibraryNameTable & libraryNameTable() noexcept
+    {
+      return mLibraryNameTable;
+    }
+
+    /*! \brief Get the library name table of this graph
+     */
+    const LibraryNameTable & libraryNameTable() const noexcept
+    {
+      return mLibraryNameTable;
+    }
+
     /*! \brief Find a vertex by given file name
      *
      * \pre \a fileName must not be empty
@@ -225,21 +293,28 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
     {
       assert( !fileName.trimmed().isEmpty() );
 
-      const OperatingSystem os = mPlatform.operatingSystem();
-      const GraphAL & graph = mGraph;
+      const auto id = mLibraryNameTable.find(fileName);
+      if( !id.has_value() ){
+        return {};
+      }
 
-      const auto pred = [&fileName, os, &graph](VertexDescriptor v){
-        return fileNamesAreEqual(graph[v].fileName(), fileName, os);
-      };
+      return findVertex(*id);
+    }
 
-      const auto itRange = boost::vertices(graph);
-      const auto it = std::find_if(itRange.first, itRange.second, pred);
+    /*! \brief Find a vertex by given file name id
+     */
+    std::optional<VertexDescriptor> findVertex(LibraryNameId fileNameId) const noexcept
+    {
+      if( fileNameId >= mVertexByNameId.size() ){
+        return {};
+      }
 
-      if(it == itRange.second){
+      const VertexDescriptor v = mVertexByNameId[fileNameId];
+      if( v == boost::graph_traits<GraphAL>::null_vertex() ){
         return {};
       }
 
-      return *it;
+      return v;
     }
 
     /*! \brief Get the count of files in this graph
@@ -278,7 +353,7 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
         return;
       }
 
-      const VertexDescriptor v = boost::add_vertex( GraphFile::fromQFileInfo(file), mGraph );
+      const VertexDescriptor v = addVertex( GraphFile::fromQFileInfo(file) );
       mTargetVertexList.push_back(v);
     }
 
@@ -311,7 +386,7 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
         return *candidateVertex;
       }
 
-      return boost::add_vertex(file, mGraph);
+      return addVertex(file);
     }
 
     /*! \brief Add given dependencies to this graph
@@ -328,14 +403,15 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
      */
     void addDependencies(const DiscoveredDependencies & dependencies) noexcept
     {
-      assert( containsFileName( dependencies.dependentFileName() ) );
-
-      const auto parentVertex = findVertex( dependencies.dependentFileName() );
-      assert( parentVertex.has_value() );
-
-      for( const QString & libraryName : dependencies.dependenciesFileNames() ){
-        VertexDescriptor libraryVertex = addFile( GraphFile::fromLibraryName(libraryName) );
-        boost::add_edge(*parentVertex, libraryVertex, mGraph);
+      const VertexDescriptor parentVertex = dependencies.dependentVertex();
+      assert( parentVertex < fileCount() );
+
+      for( const LibraryNameId libraryNameId : dependencies.dependenciesFileNameIds() ){
+        auto libraryVertex = findVertex(libraryNameId);
+        if( !libraryVertex.has_value() ){
+          libraryVertex = addVertex( GraphFile::fromLibraryName( mLibraryNameTable.name(libraryNameId) ) );
+        }
+        boost::add_edge(parentVertex, *libraryVertex, mGraph);
       }
     }
 
@@ -343,10 +419,13 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
      *
      * \pre For each set in \a dependencies ,
      * the dependent file must exist in this graph
+     * \pre \a dependencies must use the library name table of this graph
      * \sa addDependencies(const DiscoveredDependencies &)
      */
     void addDependencies(const DiscoveredDependenciesList & dependencies) noexcept
     {
+      assert( &dependencies.libraryNameTable() == &mLibraryNameTable );
+
       for(const auto & item : dependencies){
         addDependencies(item);
       }
@@ -380,6 +459,9 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
     }
 
     /*! \brief Find transitive dependencies for files in this graph
+     *
+     * Each time the absolute path of a library to redistribute is found,
+     * sharedLibraryFound() is emitted.
      *
      * \pre This graph must have at least one file
      * \sa addTarget()
@@ -390,14 +472,21 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
     {
       assert( fileCount() > 0 );
 
-      DiscoveredDependenciesList discoveredDependenciesList( mPlatform.operatingSystem() );
+      DiscoveredDependenciesList discoveredDependenciesList(mLibraryNameTable);
       GraphBuildVisitorWorker visitorWorker(shLibFinder, mPlatform, discoveredDependenciesList);
+      connect(&visitorWorker, &GraphBuildVisitorWorker::sharedLibraryFound, this, &Graph::sharedLibraryFound);
       connect(&visitorWorker, &GraphBuildVisitorWorker::verboseMessage, this, &Graph::verboseMessage);
       connect(&visitorWorker, &GraphBuildVisitorWorker::debugMessage, this, &Graph::debugMessage);
+      visitorWorker.setMetadataCache( mMetadataCache.get() );
+      visitorWorker.setFileStatCache( mFileStatCache.get() );
+      visitorWorker.setFilePrefetcher( mFilePrefetcher.get() );
+      visitorWorker.setLogLevel( shLibFinder.logLevel() );
+      visitorWorker.setMessageSink( shLibFinder.messageSink() );
       GraphBuildVisitor<Reader> visitor(visitorWorker, reader, mGraph);
 
       do{
         discoveredDependenciesList.clear();
+        visitorWorker.statCandidateFiles(mGraph);
         findDependencies(visitor);
         addDependencies(discoveredDependenciesList);
       }while( !discoveredDependenciesList.isEmpty() );
@@ -426,19 +515,58 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
       return result;
     }
 
+    /*! \brief Get a result for given target from a precomputed closure
+     *
+     * The libraries of the result are in the order
+     * they have been added to this graph.
+     *
+     * \pre \a target must be an absolute path to a file
+     * \sa fileInfoIsAbsolutePath()
+     * \pre \a target must exist in this graph
+     * \pre \a closure must have been computed for this graph,
+     *  and no file must have been added since
+     */
+    BinaryDependenciesResult getResult(const QFileInfo & target, const GraphTransitiveClosure & closure) const noexcept
+    {
+      assert( fileInfoIsAbsolutePath(target) );
+      assert( closure.fileCount() == fileCount() );
+
+      const OperatingSystem os = mPlatform.operatingSystem();
+      BinaryDependenciesResult result(target, os);
+
+      const auto u = findVertex( target.fileName() );
+      assert( u.has_value() );
+
+      const auto & reachable = closure.reachableFrom(*u);
+      for(auto v = reachable.find_first(); v != reachable.npos; v = reachable.find_next(v)){
+        if(v == *u){
+          continue;
+        }
+        addGraphLibraryToResult(mGraph[v], result);
+      }
+
+      return result;
+    }
+
     /*! \brief Get a list of results for given targets
+     *
+     * The transitive closure of this graph is computed once,
+     * then each result is made from it,
+     * so the graph is not traversed once per target.
      *
      * \pre each target in \a targets must be an absolute path to a file
      * \sa fileInfoIsAbsolutePath()
-     * \sa getResult()
+     * \sa GraphTransitiveClosure
      */
     BinaryDependenciesResultList getResultList(const QFileInfoList & targets) const noexcept
     {
       BinaryDependenciesResultList resultList( mPlatform.operatingSystem() );
 
+      const GraphTransitiveClosure closure(mGraph);
+
       for(const QFileInfo & target : targets){
         assert( fileInfoIsAbsolutePath(target) );
-        resultList.addResult( getResult(target) );
+        resultList.addResult( getResult(target, closure) );
       }
 
       return resultList;
@@ -453,14 +581,39 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
 
    signals:
 
+    /*! \brief Emitted by findTransitiveDependencies() when the absolute path of a library to redistribute has been found
+     */
+    void sharedLibraryFound(const QFileInfo & library) const;
+
     void verboseMessage(const QString & message) const;
     void debugMessage(const QString & message) const;
 
    private:
 
+    VertexDescriptor addVertex(GraphFile file) noexcept
+    {
+      assert( file.hasFileName() );
+
+      const LibraryNameId id = mLibraryNameTable.intern( file.fileName() );
+      file.setNameId(id);
+
+      const VertexDescriptor v = boost::add_vertex(file, mGraph);
+      if( mVertexByNameId.size() <= id ){
+        mVertexByNameId.resize( id + 1, boost::graph_traits<GraphAL>::null_vertex() );
+      }
+      mVertexByNameId[id] = v;
+
+      return v;
+    }
+
     GraphAL mGraph;
     std::vector<VertexDescriptor> mTargetVertexList;
     Platform mPlatform;
+    LibraryNameTable mLibraryNameTable;
+    std::vector<VertexDescriptor> mVertexByNameId;
+    std::shared_ptr<ExecutableFileMetadataCache> mMetadataCache;
+    std::shared_ptr<FileStatCache> mFileStatCache;
+    std::shared_ptr<FilePrefetcher> mFilePrefetcher;
   };
 
 }}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependencies{
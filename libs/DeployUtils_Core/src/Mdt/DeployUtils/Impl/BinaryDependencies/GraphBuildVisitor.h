@@ -15,12 +15,20 @@
 #include "Mdt/DeployUtils/AbstractSharedLibraryFinder.h"
 #include "Mdt/DeployUtils/Platform.h"
 #include "Mdt/DeployUtils/FindDependencyError.h"
+#include "Mdt/DeployUtils/ExecutableFileMetadataCache.h"
+#include "Mdt/DeployUtils/FileStatCache.h"
+#include "Mdt/DeployUtils/FilePrefetcher.h"
+#include "Mdt/DeployUtils/LogLevel.h"
+#include "Mdt/DeployUtils/AbstractMessageSink.h"
 #include "mdt_deployutilscore_export.h"
 #include <QObject>
 #include <QFileInfo>
 #include <QString>
 #include <QStringList>
+#include <QSet>
 #include <boost/graph/breadth_first_search.hpp>
+#include <vector>
+#include <utility>
 #include <cassert>
 
 
@@ -50,10 +58,140 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
     {
     }
 
+    /*! \brief Set a metadata cache
+     *
+     * If \a cache is not null,
+     * readFile() takes the dependencies and rpath from it when possible.
+     */
+    void setMetadataCache(ExecutableFileMetadataCache *cache) noexcept
+    {
+      mMetadataCache = cache;
+    }
+
+    /*! \brief Set a file stat cache
+     *
+     * If \a cache is not null,
+     * it is used to validate the entries of the metadata cache.
+     */
+    void setFileStatCache(FileStatCache *cache) noexcept
+    {
+      mFileStatCache = cache;
+    }
+
+    /*! \brief Set a file prefetcher
+     *
+     * If \a prefetcher is not null,
+     * findLibraryAbsolutePath() uses it to prefetch the library it found,
+     * so that readFile() finds the regions it parses in the page cache.
+     */
+    void setFilePrefetcher(FilePrefetcher *prefetcher) noexcept
+    {
+      mFilePrefetcher = prefetcher;
+    }
+
+    /*! \brief Set the log level
+     *
+     * Verbose messages are only built (and emitted)
+     * if \a level requires them.
+     * By default, the log level is LogLevel::Debug.
+     */
+    void setLogLevel(LogLevel level) noexcept
+    {
+      mLogLevel = level;
+    }
+
+    /*! \brief Set a message sink
+     *
+     * If \a sink is not null,
+     * messages are written to it instead of being emitted as signals.
+     */
+    void setMessageSink(AbstractMessageSink *sink) noexcept
+    {
+      mMessageSink = sink;
+    }
+
+    /*! \brief Stat in batches the files where the libraries of \a graph that are not searched yet could be
+     *
+     * For each library that has not been searched,
+     * the directories the shared library finder will try are listed
+     * (directories that the search path index knows not to contain the library are skipped).
+     *
+     * Like the finder, which stops at the first directory that contains the library,
+     * the candidates are stat'ed in rounds:
+     * the first round stats the first candidate of each library in one batch,
+     * the next round the second candidate of each library that was not found yet, and so on.
+     * findLibraryAbsolutePath() then takes the stats from the file stat cache.
+     *
+     * Does nothing if no file stat cache has been set,
+     * or if it does not use the io_uring backend
+     * (stat'ing the candidates synchronously up front
+     * would only do the work findLibraryAbsolutePath() does anyway).
+     */
+    void statCandidateFiles(const GraphAL & graph)
+    {
+      if(mFileStatCache == nullptr){
+        return;
+      }
+      if(mFileStatCache->backend() != FileStatBackend::IoUring){
+        return;
+      }
+
+      // A library that is required by several files is one vertex, but several edges
+      QSet<QString> libraryNames;
+      std::vector<QStringList> candidatesByLibrary;
+      const auto edgeRange = boost::edges(graph);
+      for(auto it = edgeRange.first; it != edgeRange.second; ++it){
+        const GraphFile & file = graph[boost::target(*it, graph)];
+        if( file.hasBeenSearched() ){
+          continue;
+        }
+        const QString libraryName = file.fileName();
+        if( libraryNames.contains(libraryName) ){
+          continue;
+        }
+        libraryNames.insert(libraryName);
+        if( !mSharedLibraryFinder.libraryShouldBeDistributed(libraryName) ){
+          continue;
+        }
+        const auto dependentFile = graph[boost::source(*it, graph)].toBinaryDependenciesFile();
+        QStringList candidates;
+        for( const QString & directory : mSharedLibraryFinder.lookupCandidateDirectories(libraryName, dependentFile) ){
+          candidates.append( QFileInfo(directory, libraryName).absoluteFilePath() );
+        }
+        if( !candidates.isEmpty() ){
+          candidatesByLibrary.push_back(candidates);
+        }
+      }
+
+      while( !candidatesByLibrary.empty() ){
+        QStringList round;
+        for(const QStringList & candidates : candidatesByLibrary){
+          round.append( candidates.constFirst() );
+        }
+        mFileStatCache->statFiles(round);
+
+        // Each library stops at its first found candidate
+        std::vector<QStringList> notFoundCandidatesByLibrary;
+        for(QStringList & candidates : candidatesByLibrary){
+          const FileStat stat = mFileStatCache->stat( candidates.constFirst() );
+          if( stat.exists && stat.isFile ){
+            continue;
+          }
+          candidates.removeFirst();
+          if( !candidates.isEmpty() ){
+            notFoundCandidatesByLibrary.push_back( std::move(candidates) );
+          }
+        }
+        candidatesByLibrary = std::move(notFoundCandidatesByLibrary);
+      }
+    }
+
     /*!\brief Read given file to extract dependencies and rpath if supported
+     *
+     * \a v is the vertex of \a file in the graph
      */
     template<typename Reader>
-    void readFile(GraphFile & file, Reader & reader)
+    void readFile(VertexDescriptor v, GraphFile & file, Reader & reader)
     {
       assert( !file.isReaden() );
       assert( file.hasAbsolutePath() );
@@ -61,28 +199,43 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
 
       emitProcessingCurrentFileMessage(file);
 
-      reader.openFile(file.fileInfo(), mPlatform);
-      if( !reader.isExecutableOrSharedLibrary() ){
-        const QString message = tr("'%1' is not a executable or a shared library")
-                                .arg( file.fileInfo().absoluteFilePath() );
-        throw FindDependencyError(message);
-      }
+      const QFileInfo fileInfo = file.fileInfo();
 
-      const QStringList directDependenciesFileNames = reader.getNeededSharedLibraries();
-      mDiscoveredDependenciesList.setDirectDependenciesFileNames(file, directDependenciesFileNames);
-      emitDirectDependenciesMessage(file, directDependenciesFileNames);
+      if(mMetadataCache != nullptr){
+        const auto metadata = mMetadataCache->find(fileInfo, mFileStatCache);
+        if( metadata && metadata->hasDependencies ){
+          setFileMetadata(v, file, *metadata);
+          return;
+        }
+      }
 
-      file.setRPath( reader.getRunPath() );
+      ExecutableFileMetadata metadata;
+      metadata.hasDependencies = true;
 
+      reader.openFile(fileInfo, mPlatform);
+      metadata.isExecutableOrSharedLibrary = reader.isExecutableOrSharedLibrary();
+      if(metadata.isExecutableOrSharedLibrary){
+        metadata.platform = reader.getFilePlatform();
+        metadata.neededSharedLibraries = reader.getNeededSharedLibraries();
+        metadata.runPath = reader.getRunPath();
+      }
       reader.close();
+
+      if(mMetadataCache != nullptr){
+        mMetadataCache->insert(fileInfo, metadata, mFileStatCache);
+      }
+
+      setFileMetadata(v, file, metadata);
     }
 
     /*! \brief Find the absolute path for given library name
+     *
+     * If the library is found, sharedLibraryFound() is emitted.
      */
     void findLibraryAbsolutePath(GraphFile & file, const GraphFile & parentFile)
     {
       assert( !file.hasBeenSearched() );
-      assert( fileInfoIsFileNameWithoutPath( file.fileInfo() ) );
+      assert( fileInfoIsFileNameWithoutPath( file.filePath() ) );
 
       const QString libraryName = file.fileName();
 
@@ -96,6 +249,8 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
         const QFileInfo path = mSharedLibraryFinder.findLibraryAbsolutePath( libraryName, dependentFile );
         assert( fileInfoIsAbsolutePath(path) );
         file.setAbsoluteFilePath(path);
+        prefetchFile(file);
+        emit sharedLibraryFound(path);
       }catch(const FindDependencyError &){
         file.markAsNotFound();
       }
@@ -103,15 +258,56 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
 
    signals:
 
+    /*! \brief Emitted when the absolute path of a library to redistribute has been found
+     */
+    void sharedLibraryFound(const QFileInfo & library) const;
+
     void verboseMessage(const QString & message) const;
     void debugMessage(const QString & message) const;
 
    private:
 
+    void setFileMetadata(VertexDescriptor v, GraphFile & file, const ExecutableFileMetadata & metadata)
+    {
+      if( !metadata.isExecutableOrSharedLibrary ){
+        const QString message = tr("'%1' is not a executable or a shared library")
+                                .arg( file.filePath() );
+        throw FindDependencyError(message);
+      }
+
+      mDiscoveredDependenciesList.setDirectDependenciesFileNames(v, file, metadata.neededSharedLibraries);
+      emitDirectDependenciesMessage(file, metadata.neededSharedLibraries);
+
+      file.setRPath(metadata.runPath);
+    }
+
+    /*! \brief Prefetch given file, unless it will not be read
+     *
+     * The shared library finder allready read the head of the file
+     * while validating it, so only the regions beyond it are prefetched.
+     */
+    void prefetchFile(const GraphFile & file)
+    {
+      assert( file.hasAbsolutePath() );
+
+      if(mFilePrefetcher == nullptr){
+        return;
+      }
+      // Not a lookup: readFile() does it, and counts it
+      if( (mMetadataCache != nullptr) && mMetadataCache->hasUpToDateDependencies(file.fileInfo(), mFileStatCache) ){
+        return;
+      }
+
+      mFilePrefetcher->prefetch( file.filePath() );
+    }
+
     void emitProcessingCurrentFileMessage(const GraphFile & file) const noexcept
     {
+      if( !shouldOutputVerboseMessages(mLogLevel) ){
+        return;
+      }
       const QString message = tr("searching dependencies for %1").arg( file.fileName() );
-      emit verboseMessage(message);
+      outputVerboseMessage(message);
     }
 
     void emitDirectDependenciesMessage(const GraphFile & file, const QStringList & directDependenciesFileNames) const noexcept
@@ -119,17 +315,34 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
       if( directDependenciesFileNames.isEmpty() ){
         return;
       }
+      if( !shouldOutputVerboseMessages(mLogLevel) ){
+        return;
+      }
       const QString startMessage = tr("%1 has following direct dependencies:").arg( file.fileName() );
-      emit verboseMessage(startMessage);
+      outputVerboseMessage(startMessage);
       for( const QString & dependency : directDependenciesFileNames ){
         const QString msg = tr(" %1").arg(dependency);
-        emit verboseMessage(msg);
+        outputVerboseMessage(msg);
+      }
+    }
+
+    void outputVerboseMessage(const QString & message) const
+    {
+      if(mMessageSink != nullptr){
+        mMessageSink->verbose(message);
+      }else{
+        emit verboseMessage(message);
       }
     }
 
     AbstractSharedLibraryFinder & mSharedLibraryFinder;
     const Platform & mPlatform;
     DiscoveredDependenciesList & mDiscoveredDependenciesList;
+    ExecutableFileMetadataCache *mMetadataCache = nullptr;
+    FileStatCache *mFileStatCache = nullptr;
+    FilePrefetcher *mFilePrefetcher = nullptr;
+    LogLevel mLogLevel = LogLevel::Debug;
+    AbstractMessageSink *mMessageSink = nullptr;
   };
 
 
@@ -159,23 +372,29 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
     {
     }
 
-    /*! \brief Read the file associated with the new discovered vertex
+    /*! \brief Read the file associated with the vertex that is taken from the BFS queue
      *
-     * Will read the new discovered file to get its direct dependencies librarie names
+     * Will read the file to get its direct dependencies librarie names
      * and its rpath (if supported).
      *
      * If this was already done for the given file,
      * nothing is done (the graph can be processed multiple times during build).
      *
+     * The file is not read when its vertex is discovered
+     * (just after its absolute path was found in examine_edge()),
+     * but when it is taken from the queue.
+     * This way, the absolute paths of all the direct dependencies of a file are found
+     * (and the files prefetched) before the first of them is read.
+     *
      * \pre The absolute path of given file must have been set
      */
-    void discover_vertex(VertexDescriptor u, const GraphAL &)
+    void examine_vertex(VertexDescriptor u, const GraphAL &)
     {
       GraphFile & file = mGraph[u];
 
       if( file.hasToBeRead() ){
         assert( file.hasAbsolutePath() );
-        mWorker.readFile(file, mReader);
+        mWorker.readFile(u, file, mReader);
         file.markAsReaden();
       }
     }
@@ -9,16 +9,25 @@
 #ifndef MDT_DEPLOY_UTILS_IMPL_BINARY_DEPENDENCIES_GRAPH_FILE_H
 #define MDT_DEPLOY_UTILS_IMPL_BINARY_DEPENDENCIES_GRAPH_FILE_H
 
+#include "LibraryNameTable.h"
 #include "Mdt/DeployUtils/RPath.h"
 #include "Mdt/DeployUtils/FileInfoUtils.h"
 #include "Mdt/DeployUtils/BinaryDependenciesFile.h"
 #include <QFileInfo>
 #include <QString>
+#include <QLatin1Char>
+#include <QDir>
+#include <optional>
 #include <cassert>
 
 namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependencies{
 
   /*! \internal Helper class used as vertex data in a binary dependencies graph
+   *
+   * A graph can have a lot of files,
+   * and each file is copied while building the results.
+   * So, only the path is stored, as a string.
+   * A QFileInfo is only made when it is required (see fileInfo()).
    */
   class GraphFile
   {
@@ -50,35 +59,79 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
      */
     bool isNull() const noexcept
     {
-      return !fileInfoHasFileName(mFile);
+      return !hasFileName();
     }
 
     /*! \brief Check if this file has its file name
      */
     bool hasFileName() const noexcept
     {
-      return fileInfoHasFileName(mFile);
+      return !fileName().trimmed().isEmpty();
     }
 
     /*! \brief Check if this file has its absolute path
      */
     bool hasAbsolutePath() const noexcept
     {
-      return fileInfoIsAbsolutePath(mFile);
+      return QDir::isAbsolutePath(mFilePath);
     }
 
     /*! \brief Get the file name of this file
      */
     QString fileName() const noexcept
     {
-      return mFile.fileName();
+      return mFilePath.mid( mFilePath.lastIndexOf( QLatin1Char('/') ) + 1 );
+    }
+
+    /*! \brief Set the name id of this file
+     *
+     * \sa LibraryNameTable
+     */
+    void setNameId(LibraryNameId id) noexcept
+    {
+      mNameId = id;
+    }
+
+    /*! \brief Check if this file has its name id
+     *
+     * A file gets its name id when it is added to a graph.
+     */
+    bool hasNameId() const noexcept
+    {
+      return mNameId.has_value();
+    }
+
+    /*! \brief Get the name id of this file
+     *
+     * \pre this file must have its name id
+     * \sa hasNameId()
+     */
+    LibraryNameId nameId() const noexcept
+    {
+      assert( hasNameId() );
+
+      return *mNameId;
+    }
+
+    /*! \brief Get the path of this file
+     *
+     * Returns the absolute file path if this file has it,
+     * otherwise only its file name.
+     *
+     * \sa hasAbsolutePath()
+     */
+    const QString & filePath() const noexcept
+    {
+      return mFilePath;
     }
 
     /*! \brief Get the file info of this file
+     *
+     * The returned file info is made from filePath() on each call.
      */
-    const QFileInfo & fileInfo() const noexcept
+    QFileInfo fileInfo() const noexcept
     {
-      return mFile;
+      return QFileInfo(mFilePath);
     }
 
     /*! \brief Check if this file has to be read
@@ -122,7 +175,7 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
     {
       assert( fileInfoIsAbsolutePath(path) );
 
-      mFile = path;
+      mFilePath = path.absoluteFilePath();
     }
 
     /*! \brief Set the rpath to this file
@@ -212,7 +265,7 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
     {
       assert( !isNull() );
 
-      auto bdFile = BinaryDependenciesFile::fromQFileInfo(mFile);
+      auto bdFile = BinaryDependenciesFile::fromQFileInfo( fileInfo() );
       bdFile.setRPath(mRPath);
 
       return bdFile;
@@ -241,20 +294,25 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
     {
       assert( fileInfoHasFileName(fileInfo) );
 
-      return GraphFile(fileInfo);
+      if( fileInfoIsAbsolutePath(fileInfo) ){
+        return GraphFile( fileInfo.absoluteFilePath() );
+      }
+
+      return GraphFile( fileInfo.filePath() );
     }
 
    private:
 
-    GraphFile(const QFileInfo & fileInfo)
-      : mFile(fileInfo)
+    GraphFile(const QString & filePath)
+      : mFilePath(filePath)
     {
     }
 
     bool mIsReaden = false;
     bool mIsNotFound = false;
     bool mShouldNotBeRedistributed = false;
-    QFileInfo mFile;
+    std::optional<LibraryNameId> mNameId;
+    QString mFilePath;
     RPath mRPath;
   };
 
@@ -16,6 +16,7 @@
 #include "Mdt/DeployUtils/BinaryDependenciesResultLibrary.h"
 #include "Mdt/DeployUtils/OperatingSystem.h"
 #include <boost/graph/breadth_first_search.hpp>
+#include <cassert>
 
 namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependencies{
 
@@ -29,17 +30,11 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
     return fileNamesAreEqual(file.fileName(), result.target().fileName(), os);
   }
 
-  /*! \internal
+  /*! \internal Add given file, that is a dependency of \a result 's target, to \a result
    */
   inline
-  void addGraphFileToResult(const GraphFile & file, BinaryDependenciesResult & result, OperatingSystem os) noexcept
+  void addGraphLibraryToResult(const GraphFile & file, BinaryDependenciesResult & result) noexcept
   {
-    assert( os != OperatingSystem::Unknown );
-
-    if( graphFileIsResultTarget(file, result, os) ){
-      return;
-    }
-
     if( file.isNotFound() ){
       result.addNotFoundLibrary( file.fileInfo() );
       return;
@@ -53,6 +48,20 @@ namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependenci
     result.addFoundLibrary( file.fileInfo(), file.rPath() );
   }
 
+  /*! \internal
+   */
+  inline
+  void addGraphFileToResult(const GraphFile & file, BinaryDependenciesResult & result, OperatingSystem os) noexcept
+  {
+    assert( os != OperatingSystem::Unknown );
+
+    if( graphFileIsResultTarget(file, result, os) ){
+      return;
+    }
+
+    addGraphLibraryToResult(file, result);
+  }
+
   /*! \internal
    */
   class GraphResultVisitor
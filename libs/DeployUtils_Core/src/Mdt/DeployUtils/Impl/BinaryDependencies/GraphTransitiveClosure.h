@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_IMPL_BINARY_DEPENDENCIES_GRAPH_TRANSITIVE_CLOSURE_H
+#define MDT_DEPLOY_UTILS_IMPL_BINARY_DEPENDENCIES_GRAPH_TRANSITIVE_CLOSURE_H
+
+#include "GraphDef.h"
+#include <boost/graph/strong_components.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/dynamic_bitset.hpp>
+#include <vector>
+#include <cstddef>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependencies{
+
+  /*! \internal Files reachable from each file of a graph
+   *
+   * The closure is computed once for the whole graph:
+   * the graph is condensed to its strongly connected components
+   * (a component is more than 1 file if some libraries depend on each other),
+   * then each component gets a bitset of the files it can reach.
+   * Because boost::strong_components() numbers the components
+   * in reverse topological order, the bitsets of the dependencies of a component
+   * are always known before the component itself is processed.
+   *
+   * This is O(V+E) bitset unions (each of V bits),
+   * instead of O(T·(V+E)) for a traversal per target.
+   *
+   * The closure is a snapshot of the graph:
+   * it must not be used after a file or a dependency has been added to the graph.
+   */
+  class GraphTransitiveClosure
+  {
+   public:
+
+    /*! \brief Compute the closure of given graph
+     */
+    explicit
+    GraphTransitiveClosure(const GraphAL & graph) noexcept
+     : mComponentByVertex( boost::num_vertices(graph) )
+    {
+      const std::size_t vertexCount = boost::num_vertices(graph);
+
+      const std::size_t componentCount = boost::strong_components(
+        graph, boost::make_iterator_property_map( mComponentByVertex.begin(), boost::get(boost::vertex_index, graph) )
+      );
+
+      std::vector< std::vector<VertexDescriptor> > verticesByComponent(componentCount);
+      for(VertexDescriptor v = 0; v < vertexCount; ++v){
+        verticesByComponent[ mComponentByVertex[v] ].push_back(v);
+      }
+
+      mReachableByComponent.assign( componentCount, boost::dynamic_bitset<>(vertexCount) );
+
+      for(std::size_t c = 0; c < componentCount; ++c){
+        boost::dynamic_bitset<> & reachable = mReachableByComponent[c];
+        for(VertexDescriptor u : verticesByComponent[c]){
+          const auto edgeRange = boost::out_edges(u, graph);
+          for(auto it = edgeRange.first; it != edgeRange.second; ++it){
+            const VertexDescriptor v = boost::target(*it, graph);
+            const std::size_t vc = mComponentByVertex[v];
+            reachable.set(v);
+            if(vc != c){
+              assert( vc < c );
+              reachable |= mReachableByComponent[vc];
+            }
+          }
+        }
+      }
+    }
+
+    /*! \brief Get the count of files in the graph this closure was computed for
+     */
+    std::size_t fileCount() const noexcept
+    {
+      return mComponentByVertex.size();
+    }
+
+    /*! \brief Get the files reachable from \a v
+     *
+     * Bit n is set if the file with vertex descriptor n
+     * is a direct or transitive dependency of \a v .
+     * \a v itself is only part of the set if it is in a dependency cycle.
+     *
+     * The returned reference is valid as long as this closure exists,
+     * and is shared by all files of a same cycle.
+     *
+     * \pre \a v must be a vertex of the graph this closure was computed for
+     */
+    const boost::dynamic_bitset<> & reachableFrom(VertexDescriptor v) const noexcept
+    {
+      assert( v < fileCount() );
+
+      return mReachableByComponent[ mComponentByVertex[v] ];
+    }
+
+   private:
+
+    std::vector<std::size_t> mComponentByVertex;
+    std::vector< boost::dynamic_bitset<> > mReachableByComponent;
+  };
+
+}}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependencies{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_IMPL_BINARY_DEPENDENCIES_GRAPH_TRANSITIVE_CLOSURE_H
@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_IMPL_BINARY_DEPENDENCIES_LIBRARY_NAME_TABLE_H
+#define MDT_DEPLOY_UTILS_IMPL_BINARY_DEPENDENCIES_LIBRARY_NAME_TABLE_H
+
+#include "FileComparison.h"
+#include "Mdt/DeployUtils/OperatingSystem.h"
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <vector>
+#include <optional>
+#include <limits>
+#include <cstdint>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependencies{
+
+  /*! \internal Identifier of a library (or target) name in a LibraryNameTable
+   */
+  using LibraryNameId = std::uint32_t;
+
+  /*! \internal Table of library names, each with a integer id
+   *
+   * While building a binary dependencies graph,
+   * the same library names are compared over and over
+   * (case insensitive on Windows).
+   * With this table, a name is normalized once, when it is added,
+   * and gets a id.
+   * Two names that are equal for fileNamesAreEqual() have the same id,
+   * so comparing names is comparing integers.
+   *
+   * Ids are dense, starting from 0,
+   * so they can be used as index in a vector.
+   *
+   * The names are only converted back to strings
+   * to search them on the file system and to make results.
+   */
+  class LibraryNameTable
+  {
+   public:
+
+    /*! \brief Construct a empty table
+     *
+     * \pre \a os must be valid
+     */
+    explicit
+    LibraryNameTable(OperatingSystem os) noexcept
+     : mOs(os)
+    {
+      assert( mOs != OperatingSystem::Unknown );
+    }
+
+    /*! \brief Get the operating system of this table
+     */
+    OperatingSystem operatingSystem() const noexcept
+    {
+      return mOs;
+    }
+
+    /*! \brief Get the count of names in this table
+     */
+    std::size_t size() const noexcept
+    {
+      return mNames.size();
+    }
+
+    /*! \brief Check if this table is empty
+     */
+    bool isEmpty() const noexcept
+    {
+      return mNames.empty();
+    }
+
+    /*! \brief Get the id for given name
+     *
+     * If \a name does not exist in this table,
+     * it is added with a new id.
+     *
+     * \pre \a name must not be empty
+     */
+    LibraryNameId intern(const QString & name) noexcept
+    {
+      assert( !name.trimmed().isEmpty() );
+      assert( mNames.size() < std::numeric_limits<LibraryNameId>::max() );
+
+      const QString key = fileNameComparisonKey(name, mOs);
+      const auto it = mIdByKey.constFind(key);
+      if( it != mIdByKey.constEnd() ){
+        return *it;
+      }
+
+      const LibraryNameId id = static_cast<LibraryNameId>( mNames.size() );
+      mIdByKey.insert(key, id);
+      mNames.push_back(name);
+
+      return id;
+    }
+
+    /*! \brief Get the ids for given list of names
+     *
+     * \sa intern()
+     */
+    std::vector<LibraryNameId> intern(const QStringList & names) noexcept
+    {
+      std::vector<LibraryNameId> ids;
+      ids.reserve( static_cast<std::size_t>( names.size() ) );
+
+      for(const QString & name : names){
+        ids.push_back( intern(name) );
+      }
+
+      return ids;
+    }
+
+    /*! \brief Find the id for given name
+     *
+     * Returns a empty optional if \a name does not exist in this table.
+     *
+     * \pre \a name must not be empty
+     */
+    std::optional<LibraryNameId> find(const QString & name) const noexcept
+    {
+      assert( !name.trimmed().isEmpty() );
+
+      const auto it = mIdByKey.constFind( fileNameComparisonKey(name, mOs) );
+      if( it == mIdByKey.constEnd() ){
+        return {};
+      }
+
+      return *it;
+    }
+
+    /*! \brief Check if this table contains given id
+     */
+    bool containsId(LibraryNameId id) const noexcept
+    {
+      return id < mNames.size();
+    }
+
+    /*! \brief Get the name for given id
+     *
+     * Returns the name as it was first added to this table.
+     *
+     * \pre \a id must exist in this table
+     */
+    const QString & name(LibraryNameId id) const noexcept
+    {
+      assert( containsId(id) );
+
+      return mNames[id];
+    }
+
+    /*! \brief Get the names for given list of ids
+     *
+     * \pre each id in \a ids must exist in this table
+     */
+    QStringList names(const std::vector<LibraryNameId> & ids) const noexcept
+    {
+      QStringList names;
+      names.reserve( static_cast<int>( ids.size() ) );
+
+      for(const LibraryNameId id : ids){
+        names.append( name(id) );
+      }
+
+      return names;
+    }
+
+   private:
+
+    OperatingSystem mOs;
+    QHash<QString, LibraryNameId> mIdByKey;
+    std::vector<QString> mNames;
+  };
+
+}}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{ namespace BinaryDependencies{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_IMPL_BINARY_DEPENDENCIES_LIBRARY_NAME_TABLE_H
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "InMemoryFile.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QByteArray>
+#include <QLatin1String>
+#include <QtGlobal>
+#include <cassert>
+
+#ifdef Q_OS_LINUX
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // #ifdef Q_OS_LINUX
+
+#if defined(Q_OS_LINUX) && defined(SYS_memfd_create)
+#define MDT_DEPLOY_UTILS_HAS_MEMFD
+#endif
+
+namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+InMemoryFile::~InMemoryFile() noexcept
+{
+  release();
+}
+
+bool InMemoryFile::copyFrom(const QString & sourceFilePath) noexcept
+{
+  assert( !sourceFilePath.isEmpty() );
+
+  release();
+
+  const QString name = QFileInfo(sourceFilePath).fileName();
+  if( !createMemoryFile(name) ){
+    if( !createTemporaryFile(name) ){
+      return false;
+    }
+  }
+  assert( !mFilePath.isEmpty() );
+
+  QFile source(sourceFilePath);
+  if( !source.open(QIODevice::ReadOnly) ){
+    return false;
+  }
+  QFile destination(mFilePath);
+  if( !destination.open(QIODevice::WriteOnly | QIODevice::Truncate) ){
+    return false;
+  }
+
+  QByteArray buffer(1024 * 1024, Qt::Uninitialized);
+  qint64 readSize = 0;
+  while( (readSize = source.read( buffer.data(), buffer.size() )) > 0 ){
+    if( destination.write(buffer.constData(), readSize) != readSize ){
+      return false;
+    }
+  }
+  if(readSize < 0){
+    return false;
+  }
+
+  return destination.flush();
+}
+
+bool InMemoryFile::createMemoryFile(const QString & name) noexcept
+{
+#ifdef MDT_DEPLOY_UTILS_HAS_MEMFD
+  const QByteArray encodedName = QFile::encodeName(name);
+  const long fd = ::syscall(SYS_memfd_create, encodedName.constData(), 0x0001U /* MFD_CLOEXEC */);
+  if(fd < 0){
+    return false;
+  }
+  mFd = static_cast<int>(fd);
+  mFilePath = QLatin1String("/proc/self/fd/") + QString::number(mFd);
+
+  return true;
+#else
+  Q_UNUSED(name)
+  return false;
+#endif // #ifdef MDT_DEPLOY_UTILS_HAS_MEMFD
+}
+
+bool InMemoryFile::createTemporaryFile(const QString & name) noexcept
+{
+  if(!mTemporaryDirectory){
+    mTemporaryDirectory = std::make_unique<QTemporaryDir>();
+  }
+  if( !mTemporaryDirectory->isValid() ){
+    mTemporaryDirectory.reset();
+    return false;
+  }
+  mFilePath = mTemporaryDirectory->filePath(name);
+
+  return true;
+}
+
+void InMemoryFile::release() noexcept
+{
+  if(mFd >= 0){
+#ifdef MDT_DEPLOY_UTILS_HAS_MEMFD
+    ::close(mFd);
+#endif // #ifdef MDT_DEPLOY_UTILS_HAS_MEMFD
+    mFd = -1;
+  }else if( mTemporaryDirectory && !mFilePath.isEmpty() ){
+    QFile::remove(mFilePath);
+  }
+  mFilePath.clear();
+}
+
+}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_IMPL_IN_MEMORY_FILE_H
+#define MDT_DEPLOY_UTILS_IMPL_IN_MEMORY_FILE_H
+
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <QTemporaryDir>
+#include <memory>
+
+namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+  /*! \internal Copy of a file that lives in memory
+   *
+   * ExecutableFileWriter works on files.
+   * To change the RPATH of a file without writing it to the disk,
+   * it is copied to a anonymous memory file (memfd_create(2)),
+   * which path is /proc/self/fd/N .
+   *
+   * If memory files are not available (other platform than Linux,
+   * or a kernel older than 3.17),
+   * a file in a temporary directory is used instead.
+   *
+   * The content is released when this object is destroyed.
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT InMemoryFile
+  {
+   public:
+
+    /*! \brief Construct a empty object
+     */
+    InMemoryFile() noexcept = default;
+
+    /*! \brief Release the content
+     */
+    ~InMemoryFile() noexcept;
+
+    InMemoryFile(const InMemoryFile &) = delete;
+    InMemoryFile & operator=(const InMemoryFile &) = delete;
+    InMemoryFile(InMemoryFile &&) = delete;
+    InMemoryFile & operator=(InMemoryFile &&) = delete;
+
+    /*! \brief Replace the content of this file with a copy of \a sourceFilePath
+     *
+     * Returns false if the copy failed.
+     *
+     * \pre \a sourceFilePath must not be empty
+     */
+    bool copyFrom(const QString & sourceFilePath) noexcept;
+
+    /*! \brief Get the path of this file
+     *
+     * The path can be opened like a regular file
+     * as long as this object exists.
+     */
+    const QString & filePath() const noexcept
+    {
+      return mFilePath;
+    }
+
+    /*! \brief Check if the content lives in memory
+     *
+     * Returns false if a temporary file is used.
+     */
+    bool isInMemory() const noexcept
+    {
+      return mFd >= 0;
+    }
+
+   private:
+
+    bool createMemoryFile(const QString & name) noexcept;
+    bool createTemporaryFile(const QString & name) noexcept;
+    void release() noexcept;
+
+    int mFd = -1;
+    QString mFilePath;
+    std::unique_ptr<QTemporaryDir> mTemporaryDirectory;
+  };
+
+}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_IMPL_IN_MEMORY_FILE_H
@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "IoUringFileStat.h"
+#include <QDir>
+#include <QFile>
+#include <QByteArray>
+#include <QtGlobal>
+#include <algorithm>
+#include <cassert>
+
+#if defined(Q_OS_LINUX) && __has_include(<linux/io_uring.h>)
+#define MDT_DEPLOY_UTILS_HAS_IO_URING
+#endif
+
+#ifdef MDT_DEPLOY_UTILS_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif // #ifdef MDT_DEPLOY_UTILS_HAS_IO_URING
+
+namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+#ifdef MDT_DEPLOY_UTILS_HAS_IO_URING
+
+/*
+ * The rings shared with the kernel.
+ * See io_uring_setup(2)
+ */
+struct IoUringFileStat::Ring
+{
+  int fd = -1;
+  unsigned int sqEntries = 0;
+  void *sqRing = MAP_FAILED;
+  size_t sqRingSize = 0;
+  void *cqRing = MAP_FAILED;
+  size_t cqRingSize = 0;
+  io_uring_sqe *sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+  size_t sqesSize = 0;
+
+  unsigned int *sqTail = nullptr;
+  unsigned int *sqMask = nullptr;
+  unsigned int *sqArray = nullptr;
+  unsigned int *cqHead = nullptr;
+  unsigned int *cqTail = nullptr;
+  unsigned int *cqMask = nullptr;
+  io_uring_cqe *cqes = nullptr;
+
+  ~Ring() noexcept
+  {
+    if(sqes != MAP_FAILED){
+      ::munmap(sqes, sqesSize);
+    }
+    if( (cqRing != MAP_FAILED) && (cqRing != sqRing) ){
+      ::munmap(cqRing, cqRingSize);
+    }
+    if(sqRing != MAP_FAILED){
+      ::munmap(sqRing, sqRingSize);
+    }
+    if(fd >= 0){
+      ::close(fd);
+    }
+  }
+};
+
+namespace{
+
+  const unsigned int queueDepth = 64;
+
+  int ioUringEnter(int fd, unsigned int toSubmit, unsigned int minComplete) noexcept
+  {
+    return static_cast<int>( ::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, IORING_ENTER_GETEVENTS, nullptr, 0) );
+  }
+
+  FileStat fileStatFromStatx(const struct statx & status) noexcept
+  {
+    FileStat stat;
+    stat.exists = true;
+    stat.isFile = S_ISREG(status.stx_mode);
+    stat.size = static_cast<qint64>(status.stx_size);
+    stat.lastModified = static_cast<qint64>(status.stx_mtime.tv_sec) * 1000 + status.stx_mtime.tv_nsec / 1000000;
+
+    return stat;
+  }
+
+} // namespace{
+
+IoUringFileStat::IoUringFileStat() noexcept
+{
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+
+  auto ring = std::make_unique<Ring>();
+
+  ring->fd = static_cast<int>( ::syscall(__NR_io_uring_setup, queueDepth, &params) );
+  if(ring->fd < 0){
+    return;
+  }
+  ring->sqEntries = params.sq_entries;
+
+  ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+  ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool isSingleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if(isSingleMmap){
+    ring->sqRingSize = std::max(ring->sqRingSize, ring->cqRingSize);
+    ring->cqRingSize = ring->sqRingSize;
+  }
+
+  ring->sqRing = ::mmap(nullptr, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+  if(ring->sqRing == MAP_FAILED){
+    return;
+  }
+  if(isSingleMmap){
+    ring->cqRing = ring->sqRing;
+  }else{
+    ring->cqRing = ::mmap(nullptr, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+    if(ring->cqRing == MAP_FAILED){
+      return;
+    }
+  }
+  ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+  ring->sqes = static_cast<io_uring_sqe*>( ::mmap(nullptr, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES) );
+  if(ring->sqes == MAP_FAILED){
+    return;
+  }
+
+  char *sqRing = static_cast<char*>(ring->sqRing);
+  ring->sqTail = reinterpret_cast<unsigned int*>(sqRing + params.sq_off.tail);
+  ring->sqMask = reinterpret_cast<unsigned int*>(sqRing + params.sq_off.ring_mask);
+  ring->sqArray = reinterpret_cast<unsigned int*>(sqRing + params.sq_off.array);
+
+  char *cqRing = static_cast<char*>(ring->cqRing);
+  ring->cqHead = reinterpret_cast<unsigned int*>(cqRing + params.cq_off.head);
+  ring->cqTail = reinterpret_cast<unsigned int*>(cqRing + params.cq_off.tail);
+  ring->cqMask = reinterpret_cast<unsigned int*>(cqRing + params.cq_off.ring_mask);
+  ring->cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+
+  mRing = std::move(ring);
+}
+
+bool IoUringFileStat::statFiles(const QStringList & absoluteFilePaths, std::vector<FileStat> & stats) noexcept
+{
+  assert( isValid() );
+
+  const int fileCount = absoluteFilePaths.count();
+  stats.assign( static_cast<size_t>(fileCount), FileStat() );
+
+  std::vector<QByteArray> encodedPaths( static_cast<size_t>(mRing->sqEntries) );
+  std::vector<struct statx> statxBuffers( static_cast<size_t>(mRing->sqEntries) );
+
+  /*
+   * Submit the requests by chunks of the submission queue size.
+   * The completion queue is at least as large,
+   * so it can not overflow
+   */
+  for(int chunkStart = 0; chunkStart < fileCount; chunkStart += static_cast<int>(mRing->sqEntries)){
+    const unsigned int chunkSize = static_cast<unsigned int>( std::min(fileCount - chunkStart, static_cast<int>(mRing->sqEntries)) );
+
+    unsigned int sqTail = *mRing->sqTail;
+    for(unsigned int i = 0; i < chunkSize; ++i){
+      const QString & path = absoluteFilePaths.at( chunkStart + static_cast<int>(i) );
+      assert( QDir::isAbsolutePath(path) );
+      encodedPaths[i] = QFile::encodeName(path);
+
+      const unsigned int index = sqTail & *mRing->sqMask;
+      io_uring_sqe & sqe = mRing->sqes[index];
+      std::memset(&sqe, 0, sizeof(sqe));
+      sqe.opcode = IORING_OP_STATX;
+      sqe.fd = AT_FDCWD;
+      sqe.addr = reinterpret_cast<quintptr>( encodedPaths[i].constData() );
+      sqe.len = STATX_TYPE | STATX_SIZE | STATX_MTIME;
+      sqe.off = reinterpret_cast<quintptr>( &statxBuffers[i] );
+      sqe.statx_flags = AT_STATX_SYNC_AS_STAT;
+      sqe.user_data = i;
+      mRing->sqArray[index] = index;
+      ++sqTail;
+    }
+    __atomic_store_n(mRing->sqTail, sqTail, __ATOMIC_RELEASE);
+
+    /*
+     * The kernel reads the paths and writes the statx buffers
+     * until each submitted request is completed.
+     * So, even if a request fails, every submitted request
+     * is reaped before the buffers are destroyed.
+     */
+    bool hasFailed = false;
+    unsigned int submittedCount = 0;
+    unsigned int completedCount = 0;
+    while( completedCount < (hasFailed ? submittedCount : chunkSize) ){
+      const unsigned int toSubmit = hasFailed ? 0 : chunkSize - submittedCount;
+      const unsigned int toComplete = (hasFailed ? submittedCount : chunkSize) - completedCount;
+      const int ret = ioUringEnter(mRing->fd, toSubmit, toComplete);
+      if(ret < 0){
+        if( (errno == EINTR) || (errno == EAGAIN) || (errno == EBUSY) ){
+          continue;
+        }
+        if(hasFailed){
+          /*
+           * The submitted requests can not be reaped,
+           * so the kernel could still use the buffers:
+           * they are leaked, not freed
+           */
+          new std::vector<QByteArray>( std::move(encodedPaths) );
+          new std::vector<struct statx>( std::move(statxBuffers) );
+          releaseRing();
+          return false;
+        }
+        hasFailed = true;
+        continue;
+      }
+      submittedCount += static_cast<unsigned int>(ret);
+
+      unsigned int cqHead = *mRing->cqHead;
+      const unsigned int cqTail = __atomic_load_n(mRing->cqTail, __ATOMIC_ACQUIRE);
+      for(; cqHead != cqTail; ++cqHead){
+        const io_uring_cqe & cqe = mRing->cqes[cqHead & *mRing->cqMask];
+        const size_t i = static_cast<size_t>(cqe.user_data);
+        assert( i < chunkSize );
+        // A kernel that does not know statx for io_uring gives EINVAL
+        if(cqe.res == -EINVAL){
+          hasFailed = true;
+        }else if(cqe.res == 0){
+          stats[static_cast<size_t>(chunkStart) + i] = fileStatFromStatx(statxBuffers[i]);
+        }
+        ++completedCount;
+      }
+      __atomic_store_n(mRing->cqHead, cqHead, __ATOMIC_RELEASE);
+    }
+
+    /*
+     * Requests that are not submitted are still in the submission queue,
+     * so the ring can not be used anymore
+     */
+    if(hasFailed){
+      releaseRing();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool IoUringFileStat::isSupported() noexcept
+{
+  return true;
+}
+
+#else
+
+struct IoUringFileStat::Ring
+{
+};
+
+IoUringFileStat::IoUringFileStat() noexcept
+{
+}
+
+bool IoUringFileStat::statFiles(const QStringList &, std::vector<FileStat> &) noexcept
+{
+  assert( isValid() );
+
+  return false;
+}
+
+bool IoUringFileStat::isSupported() noexcept
+{
+  return false;
+}
+
+#endif // #ifdef MDT_DEPLOY_UTILS_HAS_IO_URING
+
+IoUringFileStat::~IoUringFileStat() noexcept
+{
+}
+
+void IoUringFileStat::releaseRing() noexcept
+{
+  mRing.reset();
+}
+
+}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{
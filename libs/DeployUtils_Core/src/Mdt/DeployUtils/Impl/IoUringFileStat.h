@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_IMPL_IO_URING_FILE_STAT_H
+#define MDT_DEPLOY_UTILS_IMPL_IO_URING_FILE_STAT_H
+
+#include "Mdt/DeployUtils/FileStatCache.h"
+#include "mdt_deployutilscore_export.h"
+#include <QStringList>
+#include <vector>
+#include <memory>
+
+namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+  /*! \internal Stat batches of files using io_uring
+   *
+   * A io_uring submission queue is set up at construction.
+   * This can fail, for example if the kernel is too old,
+   * or if io_uring is disabled (some containers forbid it).
+   * In that case, isValid() returns false.
+   *
+   * The io_uring interface is used directly (no liburing),
+   * so nothing more than the kernel headers are required.
+   *
+   * \sa FileStatCache
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT IoUringFileStat
+  {
+   public:
+
+    /*! \brief Set up a io_uring submission queue
+     */
+    IoUringFileStat() noexcept;
+
+    /*! \brief Release the submission queue
+     */
+    ~IoUringFileStat() noexcept;
+
+    IoUringFileStat(const IoUringFileStat &) = delete;
+    IoUringFileStat & operator=(const IoUringFileStat &) = delete;
+    IoUringFileStat(IoUringFileStat &&) = delete;
+    IoUringFileStat & operator=(IoUringFileStat &&) = delete;
+
+    /*! \brief Check if the submission queue could be set up
+     */
+    bool isValid() const noexcept
+    {
+      return mRing.get() != nullptr;
+    }
+
+    /*! \brief Stat the files in \a absoluteFilePaths
+     *
+     * On success, \a stats contains the stat of each file,
+     * in the same order than \a absoluteFilePaths .
+     *
+     * Returns false if the kernel could not process the requests
+     * (for example, a kernel that does not support statx with io_uring).
+     * In that case, \a stats is undefined and this object is no longer valid.
+     *
+     * \pre this object must be valid
+     * \pre each path in \a absoluteFilePaths must be a absolute file path
+     */
+    bool statFiles(const QStringList & absoluteFilePaths, std::vector<FileStat> & stats) noexcept;
+
+    /*! \brief Check if io_uring support has been compiled in
+     */
+    static
+    bool isSupported() noexcept;
+
+   private:
+
+    struct Ring;
+
+    void releaseRing() noexcept;
+
+    std::unique_ptr<Ring> mRing;
+  };
+
+}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_IMPL_IO_URING_FILE_STAT_H
@@ -1,77 +0,0 @@
-/*
- * List of libraries to exclude for different reasons.
- *
- * Automatically generated from
- * https://raw.githubusercontent.com/probonopd/AppImages/master/excludelist
- *
- * This file shall be committed by the developers occassionally,
- * otherwise systems without access to the internet won't be able to build
- * fully working versions of MdtDeployUtils.
- *
- * See https://github.com/probonopd/linuxdeployqt/issues/274 for more
- * information.
- *
- * Credits: https://github.com/probonopd/linuxdeployqt
- */
-#ifndef MDT_DEPLOY_UTILS_IMPL_LIBRARY_EXCLUDE_LIST_LINUX_H
-#define MDT_DEPLOY_UTILS_IMPL_LIBRARY_EXCLUDE_LIST_LINUX_H
-
-#include <QStringList>
-#include <QLatin1String>
-
-static
-const QStringList libraryExcludelistLinux = {
-  QLatin1String("ld-linux.so.2"),
-  QLatin1String("ld-linux-x86-64.so.2"),
-  QLatin1String("libanl.so.1"),
-  QLatin1String("libasound.so.2"),
-  QLatin1String("libBrokenLocale.so.1"),
-  QLatin1String("libcidn.so.1"),
-  QLatin1String("libcom_err.so.2"),
-  QLatin1String("libc.so.6"),
-  QLatin1String("libdl.so.2"),
-  QLatin1String("libdrm.so.2"),
-  QLatin1String("libEGL.so.1"),
-  QLatin1String("libexpat.so.1"),
-  QLatin1String("libfontconfig.so.1"),
-  QLatin1String("libfreetype.so.6"),
-  QLatin1String("libfribidi.so.0"),
-  QLatin1String("libgbm.so.1"),
-  QLatin1String("libgcc_s.so.1"),
-  QLatin1String("libglapi.so.0"),
-  QLatin1String("libGLdispatch.so.0"),
-  QLatin1String("libGL.so.1"),
-  QLatin1String("libGLX.so.0"),
-  QLatin1String("libgmp.so.10"),
-  QLatin1String("libgpg-error.so.0"),
-  QLatin1String("libharfbuzz.so.0"),
-  QLatin1String("libICE.so.6"),
-  QLatin1String("libjack.so.0"),
-  QLatin1String("libm.so.6"),
-  QLatin1String("libmvec.so.1"),
-  QLatin1String("libnss_compat.so.2"),
-  QLatin1String("libnss_dns.so.2"),
-  QLatin1String("libnss_files.so.2"),
-  QLatin1String("libnss_hesiod.so.2"),
-  QLatin1String("libnss_nisplus.so.2"),
-  QLatin1String("libnss_nis.so.2"),
-  QLatin1String("libOpenGL.so.0"),
-  QLatin1String("libp11-kit.so.0"),
-  QLatin1String("libpthread.so.0"),
-  QLatin1String("libresolv.so.2"),
-  QLatin1String("librt.so.1"),
-  QLatin1String("libSM.so.6"),
-  QLatin1String("libstdc++.so.6"),
-  QLatin1String("libthai.so.0"),
-  QLatin1String("libthread_db.so.1"),
-  QLatin1String("libusb-1.0.so.0"),
-  QLatin1String("libutil.so.1"),
-  QLatin1String("libuuid.so.1"),
-  QLatin1String("libX11.so.6"),
-  QLatin1String("libxcb-dri2.so.0"),
-  QLatin1String("libxcb-dri3.so.0"),
-  QLatin1String("libxcb.so.1"),
-  QLatin1String("libz.so.1")
-};
-
-#endif // #ifndef MDT_DEPLOY_UTILS_IMPL_LIBRARY_EXCLUDE_LIST_LINUX_H
@@ -0,0 +1,240 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "LibraryRedistributionPolicyMatcher.h"
+#include <QLatin1Char>
+#include <algorithm>
+#include <map>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+namespace{
+
+  /*
+   * A NFA state is a position in a pattern.
+   * All positions of all patterns are numbered sequentially,
+   * the position past the last character of a pattern is its accepting state.
+   */
+  struct NfaPattern
+  {
+    QString pattern;
+    LibraryRedistributionPolicyAction action;
+    int firstState;
+  };
+
+  struct Nfa
+  {
+    std::vector<NfaPattern> patterns;
+    // For each NFA state, the index of its pattern and its position
+    std::vector< std::pair<int, int> > states;
+
+    void addPattern(const QString & pattern, LibraryRedistributionPolicyAction action)
+    {
+      const int patternIndex = static_cast<int>( patterns.size() );
+      patterns.push_back( {pattern, action, static_cast<int>( states.size() )} );
+      for(int pos = 0; pos <= pattern.size(); ++pos){
+        states.emplace_back(patternIndex, pos);
+      }
+    }
+
+    QChar charAt(int state) const noexcept
+    {
+      const auto & p = patterns[ states[state].first ];
+      const int pos = states[state].second;
+      if( pos >= p.pattern.size() ){
+        return QChar();
+      }
+      return p.pattern.at(pos);
+    }
+
+    bool isAccepting(int state) const noexcept
+    {
+      return states[state].second == patterns[ states[state].first ].pattern.size();
+    }
+
+    LibraryRedistributionPolicyAction action(int state) const noexcept
+    {
+      return patterns[ states[state].first ].action;
+    }
+
+    /*
+     * A * can also match a empty sequence,
+     * so the state after it is also active
+     */
+    void addClosure(std::vector<int> & set) const
+    {
+      for(size_t i = 0; i < set.size(); ++i){
+        if( charAt(set[i]) == QLatin1Char('*') ){
+          const int next = set[i] + 1;
+          if( std::find(set.cbegin(), set.cend(), next) == set.cend() ){
+            set.push_back(next);
+          }
+        }
+      }
+      std::sort(set.begin(), set.end());
+    }
+  };
+
+} // namespace{
+
+LibraryRedistributionPolicyMatcher
+LibraryRedistributionPolicyMatcher::compile(const LibraryRedistributionPolicy & policy, OperatingSystem os)
+{
+  LibraryRedistributionPolicyMatcher matcher;
+  matcher.mFoldCase = (os == OperatingSystem::Windows);
+
+  Nfa nfa;
+  for(const LibraryRedistributionPolicyRule & rule : policy.rules()){
+    if( !rule.appliesToOperatingSystem(os) ){
+      continue;
+    }
+    assert( !rule.pattern.isEmpty() );
+    if(matcher.mFoldCase){
+      nfa.addPattern(rule.pattern.toLower(), rule.action);
+    }else{
+      nfa.addPattern(rule.pattern, rule.action);
+    }
+  }
+
+  if( nfa.patterns.empty() ){
+    return matcher;
+  }
+
+  for(const NfaPattern & p : nfa.patterns){
+    for(const QChar c : p.pattern){
+      if( (c != QLatin1Char('*')) && (c != QLatin1Char('?')) && (matcher.characterClass(c) == otherCharacterClass) ){
+        matcher.addCharacterClass(c);
+      }
+    }
+  }
+  const int classCount = matcher.mClassCount;
+
+  // Subset construction. State 0 is the dead state (empty set)
+  std::map<std::vector<int>, int> dfaStates;
+  std::vector< std::vector<int> > dfaStateSets;
+  auto addDfaState = [&](const std::vector<int> & set){
+    const auto it = dfaStates.find(set);
+    if( it != dfaStates.cend() ){
+      return it->second;
+    }
+    const int state = static_cast<int>( dfaStateSets.size() );
+    dfaStates.emplace(set, state);
+    dfaStateSets.push_back(set);
+    matcher.mTransitions.resize( matcher.mTransitions.size() + static_cast<size_t>(classCount), deadState );
+
+    AcceptAction accept = AcceptAction::None;
+    for(int nfaState : set){
+      if( nfa.isAccepting(nfaState) ){
+        if( nfa.action(nfaState) == LibraryRedistributionPolicyAction::Include ){
+          accept = AcceptAction::Include;
+        }else if(accept == AcceptAction::None){
+          accept = AcceptAction::Exclude;
+        }
+      }
+    }
+    matcher.mAcceptActions.push_back(accept);
+
+    return state;
+  };
+
+  addDfaState( std::vector<int>() );
+
+  std::vector<int> startSet;
+  for(const NfaPattern & p : nfa.patterns){
+    startSet.push_back(p.firstState);
+  }
+  nfa.addClosure(startSet);
+  matcher.mStartState = addDfaState(startSet);
+
+  for(size_t dfaState = 1; dfaState < dfaStateSets.size(); ++dfaState){
+    for(int cls = 0; cls < classCount; ++cls){
+      std::vector<int> nextSet;
+      for(int nfaState : dfaStateSets[dfaState]){
+        const QChar c = nfa.charAt(nfaState);
+        if( c.isNull() ){
+          continue;
+        }
+        if( c == QLatin1Char('*') ){
+          nextSet.push_back(nfaState);
+        }else if( (c == QLatin1Char('?')) || (matcher.characterClass(c) == cls) ){
+          nextSet.push_back(nfaState + 1);
+        }
+      }
+      std::sort(nextSet.begin(), nextSet.end());
+      nextSet.erase( std::unique(nextSet.begin(), nextSet.end()), nextSet.end() );
+      nfa.addClosure(nextSet);
+      const int next = addDfaState(nextSet);
+      matcher.mTransitions[dfaState * static_cast<size_t>(classCount) + static_cast<size_t>(cls)] = next;
+    }
+  }
+
+  return matcher;
+}
+
+std::optional<LibraryRedistributionPolicyAction> LibraryRedistributionPolicyMatcher::match(const QString & libraryName) const noexcept
+{
+  if( isEmpty() ){
+    return {};
+  }
+
+  int state = mStartState;
+  for(const QChar c : libraryName){
+    const int cls = mFoldCase ? characterClass( c.toLower() ) : characterClass(c);
+    state = mTransitions[static_cast<size_t>(state) * static_cast<size_t>(mClassCount) + static_cast<size_t>(cls)];
+    if(state == deadState){
+      return {};
+    }
+  }
+
+  switch( mAcceptActions[static_cast<size_t>(state)] ){
+    case AcceptAction::Exclude:
+      return LibraryRedistributionPolicyAction::Exclude;
+    case AcceptAction::Include:
+      return LibraryRedistributionPolicyAction::Include;
+    case AcceptAction::None:
+      break;
+  }
+
+  return {};
+}
+
+int LibraryRedistributionPolicyMatcher::characterClass(QChar c) const noexcept
+{
+  const ushort u = c.unicode();
+  if(u < 128){
+    return mAsciiClasses[u];
+  }
+
+  const auto it = std::lower_bound( mOtherClasses.cbegin(), mOtherClasses.cend(), std::make_pair(u, 0) );
+  if( (it != mOtherClasses.cend()) && (it->first == u) ){
+    return it->second;
+  }
+
+  return otherCharacterClass;
+}
+
+int LibraryRedistributionPolicyMatcher::addCharacterClass(QChar c) noexcept
+{
+  assert( characterClass(c) == otherCharacterClass );
+
+  const int cls = mClassCount;
+  ++mClassCount;
+
+  const ushort u = c.unicode();
+  if(u < 128){
+    mAsciiClasses[u] = cls;
+  }else{
+    const auto pair = std::make_pair(u, cls);
+    mOtherClasses.insert( std::lower_bound(mOtherClasses.begin(), mOtherClasses.end(), pair), pair );
+  }
+
+  return cls;
+}
+
+}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_IMPL_LIBRARY_REDISTRIBUTION_POLICY_MATCHER_H
+#define MDT_DEPLOY_UTILS_IMPL_LIBRARY_REDISTRIBUTION_POLICY_MATCHER_H
+
+#include "Mdt/DeployUtils/LibraryRedistributionPolicy.h"
+#include "Mdt/DeployUtils/OperatingSystem.h"
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <QChar>
+#include <array>
+#include <vector>
+#include <utility>
+#include <optional>
+
+namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+  /*! \internal Matcher compiled from a LibraryRedistributionPolicy
+   *
+   * The rules that apply to a operating system are compiled
+   * to a single DFA, so matching a library name
+   * is linear in the length of the name,
+   * regardless of the count of rules.
+   *
+   * Each glob becomes a small NFA
+   * (a literal or ? advances, a * loops on itself),
+   * then all NFA's are combined using subset construction.
+   * The alphabet is reduced to the characters that appear in the patterns,
+   * plus a class for any other character.
+   *
+   * A exact name or a prefix is just a special case of a glob,
+   * and compiles to a trie-shaped part of the DFA.
+   *
+   * On Windows, names are compared case insensitively.
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT LibraryRedistributionPolicyMatcher
+  {
+   public:
+
+    /*! \brief Compile the rules of \a policy that apply to \a os
+     */
+    static
+    LibraryRedistributionPolicyMatcher compile(const LibraryRedistributionPolicy & policy, OperatingSystem os);
+
+    /*! \brief Check if this matcher has no rules
+     */
+    bool isEmpty() const noexcept
+    {
+      return mAcceptActions.empty();
+    }
+
+    /*! \brief Get the count of states of the DFA
+     *
+     * Including the dead state.
+     * Returns 0 for a empty matcher.
+     */
+    int stateCount() const noexcept
+    {
+      return static_cast<int>( mAcceptActions.size() );
+    }
+
+    /*! \brief Match given library name
+     *
+     * Returns the action of the rule that matches \a libraryName ,
+     * a Include rule having precedence over a Exclude rule,
+     * or nothing if no rule matches.
+     */
+    std::optional<LibraryRedistributionPolicyAction> match(const QString & libraryName) const noexcept;
+
+   private:
+
+    enum class AcceptAction : char
+    {
+      None,
+      Exclude,
+      Include
+    };
+
+    static constexpr int deadState = 0;
+    static constexpr int otherCharacterClass = 0;
+
+    int characterClass(QChar c) const noexcept;
+    int addCharacterClass(QChar c) noexcept;
+
+    bool mFoldCase = false;
+    int mClassCount = 1;
+    int mStartState = deadState;
+    std::array<int, 128> mAsciiClasses{};
+    std::vector< std::pair<ushort, int> > mOtherClasses;
+    std::vector<int> mTransitions;
+    std::vector<AcceptAction> mAcceptActions;
+  };
+
+}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_IMPL_LIBRARY_REDISTRIBUTION_POLICY_MATCHER_H
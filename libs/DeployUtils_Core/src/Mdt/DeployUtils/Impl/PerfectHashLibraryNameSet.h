@@ -0,0 +1,290 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_IMPL_PERFECT_HASH_LIBRARY_NAME_SET_H
+#define MDT_DEPLOY_UTILS_IMPL_PERFECT_HASH_LIBRARY_NAME_SET_H
+
+#include <QString>
+#include <QChar>
+#include <Qt>
+#include <array>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+  /*! \internal Fold given ASCII character to lower case
+   */
+  constexpr
+  char foldLibraryNameChar(char c) noexcept
+  {
+    if( (c >= 'A') && (c <= 'Z') ){
+      return static_cast<char>(c - 'A' + 'a');
+    }
+    return c;
+  }
+
+  /*! \internal Hash given library name with given seed
+   *
+   * This is FNV-1a, followed by the murmur3 finalizer,
+   * because we only use the low bits of the result.
+   */
+  constexpr
+  uint32_t libraryNameHash(std::string_view name, uint32_t seed) noexcept
+  {
+    uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+    for(char c : name){
+      h ^= static_cast<uint8_t>(c);
+      h *= 16777619u;
+    }
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+
+    return h;
+  }
+
+  /*! \internal Get the smallest power of 2 that is >= \a n
+   */
+  constexpr
+  std::size_t perfectHashTableSize(std::size_t n) noexcept
+  {
+    std::size_t size = 1;
+    while(size < n){
+      size *= 2;
+    }
+    return size;
+  }
+
+  /*! \internal Set of library names with a perfect hash, built at compile time
+   *
+   * The exclude lists are consulted for each library we discover,
+   * so we want a lookup that does not depend on the list length.
+   *
+   * The table is built using hash and displace:
+   * each key goes to a bucket, then, starting with the largest bucket,
+   * we search a seed that puts all keys of this bucket into free slots.
+   * A lookup is then 2 hashes and 1 string comparison.
+   *
+   * If \a cs is Qt::CaseInsensitive,
+   * the keys must be given in lower case
+   * (the generator does this for us),
+   * and the looked up names are folded to lower case.
+   *
+   * Keys are expected to be ASCII, which is the case for library names
+   * in the exclude lists.
+   *
+   * Instances are generated by GenerateLibraryExcludeList.cmake
+   */
+  template<std::size_t N, Qt::CaseSensitivity cs>
+  class PerfectHashLibraryNameSet
+  {
+    static_assert( N > 0, "the set must have at least 1 key" );
+
+   public:
+
+    static constexpr std::size_t tableSize = perfectHashTableSize(N);
+
+    /*! \brief Build the table from given keys
+     *
+     * If the table could not be built
+     * (for example if \a keys contains duplicates),
+     * isValid() returns false.
+     * The generated headers static_assert on it.
+     */
+    constexpr
+    explicit PerfectHashLibraryNameSet(const std::array<std::string_view, N> & keys) noexcept
+     : mKeys(keys)
+    {
+      for(std::size_t slot = 0; slot < tableSize; ++slot){
+        mSlots[slot] = N;
+      }
+
+      std::array<std::size_t, tableSize> bucketSizes{};
+      std::array<std::size_t, N> keyBuckets{};
+
+      for(std::size_t i = 0; i < N; ++i){
+        if( keys[i].empty() || !keyIsFolded(keys[i]) ){
+          return;
+        }
+        for(std::size_t j = 0; j < i; ++j){
+          if(keys[j] == keys[i]){
+            return;
+          }
+        }
+        if( keys[i].size() > mMaxKeyLength ){
+          mMaxKeyLength = keys[i].size();
+        }
+        keyBuckets[i] = libraryNameHash(keys[i], 0) % tableSize;
+        ++bucketSizes[keyBuckets[i]];
+      }
+
+      std::array<bool, tableSize> bucketIsDone{};
+      for(std::size_t n = 0; n < tableSize; ++n){
+        const std::size_t bucket = findLargestRemainingBucket(bucketSizes, bucketIsDone);
+        bucketIsDone[bucket] = true;
+        if(bucketSizes[bucket] == 0){
+          break;
+        }
+        if( !placeBucket(bucket, keys, keyBuckets) ){
+          return;
+        }
+      }
+
+      mIsValid = true;
+    }
+
+    /*! \brief Check if this set could be built
+     */
+    constexpr
+    bool isValid() const noexcept
+    {
+      return mIsValid;
+    }
+
+    /*! \brief Check if \a name is in this set
+     *
+     * \pre if this set is case insensitive, \a name must be in lower case
+     */
+    constexpr
+    bool contains(std::string_view name) const noexcept
+    {
+      if( name.empty() ){
+        return false;
+      }
+      const std::size_t bucket = libraryNameHash(name, 0) % tableSize;
+      const std::size_t slot = libraryNameHash(name, mSeeds[bucket]) % tableSize;
+
+      if(mSlots[slot] == N){
+        return false;
+      }
+
+      return mKeys[mSlots[slot]] == name;
+    }
+
+    /*! \brief Check if \a libraryName is in this set
+     *
+     * Does not allocate.
+     */
+    bool contains(const QString & libraryName) const noexcept
+    {
+      const auto size = static_cast<std::size_t>( libraryName.size() );
+      if( (size == 0) || (size > mMaxKeyLength) ){
+        return false;
+      }
+
+      std::array<char, maxKeyBufferSize> buffer{};
+      for(std::size_t i = 0; i < size; ++i){
+        const ushort c = libraryName.at( static_cast<int>(i) ).unicode();
+        if(c > 0x7F){
+          return false;
+        }
+        if(cs == Qt::CaseInsensitive){
+          buffer[i] = foldLibraryNameChar( static_cast<char>(c) );
+        }else{
+          buffer[i] = static_cast<char>(c);
+        }
+      }
+
+      return contains( std::string_view(buffer.data(), size) );
+    }
+
+    /*! \brief Get the count of keys in this set
+     */
+    static constexpr
+    std::size_t size() noexcept
+    {
+      return N;
+    }
+
+   private:
+
+    static constexpr std::size_t maxKeyBufferSize = 256;
+    static constexpr uint32_t maxSeed = 1u << 16;
+
+    static constexpr
+    bool keyIsFolded(std::string_view key) noexcept
+    {
+      if(key.size() > maxKeyBufferSize){
+        return false;
+      }
+      if(cs == Qt::CaseSensitive){
+        return true;
+      }
+      for(char c : key){
+        if( foldLibraryNameChar(c) != c ){
+          return false;
+        }
+      }
+      return true;
+    }
+
+    static constexpr
+    std::size_t findLargestRemainingBucket(const std::array<std::size_t, tableSize> & bucketSizes,
+                                           const std::array<bool, tableSize> & bucketIsDone) noexcept
+    {
+      std::size_t largest = 0;
+      bool found = false;
+      for(std::size_t b = 0; b < tableSize; ++b){
+        if( bucketIsDone[b] ){
+          continue;
+        }
+        if( !found || (bucketSizes[b] > bucketSizes[largest]) ){
+          largest = b;
+          found = true;
+        }
+      }
+      return largest;
+    }
+
+    constexpr
+    bool placeBucket(std::size_t bucket, const std::array<std::string_view, N> & keys,
+                     const std::array<std::size_t, N> & keyBuckets) noexcept
+    {
+      for(uint32_t seed = 1; seed < maxSeed; ++seed){
+        std::array<bool, tableSize> taken{};
+        bool ok = true;
+        for(std::size_t i = 0; (i < N) && ok; ++i){
+          if(keyBuckets[i] != bucket){
+            continue;
+          }
+          const std::size_t slot = libraryNameHash(keys[i], seed) % tableSize;
+          if( (mSlots[slot] != N) || taken[slot] ){
+            ok = false;
+          }else{
+            taken[slot] = true;
+          }
+        }
+        if(ok){
+          mSeeds[bucket] = seed;
+          for(std::size_t i = 0; i < N; ++i){
+            if(keyBuckets[i] == bucket){
+              mSlots[libraryNameHash(keys[i], seed) % tableSize] = i;
+            }
+          }
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    bool mIsValid = false;
+    std::size_t mMaxKeyLength = 0;
+    std::array<uint32_t, tableSize> mSeeds{};
+    std::array<std::string_view, N> mKeys;
+    // Index in mKeys for each slot, N for a free slot
+    std::array<std::size_t, tableSize> mSlots{};
+  };
+
+}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_IMPL_PERFECT_HASH_LIBRARY_NAME_SET_H
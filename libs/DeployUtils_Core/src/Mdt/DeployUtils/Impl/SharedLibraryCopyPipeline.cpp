@@ -0,0 +1,263 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "SharedLibraryCopyPipeline.h"
+#include "Mdt/DeployUtils/FileCopier.h"
+#include "Mdt/DeployUtils/FileCopyError.h"
+#include <QObject>
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QLatin1String>
+#include <QStringBuilder>
+#include <cassert>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif // #ifdef Q_OS_LINUX
+
+namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+SharedLibraryCopyPipeline::SharedLibraryCopyPipeline(const QString & destinationDirectoryPath) noexcept
+ : mDestinationDirectoryPath(destinationDirectoryPath)
+{
+  assert( !destinationDirectoryPath.trimmed().isEmpty() );
+}
+
+SharedLibraryCopyPipeline::~SharedLibraryCopyPipeline() noexcept
+{
+  if( isRunning() ){
+    abort();
+  }
+  removeBackupFiles();
+}
+
+void SharedLibraryCopyPipeline::setOverwriteBehavior(OverwriteBehavior behavior) noexcept
+{
+  assert( !isRunning() );
+
+  mOverwriteBehavior = behavior;
+}
+
+void SharedLibraryCopyPipeline::setDeployManifest(const std::shared_ptr<const DeployManifest> & manifest) noexcept
+{
+  assert( !isRunning() );
+
+  mDeployManifest = manifest;
+}
+
+void SharedLibraryCopyPipeline::setDeployStore(const std::shared_ptr<DeployStore> & store) noexcept
+{
+  assert( !isRunning() );
+
+  mDeployStore = store;
+}
+
+void SharedLibraryCopyPipeline::setFileHashCache(const std::shared_ptr<FileHashCache> & cache) noexcept
+{
+  assert( !isRunning() );
+
+  mFileHashCache = cache;
+}
+
+void SharedLibraryCopyPipeline::setPreserveSymLinks(bool preserve) noexcept
+{
+  assert( !isRunning() );
+
+  mPreserveSymLinks = preserve;
+}
+
+void SharedLibraryCopyPipeline::start()
+{
+  assert( !isRunning() );
+  assert( FileCopier::isExistingDirectory(mDestinationDirectoryPath) );
+
+  mIsClosed = false;
+  mIsAborted = false;
+  mThread = std::thread(&SharedLibraryCopyPipeline::run, this);
+}
+
+void SharedLibraryCopyPipeline::enqueue(const QString & libraryFilePath)
+{
+  assert( QDir::isAbsolutePath(libraryFilePath) );
+
+  if( mEnqueuedFiles.contains(libraryFilePath) ){
+    return;
+  }
+  mEnqueuedFiles.insert(libraryFilePath);
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQueue.push_back(libraryFilePath);
+  }
+  mQueueChanged.notify_one();
+}
+
+std::vector<FileCopierFile> SharedLibraryCopyPipeline::finish()
+{
+  assert( isRunning() );
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIsClosed = true;
+  }
+  mQueueChanged.notify_one();
+  mThread.join();
+
+  if(mError){
+    rollback();
+    std::rethrow_exception(mError);
+  }
+
+  return mCopiedFiles;
+}
+
+void SharedLibraryCopyPipeline::abort() noexcept
+{
+  if( isRunning() ){
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mIsAborted = true;
+      mQueue.clear();
+    }
+    mQueueChanged.notify_one();
+    mThread.join();
+  }
+
+  rollback();
+}
+
+void SharedLibraryCopyPipeline::rollback() noexcept
+{
+  assert( !isRunning() );
+
+  for(const QString & filePath : mCreatedFiles){
+    QFile::remove(filePath);
+  }
+  mCreatedFiles.clear();
+
+  for(const BackupFile & file : mBackupFiles){
+    QFile::remove(file.filePath);
+    QFile::rename(file.backupFilePath, file.filePath);
+  }
+  mBackupFiles.clear();
+
+  mCopiedFiles.clear();
+}
+
+void SharedLibraryCopyPipeline::removeBackupFiles() noexcept
+{
+  for(const BackupFile & file : mBackupFiles){
+    QFile::remove(file.backupFilePath);
+  }
+  mBackupFiles.clear();
+}
+
+SharedLibraryCopyPipeline::BackupFile SharedLibraryCopyPipeline::backupFile(const QString & filePath)
+{
+  BackupFile file;
+  file.filePath = filePath;
+  file.backupFilePath = filePath % QLatin1String(".backup-") % QString::number( QCoreApplication::applicationPid() );
+
+  // A backup left by a other run of this process
+  QFile::remove(file.backupFilePath);
+
+#ifdef Q_OS_LINUX
+  // Does not follow a symbolic link, so a link is restored as a link
+  const bool ok = ( ::linkat( AT_FDCWD, QFile::encodeName(filePath).constData(),
+                              AT_FDCWD, QFile::encodeName(file.backupFilePath).constData(), 0 ) == 0 );
+#else
+  const bool ok = QFile::copy(filePath, file.backupFilePath);
+#endif // #ifdef Q_OS_LINUX
+  if(!ok){
+    const QString msg = QCoreApplication::translate("Mdt::DeployUtils::Impl::SharedLibraryCopyPipeline",
+                                                    "Could not backup '%1' before overwriting it")
+                        .arg(filePath);
+    throw FileCopyError(msg);
+  }
+
+  return file;
+}
+
+bool SharedLibraryCopyPipeline::takeNextFile(QString & libraryFilePath) noexcept
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+
+  mQueueChanged.wait(lock, [this](){
+    return mIsAborted || mIsClosed || !mQueue.empty();
+  });
+
+  if( mIsAborted || mQueue.empty() ){
+    return false;
+  }
+
+  libraryFilePath = mQueue.front();
+  mQueue.pop_front();
+
+  return true;
+}
+
+void SharedLibraryCopyPipeline::run() noexcept
+{
+  /*
+   * The copier lives in this thread,
+   * and its messages are only collected here
+   */
+  FileCopier fileCopier;
+  fileCopier.setOverwriteBehavior(mOverwriteBehavior);
+  fileCopier.setDeployManifest(mDeployManifest);
+  fileCopier.setDeployStore(mDeployStore);
+  fileCopier.setFileHashCache(mFileHashCache);
+  fileCopier.setPreserveSymLinks(mPreserveSymLinks);
+  QObject::connect(&fileCopier, &FileCopier::verboseMessage, [this](const QString & message){
+    mMessages.append(message);
+  });
+
+  QString libraryFilePath;
+  while( takeNextFile(libraryFilePath) ){
+    try{
+      const QFileInfo libraryFile(libraryFilePath);
+      /*
+       * With preserved symbolic links,
+       * a link and the real file can be created
+       */
+      const QStringList destinationFilePathList = fileCopier.getDestinationFilePathList(libraryFile, mDestinationDirectoryPath);
+      QStringList existingFilePathList;
+      for(const QString & destinationFilePath : destinationFilePathList){
+        if( FileCopier::isExistingFileOrSymLink(destinationFilePath) ){
+          existingFilePathList.append(destinationFilePath);
+        }
+      }
+      /*
+       * FileCopier removes a file before replacing it,
+       * so the backup keeps the previous content
+       */
+      if(mOverwriteBehavior == OverwriteBehavior::Overwrite){
+        for(const QString & existingFilePath : existingFilePathList){
+          mBackupFiles.push_back( backupFile(existingFilePath) );
+        }
+      }
+      const FileCopierFile file = fileCopier.copyFile(libraryFile, mDestinationDirectoryPath);
+      if( file.hasBeenCopied() ){
+        mCopiedFiles.push_back(file);
+      }
+      for(const QString & destinationFilePath : destinationFilePathList){
+        if( !existingFilePathList.contains(destinationFilePath) && FileCopier::isExistingFileOrSymLink(destinationFilePath) ){
+          mCreatedFiles.append(destinationFilePath);
+        }
+      }
+    }catch(...){
+      mError = std::current_exception();
+      return;
+    }
+  }
+}
+
+}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{
@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_IMPL_SHARED_LIBRARY_COPY_PIPELINE_H
+#define MDT_DEPLOY_UTILS_IMPL_SHARED_LIBRARY_COPY_PIPELINE_H
+
+#include "Mdt/DeployUtils/FileCopierFile.h"
+#include "Mdt/DeployUtils/OverwriteBehavior.h"
+#include "Mdt/DeployUtils/DeployManifest.h"
+#include "Mdt/DeployUtils/DeployStore.h"
+#include "Mdt/DeployUtils/FileHashCache.h"
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <QStringList>
+#include <QSet>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <vector>
+
+namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+  /*! \internal Copy shared libraries in a worker thread while their dependencies are still searched
+   *
+   * Libraries are enqueued as soon as their absolute path is known,
+   * and copied by a worker thread, in the order they have been enqueued.
+   *
+   * The files created in the destination directory by this pipeline are recorded,
+   * so that they can be removed if the run fails
+   * (a dependency could not be found, a copy failed, ...).
+   *
+   * With OverwriteBehavior::Overwrite, a file that allready existed in the destination directory
+   * is backed up before it is replaced (a hard link on Linux, otherwise a copy,
+   * named after the file with a .backup-<pid> suffix),
+   * so that it can be restored if the run fails.
+   * A failed run never leaves a mix of old and new libraries.
+   *
+   * If this pipeline is destroyed before finish() has been called,
+   * it is aborted (see abort()).
+   * Otherwise, the backups are removed when it is destroyed.
+   *
+   * The worker thread does not emit any signal.
+   * The messages of the copy are available with messages()
+   * once finish() has returned.
+   *
+   * \sa SharedLibrariesDeployer::setPipelinedCopy()
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT SharedLibraryCopyPipeline
+  {
+   public:
+
+    /*! \brief Construct a pipeline that copies to \a destinationDirectoryPath
+     *
+     * \pre \a destinationDirectoryPath must not be empty
+     */
+    explicit
+    SharedLibraryCopyPipeline(const QString & destinationDirectoryPath) noexcept;
+
+    /*! \brief Destruct this pipeline
+     *
+     * If the worker thread is still running,
+     * this pipeline is aborted.
+     */
+    ~SharedLibraryCopyPipeline() noexcept;
+
+    SharedLibraryCopyPipeline(const SharedLibraryCopyPipeline &) = delete;
+    SharedLibraryCopyPipeline & operator=(const SharedLibraryCopyPipeline &) = delete;
+    SharedLibraryCopyPipeline(SharedLibraryCopyPipeline &&) = delete;
+    SharedLibraryCopyPipeline & operator=(SharedLibraryCopyPipeline &&) = delete;
+
+    /*! \brief Set the overwrite behavior
+     *
+     * \pre this pipeline must not be started
+     * \sa FileCopier::setOverwriteBehavior()
+     */
+    void setOverwriteBehavior(OverwriteBehavior behavior) noexcept;
+
+    /*! \brief Set the manifest of a previous deploy
+     *
+     * \pre this pipeline must not be started
+     * \sa FileCopier::setDeployManifest()
+     */
+    void setDeployManifest(const std::shared_ptr<const DeployManifest> & manifest) noexcept;
+
+    /*! \brief Set a deploy store
+     *
+     * The store is only used by the worker thread while it is running.
+     *
+     * \pre this pipeline must not be started
+     * \sa FileCopier::setDeployStore()
+     */
+    void setDeployStore(const std::shared_ptr<DeployStore> & store) noexcept;
+
+    /*! \brief Set a file hash cache
+     *
+     * \pre this pipeline must not be started
+     * \sa FileCopier::setFileHashCache()
+     */
+    void setFileHashCache(const std::shared_ptr<FileHashCache> & cache) noexcept;
+
+    /*! \brief Preserve symbolic links to shared libraries
+     *
+     * \pre this pipeline must not be started
+     * \sa FileCopier::setPreserveSymLinks()
+     */
+    void setPreserveSymLinks(bool preserve) noexcept;
+
+    /*! \brief Start the worker thread
+     *
+     * \pre this pipeline must not be started
+     * \pre the destination directory must exist
+     */
+    void start();
+
+    /*! \brief Check if the worker thread is running
+     */
+    bool isRunning() const noexcept
+    {
+      return mThread.joinable();
+    }
+
+    /*! \brief Enqueue a library to copy
+     *
+     * A library that has allready been enqueued is not enqueued again.
+     *
+     * \pre \a libraryFilePath must be a absolute path to a existing file
+     */
+    void enqueue(const QString & libraryFilePath);
+
+    /*! \brief Get the count of libraries that have been enqueued
+     */
+    int enqueuedCount() const noexcept
+    {
+      return mEnqueuedFiles.count();
+    }
+
+    /*! \brief Copy the remaining libraries and stop the worker thread
+     *
+     * Returns the libraries that have been copied
+     * (those for which FileCopierFile::hasBeenCopied() is true),
+     * in the order they have been enqueued.
+     *
+     * If a copy failed, this pipeline is rolled back (see rollback()),
+     * then the error is thrown.
+     *
+     * \pre this pipeline must be running
+     * \exception FileCopyError
+     */
+    std::vector<FileCopierFile> finish();
+
+    /*! \brief Stop the worker thread and roll back this pipeline
+     *
+     * The libraries that are still in the queue are not copied.
+     * The copy that is in progress, if any, is waited for.
+     *
+     * \sa rollback()
+     */
+    void abort() noexcept;
+
+    /*! \brief Undo the changes this pipeline did in the destination directory
+     *
+     * The files that this pipeline has created are removed,
+     * and the files it has overwritten are restored from their backup.
+     *
+     * Can also be called after finish(),
+     * if a later step of the run fails
+     * (for example, changing the RPATH of the copied libraries).
+     *
+     * \pre this pipeline must not be running
+     */
+    void rollback() noexcept;
+
+    /*! \brief Get the messages of the copy
+     *
+     * \pre this pipeline must not be running
+     */
+    const QStringList & messages() const noexcept
+    {
+      return mMessages;
+    }
+
+   private:
+
+    struct BackupFile
+    {
+      QString filePath;
+      QString backupFilePath;
+    };
+
+    void run() noexcept;
+    bool takeNextFile(QString & libraryFilePath) noexcept;
+    void removeBackupFiles() noexcept;
+
+    static
+    BackupFile backupFile(const QString & filePath);
+
+    QString mDestinationDirectoryPath;
+    OverwriteBehavior mOverwriteBehavior = OverwriteBehavior::Fail;
+    bool mPreserveSymLinks = false;
+    std::shared_ptr<const DeployManifest> mDeployManifest;
+    std::shared_ptr<DeployStore> mDeployStore;
+    std::shared_ptr<FileHashCache> mFileHashCache;
+    QSet<QString> mEnqueuedFiles;
+
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mQueueChanged;
+    std::deque<QString> mQueue;
+    bool mIsClosed = false;
+    bool mIsAborted = false;
+
+    // Only accessed by the worker thread while it is running
+    std::exception_ptr mError;
+    std::vector<FileCopierFile> mCopiedFiles;
+    QStringList mCreatedFiles;
+    std::vector<BackupFile> mBackupFiles;
+    QStringList mMessages;
+  };
+
+}}} // namespace Mdt{ namespace DeployUtils{ namespace Impl{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_IMPL_SHARED_LIBRARY_COPY_PIPELINE_H
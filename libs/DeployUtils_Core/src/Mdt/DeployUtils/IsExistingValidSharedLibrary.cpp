@@ -25,7 +25,11 @@ namespace Mdt{ namespace DeployUtils{
 
 bool IsExistingValidSharedLibrary::doIsExistingValidSharedLibrary(const QFileInfo & libraryFile) const
 {
-  if( !libraryFile.exists() ){
+  if(mFileStatCache){
+    if( !mFileStatCache->stat(libraryFile).exists ){
+      return false;
+    }
+  }else if( !libraryFile.exists() ){
     return false;
   }
   if( !isSharedLibraryForExpectedPlatform(libraryFile) ){
@@ -39,21 +43,38 @@ bool IsExistingValidSharedLibrary::isSharedLibraryForExpectedPlatform(const QFil
 {
   assert( !mReader.isOpen() );
 
+  if(mMetadataCache){
+    const auto metadata = mMetadataCache->find( libraryFile, mFileStatCache.get() );
+    if(metadata){
+      return isSharedLibraryForExpectedPlatform(*metadata);
+    }
+  }
+
+  ExecutableFileMetadata metadata;
   try{
     mReader.openFile(libraryFile, mPlatform);
 
-    const bool isSharedLibrary = mReader.isExecutableOrSharedLibrary();
-
-    const Platform libraryPlatform = mReader.getFilePlatform();
-    const bool isCorrectProcessorISA = ( libraryPlatform.processorISA() == mPlatform.processorISA() );
+    metadata.isExecutableOrSharedLibrary = mReader.isExecutableOrSharedLibrary();
+    metadata.platform = mReader.getFilePlatform();
 
     mReader.close();
-
-    return isSharedLibrary && isCorrectProcessorISA;
   }catch(...){
     mReader.close();
     throw;
   }
+
+  if(mMetadataCache){
+    mMetadataCache->insert( libraryFile, metadata, mFileStatCache.get() );
+  }
+
+  return isSharedLibraryForExpectedPlatform(metadata);
+}
+
+bool IsExistingValidSharedLibrary::isSharedLibraryForExpectedPlatform(const ExecutableFileMetadata & metadata) const noexcept
+{
+  const bool isCorrectProcessorISA = ( metadata.platform.processorISA() == mPlatform.processorISA() );
+
+  return metadata.isExecutableOrSharedLibrary && isCorrectProcessorISA;
 }
 
 }} // namespace Mdt{ namespace DeployUtils{
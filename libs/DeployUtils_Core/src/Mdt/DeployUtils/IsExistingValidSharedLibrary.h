@@ -23,8 +23,11 @@
 
 #include "AbstractIsExistingValidSharedLibrary.h"
 #include "Platform.h"
+#include "ExecutableFileMetadataCache.h"
+#include "FileStatCache.h"
 #include "mdt_deployutilscore_export.h"
 #include <Mdt/ExecutableFile/ExecutableFileReader.h>
+#include <memory>
 
 namespace Mdt{ namespace DeployUtils{
 
@@ -43,13 +46,36 @@ namespace Mdt{ namespace DeployUtils{
       assert( !mReader.isOpen() );
     }
 
+    /*! \brief Set a metadata cache
+     *
+     * If set, the platform of a library is taken from \a cache if available,
+     * otherwise the library is read and the result is put to \a cache .
+     */
+    void setMetadataCache(const std::shared_ptr<ExecutableFileMetadataCache> & cache) noexcept
+    {
+      mMetadataCache = cache;
+    }
+
+    /*! \brief Set a file stat cache
+     *
+     * If set, checking if a library exists is done with \a cache ,
+     * so each candidate is stat'ed at most once.
+     */
+    void setFileStatCache(const std::shared_ptr<FileStatCache> & cache) noexcept
+    {
+      mFileStatCache = cache;
+    }
+
    private:
 
     bool doIsExistingValidSharedLibrary(const QFileInfo & libraryFile) const override;
     bool isSharedLibraryForExpectedPlatform(const QFileInfo & libraryFile) const;
+    bool isSharedLibraryForExpectedPlatform(const ExecutableFileMetadata & metadata) const noexcept;
 
     Mdt::ExecutableFile::ExecutableFileReader & mReader;
     const Platform mPlatform;
+    std::shared_ptr<ExecutableFileMetadataCache> mMetadataCache;
+    std::shared_ptr<FileStatCache> mFileStatCache;
   };
 
 }} // namespace Mdt{ namespace DeployUtils{
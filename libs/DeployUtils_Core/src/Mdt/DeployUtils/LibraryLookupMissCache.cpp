@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "LibraryLookupMissCache.h"
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+bool LibraryLookupMissCache::isKnownMiss(const QString & libraryName, const QString & searchContext) noexcept
+{
+  assert( !libraryName.isEmpty() );
+
+  const auto it = mMisses.constFind( Key(libraryName, searchContext) );
+  if( it == mMisses.constEnd() ){
+    return false;
+  }
+
+  ++mHitCount;
+  mSavedProbeCount += *it;
+
+  return true;
+}
+
+void LibraryLookupMissCache::addMiss(const QString & libraryName, const QString & searchContext, qint64 probeCount) noexcept
+{
+  assert( !libraryName.isEmpty() );
+  assert( probeCount >= 0 );
+
+  mMisses.insert( Key(libraryName, searchContext), probeCount );
+}
+
+void LibraryLookupMissCache::clear() noexcept
+{
+  mMisses.clear();
+  mHitCount = 0;
+  mSavedProbeCount = 0;
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
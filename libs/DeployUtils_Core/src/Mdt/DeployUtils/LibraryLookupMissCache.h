@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_LIBRARY_LOOKUP_MISS_CACHE_H
+#define MDT_DEPLOY_UTILS_LIBRARY_LOOKUP_MISS_CACHE_H
+
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <QPair>
+#include <QHash>
+#include <QtGlobal>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Cache of libraries that could not be found
+   *
+   * When a library is missing,
+   * a shared library finder tries every RPATH entry
+   * and every directory of its search path list.
+   * The same library is typically a direct dependency
+   * of many files, so this is done again and again.
+   *
+   * This cache remembers the libraries that could not be found,
+   * together with the search context in which they where searched
+   * (the ordered list of directories that have been tried).
+   * A library that is searched again in the same context
+   * is known to be missing without probing any file.
+   *
+   * This cache does not detect changes on the file system,
+   * so it should only live for a run.
+   *
+   * \sa AbstractSharedLibraryFinder::setLookupMissCache()
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT LibraryLookupMissCache
+  {
+   public:
+
+    /*! \brief Check if \a libraryName is known to be missing in \a searchContext
+     *
+     * If so, the probes that are saved are accounted in the statistics.
+     *
+     * \pre \a libraryName must not be empty
+     */
+    bool isKnownMiss(const QString & libraryName, const QString & searchContext) noexcept;
+
+    /*! \brief Add a miss to this cache
+     *
+     * \a probeCount is the count of files that have been probed
+     * to find out that \a libraryName is missing in \a searchContext .
+     *
+     * \pre \a libraryName must not be empty
+     * \pre \a probeCount must be >= 0
+     */
+    void addMiss(const QString & libraryName, const QString & searchContext, qint64 probeCount) noexcept;
+
+    /*! \brief Get the count of misses in this cache
+     */
+    int count() const noexcept
+    {
+      return mMisses.count();
+    }
+
+    /*! \brief Check if this cache is empty
+     */
+    bool isEmpty() const noexcept
+    {
+      return mMisses.isEmpty();
+    }
+
+    /*! \brief Get the count of lookups that have been answered by this cache
+     */
+    qint64 hitCount() const noexcept
+    {
+      return mHitCount;
+    }
+
+    /*! \brief Get the count of probes that have been saved by this cache
+     */
+    qint64 savedProbeCount() const noexcept
+    {
+      return mSavedProbeCount;
+    }
+
+    /*! \brief Clear this cache
+     *
+     * Also resets the statistics.
+     */
+    void clear() noexcept;
+
+   private:
+
+    using Key = QPair<QString, QString>;
+
+    QHash<Key, qint64> mMisses;
+    qint64 mHitCount = 0;
+    qint64 mSavedProbeCount = 0;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_LIBRARY_LOOKUP_MISS_CACHE_H
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "LibraryRedistributionPolicy.h"
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+void LibraryRedistributionPolicy::addRule(LibraryRedistributionPolicyAction action, const QString & pattern, OperatingSystem os) noexcept
+{
+  assert( !pattern.trimmed().isEmpty() );
+
+  LibraryRedistributionPolicyRule rule;
+  rule.action = action;
+  rule.pattern = pattern.trimmed();
+  rule.operatingSystem = os;
+
+  mRules.push_back(rule);
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
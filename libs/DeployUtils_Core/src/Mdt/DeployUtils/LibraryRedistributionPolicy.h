@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_LIBRARY_REDISTRIBUTION_POLICY_H
+#define MDT_DEPLOY_UTILS_LIBRARY_REDISTRIBUTION_POLICY_H
+
+#include "OperatingSystem.h"
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <vector>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Action of a LibraryRedistributionPolicyRule
+   */
+  enum class LibraryRedistributionPolicyAction
+  {
+    Exclude,  /*!< Libraries matching the rule are not redistributed */
+    Include   /*!< Libraries matching the rule are redistributed, even if they are in a exclude list */
+  };
+
+  /*! \brief A rule of a LibraryRedistributionPolicy
+   */
+  struct MDT_DEPLOYUTILSCORE_EXPORT LibraryRedistributionPolicyRule
+  {
+    LibraryRedistributionPolicyAction action = LibraryRedistributionPolicyAction::Exclude;
+
+    /*! \brief Pattern of the library name
+     *
+     * Can be a exact name, like libfoo.so.1 ,
+     * or a glob, where * matches any sequence of characters
+     * and ? matches any single character.
+     * A prefix is expressed as a glob, like api-ms-win-* .
+     */
+    QString pattern;
+
+    /*! \brief Operating system this rule applies to
+     *
+     * OperatingSystem::Unknown means that the rule applies to all operating systems.
+     */
+    OperatingSystem operatingSystem = OperatingSystem::Unknown;
+
+    /*! \brief Check if this rule applies to given operating system
+     */
+    bool appliesToOperatingSystem(OperatingSystem os) const noexcept
+    {
+      return (operatingSystem == OperatingSystem::Unknown) || (operatingSystem == os);
+    }
+  };
+
+  /*! \brief Per product rules that decide which shared libraries are redistributed
+   *
+   * The built-in exclude lists (see SharedLibraryFinderLinux and SharedLibraryFinderWindows)
+   * are good defaults, but some products need to exclude more libraries,
+   * or to redistribute a library that is excluded by default.
+   *
+   * A policy is a list of rules.
+   * For a given library name:
+   * - if a Include rule matches, the library is redistributed
+   * - else, if a Exclude rule matches, the library is not redistributed
+   * - else, the built-in rules of the shared library finder apply
+   *
+   * The policy is typically read from a file.
+   * \sa LibraryRedistributionPolicyReader
+   *
+   * To decide for a library name,
+   * the rules are compiled to a matcher.
+   * \sa Impl::LibraryRedistributionPolicyMatcher
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT LibraryRedistributionPolicy
+  {
+   public:
+
+    /*! \brief Add a rule to this policy
+     *
+     * \pre \a pattern must not be empty
+     */
+    void addRule(LibraryRedistributionPolicyAction action, const QString & pattern,
+                 OperatingSystem os = OperatingSystem::Unknown) noexcept;
+
+    /*! \brief Add a rule that excludes libraries matching \a pattern
+     *
+     * \pre \a pattern must not be empty
+     * \sa addRule()
+     */
+    void addExcludeRule(const QString & pattern, OperatingSystem os = OperatingSystem::Unknown) noexcept
+    {
+      addRule(LibraryRedistributionPolicyAction::Exclude, pattern, os);
+    }
+
+    /*! \brief Add a rule that includes libraries matching \a pattern
+     *
+     * \pre \a pattern must not be empty
+     * \sa addRule()
+     */
+    void addIncludeRule(const QString & pattern, OperatingSystem os = OperatingSystem::Unknown) noexcept
+    {
+      addRule(LibraryRedistributionPolicyAction::Include, pattern, os);
+    }
+
+    /*! \brief Get the count of rules in this policy
+     */
+    int ruleCount() const noexcept
+    {
+      return static_cast<int>( mRules.size() );
+    }
+
+    /*! \brief Check if this policy is empty
+     */
+    bool isEmpty() const noexcept
+    {
+      return mRules.empty();
+    }
+
+    /*! \brief Get the rules of this policy
+     */
+    const std::vector<LibraryRedistributionPolicyRule> & rules() const noexcept
+    {
+      return mRules;
+    }
+
+   private:
+
+    std::vector<LibraryRedistributionPolicyRule> mRules;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_LIBRARY_REDISTRIBUTION_POLICY_H
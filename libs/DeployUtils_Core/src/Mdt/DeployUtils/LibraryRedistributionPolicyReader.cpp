@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "LibraryRedistributionPolicyReader.h"
+#include <QFile>
+#include <QStringList>
+#include <QLatin1String>
+#include <QLatin1Char>
+#include <QRegularExpression>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+LibraryRedistributionPolicyReader::LibraryRedistributionPolicyReader(QObject *parent) noexcept
+ : QObject(parent)
+{
+}
+
+LibraryRedistributionPolicy LibraryRedistributionPolicyReader::readFile(const QFileInfo & filePath)
+{
+  assert( !filePath.filePath().isEmpty() );
+  assert( filePath.isAbsolute() );
+
+  QFile file( filePath.absoluteFilePath() );
+  if( !file.open(QIODevice::ReadOnly | QIODevice::Text) ){
+    const QString msg = tr("reading redistribution policy %1 failed: %2")
+                        .arg( filePath.absoluteFilePath(), file.errorString() );
+    throw ReadLibraryRedistributionPolicyError(msg);
+  }
+
+  const QString msg = tr("reading redistribution policy %1").arg( filePath.absoluteFilePath() );
+  emit verboseMessage(msg);
+
+  return readText( QString::fromUtf8( file.readAll() ), filePath.absoluteFilePath() );
+}
+
+LibraryRedistributionPolicy LibraryRedistributionPolicyReader::readText(const QString & text, const QString & sourceName)
+{
+  LibraryRedistributionPolicy policy;
+  OperatingSystem os = OperatingSystem::Unknown;
+
+  const QStringList lines = text.split( QLatin1Char('\n') );
+  for(int i = 0; i < lines.size(); ++i){
+    const QString line = lines.at(i).trimmed();
+    const int lineNumber = i + 1;
+    if( line.isEmpty() || line.startsWith( QLatin1Char('#') ) ){
+      continue;
+    }
+    if( isSectionLine(line) ){
+      os = operatingSystemFromSectionLine(line, sourceName, lineNumber);
+    }else{
+      addRuleFromLine(policy, line, os, sourceName, lineNumber);
+    }
+  }
+
+  return policy;
+}
+
+bool LibraryRedistributionPolicyReader::isSectionLine(const QString & line) noexcept
+{
+  return line.startsWith( QLatin1Char('[') );
+}
+
+OperatingSystem LibraryRedistributionPolicyReader::operatingSystemFromSectionLine(const QString & line,
+                                                                                  const QString & sourceName, int lineNumber) const
+{
+  assert( isSectionLine(line) );
+
+  if( !line.endsWith( QLatin1Char(']') ) ){
+    const QString msg = tr("%1:%2: expected a section of the form [name], got '%3'")
+                        .arg( sourceName, QString::number(lineNumber), line );
+    throw ReadLibraryRedistributionPolicyError(msg);
+  }
+
+  const QString name = line.mid(1, line.size() - 2).trimmed();
+  if( name.compare(QLatin1String("all"), Qt::CaseInsensitive) == 0 ){
+    return OperatingSystem::Unknown;
+  }
+  if( name.compare(QLatin1String("linux"), Qt::CaseInsensitive) == 0 ){
+    return OperatingSystem::Linux;
+  }
+  if( name.compare(QLatin1String("windows"), Qt::CaseInsensitive) == 0 ){
+    return OperatingSystem::Windows;
+  }
+
+  const QString msg = tr("%1:%2: unknown section '%3' (expected all, linux or windows)")
+                      .arg( sourceName, QString::number(lineNumber), name );
+  throw ReadLibraryRedistributionPolicyError(msg);
+}
+
+void LibraryRedistributionPolicyReader::addRuleFromLine(LibraryRedistributionPolicy & policy, const QString & line,
+                                                        OperatingSystem os, const QString & sourceName, int lineNumber) const
+{
+  const QStringList items = line.split( QRegularExpression( QLatin1String("\\s+") ), QString::SkipEmptyParts );
+  if( items.size() != 2 ){
+    const QString msg = tr("%1:%2: expected a rule of the form 'exclude|include pattern', got '%3'")
+                        .arg( sourceName, QString::number(lineNumber), line );
+    throw ReadLibraryRedistributionPolicyError(msg);
+  }
+
+  const QString & action = items.at(0);
+  const QString & pattern = items.at(1);
+
+  if( action == QLatin1String("exclude") ){
+    policy.addExcludeRule(pattern, os);
+  }else if( action == QLatin1String("include") ){
+    policy.addIncludeRule(pattern, os);
+  }else{
+    const QString msg = tr("%1:%2: unknown action '%3' (expected exclude or include)")
+                        .arg( sourceName, QString::number(lineNumber), action );
+    throw ReadLibraryRedistributionPolicyError(msg);
+  }
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_LIBRARY_REDISTRIBUTION_POLICY_READER_H
+#define MDT_DEPLOY_UTILS_LIBRARY_REDISTRIBUTION_POLICY_READER_H
+
+#include "LibraryRedistributionPolicy.h"
+#include "ReadLibraryRedistributionPolicyError.h"
+#include "OperatingSystem.h"
+#include "mdt_deployutilscore_export.h"
+#include <QObject>
+#include <QString>
+#include <QFileInfo>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Read a LibraryRedistributionPolicy from a policy file
+   *
+   * A policy file is a text file with one rule per line:
+   * \code
+   * # Rules before any section apply to all platforms
+   * exclude libfoo.so.1
+   * include libstdc++.so.6
+   *
+   * [linux]
+   * exclude libnss_*
+   *
+   * [windows]
+   * include msvcp140.dll
+   * exclude api-ms-win-*
+   * \endcode
+   *
+   * A rule is a action, exclude or include,
+   * followed by a library name pattern.
+   * \sa LibraryRedistributionPolicyRule::pattern
+   *
+   * The sections are [all], [linux] and [windows].
+   * Empty lines and lines beginning with # are ignored.
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT LibraryRedistributionPolicyReader : public QObject
+  {
+    Q_OBJECT
+
+   public:
+
+    /*! \brief Constructor
+     */
+    explicit LibraryRedistributionPolicyReader(QObject *parent = nullptr) noexcept;
+
+    /*! \brief Read from given file
+     *
+     * \pre \a filePath must be a absolute path to a file
+     * \exception ReadLibraryRedistributionPolicyError
+     */
+    LibraryRedistributionPolicy readFile(const QFileInfo & filePath);
+
+    /*! \brief Read from given text
+     *
+     * \a sourceName is only used in error messages
+     *
+     * \exception ReadLibraryRedistributionPolicyError
+     */
+    LibraryRedistributionPolicy readText(const QString & text, const QString & sourceName);
+
+   signals:
+
+    void verboseMessage(const QString & message) const;
+
+   private:
+
+    static
+    bool isSectionLine(const QString & line) noexcept;
+
+    OperatingSystem operatingSystemFromSectionLine(const QString & line, const QString & sourceName, int lineNumber) const;
+    void addRuleFromLine(LibraryRedistributionPolicy & policy, const QString & line,
+                         OperatingSystem os, const QString & sourceName, int lineNumber) const;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_LIBRARY_REDISTRIBUTION_POLICY_READER_H
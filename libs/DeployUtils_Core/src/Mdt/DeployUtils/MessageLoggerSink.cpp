@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "MessageLoggerSink.h"
+#include "MessageLogger.h"
+
+namespace Mdt{ namespace DeployUtils{
+
+void MessageLoggerSink::status(const QString & message)
+{
+  if( shouldOutputStatusMessages(mLogLevel) ){
+    MessageLogger::info(message);
+  }
+}
+
+void MessageLoggerSink::verbose(const QString & message)
+{
+  if( shouldOutputVerboseMessages(mLogLevel) ){
+    MessageLogger::info(message);
+  }
+}
+
+void MessageLoggerSink::debug(const QString & message)
+{
+  if( shouldOutputDebugMessages(mLogLevel) ){
+    MessageLogger::info(message);
+  }
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_MESSAGE_LOGGER_SINK_H
+#define MDT_DEPLOY_UTILS_MESSAGE_LOGGER_SINK_H
+
+#include "AbstractMessageSink.h"
+#include "LogLevel.h"
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Message sink that logs the messages with MessageLogger
+   *
+   * Messages are only logged if \a logLevel requires them.
+   *
+   * \pre MessageLogger must be initialized
+   * \sa MessageLogger
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT MessageLoggerSink : public AbstractMessageSink
+  {
+   public:
+
+    /*! \brief Construct a sink that logs messages required by \a logLevel
+     */
+    explicit MessageLoggerSink(LogLevel logLevel) noexcept
+     : mLogLevel(logLevel)
+    {
+    }
+
+    /*! \brief Get the log level
+     */
+    LogLevel logLevel() const noexcept
+    {
+      return mLogLevel;
+    }
+
+    /*! \brief Log a status message
+     */
+    void status(const QString & message) override;
+
+    /*! \brief Log a verbose message
+     */
+    void verbose(const QString & message) override;
+
+    /*! \brief Log a debug message
+     */
+    void debug(const QString & message) override;
+
+   private:
+
+    LogLevel mLogLevel;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_MESSAGE_LOGGER_SINK_H
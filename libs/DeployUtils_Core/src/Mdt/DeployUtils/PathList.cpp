@@ -24,10 +24,20 @@
 #include <QByteArray>
 #include <QLibraryInfo>
 #include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
 #include <QChar>
+#include <QLatin1Char>
+#include <QStringBuilder>
 #include <algorithm>
 #include <cassert>
 
+#ifdef Q_OS_UNIX
+#include <sys/types.h>
+#include <sys/stat.h>
+#endif // #ifdef Q_OS_UNIX
+
 // #include <QDebug>
 
 namespace Mdt{ namespace DeployUtils{
@@ -78,6 +88,48 @@ void PathList::removeNonExistingDirectories() noexcept
   mList.erase( std::remove_if(mList.begin(), mList.end(), pred) , mList.end() );
 }
 
+namespace{
+
+  /*
+   * Returns a key that is the same for paths
+   * that refer to the same directory
+   */
+  QString directoryIdentityKey(const QString & path) noexcept
+  {
+#ifdef Q_OS_UNIX
+    struct stat status;
+    // stat() follows symbolic links
+    if( ::stat(QFile::encodeName(path).constData(), &status) == 0 ){
+      return QString::number(status.st_dev) % QLatin1Char(':') % QString::number(status.st_ino);
+    }
+#else
+    const QString canonicalPath = QFileInfo(path).canonicalFilePath();
+    if( !canonicalPath.isEmpty() ){
+      return canonicalPath;
+    }
+#endif // #ifdef Q_OS_UNIX
+
+    return QDir::cleanPath(path);
+  }
+
+} // namespace{
+
+void PathList::removeDuplicateDirectories() noexcept
+{
+  QSet<QString> directories;
+  QStringList list;
+
+  for(const QString & path : *this){
+    const QString key = directoryIdentityKey(path);
+    if( !directories.contains(key) ){
+      directories.insert(key);
+      list.append(path);
+    }
+  }
+
+  mList = list;
+}
+
 void PathList::clear()
 {
   mList.clear();
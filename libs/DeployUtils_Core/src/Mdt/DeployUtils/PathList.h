@@ -110,6 +110,23 @@ namespace Mdt{ namespace DeployUtils{
      */
     void removeNonExistingDirectories() noexcept;
 
+    /*! \brief Remove paths that refer to a directory that is allready in this list
+     *
+     * Two paths refer to the same directory if they have the same device and inode,
+     * after resolving symbolic links.
+     * This is typically the case for /lib and /usr/lib
+     * on Linux distributions that merged /usr .
+     *
+     * The first path that refers to a directory is kept,
+     * so the order of precedence does not change.
+     *
+     * Paths that do not refer to a existing directory are compared as given.
+     *
+     * \note On platforms that do not provide device and inode numbers,
+     * the canonical paths are compared.
+     */
+    void removeDuplicateDirectories() noexcept;
+
     /*! \brief Clear this path list
      */
     void clear();
@@ -57,4 +57,21 @@ void QtConfWriter::writeConfToDirectory(const QtConf & conf, const QString & dir
   }
 }
 
+QByteArray QtConfWriter::makeConfFileContent(const QtConf & conf)
+{
+  /*
+   * Same layout than QSettings, which sorts the keys
+   */
+  QByteArray content = "[Paths]\n";
+
+  if( conf.containsPluginsPath() ){
+    content += "Plugins=" + conf.pluginsPath().toUtf8() + '\n';
+  }
+  if( conf.containsPrefixPath() ){
+    content += "Prefix=" + conf.prefixPath().toUtf8() + '\n';
+  }
+
+  return content;
+}
+
 }} // namespace Mdt{ namespace DeployUtils{
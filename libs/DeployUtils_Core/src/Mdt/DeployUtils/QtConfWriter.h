@@ -26,6 +26,7 @@
 #include "mdt_deployutilscore_export.h"
 #include <QObject>
 #include <QString>
+#include <QByteArray>
 
 namespace Mdt{ namespace DeployUtils{
 
@@ -50,6 +51,14 @@ namespace Mdt{ namespace DeployUtils{
      */
     void writeConfToDirectory(const QtConf & conf, const QString & directoryPath);
 
+    /*! \brief Get the content of a qt.conf file for \a conf
+     *
+     * The content is the same than the one written by writeConfToDirectory().
+     * This is used to write a qt.conf to a archive.
+     */
+    static
+    QByteArray makeConfFileContent(const QtConf & conf);
+
    signals:
 
     void verboseMessage(const QString & message) const;
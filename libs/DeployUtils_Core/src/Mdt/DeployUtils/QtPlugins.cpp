@@ -48,7 +48,7 @@ void QtPlugins::installQtPlugins(const QtPluginFileList & plugins, const Destina
   const QStringList pluginsDirectories = getQtPluginsDirectoryNames(plugins);
 
   makeDestinationDirectoryStructure(pluginsDirectories, destination);
-  const CopiedSharedLibraryFileList copiedPlugins = copyPluginsToDestination(plugins, destination, overwriteBehavior);
+  CopiedSharedLibraryFileList copiedPlugins = copyPluginsToDestination(plugins, destination, overwriteBehavior);
 
   if( mShLibDeployer->currentPlatform().supportsRPath() ){
    setRPathToCopiedPlugins(copiedPlugins, destination);
@@ -85,6 +85,8 @@ QtPlugins::copyPluginsToDestination(const QtPluginFileList & plugins,
 
   FileCopier fileCopier;
   fileCopier.setOverwriteBehavior(overwriteBehavior);
+  fileCopier.setDeployManifest( mShLibDeployer->deployManifest() );
+  fileCopier.setFileHashCache( mShLibDeployer->fileHashCache() );
   connect(&fileCopier, &FileCopier::verboseMessage, this, &QtPlugins::verboseMessage);
 
   ExecutableFileReader reader;
@@ -104,7 +106,7 @@ QtPlugins::copyPluginsToDestination(const QtPluginFileList & plugins,
   return copiedPlugins;
 }
 
-void QtPlugins::setRPathToCopiedPlugins(const CopiedSharedLibraryFileList & copiedPlugins,
+void QtPlugins::setRPathToCopiedPlugins(CopiedSharedLibraryFileList & copiedPlugins,
                                         const DestinationDirectory & destination)
 {
   assert( mShLibDeployer.get() != nullptr );
@@ -70,7 +70,7 @@ namespace Mdt{ namespace DeployUtils{
 
     CopiedSharedLibraryFileList copyPluginsToDestination(const QtPluginFileList & plugins,
                                                          const DestinationDirectory & destination, OverwriteBehavior overwriteBehavior);
-    void setRPathToCopiedPlugins(const CopiedSharedLibraryFileList & copiedPlugins, const DestinationDirectory & destination);
+    void setRPathToCopiedPlugins(CopiedSharedLibraryFileList & copiedPlugins, const DestinationDirectory & destination);
 
     std::shared_ptr<SharedLibrariesDeployer> mShLibDeployer;
   };
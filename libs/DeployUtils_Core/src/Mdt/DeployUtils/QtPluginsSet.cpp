@@ -22,6 +22,8 @@
 #include "LibraryName.h"
 #include <QByteArray>
 #include <QDataStream>
+#include <QStringList>
+#include <QLatin1Char>
 #include <cassert>
 
 namespace Mdt{ namespace DeployUtils{
@@ -49,6 +51,17 @@ bool QtPluginsSet::shouldDeployPlugin(const QtPluginFile & plugin) const noexcep
   return contains(directoryName, pluginBaseName);
 }
 
+QString QtPluginsSet::toString() const noexcept
+{
+  QStringList directories;
+
+  for(auto it = mMap.cbegin(); it != mMap.cend(); ++it){
+    directories.append( it.key() + QLatin1Char(':') + it.value().join( QLatin1Char(',') ) );
+  }
+
+  return directories.join( QLatin1Char('|') );
+}
+
 // QString QtPluginsSet::toDebugString() const noexcept
 // {
 //   QByteArray ba;
@@ -102,6 +102,14 @@ namespace Mdt{ namespace DeployUtils{
      */
     bool shouldDeployPlugin(const QtPluginFile & plugin) const noexcept;
 
+    /*! \brief Get a string representation of this set
+     *
+     * The format is the one of the qt-plugins-set command line option:
+     * directoryName1:name1,name2|directoryName2:name1 .
+     * Directories are sorted by name.
+     */
+    QString toString() const noexcept;
+
 //     /*! \internal
 //      */
 //     QString toDebugString() const noexcept;
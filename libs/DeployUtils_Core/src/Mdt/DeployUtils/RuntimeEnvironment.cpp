@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "RuntimeEnvironment.h"
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QDir>
+#include <QLatin1String>
+#include <QLatin1Char>
+#include <QStringBuilder>
+#include <vector>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+RuntimeEnvironment::RuntimeEnvironment(OperatingSystem os) noexcept
+ : mOperatingSystem(os)
+{
+  assert( (os == OperatingSystem::Linux) || (os == OperatingSystem::Windows) );
+}
+
+QString RuntimeEnvironment::libraryPathVariableName() const noexcept
+{
+  if(mOperatingSystem == OperatingSystem::Windows){
+    return QLatin1String("PATH");
+  }
+
+  return QLatin1String("LD_LIBRARY_PATH");
+}
+
+QChar RuntimeEnvironment::pathListSeparator() const noexcept
+{
+  if(mOperatingSystem == OperatingSystem::Windows){
+    return QLatin1Char(';');
+  }
+
+  return QLatin1Char(':');
+}
+
+QString RuntimeEnvironment::toEnvironmentFileContent() const noexcept
+{
+  QStringList nativeDirectories;
+  for(const QString & directory : mLibraryDirectories){
+    nativeDirectories.append( QDir::toNativeSeparators(directory) );
+  }
+
+  return libraryPathVariableName() % QLatin1Char('=') % nativeDirectories.join( pathListSeparator() ) % QLatin1Char('\n');
+}
+
+namespace{
+
+  bool isSameFile(const QFileInfo & a, const QFileInfo & b) noexcept
+  {
+    return a.canonicalFilePath() == b.canonicalFilePath();
+  }
+
+} // namespace{
+
+RuntimeEnvironment RuntimeEnvironment::fromLibraries(OperatingSystem os, const QFileInfoList & libraries)
+{
+  QStringList directories;
+  for(const QFileInfo & library : libraries){
+    assert( library.isAbsolute() );
+    const QString directory = library.absolutePath();
+    if( !directories.contains(directory) ){
+      directories.append(directory);
+    }
+  }
+
+  /*
+   * If a other file with the same name as a library
+   * exists in a other directory, the directory of the library
+   * must come before this other directory
+   */
+  const size_t directoryCount = static_cast<size_t>( directories.count() );
+  std::vector< std::vector<bool> > mustComeBefore( directoryCount, std::vector<bool>(directoryCount, false) );
+  std::vector<int> predecessorCount(directoryCount, 0);
+
+  for(const QFileInfo & library : libraries){
+    const size_t libraryDirectoryIndex = static_cast<size_t>( directories.indexOf( library.absolutePath() ) );
+    for(size_t i = 0; i < directoryCount; ++i){
+      if( (i == libraryDirectoryIndex) || mustComeBefore[libraryDirectoryIndex][i] ){
+        continue;
+      }
+      const QFileInfo otherFile( QDir( directories.at( static_cast<int>(i) ) ), library.fileName() );
+      if( otherFile.exists() && !isSameFile(otherFile, library) ){
+        mustComeBefore[libraryDirectoryIndex][i] = true;
+        ++predecessorCount[i];
+      }
+    }
+  }
+
+  /*
+   * Topological sort that allways takes the first directory
+   * (in the order of the libraries) that has no predecessor left
+   */
+  QStringList sortedDirectories;
+  std::vector<bool> isPlaced(directoryCount, false);
+  while( static_cast<size_t>( sortedDirectories.count() ) < directoryCount ){
+    size_t next = directoryCount;
+    for(size_t i = 0; i < directoryCount; ++i){
+      if( !isPlaced[i] && (predecessorCount[i] == 0) ){
+        next = i;
+        break;
+      }
+    }
+    if(next == directoryCount){
+      QStringList remainingDirectories;
+      for(size_t i = 0; i < directoryCount; ++i){
+        if( !isPlaced[i] ){
+          remainingDirectories.append( QDir::toNativeSeparators( directories.at( static_cast<int>(i) ) ) );
+        }
+      }
+      const QString message = QCoreApplication::translate(
+        "Mdt::DeployUtils::RuntimeEnvironment",
+        "could not order the directories of the shared libraries: "
+        "each of %1 contains a other file with the same name as a library found in a other one of them"
+      ).arg( remainingDirectories.join( QLatin1String(", ") ) );
+      throw FindDependencyError(message);
+    }
+    isPlaced[next] = true;
+    sortedDirectories.append( directories.at( static_cast<int>(next) ) );
+    for(size_t i = 0; i < directoryCount; ++i){
+      if(mustComeBefore[next][i]){
+        --predecessorCount[i];
+      }
+    }
+  }
+
+  RuntimeEnvironment environment(os);
+  environment.setLibraryDirectories(sortedDirectories);
+
+  return environment;
+}
+
+RuntimeEnvironment RuntimeEnvironment::fromDependencies(const BinaryDependenciesResult & dependencies)
+{
+  assert( dependencies.isSolved() );
+
+  QFileInfoList libraries;
+  for(const BinaryDependenciesResultLibrary & library : dependencies){
+    if( library.isToRedistribute() ){
+      libraries.append( QFileInfo( library.absoluteFilePath() ) );
+    }
+  }
+
+  return fromLibraries(dependencies.operatingSystem(), libraries);
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
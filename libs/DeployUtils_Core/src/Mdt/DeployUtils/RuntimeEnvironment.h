@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_RUNTIME_ENVIRONMENT_H
+#define MDT_DEPLOY_UTILS_RUNTIME_ENVIRONMENT_H
+
+#include "OperatingSystem.h"
+#include "BinaryDependenciesResult.h"
+#include "FindDependencyError.h"
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <QStringList>
+#include <QChar>
+#include <QFileInfoList>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Environment to run a target from where its shared libraries are
+   *
+   * Instead of copying the shared libraries a target depends on,
+   * the directories where they are can be put in the variable
+   * that the loader uses to find them
+   * (LD_LIBRARY_PATH on Linux, PATH on Windows).
+   *
+   * \sa fromDependencies()
+   * \sa fromLibraries()
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT RuntimeEnvironment
+  {
+   public:
+
+    /*! \brief Construct a empty environment for \a os
+     *
+     * \pre \a os must be Linux or Windows
+     */
+    explicit RuntimeEnvironment(OperatingSystem os) noexcept;
+
+    /*! \brief Get the operating system
+     */
+    OperatingSystem operatingSystem() const noexcept
+    {
+      return mOperatingSystem;
+    }
+
+    /*! \brief Set the library directories
+     *
+     * The loader will search the directories in given order.
+     */
+    void setLibraryDirectories(const QStringList & directories) noexcept
+    {
+      mLibraryDirectories = directories;
+    }
+
+    /*! \brief Get the library directories
+     */
+    const QStringList & libraryDirectories() const noexcept
+    {
+      return mLibraryDirectories;
+    }
+
+    /*! \brief Get the name of the variable the loader uses to find shared libraries
+     *
+     * Returns LD_LIBRARY_PATH on Linux, PATH on Windows
+     */
+    QString libraryPathVariableName() const noexcept;
+
+    /*! \brief Get the separator of the directories in the library path variable
+     *
+     * Returns ':' on Linux, ';' on Windows
+     */
+    QChar pathListSeparator() const noexcept;
+
+    /*! \brief Get the content of a environment file for this environment
+     *
+     * The content is a single line, like:
+     * \code
+     * LD_LIBRARY_PATH=/opt/qt/lib:/home/me/build/libs
+     * \endcode
+     *
+     * Directories are written with native separators.
+     */
+    QString toEnvironmentFileContent() const noexcept;
+
+    /*! \brief Get the environment to run a target that depends on \a libraries
+     *
+     * The directories of \a libraries are ordered,
+     * so that the loader finds each library in the directory it has been found,
+     * and not a other file with the same name that exists in a other directory.
+     * When there is no constraint, the directories
+     * are kept in the order of \a libraries .
+     *
+     * \pre \a os must be Linux or Windows
+     * \pre each library in \a libraries must have a absolute path
+     * \exception FindDependencyError
+     * Thrown if no order can satisfy every library
+     * (for example, 2 directories that both contain a other version of a library the other one provides).
+     */
+    static
+    RuntimeEnvironment fromLibraries(OperatingSystem os, const QFileInfoList & libraries);
+
+    /*! \brief Get the environment to run the target of \a dependencies
+     *
+     * Only the libraries that are to redistribute are considered,
+     * the other ones (for example, system libraries)
+     * are found by the loader the usual way,
+     * and their directories must not be put before the ones of the libraries to redistribute.
+     *
+     * \pre \a dependencies must be solved
+     * \exception FindDependencyError
+     * \sa fromLibraries()
+     * \sa BinaryDependenciesResultLibrary::isToRedistribute()
+     */
+    static
+    RuntimeEnvironment fromDependencies(const BinaryDependenciesResult & dependencies);
+
+   private:
+
+    OperatingSystem mOperatingSystem;
+    QStringList mLibraryDirectories;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_RUNTIME_ENVIRONMENT_H
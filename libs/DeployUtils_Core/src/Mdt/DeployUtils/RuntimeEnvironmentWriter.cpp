@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "RuntimeEnvironmentWriter.h"
+#include <QSaveFile>
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+RuntimeEnvironmentWriter::RuntimeEnvironmentWriter(QObject *parent) noexcept
+ : QObject(parent)
+{
+}
+
+void RuntimeEnvironmentWriter::writeFile(const RuntimeEnvironment & environment, const QString & filePath)
+{
+  assert( QDir::isAbsolutePath(filePath) );
+
+  emit verboseMessage(
+    tr("writing runtime environment %1")
+    .arg(filePath)
+  );
+
+  const QString directoryPath = QFileInfo(filePath).absolutePath();
+  if( !QDir().mkpath(directoryPath) ){
+    const QString msg = tr("writing %1 failed: could not create directory %2")
+                        .arg(filePath, directoryPath);
+    throw WriteRuntimeEnvironmentError(msg);
+  }
+
+  QSaveFile file(filePath);
+  if( !file.open(QIODevice::WriteOnly | QIODevice::Text) ){
+    const QString msg = tr("writing %1 failed: %2")
+                        .arg( filePath, file.errorString() );
+    throw WriteRuntimeEnvironmentError(msg);
+  }
+
+  file.write( QFile::encodeName( environment.toEnvironmentFileContent() ) );
+
+  if( !file.commit() ){
+    const QString msg = tr("writing %1 failed: %2")
+                        .arg( filePath, file.errorString() );
+    throw WriteRuntimeEnvironmentError(msg);
+  }
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_RUNTIME_ENVIRONMENT_WRITER_H
+#define MDT_DEPLOY_UTILS_RUNTIME_ENVIRONMENT_WRITER_H
+
+#include "RuntimeEnvironment.h"
+#include "WriteRuntimeEnvironmentError.h"
+#include "mdt_deployutilscore_export.h"
+#include <QObject>
+#include <QString>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Helper to write a RuntimeEnvironment to a environment file
+   *
+   * \sa RuntimeEnvironment::toEnvironmentFileContent()
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT RuntimeEnvironmentWriter : public QObject
+  {
+    Q_OBJECT
+
+   public:
+
+    /*! \brief Constructor
+     */
+    explicit RuntimeEnvironmentWriter(QObject *parent = nullptr) noexcept;
+
+    /*! \brief Write \a environment to given \a filePath
+     *
+     * Missing parent directories are created.
+     * The file is allways rewritten, also if its content did not change.
+     *
+     * \pre \a filePath must be a absolute path
+     * \exception WriteRuntimeEnvironmentError
+     */
+    void writeFile(const RuntimeEnvironment & environment, const QString & filePath);
+
+   signals:
+
+    void verboseMessage(const QString & message) const;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_RUNTIME_ENVIRONMENT_WRITER_H
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "SearchPathIndex.h"
+#include <QDir>
+#include <QDirIterator>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+QStringList SearchPathIndex::directoriesContaining(const QString & fileName) const noexcept
+{
+  assert( !fileName.isEmpty() );
+
+  QStringList directories;
+
+  const auto it = mDirectoryIndexesByFileName.constFind( makeKey(fileName) );
+  if( it == mDirectoryIndexesByFileName.cend() ){
+    return directories;
+  }
+  for(const int index : *it){
+    directories.append( mDirectories.at(index) );
+  }
+
+  return directories;
+}
+
+bool SearchPathIndex::directoryContains(const QString & directory, const QString & fileName) const noexcept
+{
+  assert( isIndexedDirectory(directory) );
+  assert( !fileName.isEmpty() );
+
+  const auto it = mDirectoryIndexesByFileName.constFind( makeKey(fileName) );
+  if( it == mDirectoryIndexesByFileName.cend() ){
+    return false;
+  }
+
+  return it->contains( mDirectoryIndexes.value(directory) );
+}
+
+SearchPathIndex SearchPathIndex::fromDirectories(const QStringList & directories, Qt::CaseSensitivity caseSensitivity)
+{
+  SearchPathIndex index;
+  index.mCaseSensitivity = caseSensitivity;
+
+  for(const QString & directory : directories){
+    if( index.mDirectoryIndexes.contains(directory) ){
+      continue;
+    }
+    const int directoryIndex = index.mDirectories.count();
+    index.mDirectories.append(directory);
+    index.mDirectoryIndexes.insert(directory, directoryIndex);
+
+    QDirIterator it( directory, QDir::Files | QDir::Hidden );
+    while( it.hasNext() ){
+      it.next();
+      QVector<int> & directoryIndexes = index.mDirectoryIndexesByFileName[ index.makeKey( it.fileName() ) ];
+      // With a case insensitive index, a directory can contain several matching files
+      if( directoryIndexes.isEmpty() || (directoryIndexes.last() != directoryIndex) ){
+        directoryIndexes.append(directoryIndex);
+      }
+      ++index.mFileCount;
+    }
+  }
+
+  return index;
+}
+
+QString SearchPathIndex::makeKey(const QString & fileName) const noexcept
+{
+  if(mCaseSensitivity == Qt::CaseInsensitive){
+    return fileName.toLower();
+  }
+
+  return fileName;
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_SEARCH_PATH_INDEX_H
+#define MDT_DEPLOY_UTILS_SEARCH_PATH_INDEX_H
+
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QVector>
+#include <QtGlobal>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Index of the files in the directories of a search path list
+   *
+   * When the search path list is built from a long list of prefixes
+   * (for example a CMAKE_PREFIX_PATH with a entry per Conan package),
+   * it contains a lot of directories,
+   * and a shared library finder probes a file in each of them
+   * until it finds the library.
+   *
+   * This index lists each directory once,
+   * then gives, for a file name, the directories that contain it,
+   * in the order of the search path list.
+   * A finder then only probes those directories.
+   *
+   * This index does not detect changes on the file system,
+   * so it should only live for a run.
+   *
+   * \sa AbstractSharedLibraryFinder::buildSearchPathIndex()
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT SearchPathIndex
+  {
+   public:
+
+    /*! \brief Get the directories that contain a file named \a fileName
+     *
+     * The directories are returned in the order
+     * they have been given to fromDirectories().
+     *
+     * \pre \a fileName must not be empty
+     */
+    QStringList directoriesContaining(const QString & fileName) const noexcept;
+
+    /*! \brief Check if \a directory has been indexed
+     */
+    bool isIndexedDirectory(const QString & directory) const noexcept
+    {
+      return mDirectoryIndexes.contains(directory);
+    }
+
+    /*! \brief Check if \a directory contains a file named \a fileName
+     *
+     * \pre \a directory must have been indexed
+     * \pre \a fileName must not be empty
+     * \sa isIndexedDirectory()
+     */
+    bool directoryContains(const QString & directory, const QString & fileName) const noexcept;
+
+    /*! \brief Get the count of indexed directories
+     */
+    int directoryCount() const noexcept
+    {
+      return mDirectories.count();
+    }
+
+    /*! \brief Get the count of indexed files
+     */
+    int fileCount() const noexcept
+    {
+      return mFileCount;
+    }
+
+    /*! \brief Check if this index is empty
+     */
+    bool isEmpty() const noexcept
+    {
+      return mDirectories.isEmpty();
+    }
+
+    /*! \brief Build a index of the files in \a directories
+     *
+     * Each directory is listed once.
+     * A directory that does not exist is indexed as empty.
+     *
+     * If \a caseSensitivity is Qt::CaseInsensitive
+     * (for example to find libraries for Windows),
+     * file names are compared without regard to case.
+     */
+    static
+    SearchPathIndex fromDirectories(const QStringList & directories, Qt::CaseSensitivity caseSensitivity);
+
+   private:
+
+    QString makeKey(const QString & fileName) const noexcept;
+
+    Qt::CaseSensitivity mCaseSensitivity = Qt::CaseSensitive;
+    QStringList mDirectories;
+    QHash<QString, int> mDirectoryIndexes;
+    QHash< QString, QVector<int> > mDirectoryIndexesByFileName;
+    int mFileCount = 0;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_SEARCH_PATH_INDEX_H
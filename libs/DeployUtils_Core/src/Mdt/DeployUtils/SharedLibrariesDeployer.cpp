@@ -22,14 +22,20 @@
 #include "BinaryDependenciesResultLibrary.h"
 #include "CompilerFinder.h"
 #include "FileCopier.h"
+#include "FindDependencyError.h"
 #include "RPath.h"
 #include "Algorithm.h"
 #include "FileInfoUtils.h"
+#include "Impl/SharedLibraryCopyPipeline.h"
+#include "Impl/InMemoryFile.h"
 #include <Mdt/ExecutableFile/ExecutableFileReader.h>
 #include <Mdt/ExecutableFile/ExecutableFileWriter.h>
 #include <QLatin1String>
+#include <QLatin1Char>
 #include <QStringBuilder>
+#include <QHash>
 #include <memory>
+#include <optional>
 #include <cassert>
 
 // #include <QDebug>
@@ -87,6 +93,37 @@ void SharedLibrariesDeployer::setCompilerLocation(const CompilerLocationRequest
   mBinaryDependencies.setCompilerFinder(compilerFinder);
 }
 
+void SharedLibrariesDeployer::setRedistributionPolicy(const LibraryRedistributionPolicy & policy) noexcept
+{
+  mBinaryDependencies.setRedistributionPolicy(policy);
+}
+
+void SharedLibrariesDeployer::setMetadataCache(const std::shared_ptr<ExecutableFileMetadataCache> & cache) noexcept
+{
+  mMetadataCache = cache;
+  mBinaryDependencies.setMetadataCache(cache);
+}
+
+void SharedLibrariesDeployer::setLookupMissCache(const std::shared_ptr<LibraryLookupMissCache> & cache) noexcept
+{
+  mBinaryDependencies.setLookupMissCache(cache);
+}
+
+void SharedLibrariesDeployer::setFileStatBackend(FileStatBackend backend) noexcept
+{
+  mBinaryDependencies.setFileStatBackend(backend);
+}
+
+void SharedLibrariesDeployer::setLogLevel(LogLevel level) noexcept
+{
+  mBinaryDependencies.setLogLevel(level);
+}
+
+void SharedLibrariesDeployer::setMessageSink(const std::shared_ptr<AbstractMessageSink> & sink) noexcept
+{
+  mBinaryDependencies.setMessageSink(sink);
+}
+
 void SharedLibrariesDeployer::setOverwriteBehavior(OverwriteBehavior overwriteBehavior) noexcept
 {
   mOverwriteBehavior = overwriteBehavior;
@@ -97,6 +134,26 @@ void SharedLibrariesDeployer::setRemoveRpath(bool remove) noexcept
   mRemoveRpath = remove;
 }
 
+void SharedLibrariesDeployer::setPipelinedCopy(bool pipelined) noexcept
+{
+  mPipelinedCopy = pipelined;
+}
+
+void SharedLibrariesDeployer::setDeployManifest(const std::shared_ptr<const DeployManifest> & manifest) noexcept
+{
+  mDeployManifest = manifest;
+}
+
+void SharedLibrariesDeployer::setDeployStore(const std::shared_ptr<DeployStore> & store) noexcept
+{
+  mDeployStore = store;
+}
+
+void SharedLibrariesDeployer::setFileHashCache(const std::shared_ptr<FileHashCache> & cache) noexcept
+{
+  mFileHashCache = cache;
+}
+
 bool SharedLibrariesDeployer::hasToUpdateRpath(const CopiedSharedLibraryFile & file, const RPath & rpath, const PathList & systemWideLocations) const noexcept
 {
   if(file.rpath == rpath){
@@ -160,20 +217,9 @@ void SharedLibrariesDeployer::installSharedLibraries(const BinaryDependenciesRes
     tr("installing shared libraries")
   );
 
-  const QString overwriteBehaviorMessage = tr("overwrite behavior: %1").arg( overwriteBehaviorToString(mOverwriteBehavior) );
-  emit verboseMessage(overwriteBehaviorMessage);
+  emitInstallSharedLibrariesMessages();
 
-  if( mPlatform.supportsRPath() ){
-    if(mRemoveRpath){
-      const QString rpathMessage = tr("RPATH will be removed in copied libraries");
-      emit verboseMessage(rpathMessage);
-    }else{
-      const QString rpathMessage = tr("RPATH will be set to $ORIGIN in copied libraries");
-      emit verboseMessage(rpathMessage);
-    }
-  }
-
-  const CopiedSharedLibraryFileList copiedFiles = copySharedLibraries(libraries, destinationDirectoryPath);
+  CopiedSharedLibraryFileList copiedFiles = copySharedLibraries(libraries, destinationDirectoryPath);
 
   if( mPlatform.supportsRPath() ){
     setRPathToCopiedDependencies(copiedFiles);
@@ -187,6 +233,10 @@ SharedLibrariesDeployer::copySharedLibraries(const BinaryDependenciesResultList
 
   FileCopier fileCopier;
   fileCopier.setOverwriteBehavior(mOverwriteBehavior);
+  fileCopier.setDeployManifest(mDeployManifest);
+  fileCopier.setDeployStore(mDeployStore);
+  fileCopier.setFileHashCache(mFileHashCache);
+  fileCopier.setPreserveSymLinks( hasToPreserveSymLinks() );
   connect(&fileCopier, &FileCopier::verboseMessage, this, &SharedLibrariesDeployer::verboseMessage);
 
   fileCopier.createDirectory(destinationDirectoryPath);
@@ -206,13 +256,18 @@ SharedLibrariesDeployer::copySharedLibraries(const BinaryDependenciesResultList
   return copiedFiles;
 }
 
-void SharedLibrariesDeployer::copySharedLibrariesTargetDependsOn(const QFileInfo & targetFilePath, const QString & destinationDirectoryPath)
+BinaryDependenciesResult
+SharedLibrariesDeployer::copySharedLibrariesTargetDependsOn(const QFileInfo & targetFilePath, const QString & destinationDirectoryPath)
 {
   assert( !targetFilePath.filePath().isEmpty() );
   assert( targetFilePath.isAbsolute() );
   assert( !destinationDirectoryPath.isEmpty() );
 
-  copySharedLibrariesTargetsDependsOnImpl(QFileInfoList{targetFilePath}, destinationDirectoryPath);
+  const BinaryDependenciesResultList dependencies
+    = copySharedLibrariesTargetsDependsOnImpl(QFileInfoList{targetFilePath}, destinationDirectoryPath);
+  assert( dependencies.resultCount() == 1 );
+
+  return *dependencies.cbegin();
 }
 
 void SharedLibrariesDeployer::setCurrentPlatformFromFile(const QFileInfo & file)
@@ -225,19 +280,110 @@ void SharedLibrariesDeployer::setCurrentPlatformFromFile(const QFileInfo & file)
   reader.close();
 }
 
-void SharedLibrariesDeployer::copySharedLibrariesTargetsDependsOnImpl(const QFileInfoList & targetFilePathList, const QString & destinationDirectoryPath)
+BinaryDependenciesResultList
+SharedLibrariesDeployer::copySharedLibrariesTargetsDependsOnImpl(const QFileInfoList & targetFilePathList, const QString & destinationDirectoryPath)
 {
   assert( !targetFilePathList.isEmpty() );
   assert( !destinationDirectoryPath.isEmpty() );
 
+  if(mPipelinedCopy){
+    return copySharedLibrariesTargetsDependsOnPipelined(targetFilePathList, destinationDirectoryPath);
+  }
+
   const BinaryDependenciesResultList dependencies = findSharedLibrariesTargetsDependsOn(targetFilePathList);
 
   installSharedLibraries(dependencies, destinationDirectoryPath);
 
-  return;
+  return dependencies;
 }
 
-void SharedLibrariesDeployer::setRPathToCopiedSharedLibraries(const CopiedSharedLibraryFileList & copiedFiles, const RPath & rpath)
+BinaryDependenciesResultList
+SharedLibrariesDeployer::copySharedLibrariesTargetsDependsOnPipelined(const QFileInfoList & targetFilePathList, const QString & destinationDirectoryPath)
+{
+  assert( !targetFilePathList.isEmpty() );
+  assert( !destinationDirectoryPath.isEmpty() );
+
+  FileCopier::createDirectory(destinationDirectoryPath);
+
+  // The platform tells if symbolic links can be preserved
+  setCurrentPlatformFromFile( targetFilePathList.at(0) );
+
+  /*
+   * If anything throws before finish() has returned,
+   * the pipeline is aborted by its destructor,
+   * which removes the files it created
+   * and restores the files it overwrote.
+   */
+  Impl::SharedLibraryCopyPipeline pipeline(destinationDirectoryPath);
+  pipeline.setOverwriteBehavior(mOverwriteBehavior);
+  pipeline.setDeployManifest(mDeployManifest);
+  pipeline.setDeployStore(mDeployStore);
+  pipeline.setFileHashCache(mFileHashCache);
+  pipeline.setPreserveSymLinks( hasToPreserveSymLinks() );
+  pipeline.start();
+
+  emit statusMessage(
+    tr("installing shared libraries while finding dependencies")
+  );
+
+  const auto connection = connect(&mBinaryDependencies, &BinaryDependencies::sharedLibraryFound, [&pipeline](const QFileInfo & library){
+    pipeline.enqueue( library.absoluteFilePath() );
+  });
+
+  std::optional<BinaryDependenciesResultList> dependencies;
+  try{
+    dependencies = findSharedLibrariesTargetsDependsOn(targetFilePathList);
+  }catch(...){
+    disconnect(connection);
+    throw;
+  }
+  disconnect(connection);
+
+  if( !dependencies->isSolved() ){
+    pipeline.abort();
+    throwDependenciesNotSolvedError(*dependencies);
+  }
+
+  emitInstallSharedLibrariesMessages();
+
+  /*
+   * The libraries that are not found while searching,
+   * like a target that is also a dependency of a other target,
+   * are only known now
+   */
+  const auto libraries = getLibrariesToRedistribute(*dependencies);
+  QHash<QString, RPath> rpathByLibrary;
+  for(const BinaryDependenciesResultLibrary & library : libraries){
+    pipeline.enqueue( library.absoluteFilePath() );
+    rpathByLibrary.insert( library.absoluteFilePath(), library.rPath() );
+  }
+
+  const std::vector<FileCopierFile> files = pipeline.finish();
+  for( const QString & message : pipeline.messages() ){
+    emit verboseMessage(message);
+  }
+
+  CopiedSharedLibraryFileList copiedFiles;
+  for(const FileCopierFile & file : files){
+    CopiedSharedLibraryFile copiedShLib;
+    copiedShLib.file = file;
+    copiedShLib.rpath = rpathByLibrary.value( file.sourceAbsoluteFilePath() );
+    copiedFiles.push_back(copiedShLib);
+  }
+
+  if( mPlatform.supportsRPath() ){
+    try{
+      setRPathToCopiedDependencies(copiedFiles);
+    }catch(...){
+      pipeline.rollback();
+      throw;
+    }
+  }
+
+  return *dependencies;
+}
+
+void SharedLibrariesDeployer::setRPathToCopiedSharedLibraries(CopiedSharedLibraryFileList & copiedFiles, const RPath & rpath)
 {
   assert( mPlatform.supportsRPath() );
 
@@ -255,18 +401,68 @@ void SharedLibrariesDeployer::setRPathToCopiedSharedLibraries(const CopiedShared
 
   const PathList systemWideLocations = PathList::getSystemLibraryKnownPathList(mPlatform);
 
-  for(const CopiedSharedLibraryFile & copiedFile : copiedFiles){
-    if( hasToUpdateRpath(copiedFile, rpath, systemWideLocations) ){
-      const QString msg = tr("update rpath for %1").arg( copiedFile.file.destinationFileInfo().absoluteFilePath() );
+  Impl::InMemoryFile patchedFile;
+
+  /*
+   * The RPATH is changed in memory, never in place,
+   * because a destination could be a hard link to a deploy store
+   */
+  const auto patchFileInMemory = [&](const QString & filePath){
+    if( !patchedFile.copyFrom(filePath) ){
+      const QString msg = tr("could not copy %1 to update its rpath").arg(filePath);
+      throw FileCopyError(msg);
+    }
+    writer.openFile(QFileInfo( patchedFile.filePath() ), mPlatform);
+    writer.setRunPath(rpath);
+    writer.close();
+  };
+
+  // A library linked from the deploy store is patched once per RPATH
+  QStringList rpathPathList;
+  for(int i = 0; i < rpath.entriesCount(); ++i){
+    rpathPathList.append( rpath.entryAt(i).path() );
+  }
+  const QString storePatchKey = QLatin1String("rpath:") % rpathPathList.join( QLatin1Char(':') );
+
+  for(CopiedSharedLibraryFile & copiedFile : copiedFiles){
+    const bool rpathHasToBeUpdated = hasToUpdateRpath(copiedFile, rpath, systemWideLocations);
+    if(rpathHasToBeUpdated){
+      const QString destinationFilePath = copiedFile.file.destinationFileInfo().absoluteFilePath();
+      const QString msg = tr("update rpath for %1").arg(destinationFilePath);
       emit verboseMessage(msg);
-      writer.openFile(copiedFile.file.destinationFileInfo(), mPlatform);
-      writer.setRunPath(rpath);
+      if( mDeployStore && copiedFile.file.isLinkedFromDeployStore() ){
+        const QString sourceSha256 = copiedFile.file.sha256();
+        QString sha256 = mDeployStore->findPatchedFile(sourceSha256, storePatchKey);
+        if( sha256.isEmpty() ){
+          patchFileInMemory(destinationFilePath);
+          sha256 = mDeployStore->addPatchedFile( sourceSha256, storePatchKey, patchedFile.filePath() );
+        }else{
+          const QString reuseMsg = tr(" rpath allready updated in the deploy store");
+          emit verboseMessage(reuseMsg);
+        }
+        mDeployStore->relinkFile(sha256, destinationFilePath);
+        // The unchanged content is only kept if a other destination links to it
+        mDeployStore->removeUnusedFile(sourceSha256);
+        copiedFile.file.setSha256(sha256);
+      }else{
+        patchFileInMemory(destinationFilePath);
+        // The SHA-256 is computed while the destination is written
+        copiedFile.file.setSha256( FileCopier::replaceFileContent(patchedFile.filePath(), destinationFilePath) );
+      }
+      if(mFileHashCache){
+        mFileHashCache->insert( destinationFilePath, copiedFile.file.sha256() );
+      }
+    }
+    // So that the deploy manifest gets the RPATH without reading the file again
+    if(mMetadataCache){
+      const RPath & runPath = rpathHasToBeUpdated ? rpath : copiedFile.rpath;
+      mMetadataCache->insertCopiedFile( copiedFile.file.sourceFileInfo(), copiedFile.file.destinationFileInfo(), runPath );
     }
     writer.close();
   }
 }
 
-void SharedLibrariesDeployer::setRPathToCopiedDependencies(const CopiedSharedLibraryFileList & copiedFiles)
+void SharedLibrariesDeployer::setRPathToCopiedDependencies(CopiedSharedLibraryFileList & copiedFiles)
 {
   assert( mPlatform.supportsRPath() );
 
@@ -278,6 +474,55 @@ void SharedLibrariesDeployer::setRPathToCopiedDependencies(const CopiedSharedLib
   setRPathToCopiedSharedLibraries(copiedFiles, rpath);
 }
 
+bool SharedLibrariesDeployer::hasToPreserveSymLinks() const noexcept
+{
+  if( mPlatform.isNull() ){
+    return false;
+  }
+
+  return mPlatform.operatingSystem() != OperatingSystem::Windows;
+}
+
+void SharedLibrariesDeployer::emitInstallSharedLibrariesMessages() const
+{
+  const QString overwriteBehaviorMessage = tr("overwrite behavior: %1").arg( overwriteBehaviorToString(mOverwriteBehavior) );
+  emit verboseMessage(overwriteBehaviorMessage);
+
+  if( mPlatform.supportsRPath() ){
+    if(mRemoveRpath){
+      const QString rpathMessage = tr("RPATH will be removed in copied libraries");
+      emit verboseMessage(rpathMessage);
+    }else{
+      const QString rpathMessage = tr("RPATH will be set to $ORIGIN in copied libraries");
+      emit verboseMessage(rpathMessage);
+    }
+  }
+}
+
+void SharedLibrariesDeployer::throwDependenciesNotSolvedError(const BinaryDependenciesResultList & resultList) const
+{
+  assert( !resultList.isSolved() );
+
+  QString notSolvedTargetsMsg;
+  for(const BinaryDependenciesResult & result : resultList){
+    if( result.isSolved() ){
+      continue;
+    }
+    QStringList missingLibraries;
+    for(const BinaryDependenciesResultLibrary & library : result){
+      if( library.isMissing() ){
+        missingLibraries.append( library.libraryName() );
+      }
+    }
+    notSolvedTargetsMsg += tr("\n %1: missing libraries: %2")
+                           .arg( result.target().fileName(), missingLibraries.join( QLatin1String(", ") ) );
+  }
+
+  const QString msg = tr("some shared libraries could not be found, nothing has been installed: %1")
+                      .arg(notSolvedTargetsMsg);
+  throw FindDependencyError(msg);
+}
+
 void SharedLibrariesDeployer::emitStartMessage(const QFileInfo & target) const noexcept
 {
   emit statusMessage(
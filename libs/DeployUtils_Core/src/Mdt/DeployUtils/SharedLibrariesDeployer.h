@@ -24,6 +24,11 @@
 #include "PathList.h"
 #include "FileCopierFile.h"
 #include "CompilerLocationRequest.h"
+#include "LibraryRedistributionPolicy.h"
+#include "ExecutableFileMetadataCache.h"
+#include "DeployManifest.h"
+#include "DeployStore.h"
+#include "FileHashCache.h"
 #include "OverwriteBehavior.h"
 #include "Platform.h"
 #include "BinaryDependencies.h"
@@ -64,6 +69,11 @@ namespace Mdt{ namespace DeployUtils{
    *
    * To find dependencies, \a searchPrefixPathList will be used.
    *
+   * On platforms other than Windows,
+   * a shared library found by a symbolic link (like libfoo.so.1 -> libfoo.so.1.2.3)
+   * is copied once, and the link is created in the destination
+   * (see FileCopier::setPreserveSymLinks()).
+   *
    * \sa setOverwriteBehavior()
    * \sa setRemoveRpath()
    * \sa setSearchPrefixPathList()
@@ -114,6 +124,56 @@ namespace Mdt{ namespace DeployUtils{
      */
     void setCompilerLocation(const CompilerLocationRequest & location);
 
+    /*! \brief Set the redistribution policy
+     *
+     * By default, only the built-in rules decide which shared libraries are redistributed.
+     *
+     * \sa LibraryRedistributionPolicy
+     */
+    void setRedistributionPolicy(const LibraryRedistributionPolicy & policy) noexcept;
+
+    /*! \brief Set a metadata cache
+     *
+     * \sa BinaryDependencies::setMetadataCache()
+     */
+    void setMetadataCache(const std::shared_ptr<ExecutableFileMetadataCache> & cache) noexcept;
+
+    /*! \brief Get the metadata cache
+     *
+     * Once the RPATH of the copied libraries has been set,
+     * the cache also knows the metadata of the copied libraries.
+     *
+     * \sa ExecutableFileMetadataCache::insertCopiedFile()
+     */
+    const std::shared_ptr<ExecutableFileMetadataCache> & metadataCache() const noexcept
+    {
+      return mMetadataCache;
+    }
+
+    /*! \brief Set a cache of libraries that could not be found
+     *
+     * \sa BinaryDependencies::setLookupMissCache()
+     */
+    void setLookupMissCache(const std::shared_ptr<LibraryLookupMissCache> & cache) noexcept;
+
+    /*! \brief Set the backend used to stat files
+     *
+     * \sa BinaryDependencies::setFileStatBackend()
+     */
+    void setFileStatBackend(FileStatBackend backend) noexcept;
+
+    /*! \brief Set the log level
+     *
+     * \sa BinaryDependencies::setLogLevel()
+     */
+    void setLogLevel(LogLevel level) noexcept;
+
+    /*! \brief Set a message sink
+     *
+     * \sa BinaryDependencies::setMessageSink()
+     */
+    void setMessageSink(const std::shared_ptr<AbstractMessageSink> & sink) noexcept;
+
     /*! \brief Set the overwrite behaviour
      *
      * If a shared library allready exists at the destination location,
@@ -156,6 +216,91 @@ namespace Mdt{ namespace DeployUtils{
       return mRemoveRpath;
     }
 
+    /*! \brief Set the pipelined copy
+     *
+     * By default, copySharedLibrariesTargetDependsOn() first finds all the dependencies,
+     * then copies the shared libraries.
+     *
+     * If \a pipelined is true, each shared library to redistribute
+     * is copied by a worker thread as soon as it is found,
+     * while the other dependencies are still searched.
+     * If some dependencies could not be found, or if a error occurs,
+     * the files that have been created in the destination directory are removed.
+     *
+     * \sa Impl::SharedLibraryCopyPipeline
+     */
+    void setPipelinedCopy(bool pipelined) noexcept;
+
+    /*! \brief Check if the pipelined copy is enabled
+     *
+     * \sa setPipelinedCopy()
+     */
+    bool isPipelinedCopy() const noexcept
+    {
+      return mPipelinedCopy;
+    }
+
+    /*! \brief Set the manifest of a previous deploy
+     *
+     * If set, shared libraries that are up to date are not copied again.
+     *
+     * \sa FileCopier::setDeployManifest()
+     */
+    void setDeployManifest(const std::shared_ptr<const DeployManifest> & manifest) noexcept;
+
+    /*! \brief Get the manifest of a previous deploy
+     *
+     * Can be null
+     *
+     * \sa setDeployManifest()
+     */
+    const std::shared_ptr<const DeployManifest> & deployManifest() const noexcept
+    {
+      return mDeployManifest;
+    }
+
+    /*! \brief Set a deploy store
+     *
+     * If set, copied shared libraries are linked to \a store
+     * instead of being copied.
+     * A library whose RPATH is changed is changed once per store and RPATH,
+     * stored as a other content,
+     * then linked to each destination that requires it
+     * (see DeployStore::addPatchedFile()).
+     *
+     * Only shared libraries go through the store:
+     * executables and Qt plugins are copied.
+     *
+     * By default, no deploy store is used.
+     *
+     * \sa FileCopier::setDeployStore()
+     * \sa DeployStore
+     */
+    void setDeployStore(const std::shared_ptr<DeployStore> & store) noexcept;
+
+    /*! \brief Set a file hash cache
+     *
+     * If set, the SHA-256 of each installed shared library
+     * is inserted to \a cache , once its RPATH has been changed.
+     *
+     * By default, no cache is used.
+     *
+     * \sa FileCopier::setFileHashCache()
+     * \sa FileHashCache
+     */
+    void setFileHashCache(const std::shared_ptr<FileHashCache> & cache) noexcept;
+
+    /*! \brief Get the file hash cache
+     *
+     * Can be null
+     *
+     * \sa setFileHashCache()
+     */
+    const std::shared_ptr<FileHashCache> & fileHashCache() const noexcept
+    {
+      return mFileHashCache;
+    }
+
     /*! \brief Check if given Rpath has to be changed for given file
      *
      * \sa https://gitlab.com/scandyna/mdtdeployutils/-/issues/3
@@ -206,6 +351,12 @@ namespace Mdt{ namespace DeployUtils{
      * \sa doc of QFileInfo::absoluteFilePath()
      * \pre \a destinationDirectoryPath must be a absolute path
      *
+     * In pipelined copy mode, a FindDependencyError is thrown
+     * if some dependencies could not be found.
+     *
+     * Returns the dependencies that have been found for \a targetFilePath
+     * (including those that are not redistributed).
+     *
      * \exception FindCompilerError
      * \exception FileOpenError
      * \exception ExecutableFileReadError
@@ -214,14 +365,30 @@ namespace Mdt{ namespace DeployUtils{
      * \exception ExecutableFileWriteError
      *
      * \sa copySharedLibrariesTargetsDependsOn()
+     * \sa setPipelinedCopy()
      */
-    void copySharedLibrariesTargetDependsOn(const QFileInfo & targetFilePath, const QString & destinationDirectoryPath);
+    BinaryDependenciesResult copySharedLibrariesTargetDependsOn(const QFileInfo & targetFilePath, const QString & destinationDirectoryPath);
 
     /*! \brief Set given rpath to given copied shared libraries
+     *
+     * The RPATH of each file is changed in memory,
+     * then the file is replaced,
+     * so that its SHA-256 is computed while it is written.
+     *
+     * A file that has been linked from the deploy store
+     * is instead linked to the variant of the store file that has \a rpath ,
+     * which is only changed the first time.
+     *
+     * If a metadata cache is set, the metadata of each file,
+     * with the RPATH it has now, is inserted to it.
      *
      * \pre current platform must support RPath
+     * \sa ExecutableFileMetadataCache::insertCopiedFile()
+     * \sa FileCopierFile::sha256()
+     * \sa FileCopierFile::isLinkedFromDeployStore()
+     * \sa FileCopier::replaceFileContent()
      */
-    void setRPathToCopiedSharedLibraries(const CopiedSharedLibraryFileList & copiedFiles, const RPath & rpath);
+    void setRPathToCopiedSharedLibraries(CopiedSharedLibraryFileList & copiedFiles, const RPath & rpath);
 
     /*! \brief Get the current platform
      *
@@ -245,8 +412,12 @@ namespace Mdt{ namespace DeployUtils{
    private:
 
     void setCurrentPlatformFromFile(const QFileInfo & file);
-    void copySharedLibrariesTargetsDependsOnImpl(const QFileInfoList & targetFilePathList, const QString & destinationDirectoryPath);
-    void setRPathToCopiedDependencies(const CopiedSharedLibraryFileList & copiedFiles);
+    BinaryDependenciesResultList copySharedLibrariesTargetsDependsOnImpl(const QFileInfoList & targetFilePathList, const QString & destinationDirectoryPath);
+    BinaryDependenciesResultList copySharedLibrariesTargetsDependsOnPipelined(const QFileInfoList & targetFilePathList, const QString & destinationDirectoryPath);
+    void emitInstallSharedLibrariesMessages() const;
+    void throwDependenciesNotSolvedError(const BinaryDependenciesResultList & resultList) const;
+    void setRPathToCopiedDependencies(CopiedSharedLibraryFileList & copiedFiles);
+    bool hasToPreserveSymLinks() const noexcept;
     void emitStartMessage(const QFileInfo & target) const noexcept;
     void emitStartMessage(const QFileInfoList & targetFilePathList) const;
     void emitSearchPrefixPathListMessage() const;
@@ -259,6 +430,11 @@ namespace Mdt{ namespace DeployUtils{
 
     OverwriteBehavior mOverwriteBehavior = OverwriteBehavior::Fail;
     bool mRemoveRpath = false;
+    bool mPipelinedCopy = false;
+    std::shared_ptr<const DeployManifest> mDeployManifest;
+    std::shared_ptr<DeployStore> mDeployStore;
+    std::shared_ptr<FileHashCache> mFileHashCache;
+    std::shared_ptr<ExecutableFileMetadataCache> mMetadataCache;
     PathList mSearchPrefixPathList;
     BinaryDependencies mBinaryDependencies;
     Platform mPlatform;
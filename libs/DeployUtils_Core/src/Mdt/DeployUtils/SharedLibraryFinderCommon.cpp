@@ -44,22 +44,22 @@ bool SharedLibraryFinderCommon::validateSpecificSharedLibrary(const QFileInfo &
   assert(mQtDistributionDirectory.get() != nullptr);
 
   if( QtSharedLibraryFile::isQtSharedLibrary(libraryFile) ){
-    emit debugMessage(
-      tr("  checking if %1 comes from a Qt distribution")
-      .arg( libraryFile.absoluteFilePath() )
-    );
+    emitDebugMessage([&libraryFile](){
+      return tr("  checking if %1 comes from a Qt distribution")
+             .arg( libraryFile.absoluteFilePath() );
+    });
     if( mQtDistributionDirectory->isNull() ){
       mQtDistributionDirectory->setupFromQtSharedLibrary( libraryFile, operatingSystem() );
       if( mQtDistributionDirectory->isValidExisting() ){
-        emit verboseMessage(
-          tr(" found Qt distribution: %1")
-          .arg( mQtDistributionDirectory->rootAbsolutePath() )
-        );
+        emitVerboseMessage([this](){
+          return tr(" found Qt distribution: %1")
+                 .arg( mQtDistributionDirectory->rootAbsolutePath() );
+        });
       }else{
-        emit debugMessage(
-          tr("  %1 is not a Qt distribution")
-          .arg( mQtDistributionDirectory->rootAbsolutePath() )
-        );
+        emitDebugMessage([this](){
+          return tr("  %1 is not a Qt distribution")
+                 .arg( mQtDistributionDirectory->rootAbsolutePath() );
+        });
         mQtDistributionDirectory->clear();
         assert( mQtDistributionDirectory->isNull() );
         return false;
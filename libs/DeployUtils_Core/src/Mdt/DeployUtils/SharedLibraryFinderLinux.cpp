@@ -21,6 +21,7 @@
 #include "SharedLibraryFinderLinux.h"
 #include "SearchPathList.h"
 #include "Mdt/DeployUtils/Impl/LibraryExcludeListLinux.h"
+#include "Mdt/DeployUtils/Impl/LibraryLocalExcludeListLinux.h"
 #include <QLatin1String>
 
 namespace Mdt{ namespace DeployUtils{
@@ -44,6 +45,7 @@ void SharedLibraryFinderLinux::buildSearchPathList(const PathList & searchFirstP
   searchPathList.appendPathList( searchFirstPathList.pathList() );
   searchPathList.appendPathList( PathList::getSystemLibraryKnownPathListLinux(processorISA) );
   searchPathList.removeNonExistingDirectories();
+  searchPathList.removeDuplicateDirectories();
 
   setSearchPathList(searchPathList);
 }
@@ -64,16 +66,16 @@ BinaryDependenciesFile SharedLibraryFinderLinux::findLibraryAbsolutePathByRPath(
 {
   assert( !libraryName.trimmed().isEmpty() );
 
-  emit verboseMessage(
-    tr(" searching %1 by RPath given in %2").arg( libraryName, dependentFile.fileName() )
-  );
+  emitVerboseMessage([&libraryName, &dependentFile](){
+    return tr(" searching %1 by RPath given in %2").arg( libraryName, dependentFile.fileName() );
+  });
 
   for( const auto & rpathEntry : dependentFile.rPath() ){
     const QString directory = makeDirectoryFromRpathEntry(dependentFile, rpathEntry);
     const QFileInfo libraryFile(directory, libraryName);
-    emit debugMessage(
-      tr("  try %1").arg( libraryFile.absoluteFilePath() )
-    );
+    emitDebugMessage([&libraryFile](){
+      return tr("  try %1").arg( libraryFile.absoluteFilePath() );
+    });
     if( validateIsExistingValidSharedLibrary(libraryFile) ){
       return BinaryDependenciesFile::fromQFileInfo(libraryFile);
     }
@@ -82,6 +84,18 @@ BinaryDependenciesFile SharedLibraryFinderLinux::findLibraryAbsolutePathByRPath(
   return BinaryDependenciesFile();
 }
 
+QStringList SharedLibraryFinderLinux::doLookupSearchDirectories(const BinaryDependenciesFile & dependentFile) const noexcept
+{
+  QStringList directories;
+
+  for( const auto & rpathEntry : dependentFile.rPath() ){
+    directories.append( makeDirectoryFromRpathEntry(dependentFile, rpathEntry) );
+  }
+  directories.append( searchPathList().toStringList() );
+
+  return directories;
+}
+
 bool SharedLibraryFinderLinux::doLibraryShouldBeDistributed(const QString & libraryName) const noexcept
 {
   if( libraryIsInLocalExcludeList(libraryName) ){
@@ -96,32 +110,7 @@ bool SharedLibraryFinderLinux::doLibraryShouldBeDistributed(const QString & libr
 
 bool SharedLibraryFinderLinux::libraryIsInLocalExcludeList(const QString & libraryName) noexcept
 {
-  static
-  const QStringList excludeList{
-    /*
-     * libdbus-1.so.3
-     *
-     * it is located in /lib/x86_64-linux-gnu (Ubuntu 18.04)
-     * that lets think that it is strongly dependent of the system
-     *
-     * See also https://github.com/AppImage/pkg2appimage/issues/450
-     */
-    QLatin1String("libdbus-1.so.3"),
-    /*
-     * next libraries are installed in
-     * /lib/x86_64-linux-gnu (Ubuntu 18.04)
-     *
-     * don't know if those must be redistributed or not,
-     * should test that in some way
-     */
-    QLatin1String("libkeyutils.so.1"),
-    QLatin1String("libbz2.so.1.0"),
-    QLatin1String("liblzma.so.5"),
-    QLatin1String("libudev.so.1"),
-    QLatin1String("libbsd.so.0")
-  };
-
-  return excludeList.contains(libraryName);
+  return libraryLocalExcludelistLinux.contains(libraryName);
 }
 
 bool SharedLibraryFinderLinux::libraryIsInGeneratedExcludeList(const QString & libraryName) noexcept
@@ -158,15 +147,15 @@ BinaryDependenciesFile SharedLibraryFinderLinux::findLibraryAbsolutePathBySearch
 {
   assert( !libraryName.trimmed().isEmpty() );
 
-  emit verboseMessage(
-    tr(" searching %1 in search path list").arg(libraryName)
-  );
+  emitVerboseMessage([&libraryName](){
+    return tr(" searching %1 in search path list").arg(libraryName);
+  });
 
-  for( const QString & directory : searchPathList() ){
+  for( const QString & directory : searchPathCandidateDirectories(libraryName) ){
     QFileInfo libraryFile(directory, libraryName);
-    emit debugMessage(
-      tr("  try %1").arg( libraryFile.absoluteFilePath() )
-    );
+    emitDebugMessage([&libraryFile](){
+      return tr("  try %1").arg( libraryFile.absoluteFilePath() );
+    });
     if( validateIsExistingValidSharedLibrary(libraryFile) ){
       return BinaryDependenciesFile::fromQFileInfo(libraryFile);
     }
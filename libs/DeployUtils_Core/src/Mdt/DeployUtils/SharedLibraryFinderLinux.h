@@ -52,8 +52,13 @@ namespace Mdt{ namespace DeployUtils{
                                       QObject *parent = nullptr) noexcept;
 
     /*! \brief Build a list of path to directories where to find shared libraries
+     *
+     * A directory that is reachable by more than one path
+     * (for example /lib and /usr/lib on distributions that merged /usr)
+     * is only searched once.
      *
      * \sa PathList::getSystemLibraryKnownPathListLinux()
+     * \sa PathList::removeDuplicateDirectories()
      * \sa https://man7.org/linux/man-pages/man8/ld.so.8.html
      */
     void buildSearchPathList(const PathList & searchFirstPathPrefixList, ProcessorISA processorISA) noexcept;
@@ -75,6 +80,10 @@ namespace Mdt{ namespace DeployUtils{
       return OperatingSystem::Linux;
     }
 
+    /*! \brief Get the directories from the rpath of \a dependentFile , followed by the search path list
+     */
+    QStringList doLookupSearchDirectories(const BinaryDependenciesFile & dependentFile) const noexcept override;
+
     /*! \brief Check if given \a libraryName should be distributed
      */
     bool doLibraryShouldBeDistributed(const QString & libraryName) const noexcept override;
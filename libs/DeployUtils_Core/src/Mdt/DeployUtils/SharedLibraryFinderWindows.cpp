@@ -104,6 +104,7 @@ void SharedLibraryFinderWindows::buildSearchPathList(const QFileInfo & binaryFil
   }
 
   searchPathList.removeNonExistingDirectories();
+  searchPathList.removeDuplicateDirectories();
 
   setSearchPathList(searchPathList);
 }
@@ -113,9 +114,9 @@ BinaryDependenciesFile SharedLibraryFinderWindows::findLibraryAbsolutePathByAlte
   assert( !libraryFile.filePath().isEmpty() ); // see doc of QFileInfo::absoluteFilePath()
   assert( libraryFile.isAbsolute() );
 
-  emit debugMessage(
-    tr("  try %1").arg( libraryFile.absoluteFilePath() )
-  );
+  emitDebugMessage([&libraryFile](){
+    return tr("  try %1").arg( libraryFile.absoluteFilePath() );
+  });
   if( validateIsExistingValidSharedLibrary(libraryFile) ){
     return BinaryDependenciesFile::fromQFileInfo(libraryFile);
   }
@@ -124,17 +125,17 @@ BinaryDependenciesFile SharedLibraryFinderWindows::findLibraryAbsolutePathByAlte
   const QDir directory = libraryFile.absoluteDir();
 
   alternativeFile.setFile( directory, libraryFile.fileName().toLower() );
-  emit debugMessage(
-    tr("  try %1").arg( alternativeFile.absoluteFilePath() )
-  );
+  emitDebugMessage([&alternativeFile](){
+    return tr("  try %1").arg( alternativeFile.absoluteFilePath() );
+  });
   if( validateIsExistingValidSharedLibrary(alternativeFile) ){
     return BinaryDependenciesFile::fromQFileInfo(alternativeFile);
   }
 
   alternativeFile.setFile( directory, libraryFile.fileName().toUpper() );
-  emit debugMessage(
-    tr("  try %1").arg( alternativeFile.absoluteFilePath() )
-  );
+  emitDebugMessage([&alternativeFile](){
+    return tr("  try %1").arg( alternativeFile.absoluteFilePath() );
+  });
   if( validateIsExistingValidSharedLibrary(alternativeFile) ){
     return BinaryDependenciesFile::fromQFileInfo(alternativeFile);
   }
@@ -233,7 +234,7 @@ bool SharedLibraryFinderWindows::doLibraryShouldBeDistributed(const QString & li
 
 bool SharedLibraryFinderWindows::libraryIsInExcludeList(const QString & libraryName) noexcept
 {
-  return libraryExcludelistWindows.contains(libraryName, Qt::CaseInsensitive);
+  return libraryExcludelistWindows.contains(libraryName);
 }
 
 QFileInfo SharedLibraryFinderWindows::doFindLibraryAbsolutePath(const QString & libraryName, const BinaryDependenciesFile & /*dependentFile*/)
@@ -246,11 +247,11 @@ QFileInfo SharedLibraryFinderWindows::doFindLibraryAbsolutePath(const QString &
    * \sa https://gitlab.com/scandyna/mdtdeployutils/-/issues/5 (BinaryDependenciesFile has to much attributes and is confusing)
    */
 
-  emit verboseMessage(
-    tr(" searching %1").arg(libraryName)
-  );
+  emitVerboseMessage([&libraryName](){
+    return tr(" searching %1").arg(libraryName);
+  });
 
-  for( const QString & directory : searchPathList() ){
+  for( const QString & directory : searchPathCandidateDirectories(libraryName) ){
     QFileInfo libraryFile(directory, libraryName);
     const BinaryDependenciesFile library = findLibraryAbsolutePathByAlternateNames(libraryFile);
     if( !library.isNull() ){
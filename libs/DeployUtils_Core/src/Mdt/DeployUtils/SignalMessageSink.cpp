@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "SignalMessageSink.h"
+
+namespace Mdt{ namespace DeployUtils{
+
+void SignalMessageSink::status(const QString & message)
+{
+  emit statusMessage(message);
+}
+
+void SignalMessageSink::verbose(const QString & message)
+{
+  emit verboseMessage(message);
+}
+
+void SignalMessageSink::debug(const QString & message)
+{
+  emit debugMessage(message);
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_SIGNAL_MESSAGE_SINK_H
+#define MDT_DEPLOY_UTILS_SIGNAL_MESSAGE_SINK_H
+
+#include "AbstractMessageSink.h"
+#include "mdt_deployutilscore_export.h"
+#include <QObject>
+#include <QString>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Message sink that emits the messages as Qt signals
+   *
+   * Can be used where messages written to a sink
+   * have to be received with the Qt signal/slot mechanism:
+   * \code
+   * auto sink = std::make_shared<SignalMessageSink>();
+   * QObject::connect(sink.get(), &SignalMessageSink::verboseMessage, MessageLogger::info);
+   *
+   * BinaryDependencies binaryDependencies;
+   * binaryDependencies.setMessageSink(sink);
+   * \endcode
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT SignalMessageSink : public QObject, public AbstractMessageSink
+  {
+    Q_OBJECT
+
+   public:
+
+    /*! \brief Constructor
+     */
+    explicit SignalMessageSink(QObject *parent = nullptr) noexcept
+     : QObject(parent)
+    {
+    }
+
+    /*! \brief Emit statusMessage()
+     */
+    void status(const QString & message) override;
+
+    /*! \brief Emit verboseMessage()
+     */
+    void verbose(const QString & message) override;
+
+    /*! \brief Emit debugMessage()
+     */
+    void debug(const QString & message) override;
+
+   signals:
+
+    void statusMessage(const QString & message) const;
+    void verboseMessage(const QString & message) const;
+    void debugMessage(const QString & message) const;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_SIGNAL_MESSAGE_SINK_H
@@ -0,0 +1,451 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "TarArchiveWriter.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QStringList>
+#include <QLatin1String>
+#include <QLatin1Char>
+#include <cstring>
+#include <cassert>
+
+namespace Mdt{ namespace DeployUtils{
+
+/*
+ * Data that QProcess could not write to the pipe yet is buffered in memory.
+ * zstd is typically slower than reading the files,
+ * so we wait when this buffer grows.
+ */
+static constexpr qint64 maxPendingZstdInputSize = 4 * 1024 * 1024;
+
+static constexpr int readBufferSize = 1024 * 1024;
+
+static constexpr int blockSize = 512;
+
+static constexpr qint64 maxUstarSize = 077777777777LL;
+
+TarArchiveWriter::TarArchiveWriter(QObject *parent) noexcept
+ : QObject(parent)
+{
+}
+
+TarArchiveWriter::~TarArchiveWriter() noexcept
+{
+  discard();
+}
+
+void TarArchiveWriter::open(const QString & archiveFilePath)
+{
+  assert( QDir::isAbsolutePath(archiveFilePath) );
+  assert( !isOpen() );
+
+  mArchiveFilePath = archiveFilePath;
+  mPartialFilePath = archiveFilePath + QLatin1String(".part");
+  mCompression = compressionFromFilePath(archiveFilePath);
+  mWrittenByteCount = 0;
+  mOpenTime = QDateTime::currentSecsSinceEpoch();
+
+  emit verboseMessage(
+    tr("writing archive %1")
+    .arg(archiveFilePath)
+  );
+
+  const QString directoryPath = QFileInfo(archiveFilePath).absolutePath();
+  if( !QDir().mkpath(directoryPath) ){
+    const QString msg = tr("writing %1 failed: could not create directory %2")
+                        .arg(archiveFilePath, directoryPath);
+    throw WriteArchiveError(msg);
+  }
+
+  QFile::remove(mPartialFilePath);
+
+  if(mCompression == ArchiveCompression::Zstd){
+    startZstd(mPartialFilePath);
+    mOutput = mZstdProcess.get();
+    return;
+  }
+
+  mFile = std::make_unique<QFile>(mPartialFilePath);
+  if( !mFile->open(QIODevice::WriteOnly | QIODevice::Truncate) ){
+    const QString msg = tr("writing %1 failed: %2")
+                        .arg( archiveFilePath, mFile->errorString() );
+    mFile.reset();
+    throw WriteArchiveError(msg);
+  }
+  mOutput = mFile.get();
+}
+
+void TarArchiveWriter::addDirectory(const QString & entryPath)
+{
+  assert( isOpen() );
+
+  write( makeEntryHeader(entryPath, '5', 0, 0755, mOpenTime) );
+}
+
+void TarArchiveWriter::addFile(const QString & entryPath, const QString & sourceFilePath)
+{
+  assert( isOpen() );
+
+  QFile source(sourceFilePath);
+  if( !source.open(QIODevice::ReadOnly) ){
+    const QString msg = tr("writing %1 failed: could not open %2: %3")
+                        .arg( mArchiveFilePath, sourceFilePath, source.errorString() );
+    throw WriteArchiveError(msg);
+  }
+
+  const qint64 modificationTime = QFileInfo(sourceFilePath).lastModified().toSecsSinceEpoch();
+
+  addFile( entryPath, source, source.size(), modeFromPermissions( source.permissions() ), modificationTime );
+}
+
+void TarArchiveWriter::addFile(const QString & entryPath, QIODevice & source, qint64 size, int mode, qint64 modificationTime)
+{
+  assert( isOpen() );
+  assert( source.isReadable() );
+  assert( size >= 0 );
+
+  write( makeEntryHeader(entryPath, '0', size, mode, modificationTime) );
+
+  if( mReadBuffer.isEmpty() ){
+    mReadBuffer.resize(readBufferSize);
+  }
+
+  qint64 remainingSize = size;
+  while(remainingSize > 0){
+    const qint64 readSize = source.read( mReadBuffer.data(), qMin<qint64>( remainingSize, mReadBuffer.size() ) );
+    if(readSize <= 0){
+      const QString msg = tr("writing %1 failed: could not read the content of %2: %3")
+                          .arg( mArchiveFilePath, entryPath, source.errorString() );
+      throw WriteArchiveError(msg);
+    }
+    write(mReadBuffer.constData(), readSize);
+    remainingSize -= readSize;
+  }
+
+  writePadding(size);
+}
+
+void TarArchiveWriter::addFileData(const QString & entryPath, const QByteArray & data, int mode)
+{
+  assert( isOpen() );
+
+  write( makeEntryHeader(entryPath, '0', data.size(), mode, mOpenTime) );
+  write(data);
+  writePadding( data.size() );
+}
+
+void TarArchiveWriter::close()
+{
+  assert( isOpen() );
+
+  /*
+   * A tar archive ends with 2 blocks of zeros
+   */
+  write( QByteArray(2*blockSize, '\0') );
+
+  if(mZstdProcess){
+    finishZstd();
+    mZstdProcess.reset();
+  }else{
+    assert(mFile);
+    if( !mFile->flush() ){
+      const QString msg = tr("writing %1 failed: %2")
+                          .arg( mArchiveFilePath, mFile->errorString() );
+      throw WriteArchiveError(msg);
+    }
+    mFile->close();
+    mFile.reset();
+  }
+  mOutput = nullptr;
+
+  QFile::remove(mArchiveFilePath);
+  if( !QFile::rename(mPartialFilePath, mArchiveFilePath) ){
+    QFile::remove(mPartialFilePath);
+    const QString msg = tr("writing %1 failed: could not rename %2")
+                        .arg(mArchiveFilePath, mPartialFilePath);
+    throw WriteArchiveError(msg);
+  }
+}
+
+ArchiveCompression TarArchiveWriter::compressionFromFilePath(const QString & filePath) noexcept
+{
+  if( filePath.endsWith(QLatin1String(".tar.zst"), Qt::CaseInsensitive) ){
+    return ArchiveCompression::Zstd;
+  }
+  if( filePath.endsWith(QLatin1String(".tzst"), Qt::CaseInsensitive) ){
+    return ArchiveCompression::Zstd;
+  }
+
+  return ArchiveCompression::None;
+}
+
+QByteArray TarArchiveWriter::makeEntryHeader(const QString & entryPath, char type, qint64 size, int mode, qint64 modificationTime)
+{
+  assert( !entryPath.isEmpty() );
+  assert( !QDir::isAbsolutePath(entryPath) );
+  assert( size >= 0 );
+
+  QByteArray path = QDir::cleanPath(entryPath).toUtf8();
+  if(type == '5'){
+    path += '/';
+  }
+
+  QByteArray paxData;
+
+  QByteArray name;
+  QByteArray prefix;
+  if( !splitUstarPath(path, name, prefix) ){
+    paxData += makePaxRecord("path", path);
+    name = path.left(100);
+    prefix.clear();
+  }
+
+  qint64 ustarSize = size;
+  if(size > maxUstarSize){
+    paxData += makePaxRecord( "size", QByteArray::number(size) );
+    ustarSize = 0;
+  }
+
+  QByteArray header;
+  if( !paxData.isEmpty() ){
+    header += makeUstarHeader("././@PaxHeader", QByteArray(), 'x', paxData.size(), 0644, modificationTime);
+    header += paxData;
+    const int paddingSize = ( blockSize - (paxData.size() % blockSize) ) % blockSize;
+    header += QByteArray(paddingSize, '\0');
+  }
+  header += makeUstarHeader(name, prefix, type, ustarSize, mode, modificationTime);
+
+  return header;
+}
+
+int TarArchiveWriter::modeFromPermissions(QFileDevice::Permissions permissions) noexcept
+{
+  int mode = 0;
+
+  if( permissions.testFlag(QFileDevice::ReadOwner) ){
+    mode |= 0400;
+  }
+  if( permissions.testFlag(QFileDevice::WriteOwner) ){
+    mode |= 0200;
+  }
+  if( permissions.testFlag(QFileDevice::ExeOwner) ){
+    mode |= 0100;
+  }
+  if( permissions.testFlag(QFileDevice::ReadGroup) ){
+    mode |= 040;
+  }
+  if( permissions.testFlag(QFileDevice::WriteGroup) ){
+    mode |= 020;
+  }
+  if( permissions.testFlag(QFileDevice::ExeGroup) ){
+    mode |= 010;
+  }
+  if( permissions.testFlag(QFileDevice::ReadOther) ){
+    mode |= 04;
+  }
+  if( permissions.testFlag(QFileDevice::WriteOther) ){
+    mode |= 02;
+  }
+  if( permissions.testFlag(QFileDevice::ExeOther) ){
+    mode |= 01;
+  }
+
+  return mode;
+}
+
+void TarArchiveWriter::startZstd(const QString & outputFilePath)
+{
+  mZstdProcess = std::make_unique<QProcess>();
+  mZstdProcess->setStandardOutputFile( QProcess::nullDevice() );
+
+  const QStringList arguments{
+    QLatin1String("-q"), QLatin1String("-T0"), QLatin1String("-f"), QLatin1String("-o"), outputFilePath
+  };
+
+  emit verboseMessage(
+    tr("compressing with: zstd %1")
+    .arg( arguments.join( QLatin1Char(' ') ) )
+  );
+
+  mZstdProcess->start(QLatin1String("zstd"), arguments);
+  if( !mZstdProcess->waitForStarted(-1) ){
+    const QString msg = tr("writing %1 failed: could not start zstd: %2")
+                        .arg( mArchiveFilePath, mZstdProcess->errorString() );
+    mZstdProcess.reset();
+    throw WriteArchiveError(msg);
+  }
+}
+
+void TarArchiveWriter::finishZstd()
+{
+  assert(mZstdProcess);
+
+  mZstdProcess->closeWriteChannel();
+  const bool finished = mZstdProcess->waitForFinished(-1);
+
+  if( !finished || (mZstdProcess->exitStatus() != QProcess::NormalExit) || (mZstdProcess->exitCode() != 0) ){
+    const QString zstdError = QString::fromLocal8Bit( mZstdProcess->readAllStandardError() ).trimmed();
+    const QString msg = tr("writing %1 failed: zstd failed: %2")
+                        .arg(mArchiveFilePath, zstdError);
+    throw WriteArchiveError(msg);
+  }
+}
+
+void TarArchiveWriter::write(const char *data, qint64 size)
+{
+  assert(mOutput != nullptr);
+
+  if( mOutput->write(data, size) != size ){
+    const QString msg = tr("writing %1 failed: %2")
+                        .arg( mArchiveFilePath, mOutput->errorString() );
+    throw WriteArchiveError(msg);
+  }
+  mWrittenByteCount += size;
+
+  if(mZstdProcess){
+    while( mZstdProcess->bytesToWrite() > maxPendingZstdInputSize ){
+      if( !mZstdProcess->waitForBytesWritten(-1) ){
+        const QString msg = tr("writing %1 failed: zstd stopped: %2")
+                            .arg( mArchiveFilePath, mZstdProcess->errorString() );
+        throw WriteArchiveError(msg);
+      }
+    }
+  }
+}
+
+void TarArchiveWriter::write(const QByteArray & data)
+{
+  write( data.constData(), data.size() );
+}
+
+void TarArchiveWriter::writePadding(qint64 size)
+{
+  const int paddingSize = static_cast<int>( (blockSize - (size % blockSize)) % blockSize );
+  if(paddingSize > 0){
+    write( QByteArray(paddingSize, '\0') );
+  }
+}
+
+void TarArchiveWriter::discard() noexcept
+{
+  if( !mZstdProcess && !mFile ){
+    return;
+  }
+
+  if(mZstdProcess){
+    mZstdProcess->kill();
+    mZstdProcess->waitForFinished(-1);
+    mZstdProcess.reset();
+  }
+  if(mFile){
+    mFile->close();
+    mFile.reset();
+  }
+  mOutput = nullptr;
+
+  QFile::remove(mPartialFilePath);
+}
+
+QByteArray TarArchiveWriter::makeUstarHeader(const QByteArray & name, const QByteArray & prefix, char type,
+                                             qint64 size, int mode, qint64 modificationTime)
+{
+  assert( name.size() <= 100 );
+  assert( prefix.size() <= 155 );
+
+  QByteArray header(blockSize, '\0');
+  char *data = header.data();
+
+  std::memcpy( data, name.constData(), static_cast<size_t>( name.size() ) );
+  setOctalField(data + 100, 8, mode & 07777);
+  setOctalField(data + 108, 8, 0);
+  setOctalField(data + 116, 8, 0);
+  setOctalField(data + 124, 12, size);
+  setOctalField(data + 136, 12, qMax<qint64>(modificationTime, 0));
+  std::memset(data + 148, ' ', 8);
+  data[156] = type;
+  std::memcpy(data + 257, "ustar", 6);
+  std::memcpy(data + 263, "00", 2);
+  setOctalField(data + 329, 8, 0);
+  setOctalField(data + 337, 8, 0);
+  std::memcpy( data + 345, prefix.constData(), static_cast<size_t>( prefix.size() ) );
+
+  /*
+   * The checksum is computed with the checksum field filled with spaces,
+   * then written as 6 octal digits, a NUL and a space
+   */
+  qint64 checksum = 0;
+  for(int i = 0; i < blockSize; ++i){
+    checksum += static_cast<unsigned char>(data[i]);
+  }
+  setOctalField(data + 148, 7, checksum);
+  data[155] = ' ';
+
+  return header;
+}
+
+QByteArray TarArchiveWriter::makePaxRecord(const QByteArray & keyword, const QByteArray & value)
+{
+  /*
+   * A record is "<length> <keyword>=<value>\n",
+   * where length counts the whole record, including its own digits
+   */
+  const int lengthWithoutDigits = keyword.size() + value.size() + 3;
+  int digitCount = 1;
+  int length = lengthWithoutDigits + digitCount;
+  while( QByteArray::number(length).size() != digitCount ){
+    ++digitCount;
+    length = lengthWithoutDigits + digitCount;
+  }
+
+  return QByteArray::number(length) + ' ' + keyword + '=' + value + '\n';
+}
+
+bool TarArchiveWriter::splitUstarPath(const QByteArray & path, QByteArray & name, QByteArray & prefix) noexcept
+{
+  if( path.size() <= 100 ){
+    name = path;
+    prefix.clear();
+    return true;
+  }
+
+  /*
+   * The separator between prefix and name is not stored.
+   * Taking the last one that keeps the prefix short enough
+   * gives the shortest name.
+   */
+  const int separatorIndex = path.lastIndexOf( '/', qMin(155, path.size() - 2) );
+  if(separatorIndex <= 0){
+    return false;
+  }
+  if( (path.size() - separatorIndex - 1) > 100 ){
+    return false;
+  }
+
+  prefix = path.left(separatorIndex);
+  name = path.mid(separatorIndex + 1);
+
+  return true;
+}
+
+void TarArchiveWriter::setOctalField(char *field, int fieldSize, qint64 value) noexcept
+{
+  assert(field != nullptr);
+  assert(fieldSize > 1);
+  assert(value >= 0);
+
+  field[fieldSize-1] = '\0';
+  for(int i = fieldSize - 2; i >= 0; --i){
+    field[i] = static_cast<char>( '0' + (value & 7) );
+    value >>= 3;
+  }
+  assert(value == 0);
+}
+
+}} // namespace Mdt{ namespace DeployUtils{
@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_TAR_ARCHIVE_WRITER_H
+#define MDT_DEPLOY_UTILS_TAR_ARCHIVE_WRITER_H
+
+#include "WriteArchiveError.h"
+#include "mdt_deployutilscore_export.h"
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QIODevice>
+#include <QProcess>
+#include <QtGlobal>
+#include <memory>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Compression of a archive
+   */
+  enum class ArchiveCompression
+  {
+    None, /*!< Plain tar archive */
+    Zstd  /*!< Tar archive compressed with zstd */
+  };
+
+  /*! \brief Write a tar archive as a stream
+   *
+   * Entries are written one after the other,
+   * each file being read once from its source.
+   * Nothing is kept in memory except a small read buffer.
+   *
+   * \code
+   * TarArchiveWriter writer;
+   *
+   * writer.open( QLatin1String("/tmp/myapp.tar.zst") );
+   * writer.addDirectory( QLatin1String("myapp/bin") );
+   * writer.addFile( QLatin1String("myapp/bin/myapp"), QLatin1String("/build/myapp") );
+   * writer.close();
+   * \endcode
+   *
+   * Headers are written in the POSIX ustar format.
+   * Paths that do not fit in a ustar header,
+   * and files larger than 8 GiB, get a pax extended header.
+   *
+   * For a .tar.zst (or .tzst) archive, the tar stream is piped
+   * to the zstd executable, using all available cores (zstd -T0).
+   * zstd must be found in the PATH.
+   *
+   * The archive is first written to a partial file,
+   * that is renamed once close() succeeded.
+   * If the writer is destroyed before close(),
+   * the partial file is removed.
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT TarArchiveWriter : public QObject
+  {
+    Q_OBJECT
+
+   public:
+
+    /*! \brief Constructor
+     */
+    explicit TarArchiveWriter(QObject *parent = nullptr) noexcept;
+
+    /*! \brief Destructor
+     *
+     * If this writer is still open, the archive is discarded.
+     */
+    ~TarArchiveWriter() noexcept;
+
+    TarArchiveWriter(const TarArchiveWriter &) = delete;
+    TarArchiveWriter & operator=(const TarArchiveWriter &) = delete;
+    TarArchiveWriter(TarArchiveWriter &&) = delete;
+    TarArchiveWriter & operator=(TarArchiveWriter &&) = delete;
+
+    /*! \brief Open \a archiveFilePath for writing
+     *
+     * The compression is deduced from the file suffix
+     * (see compressionFromFilePath()).
+     * Missing parent directories are created.
+     *
+     * \pre \a archiveFilePath must be a absolute path
+     * \pre this writer must not allready be open
+     * \exception WriteArchiveError
+     */
+    void open(const QString & archiveFilePath);
+
+    /*! \brief Check if this writer is open
+     */
+    bool isOpen() const noexcept
+    {
+      return mOutput != nullptr;
+    }
+
+    /*! \brief Get the compression of the open archive
+     */
+    ArchiveCompression compression() const noexcept
+    {
+      return mCompression;
+    }
+
+    /*! \brief Add a directory entry
+     *
+     * \a entryPath is the path of the directory in the archive,
+     * for example myapp/bin
+     *
+     * \pre this writer must be open
+     * \exception WriteArchiveError
+     */
+    void addDirectory(const QString & entryPath);
+
+    /*! \brief Add a file entry from \a sourceFilePath
+     *
+     * The permissions and the modification time are taken from the source file.
+     *
+     * \pre this writer must be open
+     * \exception WriteArchiveError
+     */
+    void addFile(const QString & entryPath, const QString & sourceFilePath);
+
+    /*! \brief Add a file entry which content is read from \a source
+     *
+     * Exactly \a size bytes are read from \a source .
+     *
+     * \pre this writer must be open
+     * \pre \a source must be open for reading
+     * \exception WriteArchiveError
+     */
+    void addFile(const QString & entryPath, QIODevice & source, qint64 size, int mode, qint64 modificationTime);
+
+    /*! \brief Add a file entry which content is \a data
+     *
+     * \pre this writer must be open
+     * \exception WriteArchiveError
+     */
+    void addFileData(const QString & entryPath, const QByteArray & data, int mode = 0644);
+
+    /*! \brief Finish the archive and close this writer
+     *
+     * \pre this writer must be open
+     * \exception WriteArchiveError
+     */
+    void close();
+
+    /*! \brief Get the count of bytes of the (uncompressed) tar stream written so far
+     */
+    qint64 writtenByteCount() const noexcept
+    {
+      return mWrittenByteCount;
+    }
+
+    /*! \brief Get the compression to use for \a filePath
+     *
+     * Returns ArchiveCompression::Zstd for .tar.zst and .tzst ,
+     * otherwise ArchiveCompression::None .
+     */
+    static
+    ArchiveCompression compressionFromFilePath(const QString & filePath) noexcept;
+
+    /*! \brief Make the header block(s) of a entry
+     *
+     * \a type is the ustar type flag ('0' for a file, '5' for a directory).
+     * The returned data is a multiple of 512 bytes.
+     * A directory \a entryPath gets a trailing slash.
+     */
+    static
+    QByteArray makeEntryHeader(const QString & entryPath, char type, qint64 size, int mode, qint64 modificationTime);
+
+    /*! \brief Get the Unix mode from \a permissions
+     */
+    static
+    int modeFromPermissions(QFileDevice::Permissions permissions) noexcept;
+
+   signals:
+
+    void verboseMessage(const QString & message) const;
+
+   private:
+
+    void startZstd(const QString & outputFilePath);
+    void finishZstd();
+    void write(const char *data, qint64 size);
+    void write(const QByteArray & data);
+    void writePadding(qint64 size);
+    void discard() noexcept;
+
+    static
+    QByteArray makeUstarHeader(const QByteArray & name, const QByteArray & prefix, char type, qint64 size, int mode, qint64 modificationTime);
+
+    static
+    QByteArray makePaxRecord(const QByteArray & keyword, const QByteArray & value);
+
+    static
+    bool splitUstarPath(const QByteArray & path, QByteArray & name, QByteArray & prefix) noexcept;
+
+    static
+    void setOctalField(char *field, int fieldSize, qint64 value) noexcept;
+
+    QString mArchiveFilePath;
+    QString mPartialFilePath;
+    ArchiveCompression mCompression = ArchiveCompression::None;
+    std::unique_ptr<QFile> mFile;
+    std::unique_ptr<QProcess> mZstdProcess;
+    QIODevice *mOutput = nullptr;
+    qint64 mWrittenByteCount = 0;
+    qint64 mOpenTime = 0;
+    QByteArray mReadBuffer;
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_TAR_ARCHIVE_WRITER_H
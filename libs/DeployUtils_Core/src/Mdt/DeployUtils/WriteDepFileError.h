@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#ifndef MDT_DEPLOY_UTILS_WRITE_DEP_FILE_ERROR_H
+#define MDT_DEPLOY_UTILS_WRITE_DEP_FILE_ERROR_H
+
+#include "QRuntimeError.h"
+#include "mdt_deployutilscore_export.h"
+#include <QString>
+
+namespace Mdt{ namespace DeployUtils{
+
+  /*! \brief Error thrown by DepFileWriter
+   */
+  class MDT_DEPLOYUTILSCORE_EXPORT WriteDepFileError : public QRuntimeError
+  {
+   public:
+
+    /*! \brief Constructor
+     */
+    explicit WriteDepFileError(const QString & what)
+      : QRuntimeError(what)
+    {
+    }
+  };
+
+}} // namespace Mdt{ namespace DeployUtils{
+
+#endif // #ifndef MDT_DEPLOY_UTILS_WRITE_DEP_FILE_ERROR_H
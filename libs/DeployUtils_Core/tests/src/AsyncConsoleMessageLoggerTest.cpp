@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "Mdt/DeployUtils/AsyncConsoleMessageLogger.h"
+#include <QString>
+#include <QLatin1String>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <set>
+
+using namespace Mdt::DeployUtils;
+
+std::vector<std::string> splitLines(const std::string & text)
+{
+  std::vector<std::string> lines;
+  std::istringstream stream(text);
+  std::string line;
+
+  while( std::getline(stream, line) ){
+    lines.push_back(line);
+  }
+
+  return lines;
+}
+
+TEST_CASE("info_error")
+{
+  std::ostringstream out;
+  std::ostringstream err;
+
+  SECTION("informations are written once flushed")
+  {
+    AsyncConsoleMessageLogger logger(out, err);
+    logger.info( QLatin1String("A") );
+    logger.info( QLatin1String("B") );
+    logger.flush();
+    REQUIRE( out.str() == "A\nB\n" );
+    REQUIRE( err.str().empty() );
+  }
+
+  SECTION("a error is written before error() returns, after the preceding informations")
+  {
+    AsyncConsoleMessageLogger logger(out, err);
+    logger.info( QLatin1String("A") );
+    logger.error( QLatin1String("E") );
+    REQUIRE( out.str() == "A\n" );
+    REQUIRE( err.str() == "E\n" );
+  }
+
+  SECTION("remaining messages are written when the logger is destroyed")
+  {
+    {
+      AsyncConsoleMessageLogger logger(out, err);
+      logger.info( QLatin1String("A") );
+    }
+    REQUIRE( out.str() == "A\n" );
+  }
+
+  SECTION("prefixes")
+  {
+    AsyncConsoleMessageLogger logger(out, err);
+    logger.setPrefixes( QLatin1String("-- "), QLatin1String("ERROR: ") );
+    logger.info( QLatin1String("A") );
+    logger.error( QLatin1String("E") );
+    REQUIRE( out.str() == "-- A\n" );
+    REQUIRE( err.str() == "ERROR: E\n" );
+  }
+}
+
+TEST_CASE("several_threads")
+{
+  std::ostringstream out;
+  std::ostringstream err;
+  const int threadCount = 4;
+  const int messageCount = 1000;
+
+  {
+    AsyncConsoleMessageLogger logger(out, err);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < threadCount; ++t){
+      threads.emplace_back([&logger, t, messageCount](){
+        for(int i = 0; i < messageCount; ++i){
+          logger.info( QString::fromLatin1("thread %1 message %2").arg(t).arg(i) );
+        }
+      });
+    }
+    for(auto & thread : threads){
+      thread.join();
+    }
+    logger.flush();
+    REQUIRE( logger.batchCount() > 0 );
+    REQUIRE( logger.batchCount() <= threadCount * messageCount );
+  }
+
+  const auto lines = splitLines( out.str() );
+  REQUIRE( lines.size() == static_cast<size_t>(threadCount * messageCount) );
+
+  // Each line must be complete, so each message is found exactly once
+  const std::set<std::string> uniqueLines( lines.cbegin(), lines.cend() );
+  REQUIRE( uniqueLines.size() == lines.size() );
+  for(int t = 0; t < threadCount; ++t){
+    const std::string last = "thread " + std::to_string(t) + " message " + std::to_string(messageCount - 1);
+    REQUIRE( uniqueLines.count(last) == 1 );
+  }
+}
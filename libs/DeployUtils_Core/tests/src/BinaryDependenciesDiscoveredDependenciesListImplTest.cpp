@@ -11,64 +11,89 @@
 #include "TestUtils.h"
 #include "Mdt/DeployUtils/Impl/BinaryDependencies/DiscoveredDependenciesList.h"
 #include <QLatin1String>
+#include <QString>
 
 using namespace Mdt::DeployUtils;
 using namespace Mdt::DeployUtils::Impl::BinaryDependencies;
 
-TEST_CASE("containsDependentFile")
+/*
+ * The list only references the dependent file by its vertex,
+ * so we can use any vertex descriptor here
+ */
+GraphFile makeDependentFile(const char *name, LibraryNameTable & libraryNameTable)
 {
-  DiscoveredDependenciesList list(OperatingSystem::Linux);
-  GraphFile dependentFile;
+  GraphFile file = GraphFile::fromLibraryName( QString::fromLatin1(name) );
+  file.setNameId( libraryNameTable.intern( file.fileName() ) );
+
+  return file;
+}
+
+TEST_CASE("containsDependentVertex")
+{
+  LibraryNameTable libraryNameTable(OperatingSystem::Linux);
+  DiscoveredDependenciesList list(libraryNameTable);
+  const VertexDescriptor libAVertex = 0;
   QStringList dependencies;
 
   SECTION("empty list does not contain libA.so")
   {
-    dependentFile = GraphFile::fromLibraryName( QLatin1String("libA.so") );
-
-    REQUIRE( !list.containsDependentFile(dependentFile) );
+    REQUIRE( !list.containsDependentVertex(libAVertex) );
   }
 
   SECTION("contains libA.so")
   {
-    dependentFile = GraphFile::fromLibraryName( QLatin1String("libA.so") );
+    const GraphFile dependentFile = makeDependentFile("libA.so", libraryNameTable);
     dependencies = qStringListFromUtf8Strings({"libB"});
-    list.setDirectDependenciesFileNames(dependentFile, dependencies);
+    list.setDirectDependenciesFileNames(libAVertex, dependentFile, dependencies);
 
-    REQUIRE( list.containsDependentFile(dependentFile) );
+    REQUIRE( list.containsDependentVertex(libAVertex) );
+  }
+
+  SECTION("clear")
+  {
+    const GraphFile dependentFile = makeDependentFile("libA.so", libraryNameTable);
+    dependencies = qStringListFromUtf8Strings({"libB"});
+    list.setDirectDependenciesFileNames(libAVertex, dependentFile, dependencies);
+    list.clear();
+
+    REQUIRE( list.isEmpty() );
+    REQUIRE( !list.containsDependentVertex(libAVertex) );
   }
 }
 
 TEST_CASE("setDirectDependenciesFileNames")
 {
-  DiscoveredDependenciesList list(OperatingSystem::Linux);
-  GraphFile dependentFile;
+  LibraryNameTable libraryNameTable(OperatingSystem::Linux);
+  DiscoveredDependenciesList list(libraryNameTable);
+  const VertexDescriptor libAVertex = 0;
   QStringList dependencies;
 
   SECTION("libA -> libB")
   {
-    dependentFile = GraphFile::fromLibraryName( QLatin1String("libA") );
+    const GraphFile dependentFile = makeDependentFile("libA", libraryNameTable);
     dependencies = qStringListFromUtf8Strings({"libB"});
-    list.setDirectDependenciesFileNames(dependentFile, dependencies);
+    list.setDirectDependenciesFileNames(libAVertex, dependentFile, dependencies);
 
     REQUIRE( list.size() == 1 );
-    REQUIRE( list.at(0).dependentFileName() == QLatin1String("libA") );
-    REQUIRE( list.at(0).dependenciesFileNames() == dependencies );
+    REQUIRE( list.at(0).dependentVertex() == libAVertex );
+    REQUIRE( list.dependentFileNameAt(0) == QLatin1String("libA") );
+    REQUIRE( list.dependenciesFileNamesAt(0) == dependencies );
 
     /*
      * Setting dependencies for a existing file
      * does not change anything
      */
-    list.setDirectDependenciesFileNames(dependentFile, dependencies);
+    list.setDirectDependenciesFileNames(libAVertex, dependentFile, dependencies);
 
     REQUIRE( list.size() == 1 );
-    REQUIRE( list.at(0).dependentFileName() == QLatin1String("libA") );
-    REQUIRE( list.at(0).dependenciesFileNames() == dependencies );
+    REQUIRE( list.dependentFileNameAt(0) == QLatin1String("libA") );
+    REQUIRE( list.dependenciesFileNamesAt(0) == dependencies );
   }
 
   SECTION("add a file without dependencies does nothing")
   {
-    dependentFile = GraphFile::fromLibraryName( QLatin1String("libA") );
-    list.setDirectDependenciesFileNames(dependentFile, dependencies);
+    const GraphFile dependentFile = makeDependentFile("libA", libraryNameTable);
+    list.setDirectDependenciesFileNames(libAVertex, dependentFile, dependencies);
 
     REQUIRE( list.isEmpty() );
   }
@@ -27,6 +27,7 @@ TEST_CASE("fromLibraryName")
   auto file = GraphFile::fromLibraryName( QLatin1String("arbitraryFile.so") );
 
   REQUIRE( file.fileName() == QLatin1String("arbitraryFile.so") );
+  REQUIRE( file.filePath() == QLatin1String("arbitraryFile.so") );
 //   REQUIRE( file.absoluteDirectoryPath().isEmpty() );
   REQUIRE( !file.isNull() );
   REQUIRE( !file.hasAbsolutePath() );
@@ -39,6 +40,7 @@ TEST_CASE("fromQFileInfo")
   auto file = GraphFile::fromQFileInfo(fi);
 
   REQUIRE( file.fileName() == QLatin1String("arbitraryFile") );
+  REQUIRE( file.filePath() == makeAbsolutePath("/path/to/some/arbitraryFile") );
 //   REQUIRE( file.absoluteDirectoryPath() == makeAbsolutePath("/path/to/some") );
   REQUIRE( !file.isNull() );
   REQUIRE( file.hasAbsolutePath() );
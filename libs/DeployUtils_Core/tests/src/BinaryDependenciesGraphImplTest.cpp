@@ -272,17 +272,18 @@ TEST_CASE("addDependencies")
 {
   const Platform platform(OperatingSystem::Linux, ExecutableFileFormat::Elf, Compiler::Gcc, ProcessorISA::X86_64);
   Graph graph(platform);
-  DiscoveredDependenciesList discoveredDependenciesList( platform.operatingSystem() );
+  DiscoveredDependenciesList discoveredDependenciesList( graph.libraryNameTable() );
   QStringList dependencies;
 
   GraphFile app = GraphFile::fromQFileInfo( QString::fromLatin1("/tmp/app") );
 
   SECTION("app depends on libA.so")
   {
+    const VertexDescriptor appVertex = graph.addFile(app);
+
     dependencies = qStringListFromUtf8Strings({"libA.so"});
-    discoveredDependenciesList.setDirectDependenciesFileNames(app, dependencies);
+    discoveredDependenciesList.setDirectDependenciesFileNames( appVertex, graph.internalGraph()[appVertex], dependencies );
 
-    graph.addFile(app);
     graph.addDependencies(discoveredDependenciesList);
 
     REQUIRE( graph.fileCount() == 2 );
@@ -294,9 +295,8 @@ TEST_CASE("addDependencies")
 TEST_CASE("findDependencies")
 {
   const Platform platform(OperatingSystem::Linux, ExecutableFileFormat::Elf, Compiler::Gcc, ProcessorISA::X86_64);
-  const OperatingSystem os = platform.operatingSystem();
   Graph graph(platform);
-  DiscoveredDependenciesList discoveredDependenciesList(os);
+  DiscoveredDependenciesList discoveredDependenciesList( graph.libraryNameTable() );
   auto isExistingSharedLibraryOp = std::make_shared<TestIsExistingSharedLibrary>();
   SharedLibraryFinderBDTest shLibFinder(isExistingSharedLibraryOp);
   GraphBuildVisitorWorker visitorWorker(shLibFinder, platform, discoveredDependenciesList);
@@ -337,9 +337,9 @@ TEST_CASE("findDependencies")
     REQUIRE( graph.containsFileName( QLatin1String("app") ) );
 
     REQUIRE( discoveredDependenciesList.size() == 1 );
-    REQUIRE( discoveredDependenciesList.at(0).dependentFileName() == QLatin1String("app") );
+    REQUIRE( discoveredDependenciesList.dependentFileNameAt(0) == QLatin1String("app") );
     expectedDependenciesFileNames = qStringListFromUtf8Strings({"libA.so"});
-    REQUIRE( discoveredDependenciesList.at(0).dependenciesFileNames() == expectedDependenciesFileNames );
+    REQUIRE( discoveredDependenciesList.dependenciesFileNamesAt(0) == expectedDependenciesFileNames );
 
     // Run again, graph does not change and no new dependency is discovered
     discoveredDependenciesList.clear();
@@ -366,9 +366,8 @@ TEST_CASE("findDependencies")
 TEST_CASE("buildGraph_docExample")
 {
   const Platform platform(OperatingSystem::Linux, ExecutableFileFormat::Elf, Compiler::Gcc, ProcessorISA::X86_64);
-  const OperatingSystem os = platform.operatingSystem();
   Graph graph(platform);
-  DiscoveredDependenciesList discoveredDependenciesList(os);
+  DiscoveredDependenciesList discoveredDependenciesList( graph.libraryNameTable() );
   auto isExistingSharedLibraryOp = std::make_shared<TestIsExistingSharedLibrary>();
   SharedLibraryFinderBDTest shLibFinder(isExistingSharedLibraryOp);
   GraphBuildVisitorWorker visitorWorker(shLibFinder, platform, discoveredDependenciesList);
@@ -406,10 +405,10 @@ TEST_CASE("buildGraph_docExample")
   graph.findDependencies(visitor);
 
   REQUIRE( discoveredDependenciesList.size() == 1 );
-  REQUIRE( discoveredDependenciesList.at(0).dependentFileName() == QLatin1String("app") );
-  REQUIRE( discoveredDependenciesList.at(0).dependenciesFileNames().size() == 2 );
-  REQUIRE( discoveredDependenciesList.at(0).dependenciesFileNames().contains( QLatin1String("libA.so") ) );
-  REQUIRE( discoveredDependenciesList.at(0).dependenciesFileNames().contains( QLatin1String("libQt5Core.so") ) );
+  REQUIRE( discoveredDependenciesList.dependentFileNameAt(0) == QLatin1String("app") );
+  REQUIRE( discoveredDependenciesList.dependenciesFileNamesAt(0).size() == 2 );
+  REQUIRE( discoveredDependenciesList.dependenciesFileNamesAt(0).contains( QLatin1String("libA.so") ) );
+  REQUIRE( discoveredDependenciesList.dependenciesFileNamesAt(0).contains( QLatin1String("libQt5Core.so") ) );
 
   /*
    * Add app dependencies to the graph
@@ -435,10 +434,10 @@ TEST_CASE("buildGraph_docExample")
   graph.findDependencies(visitor);
 
   REQUIRE( discoveredDependenciesList.size() == 1 );
-  REQUIRE( discoveredDependenciesList.at(0).dependentFileName() == QLatin1String("libA.so") );
-  REQUIRE( discoveredDependenciesList.at(0).dependenciesFileNames().size() == 2 );
-  REQUIRE( discoveredDependenciesList.at(0).dependenciesFileNames().contains( QLatin1String("libQt5Core.so") ) );
-  REQUIRE( discoveredDependenciesList.at(0).dependenciesFileNames().contains( QLatin1String("libB.so") ) );
+  REQUIRE( discoveredDependenciesList.dependentFileNameAt(0) == QLatin1String("libA.so") );
+  REQUIRE( discoveredDependenciesList.dependenciesFileNamesAt(0).size() == 2 );
+  REQUIRE( discoveredDependenciesList.dependenciesFileNamesAt(0).contains( QLatin1String("libQt5Core.so") ) );
+  REQUIRE( discoveredDependenciesList.dependenciesFileNamesAt(0).contains( QLatin1String("libB.so") ) );
 
   /*
    * Add libA dependencies to the graph
@@ -936,6 +935,60 @@ TEST_CASE("getResultList")
   REQUIRE( libAResult->containsLibraryName( QLatin1String("libB.so") ) );
 }
 
+/*
+ * app
+ *  |->libA
+ *      |->libB
+ *          |->libA
+ */
+TEST_CASE("getResultList_cyclicDependencies")
+{
+  const Platform platform(OperatingSystem::Linux, ExecutableFileFormat::Elf, Compiler::Gcc, ProcessorISA::X86_64);
+  auto isExistingSharedLibraryOp = std::make_shared<TestIsExistingSharedLibrary>();
+  SharedLibraryFinderBDTest shLibFinder(isExistingSharedLibraryOp);
+  TestExecutableFileReader reader;
+
+  shLibFinder.setSearchPathList({"/tmp"});
+
+  isExistingSharedLibraryOp->setExistingSharedLibraries({
+    "/tmp/libA.so",
+    "/tmp/libB.so"
+  });
+
+  reader.setNeededSharedLibraries("app", {"libA.so"});
+  reader.setNeededSharedLibraries("libA.so", {"libB.so"});
+  reader.setNeededSharedLibraries("libB.so", {"libA.so"});
+
+  QFileInfo app( QString::fromLatin1("/tmp/app") );
+  QFileInfo libA( QString::fromLatin1("/tmp/libA.so") );
+  QFileInfo libB( QString::fromLatin1("/tmp/libB.so") );
+
+  Graph graph(platform);
+  graph.addTargets({app, libA, libB});
+  graph.findTransitiveDependencies(shLibFinder, reader);
+  REQUIRE( graph.fileCount() == 3 );
+
+  const BinaryDependenciesResultList resultList = graph.getResultList({app, libA, libB});
+  REQUIRE( resultList.resultCount() == 3 );
+
+  const auto appResult = resultList.findResultForTargetName( app.fileName() );
+  REQUIRE( appResult.has_value() );
+  REQUIRE( appResult->libraryCount() == 2 );
+  REQUIRE( appResult->containsLibraryName( QLatin1String("libA.so") ) );
+  REQUIRE( appResult->containsLibraryName( QLatin1String("libB.so") ) );
+  REQUIRE( appResult->libraryCount() == graph.getResult(app).libraryCount() );
+
+  const auto libAResult = resultList.findResultForTargetName( libA.fileName() );
+  REQUIRE( libAResult.has_value() );
+  REQUIRE( libAResult->libraryCount() == 1 );
+  REQUIRE( libAResult->containsLibraryName( QLatin1String("libB.so") ) );
+
+  const auto libBResult = resultList.findResultForTargetName( libB.fileName() );
+  REQUIRE( libBResult.has_value() );
+  REQUIRE( libBResult->libraryCount() == 1 );
+  REQUIRE( libBResult->containsLibraryName( QLatin1String("libA.so") ) );
+}
+
 /*
  * This test aims to take libararies
  * that has not to be distributed
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "TestUtils.h"
+#include "Mdt/DeployUtils/Impl/BinaryDependencies/LibraryNameTable.h"
+#include <QLatin1String>
+
+using namespace Mdt::DeployUtils;
+using namespace Mdt::DeployUtils::Impl::BinaryDependencies;
+
+TEST_CASE("intern_Linux")
+{
+  LibraryNameTable table(OperatingSystem::Linux);
+
+  SECTION("empty table")
+  {
+    REQUIRE( table.isEmpty() );
+    REQUIRE( !table.find( QLatin1String("libA.so") ).has_value() );
+  }
+
+  SECTION("add libA.so")
+  {
+    const LibraryNameId id = table.intern( QLatin1String("libA.so") );
+
+    REQUIRE( table.size() == 1 );
+    REQUIRE( table.name(id) == QLatin1String("libA.so") );
+    REQUIRE( table.find( QLatin1String("libA.so") ) == id );
+  }
+
+  SECTION("add libA.so twice")
+  {
+    const LibraryNameId id1 = table.intern( QLatin1String("libA.so") );
+    const LibraryNameId id2 = table.intern( QLatin1String("libA.so") );
+
+    REQUIRE( table.size() == 1 );
+    REQUIRE( id1 == id2 );
+  }
+
+  SECTION("names are case sensitive")
+  {
+    const LibraryNameId id1 = table.intern( QLatin1String("libA.so") );
+    const LibraryNameId id2 = table.intern( QLatin1String("LIBA.SO") );
+
+    REQUIRE( table.size() == 2 );
+    REQUIRE( id1 != id2 );
+    REQUIRE( !table.find( QLatin1String("liba.so") ).has_value() );
+  }
+}
+
+TEST_CASE("intern_Windows")
+{
+  LibraryNameTable table(OperatingSystem::Windows);
+
+  SECTION("names are case insensitive")
+  {
+    const LibraryNameId id1 = table.intern( QLatin1String("Qt5Core.dll") );
+    const LibraryNameId id2 = table.intern( QLatin1String("QT5CORE.DLL") );
+
+    REQUIRE( table.size() == 1 );
+    REQUIRE( id1 == id2 );
+    REQUIRE( table.find( QLatin1String("qt5core.dll") ) == id1 );
+    // The name is the one first added
+    REQUIRE( table.name(id1) == QLatin1String("Qt5Core.dll") );
+  }
+}
+
+TEST_CASE("internList_names")
+{
+  LibraryNameTable table(OperatingSystem::Linux);
+
+  const QStringList names = qStringListFromUtf8Strings({"libA.so","libB.so","libA.so"});
+  const std::vector<LibraryNameId> ids = table.intern(names);
+
+  REQUIRE( ids.size() == 3 );
+  REQUIRE( ids[0] != ids[1] );
+  REQUIRE( ids[0] == ids[2] );
+  REQUIRE( table.size() == 2 );
+  REQUIRE( table.names(ids) == names );
+}
@@ -211,6 +211,29 @@ TEST_CASE("getLibrariesToRedistribute")
       REQUIRE( libraryListContainsPath(libraries, "/opt/MyLibA.so") );
       REQUIRE( libraryListContainsPath(libraries, "/opt/MyLibB.so") );
     }
+
+    SECTION("libraries are in the order they are first seen")
+    {
+      QFileInfo MyLibA( QLatin1String("/opt/MyLibA.so") );
+      QFileInfo MyLibB( QLatin1String("/opt/MyLibB.so") );
+      QFileInfo MyLibC( QLatin1String("/opt/MyLibC.so") );
+
+      result1.addFoundLibrary(MyLibB, rpath);
+      result1.addFoundLibrary(MyLibA, rpath);
+      resultList.addResult(result1);
+
+      result2.addFoundLibrary(MyLibA, rpath);
+      result2.addFoundLibrary(MyLibC, rpath);
+      result2.addFoundLibrary(MyLibB, rpath);
+      resultList.addResult(result2);
+
+      libraries = getLibrariesToRedistribute(resultList);
+
+      REQUIRE( libraries.size() == 3 );
+      REQUIRE( libraries[0].libraryName() == QLatin1String("MyLibB.so") );
+      REQUIRE( libraries[1].libraryName() == QLatin1String("MyLibA.so") );
+      REQUIRE( libraries[2].libraryName() == QLatin1String("MyLibC.so") );
+    }
   }
 }
 
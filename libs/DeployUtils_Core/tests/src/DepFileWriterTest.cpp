@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "TestFileUtils.h"
+#include "Mdt/DeployUtils/DepFileWriter.h"
+#include <QTemporaryDir>
+#include <QString>
+#include <QStringList>
+#include <QLatin1String>
+
+using namespace Mdt::DeployUtils;
+
+TEST_CASE("escapeMakefilePath")
+{
+  SECTION("plain path")
+  {
+    REQUIRE( DepFileWriter::escapeMakefilePath( QLatin1String("/usr/lib/libA.so") ) == QLatin1String("/usr/lib/libA.so") );
+  }
+
+  SECTION("space")
+  {
+    REQUIRE( DepFileWriter::escapeMakefilePath( QLatin1String("/opt/my libs/libA.so") ) == QLatin1String("/opt/my\\ libs/libA.so") );
+  }
+
+  SECTION("hash")
+  {
+    REQUIRE( DepFileWriter::escapeMakefilePath( QLatin1String("/opt/#1/libA.so") ) == QLatin1String("/opt/\\#1/libA.so") );
+  }
+
+  SECTION("dollar")
+  {
+    REQUIRE( DepFileWriter::escapeMakefilePath( QLatin1String("/opt/$A/libA.so") ) == QLatin1String("/opt/$$A/libA.so") );
+  }
+}
+
+TEST_CASE("makeDepFileContent")
+{
+  const QString output = QLatin1String("/build/app.stamp");
+  QStringList dependencies;
+
+  SECTION("no dependencies")
+  {
+    REQUIRE( DepFileWriter::makeDepFileContent(output, dependencies) == "/build/app.stamp:\n" );
+  }
+
+  SECTION("2 dependencies")
+  {
+    dependencies << QLatin1String("/build/app") << QLatin1String("/usr/lib/libA.so");
+    REQUIRE( DepFileWriter::makeDepFileContent(output, dependencies) == "/build/app.stamp: \\\n  /build/app \\\n  /usr/lib/libA.so\n" );
+  }
+
+  SECTION("duplicate dependencies are listed once")
+  {
+    dependencies << QLatin1String("/build/app") << QLatin1String("/build/app");
+    REQUIRE( DepFileWriter::makeDepFileContent(output, dependencies) == "/build/app.stamp: \\\n  /build/app\n" );
+  }
+}
+
+TEST_CASE("writeFiles")
+{
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  DepFileWriter writer;
+
+  const QString stampFilePath = makePath(root, "stamps/app.stamp");
+  const QString depFilePath = makePath(root, "depfiles/app.d");
+
+  SECTION("depfile")
+  {
+    writer.writeDepFile( depFilePath, stampFilePath, {QLatin1String("/build/app")} );
+    REQUIRE( readTextFileUtf8(depFilePath) == stampFilePath + QLatin1String(": \\\n  /build/app\n") );
+  }
+
+  SECTION("stamp file")
+  {
+    writer.writeStampFile(stampFilePath);
+    REQUIRE( fileExists(stampFilePath) );
+
+    writer.writeStampFile(stampFilePath);
+    REQUIRE( fileExists(stampFilePath) );
+  }
+}
@@ -0,0 +1,245 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "TestUtils.h"
+#include "TestFileUtils.h"
+#include "Mdt/DeployUtils/DeployManifest.h"
+#include "Mdt/DeployUtils/DeployManifestReader.h"
+#include "Mdt/DeployUtils/DeployManifestWriter.h"
+#include "Mdt/DeployUtils/FileHashCache.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QString>
+#include <QLatin1String>
+#include <QLatin1Char>
+
+using namespace Mdt::DeployUtils;
+
+bool setLastModified(const QString & filePath, const QDateTime & dateTime)
+{
+  QFile file(filePath);
+  if( !file.open(QIODevice::ReadWrite) ){
+    return false;
+  }
+
+  return file.setFileTime(dateTime, QFileDevice::FileModificationTime);
+}
+
+TEST_CASE("addEntry_findEntry")
+{
+  DeployManifest manifest;
+
+  DeployManifestEntry entry;
+  entry.filePath = QLatin1String("lib/libA.so");
+  entry.sourceFilePath = QLatin1String("/opt/lib/libA.so");
+
+  SECTION("empty")
+  {
+    REQUIRE( manifest.isEmpty() );
+    REQUIRE( !manifest.findEntry( QLatin1String("lib/libA.so") ).has_value() );
+  }
+
+  SECTION("add 1 entry")
+  {
+    manifest.addEntry(entry);
+
+    REQUIRE( manifest.entriesCount() == 1 );
+    const auto foundEntry = manifest.findEntry( QLatin1String("lib/libA.so") );
+    REQUIRE( foundEntry.has_value() );
+    REQUIRE( foundEntry->sourceFilePath == QLatin1String("/opt/lib/libA.so") );
+  }
+
+  SECTION("add the same entry twice")
+  {
+    manifest.addEntry(entry);
+    entry.sourceFilePath = QLatin1String("/usr/lib/libA.so");
+    manifest.addEntry(entry);
+
+    REQUIRE( manifest.entriesCount() == 1 );
+    REQUIRE( manifest.findEntry( QLatin1String("lib/libA.so") )->sourceFilePath == QLatin1String("/usr/lib/libA.so") );
+  }
+}
+
+TEST_CASE("manifestFilePath")
+{
+  const QString destination = makeAbsolutePath("/tmp/app");
+
+  SECTION("the path is in the destination")
+  {
+    const QString path = DeployManifest::manifestFilePath( destination, qStringListFromUtf8Strings({"/build/app"}) );
+
+    REQUIRE( path.startsWith( destination + QLatin1String("/.mdtdeployutils/") ) );
+    REQUIRE( path.endsWith( QLatin1String(".json") ) );
+  }
+
+  SECTION("the same targets from a other directory have the same manifest")
+  {
+    const QString path1 = DeployManifest::manifestFilePath( destination, qStringListFromUtf8Strings({"/build1/app","/build1/tool"}) );
+    const QString path2 = DeployManifest::manifestFilePath( destination, qStringListFromUtf8Strings({"/build2/tool","/build2/app"}) );
+
+    REQUIRE( path1 == path2 );
+  }
+
+  SECTION("other targets have a other manifest")
+  {
+    const QString path1 = DeployManifest::manifestFilePath( destination, qStringListFromUtf8Strings({"/build/app"}) );
+    const QString path2 = DeployManifest::manifestFilePath( destination, qStringListFromUtf8Strings({"/build/tool"}) );
+
+    REQUIRE( path1 != path2 );
+  }
+}
+
+TEST_CASE("isUpToDate")
+{
+  QTemporaryDir sourceRoot;
+  REQUIRE( sourceRoot.isValid() );
+  QTemporaryDir destinationRoot;
+  REQUIRE( destinationRoot.isValid() );
+
+  const QString sourceFilePath = makePath(sourceRoot, "libA.so");
+  const QString destinationFilePath = makePath(destinationRoot, "libA.so");
+  REQUIRE( createTextFileUtf8( sourceFilePath, QLatin1String("A") ) );
+  REQUIRE( createTextFileUtf8( destinationFilePath, QLatin1String("A") ) );
+
+  DeployManifest manifest;
+  manifest.setDestinationDirectoryPath( destinationRoot.path() );
+
+  SECTION("empty manifest")
+  {
+    REQUIRE( !manifest.isUpToDate() );
+  }
+
+  manifest.addDeployedFile( destinationFilePath, sourceFilePath, QStringList(), DeployManifest() );
+  REQUIRE( manifest.entriesCount() == 1 );
+  REQUIRE( manifest.entries()[0].filePath == QLatin1String("libA.so") );
+  REQUIRE( !manifest.entries()[0].sha256.isEmpty() );
+
+  SECTION("nothing changed")
+  {
+    REQUIRE( manifest.isUpToDate() );
+    REQUIRE( manifest.fileIsUpToDate( QFileInfo(sourceFilePath), destinationFilePath ) );
+  }
+
+  SECTION("the source changed")
+  {
+    REQUIRE( createTextFileUtf8( sourceFilePath, QLatin1String("AB") ) );
+
+    REQUIRE( !manifest.isUpToDate() );
+    REQUIRE( !manifest.fileIsUpToDate( QFileInfo(sourceFilePath), destinationFilePath ) );
+  }
+
+  SECTION("the file comes from a other source")
+  {
+    const QString otherSourceFilePath = makePath(sourceRoot, "otherLibA.so");
+    REQUIRE( createTextFileUtf8( otherSourceFilePath, QLatin1String("A") ) );
+
+    REQUIRE( !manifest.fileIsUpToDate( QFileInfo(otherSourceFilePath), destinationFilePath ) );
+  }
+
+  SECTION("the deployed file changed")
+  {
+    REQUIRE( createTextFileUtf8( destinationFilePath, QLatin1String("AB") ) );
+
+    REQUIRE( !manifest.isUpToDate() );
+  }
+
+  SECTION("the deployed file was only touched")
+  {
+    REQUIRE( setLastModified( destinationFilePath, QDateTime::currentDateTime().addSecs(10) ) );
+
+    REQUIRE( manifest.isUpToDate() );
+  }
+
+  SECTION("the deployed file was removed")
+  {
+    REQUIRE( QFile::remove(destinationFilePath) );
+
+    REQUIRE( !manifest.isUpToDate() );
+  }
+}
+
+TEST_CASE("addDeployedFile_hashCache")
+{
+  QTemporaryDir destinationRoot;
+  REQUIRE( destinationRoot.isValid() );
+
+  const QString destinationFilePath = makePath(destinationRoot, "libA.so");
+  REQUIRE( createTextFileUtf8( destinationFilePath, QLatin1String("A") ) );
+
+  DeployManifest manifest;
+  manifest.setDestinationDirectoryPath( destinationRoot.path() );
+
+  SECTION("the SHA-256 known by the cache is used")
+  {
+    // Not the real SHA-256, to check that the file is not read
+    const QString sha256 = QString( 64, QLatin1Char('a') );
+    FileHashCache cache;
+    cache.insert(destinationFilePath, sha256);
+
+    manifest.addDeployedFile( destinationFilePath, QString(), QStringList(), DeployManifest(), &cache );
+    REQUIRE( manifest.entries()[0].sha256 == sha256 );
+  }
+
+  SECTION("the file is not in the cache")
+  {
+    FileHashCache cache;
+
+    manifest.addDeployedFile( destinationFilePath, QString(), QStringList(), DeployManifest(), &cache );
+    REQUIRE( manifest.entries()[0].sha256 == DeployManifest::fileSha256(destinationFilePath) );
+  }
+}
+
+TEST_CASE("write_read")
+{
+  QTemporaryDir sourceRoot;
+  REQUIRE( sourceRoot.isValid() );
+  QTemporaryDir destinationRoot;
+  REQUIRE( destinationRoot.isValid() );
+
+  const QString sourceFilePath = makePath(sourceRoot, "libA.so");
+  REQUIRE( createDirectoryFromPath(destinationRoot, "lib") );
+  const QString destinationFilePath = makePath(destinationRoot, "lib/libA.so");
+  const QString qtConfFilePath = makePath(destinationRoot, "qt.conf");
+  REQUIRE( createTextFileUtf8( sourceFilePath, QLatin1String("A") ) );
+  REQUIRE( createTextFileUtf8( destinationFilePath, QLatin1String("A") ) );
+  REQUIRE( createTextFileUtf8( qtConfFilePath, QLatin1String("[Paths]") ) );
+
+  DeployManifest manifest;
+  manifest.setDestinationDirectoryPath( destinationRoot.path() );
+  manifest.setRequestKey( QLatin1String("runtimeDestination=bin") );
+  manifest.addDeployedFile( destinationFilePath, sourceFilePath, qStringListFromUtf8Strings({"."}), DeployManifest() );
+  manifest.addDeployedFile( qtConfFilePath, QString(), QStringList(), DeployManifest() );
+
+  const QString manifestFilePath = DeployManifest::manifestFilePath( destinationRoot.path(), qStringListFromUtf8Strings({"/build/app"}) );
+
+  DeployManifestWriter writer;
+  writer.writeFile(manifest, manifestFilePath);
+
+  DeployManifestReader reader;
+  const DeployManifest readManifest = reader.readFile( QFileInfo(manifestFilePath) );
+
+  REQUIRE( readManifest.destinationDirectoryPath() == QFileInfo( destinationRoot.path() ).absoluteFilePath() );
+  REQUIRE( readManifest.requestKey() == QLatin1String("runtimeDestination=bin") );
+  REQUIRE( readManifest.entriesCount() == 2 );
+
+  const auto library = readManifest.findEntry( QLatin1String("lib/libA.so") );
+  REQUIRE( library.has_value() );
+  REQUIRE( library->sourceFilePath == QFileInfo(sourceFilePath).absoluteFilePath() );
+  REQUIRE( library->sha256 == manifest.entries()[0].sha256 );
+  REQUIRE( library->rpath == qStringListFromUtf8Strings({"."}) );
+
+  const auto qtConf = readManifest.findEntry( QLatin1String("qt.conf") );
+  REQUIRE( qtConf.has_value() );
+  REQUIRE( qtConf->isGenerated() );
+
+  REQUIRE( readManifest.isUpToDate() );
+}
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "TestFileUtils.h"
+#include "Mdt/DeployUtils/DeployStore.h"
+#include "Mdt/DeployUtils/DeployManifest.h"
+#include <QTemporaryDir>
+#include <QString>
+#include <QLatin1String>
+
+using namespace Mdt::DeployUtils;
+
+TEST_CASE("objectFilePath")
+{
+  DeployStore store( QLatin1String("/tmp/store") );
+
+  const QString sha256 = QLatin1String("ab0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcd");
+  REQUIRE( store.objectFilePath(sha256) == QLatin1String("/tmp/store/objects/ab/") + sha256 );
+}
+
+TEST_CASE("addFile")
+{
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  DeployStore store( makePath(root, "store") );
+
+  const QString libAFilePath = makePath(root, "libA.so");
+  const QString otherLibAFilePath = makePath(root, "other/libA.so");
+  const QString libBFilePath = makePath(root, "libB.so");
+  REQUIRE( createTextFileUtf8(libAFilePath, QLatin1String("A")) );
+  REQUIRE( createDirectoryFromPath(root, "other") );
+  REQUIRE( createTextFileUtf8(otherLibAFilePath, QLatin1String("A")) );
+  REQUIRE( createTextFileUtf8(libBFilePath, QLatin1String("B")) );
+
+  const QString libASha256 = store.addFile(libAFilePath);
+  REQUIRE( fileExists( store.objectFilePath(libASha256) ) );
+  REQUIRE( readTextFileUtf8( store.objectFilePath(libASha256) ) == QLatin1String("A") );
+  REQUIRE( store.addedFileCount() == 1 );
+  REQUIRE( store.reusedFileCount() == 0 );
+
+  SECTION("same content is stored once")
+  {
+    REQUIRE( store.addFile(otherLibAFilePath) == libASha256 );
+    REQUIRE( store.addedFileCount() == 1 );
+    REQUIRE( store.reusedFileCount() == 1 );
+  }
+
+  SECTION("other content")
+  {
+    const QString libBSha256 = store.addFile(libBFilePath);
+    REQUIRE( libBSha256 != libASha256 );
+    REQUIRE( readTextFileUtf8( store.objectFilePath(libBSha256) ) == QLatin1String("B") );
+    REQUIRE( store.addedFileCount() == 2 );
+  }
+}
+
+TEST_CASE("deployFile")
+{
+  QTemporaryDir sourceRoot;
+  REQUIRE( sourceRoot.isValid() );
+
+  QTemporaryDir destinationRoot;
+  REQUIRE( destinationRoot.isValid() );
+
+  DeployStore store( makePath(destinationRoot, "store") );
+
+  const QString libASourceFilePath = makePath(sourceRoot, "libA.so");
+  REQUIRE( createTextFileUtf8(libASourceFilePath, QLatin1String("A")) );
+
+  REQUIRE( createDirectoryFromPath(destinationRoot, "app1") );
+  REQUIRE( createDirectoryFromPath(destinationRoot, "app2") );
+  const QString app1LibAFilePath = makePath(destinationRoot, "app1/libA.so");
+  const QString app2LibAFilePath = makePath(destinationRoot, "app2/libA.so");
+
+  const DeployStoreLinkType app1LinkType = store.deployFile(libASourceFilePath, app1LibAFilePath);
+  store.deployFile(libASourceFilePath, app2LibAFilePath);
+
+  REQUIRE( readTextFileUtf8(app1LibAFilePath) == QLatin1String("A") );
+  REQUIRE( readTextFileUtf8(app2LibAFilePath) == QLatin1String("A") );
+  REQUIRE( store.addedFileCount() == 1 );
+  REQUIRE( store.reusedFileCount() == 1 );
+#ifdef Q_OS_LINUX
+  REQUIRE( app1LinkType != DeployStoreLinkType::Copy );
+#else
+  (void)app1LinkType;
+#endif
+
+  SECTION("deploy a patched variant")
+  {
+    const QString libASha256 = DeployManifest::fileSha256(libASourceFilePath);
+    const QString patchKey = QLatin1String("rpath:.");
+    REQUIRE( store.findPatchedFile(libASha256, patchKey).isEmpty() );
+
+    QTemporaryDir patchRoot;
+    REQUIRE( patchRoot.isValid() );
+    const QString patchedFilePath = makePath(patchRoot, "libA.so");
+    REQUIRE( createTextFileUtf8(patchedFilePath, QLatin1String("patched A")) );
+
+    const QString patchedSha256 = store.addPatchedFile(libASha256, patchKey, patchedFilePath);
+    REQUIRE( patchedSha256 == DeployManifest::fileSha256(patchedFilePath) );
+    REQUIRE( store.findPatchedFile(libASha256, patchKey) == patchedSha256 );
+    REQUIRE( store.findPatchedFile( libASha256, QLatin1String("rpath:lib") ).isEmpty() );
+    REQUIRE( store.addedFileCount() == 2 );
+
+    store.relinkFile(patchedSha256, app1LibAFilePath);
+    REQUIRE( readTextFileUtf8(app1LibAFilePath) == QLatin1String("patched A") );
+    REQUIRE( readTextFileUtf8(app2LibAFilePath) == QLatin1String("A") );
+
+    store.removeUnusedFile(libASha256);
+    if( app1LinkType == DeployStoreLinkType::HardLink ){
+      // app2 still links to the unchanged content
+      REQUIRE( fileExists( store.objectFilePath(libASha256) ) );
+    }
+
+    store.relinkFile(patchedSha256, app2LibAFilePath);
+    REQUIRE( readTextFileUtf8(app2LibAFilePath) == QLatin1String("patched A") );
+    REQUIRE( store.addedFileCount() == 2 );
+    store.removeUnusedFile(libASha256);
+#ifdef Q_OS_LINUX
+    REQUIRE( !fileExists( store.objectFilePath(libASha256) ) );
+#endif
+    REQUIRE( store.findPatchedFile(libASha256, patchKey) == patchedSha256 );
+  }
+}
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "TestUtils.h"
+#include "TestFileUtils.h"
+#include "Mdt/DeployUtils/ExecutableFileMetadataCache.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QString>
+#include <QLatin1String>
+
+using namespace Mdt::DeployUtils;
+
+TEST_CASE("find")
+{
+  ExecutableFileMetadataCache cache;
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  const QString filePath = makePath(root, "libA.so");
+  REQUIRE( createTextFileUtf8( filePath, QLatin1String("A") ) );
+
+  ExecutableFileMetadata metadata;
+  metadata.isExecutableOrSharedLibrary = true;
+  metadata.hasDependencies = true;
+  metadata.neededSharedLibraries = qStringListFromUtf8Strings({"libB.so"});
+
+  SECTION("empty cache")
+  {
+    REQUIRE( cache.isEmpty() );
+    REQUIRE( !cache.find( QFileInfo(filePath) ) );
+    REQUIRE( cache.missCount() == 1 );
+  }
+
+  SECTION("file did not change")
+  {
+    cache.insert(QFileInfo(filePath), metadata);
+    REQUIRE( cache.count() == 1 );
+
+    const auto cachedMetadata = cache.find( QFileInfo(filePath) );
+    REQUIRE( cachedMetadata.has_value() );
+    REQUIRE( cachedMetadata->isExecutableOrSharedLibrary );
+    REQUIRE( cachedMetadata->neededSharedLibraries == qStringListFromUtf8Strings({"libB.so"}) );
+    REQUIRE( cache.hitCount() == 1 );
+  }
+
+  SECTION("file changed")
+  {
+    cache.insert(QFileInfo(filePath), metadata);
+    REQUIRE( createTextFileUtf8( filePath, QLatin1String("AB") ) );
+
+    REQUIRE( !cache.find( QFileInfo(filePath) ) );
+    REQUIRE( cache.staleCount() == 1 );
+    REQUIRE( cache.isEmpty() );
+  }
+
+  SECTION("file removed")
+  {
+    cache.insert(QFileInfo(filePath), metadata);
+    REQUIRE( QFile::remove(filePath) );
+
+    REQUIRE( !cache.find( QFileInfo(filePath) ) );
+    REQUIRE( cache.isEmpty() );
+  }
+
+  SECTION("clear")
+  {
+    cache.insert(QFileInfo(filePath), metadata);
+    cache.clear();
+    REQUIRE( cache.isEmpty() );
+  }
+}
+
+TEST_CASE("hasUpToDateDependencies")
+{
+  ExecutableFileMetadataCache cache;
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  const QString filePath = makePath(root, "libA.so");
+  REQUIRE( createTextFileUtf8( filePath, QLatin1String("A") ) );
+
+  ExecutableFileMetadata metadata;
+  metadata.isExecutableOrSharedLibrary = true;
+
+  SECTION("empty cache")
+  {
+    REQUIRE( !cache.hasUpToDateDependencies( QFileInfo(filePath) ) );
+  }
+
+  SECTION("dependencies not read")
+  {
+    metadata.hasDependencies = false;
+    cache.insert(QFileInfo(filePath), metadata);
+
+    REQUIRE( !cache.hasUpToDateDependencies( QFileInfo(filePath) ) );
+  }
+
+  SECTION("dependencies read")
+  {
+    metadata.hasDependencies = true;
+    cache.insert(QFileInfo(filePath), metadata);
+
+    REQUIRE( cache.hasUpToDateDependencies( QFileInfo(filePath) ) );
+  }
+
+  SECTION("file changed")
+  {
+    metadata.hasDependencies = true;
+    cache.insert(QFileInfo(filePath), metadata);
+    REQUIRE( createTextFileUtf8( filePath, QLatin1String("AB") ) );
+
+    REQUIRE( !cache.hasUpToDateDependencies( QFileInfo(filePath) ) );
+    REQUIRE( cache.count() == 1 );
+  }
+
+  REQUIRE( cache.hitCount() == 0 );
+  REQUIRE( cache.missCount() == 0 );
+  REQUIRE( cache.staleCount() == 0 );
+}
+
+TEST_CASE("insertCopiedFile")
+{
+  ExecutableFileMetadataCache cache;
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  const QString sourceFilePath = makePath(root, "libA.so");
+  const QString destinationFilePath = makePath(root, "libA-copy.so");
+  REQUIRE( createTextFileUtf8( sourceFilePath, QLatin1String("A") ) );
+  REQUIRE( createTextFileUtf8( destinationFilePath, QLatin1String("A") ) );
+
+  ExecutableFileMetadata metadata;
+  metadata.isExecutableOrSharedLibrary = true;
+  metadata.hasDependencies = true;
+  metadata.neededSharedLibraries = qStringListFromUtf8Strings({"libB.so"});
+  metadata.runPath.appendPath( QLatin1String("/opt/lib") );
+
+  RPath runPath;
+  runPath.appendPath( QLatin1String(".") );
+
+  SECTION("source is in the cache")
+  {
+    cache.insert(QFileInfo(sourceFilePath), metadata);
+    cache.insertCopiedFile( QFileInfo(sourceFilePath), QFileInfo(destinationFilePath), runPath );
+    REQUIRE( cache.count() == 2 );
+    REQUIRE( cache.hitCount() == 0 );
+
+    const auto cachedMetadata = cache.find( QFileInfo(destinationFilePath) );
+    REQUIRE( cachedMetadata.has_value() );
+    REQUIRE( cachedMetadata->neededSharedLibraries == qStringListFromUtf8Strings({"libB.so"}) );
+    REQUIRE( cachedMetadata->runPath == runPath );
+  }
+
+  SECTION("source is not in the cache")
+  {
+    cache.insertCopiedFile( QFileInfo(sourceFilePath), QFileInfo(destinationFilePath), runPath );
+    REQUIRE( cache.isEmpty() );
+  }
+
+  SECTION("source changed")
+  {
+    cache.insert(QFileInfo(sourceFilePath), metadata);
+    REQUIRE( createTextFileUtf8( sourceFilePath, QLatin1String("AB") ) );
+    cache.insertCopiedFile( QFileInfo(sourceFilePath), QFileInfo(destinationFilePath), runPath );
+    REQUIRE( !cache.find( QFileInfo(destinationFilePath) ) );
+  }
+}
@@ -23,10 +23,20 @@
 #include "TestUtils.h"
 #include "TestFileUtils.h"
 #include "Mdt/DeployUtils/FileCopier.h"
+#include "Mdt/DeployUtils/FileHashCache.h"
+#include "Mdt/DeployUtils/DeployManifest.h"
 #include <QTemporaryDir>
 #include <QTemporaryFile>
+#include <QFile>
+#include <QFileInfo>
 #include <QString>
+#include <QStringList>
 #include <QLatin1String>
+#include <memory>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif // #ifdef Q_OS_LINUX
 
 using namespace Mdt::DeployUtils;
 
@@ -82,6 +92,38 @@ TEST_CASE("getDestinationFilePath")
   }
 }
 
+TEST_CASE("replaceFileContent")
+{
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  const QString sourceFilePath = makePath(root, "libA.so.patched");
+  const QString destinationFilePath = makePath(root, "libA.so");
+  REQUIRE( createTextFileUtf8( sourceFilePath, QLatin1String("patched") ) );
+  REQUIRE( createTextFileUtf8( destinationFilePath, QLatin1String("original") ) );
+
+  SECTION("replace")
+  {
+    const QString sha256 = FileCopier::replaceFileContent(sourceFilePath, destinationFilePath);
+
+    REQUIRE( readTextFileUtf8(destinationFilePath) == QLatin1String("patched") );
+    REQUIRE( sha256 == DeployManifest::fileSha256(destinationFilePath) );
+  }
+
+#ifdef Q_OS_LINUX
+  SECTION("the other names of a hard link are not changed")
+  {
+    const QString hardLinkFilePath = makePath(root, "libA.so.hardlink");
+    REQUIRE( ::link( QFile::encodeName(destinationFilePath).constData(), QFile::encodeName(hardLinkFilePath).constData() ) == 0 );
+
+    FileCopier::replaceFileContent(sourceFilePath, destinationFilePath);
+
+    REQUIRE( readTextFileUtf8(destinationFilePath) == QLatin1String("patched") );
+    REQUIRE( readTextFileUtf8(hardLinkFilePath) == QLatin1String("original") );
+  }
+#endif // #ifdef Q_OS_LINUX
+}
+
 TEST_CASE("isExistingDirectory")
 {
   QTemporaryDir root;
@@ -134,6 +176,18 @@ TEST_CASE("copyFile")
     REQUIRE( copierFile.sourceFileInfo().absoluteFilePath() == libASourceFilePath );
     REQUIRE( copierFile.destinationFileInfo().absoluteFilePath() == libADestinationFilePath );
     REQUIRE( copierFile.hasBeenCopied() );
+    REQUIRE( copierFile.sha256() == DeployManifest::fileSha256(libADestinationFilePath) );
+  }
+
+  SECTION("copy libA with a file hash cache")
+  {
+    auto cache = std::make_shared<FileHashCache>();
+    fc.setFileHashCache(cache);
+    copierFile = fc.copyFile(libASourceFilePath, destinationDirectoryPath);
+
+    REQUIRE( copierFile.hasBeenCopied() );
+    REQUIRE( cache->count() == 1 );
+    REQUIRE( cache->findSha256(libADestinationFilePath) == copierFile.sha256() );
   }
 
   SECTION("copy libA to itself (destination file path == source file path)")
@@ -142,6 +196,7 @@ TEST_CASE("copyFile")
 
     REQUIRE( readTextFileUtf8(libASourceFilePath) == QLatin1String("A") );
     REQUIRE( !copierFile.hasBeenCopied() );
+    REQUIRE( copierFile.sha256().isEmpty() );
   }
 
   SECTION("copy libA to a existing file")
@@ -164,6 +219,83 @@ TEST_CASE("copyFile")
 
       REQUIRE( readTextFileUtf8(libADestinationFilePath) == QLatin1String("A") );
       REQUIRE( copierFile.hasBeenCopied() );
+      REQUIRE( copierFile.sha256() == DeployManifest::fileSha256(libADestinationFilePath) );
+    }
+  }
+}
+
+#ifdef Q_OS_LINUX
+TEST_CASE("copyFile_preserveSymLinks")
+{
+  FileCopier fc;
+  FileCopierFile copierFile;
+  QTemporaryDir sourceRoot;
+  QTemporaryDir destinationRoot;
+
+  REQUIRE( sourceRoot.isValid() );
+  REQUIRE( destinationRoot.isValid() );
+
+  // libA.so.1 -> libA.so.1.2 -> libA.so.1.2.3
+  const QString libARealSourceFilePath = makePath(sourceRoot, "libA.so.1.2.3");
+  const QString libA12SourceFilePath = makePath(sourceRoot, "libA.so.1.2");
+  const QString libA1SourceFilePath = makePath(sourceRoot, "libA.so.1");
+  REQUIRE( createTextFileUtf8( libARealSourceFilePath, QLatin1String("A") ) );
+  REQUIRE( QFile::link( QLatin1String("libA.so.1.2.3"), libA12SourceFilePath ) );
+  REQUIRE( QFile::link( QLatin1String("libA.so.1.2"), libA1SourceFilePath ) );
+
+  const QString destinationDirectoryPath = makePath(destinationRoot, "lib");
+  const QString libARealDestinationFilePath = makePath(destinationRoot, "lib/libA.so.1.2.3");
+  const QString libA1DestinationFilePath = makePath(destinationRoot, "lib/libA.so.1");
+  const QString libA12DestinationFilePath = makePath(destinationRoot, "lib/libA.so.1.2");
+
+  fc.createDirectory(destinationDirectoryPath);
+
+  SECTION("links are followed by default")
+  {
+    REQUIRE( !fc.preserveSymLinks() );
+    copierFile = fc.copyFile(libA1SourceFilePath, destinationDirectoryPath);
+
+    REQUIRE( copierFile.hasBeenCopied() );
+    REQUIRE( !copierFile.hasDestinationSymLink() );
+    REQUIRE( !QFileInfo(libA1DestinationFilePath).isSymLink() );
+    REQUIRE( readTextFileUtf8(libA1DestinationFilePath) == QLatin1String("A") );
+    REQUIRE( !fileExists(libARealDestinationFilePath) );
+  }
+
+  SECTION("preserve links")
+  {
+    fc.setPreserveSymLinks(true);
+    REQUIRE( fc.getDestinationFilePathList(QFileInfo(libA1SourceFilePath), destinationDirectoryPath)
+             == QStringList{libA1DestinationFilePath, libARealDestinationFilePath} );
+
+    copierFile = fc.copyFile(libA1SourceFilePath, destinationDirectoryPath);
+
+    REQUIRE( copierFile.hasBeenCopied() );
+    REQUIRE( copierFile.sourceFileInfo().absoluteFilePath() == libA1SourceFilePath );
+    REQUIRE( copierFile.destinationFileInfo().absoluteFilePath() == libARealDestinationFilePath );
+    REQUIRE( copierFile.destinationSymLinkFileInfo().absoluteFilePath() == libA1DestinationFilePath );
+    REQUIRE( copierFile.sha256() == DeployManifest::fileSha256(libARealDestinationFilePath) );
+    REQUIRE( !QFileInfo(libARealDestinationFilePath).isSymLink() );
+    REQUIRE( QFileInfo(libA1DestinationFilePath).isSymLink() );
+    REQUIRE( QFile::symLinkTarget(libA1DestinationFilePath) == libARealDestinationFilePath );
+    REQUIRE( readTextFileUtf8(libA1DestinationFilePath) == QLatin1String("A") );
+
+    SECTION("a other name of the same file only creates a link")
+    {
+      copierFile = fc.copyFile(libA12SourceFilePath, destinationDirectoryPath);
+
+      REQUIRE( !copierFile.hasBeenCopied() );
+      REQUIRE( copierFile.destinationFileInfo().absoluteFilePath() == libARealDestinationFilePath );
+      REQUIRE( QFileInfo(libA12DestinationFilePath).isSymLink() );
+      REQUIRE( readTextFileUtf8(libA12DestinationFilePath) == QLatin1String("A") );
+    }
+
+    SECTION("the real file itself is not copied again")
+    {
+      copierFile = fc.copyFile(libARealSourceFilePath, destinationDirectoryPath);
+
+      REQUIRE( !copierFile.hasBeenCopied() );
     }
   }
 }
+#endif // #ifdef Q_OS_LINUX
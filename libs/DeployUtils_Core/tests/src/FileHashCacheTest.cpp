@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "TestFileUtils.h"
+#include "Mdt/DeployUtils/FileHashCache.h"
+#include "Mdt/DeployUtils/DeployManifest.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QString>
+#include <QLatin1String>
+
+using namespace Mdt::DeployUtils;
+
+TEST_CASE("findSha256")
+{
+  FileHashCache cache;
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  const QString filePath = makePath(root, "libA.so");
+  REQUIRE( createTextFileUtf8( filePath, QLatin1String("A") ) );
+  const QString sha256 = DeployManifest::fileSha256(filePath);
+  REQUIRE( sha256.length() == 64 );
+
+  SECTION("empty cache")
+  {
+    REQUIRE( cache.isEmpty() );
+    REQUIRE( cache.findSha256(filePath).isEmpty() );
+  }
+
+  SECTION("file did not change")
+  {
+    cache.insert(filePath, sha256);
+    REQUIRE( cache.count() == 1 );
+
+    REQUIRE( cache.findSha256(filePath) == sha256 );
+  }
+
+  SECTION("file changed")
+  {
+    cache.insert(filePath, sha256);
+    REQUIRE( createTextFileUtf8( filePath, QLatin1String("AB") ) );
+
+    REQUIRE( cache.findSha256(filePath).isEmpty() );
+    REQUIRE( cache.isEmpty() );
+  }
+
+  SECTION("file removed")
+  {
+    cache.insert(filePath, sha256);
+    REQUIRE( QFile::remove(filePath) );
+
+    REQUIRE( cache.findSha256(filePath).isEmpty() );
+    REQUIRE( cache.isEmpty() );
+  }
+
+  SECTION("clear")
+  {
+    cache.insert(filePath, sha256);
+    cache.clear();
+    REQUIRE( cache.isEmpty() );
+  }
+}
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "TestFileUtils.h"
+#include "Mdt/DeployUtils/FilePrefetcher.h"
+#include <QTemporaryDir>
+#include <QString>
+#include <QLatin1String>
+
+using namespace Mdt::DeployUtils;
+
+TEST_CASE("sizes")
+{
+  FilePrefetcher prefetcher;
+
+  SECTION("default")
+  {
+    REQUIRE( prefetcher.headSize() > 0 );
+    REQUIRE( prefetcher.tailSize() > 0 );
+  }
+
+  SECTION("set")
+  {
+    prefetcher.setHeadSize(4096);
+    prefetcher.setTailSize(0);
+
+    REQUIRE( prefetcher.headSize() == 4096 );
+    REQUIRE( prefetcher.tailSize() == 0 );
+  }
+}
+
+TEST_CASE("prefetch")
+{
+  FilePrefetcher prefetcher;
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  const QString filePath = makePath(root, "libA.so");
+  REQUIRE( createTextFileUtf8( filePath, QLatin1String("A") ) );
+
+  SECTION("existing file")
+  {
+    REQUIRE( prefetcher.prefetch(filePath) == FilePrefetcher::isSupported() );
+
+    if( FilePrefetcher::isSupported() ){
+      REQUIRE( prefetcher.prefetchCount() == 1 );
+    }
+  }
+
+  SECTION("small head and tail")
+  {
+    prefetcher.setHeadSize(1);
+    prefetcher.setTailSize(1);
+
+    REQUIRE( prefetcher.prefetch(filePath) == FilePrefetcher::isSupported() );
+  }
+
+  SECTION("ELF file")
+  {
+    const QString executableFilePath = QString::fromLocal8Bit(TEST_DYNAMIC_EXECUTABLE_FILE_PATH);
+
+    REQUIRE( prefetcher.prefetch(executableFilePath) == FilePrefetcher::isSupported() );
+  }
+
+  SECTION("head larger than the file")
+  {
+    prefetcher.setHeadSize(1024*1024*1024);
+
+    REQUIRE( prefetcher.prefetch(filePath) == FilePrefetcher::isSupported() );
+  }
+
+  SECTION("not existing file")
+  {
+    REQUIRE( !prefetcher.prefetch( makePath(root, "libB.so") ) );
+    REQUIRE( prefetcher.prefetchCount() == 0 );
+  }
+}
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "TestFileUtils.h"
+#include "Mdt/DeployUtils/FileStatCache.h"
+#include "Mdt/DeployUtils/ExecutableFileMetadataCache.h"
+#include <QTemporaryDir>
+#include <QFileInfo>
+#include <QString>
+#include <QStringList>
+#include <QLatin1String>
+
+using namespace Mdt::DeployUtils;
+
+TEST_CASE("stat")
+{
+  FileStatCache cache;
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  const QString filePath = makePath(root, "libA.so");
+  REQUIRE( createTextFileUtf8( filePath, QLatin1String("A") ) );
+
+  SECTION("existing file")
+  {
+    const FileStat stat = cache.stat(filePath);
+
+    REQUIRE( stat.exists );
+    REQUIRE( stat.isFile );
+    REQUIRE( stat.size == 1 );
+    REQUIRE( stat.lastModified >= 0 );
+    REQUIRE( cache.statCount() == 1 );
+    REQUIRE( cache.hitCount() == 0 );
+  }
+
+  SECTION("not existing file")
+  {
+    const FileStat stat = cache.stat( makePath(root, "libB.so") );
+
+    REQUIRE( !stat.exists );
+    REQUIRE( !stat.isFile );
+    REQUIRE( stat.size == -1 );
+  }
+
+  SECTION("a directory is not a file")
+  {
+    const FileStat stat = cache.stat( root.path() );
+
+    REQUIRE( stat.exists );
+    REQUIRE( !stat.isFile );
+  }
+
+  SECTION("each file is stat'ed once")
+  {
+    cache.stat(filePath);
+    cache.stat( QFileInfo(filePath) );
+    cache.stat(filePath);
+
+    REQUIRE( cache.count() == 1 );
+    REQUIRE( cache.statCount() == 1 );
+    REQUIRE( cache.hitCount() == 2 );
+  }
+
+  SECTION("the cache does not see changes")
+  {
+    cache.stat(filePath);
+    REQUIRE( createTextFileUtf8( filePath, QLatin1String("AB") ) );
+
+    REQUIRE( cache.stat(filePath).size == 1 );
+
+    cache.invalidate(filePath);
+    REQUIRE( cache.stat(filePath).size == 2 );
+    REQUIRE( cache.statCount() == 2 );
+  }
+
+  SECTION("clear")
+  {
+    cache.stat(filePath);
+    cache.clear();
+
+    REQUIRE( cache.isEmpty() );
+    REQUIRE( cache.statCount() == 0 );
+  }
+}
+
+TEST_CASE("statFiles")
+{
+  FileStatCache cache;
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  const QString filePathA = makePath(root, "libA.so");
+  REQUIRE( createTextFileUtf8( filePathA, QLatin1String("A") ) );
+  const QString filePathB = makePath(root, "libB.so");
+  const QStringList paths{filePathA, filePathB, root.path(), filePathA};
+
+  SECTION("synchronous backend")
+  {
+    cache.setBackend(FileStatBackend::Synchronous);
+    cache.statFiles(paths);
+
+    REQUIRE( cache.backend() == FileStatBackend::Synchronous );
+    REQUIRE( cache.count() == 3 );
+    REQUIRE( cache.statCount() == 3 );
+    REQUIRE( cache.batchCount() == 0 );
+  }
+
+  SECTION("io_uring backend")
+  {
+    cache.setBackend(FileStatBackend::IoUring);
+    if( FileStatCache::isBackendAvailable(FileStatBackend::IoUring) ){
+      REQUIRE( cache.backend() == FileStatBackend::IoUring );
+    }else{
+      REQUIRE( cache.backend() == FileStatBackend::Synchronous );
+    }
+    cache.statFiles(paths);
+
+    REQUIRE( cache.count() == 3 );
+    REQUIRE( cache.statCount() == 3 );
+    if( cache.backend() == FileStatBackend::IoUring ){
+      REQUIRE( cache.batchCount() == 1 );
+    }
+  }
+
+  const FileStat statA = cache.stat(filePathA);
+  REQUIRE( statA.exists );
+  REQUIRE( statA.isFile );
+  REQUIRE( statA.size == 1 );
+  REQUIRE( statA.lastModified == FileStatCache::statFile(filePathA).lastModified );
+
+  const FileStat statB = cache.stat(filePathB);
+  REQUIRE( !statB.exists );
+  REQUIRE( statB.size == -1 );
+
+  const FileStat rootStat = cache.stat( root.path() );
+  REQUIRE( rootStat.exists );
+  REQUIRE( !rootStat.isFile );
+
+  REQUIRE( cache.statCount() == 3 );
+  REQUIRE( cache.hitCount() == 3 );
+
+  // Files already in the cache are not stat'ed again
+  cache.statFiles(paths);
+  REQUIRE( cache.statCount() == 3 );
+}
+
+TEST_CASE("ExecutableFileMetadataCache_sharesStats")
+{
+  FileStatCache statCache;
+  ExecutableFileMetadataCache metadataCache;
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  const QString filePath = makePath(root, "libA.so");
+  REQUIRE( createTextFileUtf8( filePath, QLatin1String("A") ) );
+
+  ExecutableFileMetadata metadata;
+  metadata.isExecutableOrSharedLibrary = true;
+
+  REQUIRE( statCache.stat(filePath).exists );
+  metadataCache.insert(QFileInfo(filePath), metadata, &statCache);
+  REQUIRE( metadataCache.find(QFileInfo(filePath), &statCache).has_value() );
+
+  REQUIRE( statCache.statCount() == 1 );
+  REQUIRE( statCache.hitCount() == 2 );
+}
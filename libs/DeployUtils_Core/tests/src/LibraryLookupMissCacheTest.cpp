@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "Mdt/DeployUtils/LibraryLookupMissCache.h"
+#include <QString>
+#include <QLatin1String>
+
+using namespace Mdt::DeployUtils;
+
+TEST_CASE("isKnownMiss")
+{
+  LibraryLookupMissCache cache;
+  const QString libA = QLatin1String("libA.so");
+  const QString context = QLatin1String("/tmp\n/opt");
+
+  SECTION("empty")
+  {
+    REQUIRE( cache.isEmpty() );
+    REQUIRE( !cache.isKnownMiss(libA, context) );
+    REQUIRE( cache.hitCount() == 0 );
+  }
+
+  cache.addMiss(libA, context, 2);
+  REQUIRE( cache.count() == 1 );
+
+  SECTION("same library in the same context")
+  {
+    REQUIRE( cache.isKnownMiss(libA, context) );
+    REQUIRE( cache.isKnownMiss(libA, context) );
+    REQUIRE( cache.hitCount() == 2 );
+    REQUIRE( cache.savedProbeCount() == 4 );
+  }
+
+  SECTION("same library in a other context")
+  {
+    REQUIRE( !cache.isKnownMiss( libA, QLatin1String("/usr/lib\n/tmp\n/opt") ) );
+    REQUIRE( cache.hitCount() == 0 );
+    REQUIRE( cache.savedProbeCount() == 0 );
+  }
+
+  SECTION("other library in the same context")
+  {
+    REQUIRE( !cache.isKnownMiss( QLatin1String("libB.so"), context ) );
+  }
+
+  SECTION("clear")
+  {
+    REQUIRE( cache.isKnownMiss(libA, context) );
+    cache.clear();
+
+    REQUIRE( cache.isEmpty() );
+    REQUIRE( cache.hitCount() == 0 );
+    REQUIRE( cache.savedProbeCount() == 0 );
+    REQUIRE( !cache.isKnownMiss(libA, context) );
+  }
+}
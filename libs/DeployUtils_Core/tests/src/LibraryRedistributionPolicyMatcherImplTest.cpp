@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "Mdt/DeployUtils/Impl/LibraryRedistributionPolicyMatcher.h"
+#include "Mdt/DeployUtils/LibraryRedistributionPolicy.h"
+#include <QLatin1String>
+#include <QString>
+
+using namespace Mdt::DeployUtils;
+using Mdt::DeployUtils::Impl::LibraryRedistributionPolicyMatcher;
+
+QString qs(const char * str)
+{
+  return QString::fromLatin1(str);
+}
+
+bool isExcluded(const LibraryRedistributionPolicyMatcher & matcher, const char * libraryName)
+{
+  const auto action = matcher.match( qs(libraryName) );
+
+  return action && ( *action == LibraryRedistributionPolicyAction::Exclude );
+}
+
+bool isIncluded(const LibraryRedistributionPolicyMatcher & matcher, const char * libraryName)
+{
+  const auto action = matcher.match( qs(libraryName) );
+
+  return action && ( *action == LibraryRedistributionPolicyAction::Include );
+}
+
+bool hasNoMatch(const LibraryRedistributionPolicyMatcher & matcher, const char * libraryName)
+{
+  return !matcher.match( qs(libraryName) );
+}
+
+TEST_CASE("emptyPolicy")
+{
+  LibraryRedistributionPolicy policy;
+
+  const auto matcher = LibraryRedistributionPolicyMatcher::compile(policy, OperatingSystem::Linux);
+
+  REQUIRE( matcher.isEmpty() );
+  REQUIRE( hasNoMatch(matcher, "libc.so.6") );
+  REQUIRE( hasNoMatch(matcher, "") );
+}
+
+TEST_CASE("exactPattern")
+{
+  LibraryRedistributionPolicy policy;
+  policy.addExcludeRule( qs("libGL.so.1") );
+
+  const auto matcher = LibraryRedistributionPolicyMatcher::compile(policy, OperatingSystem::Linux);
+  REQUIRE( !matcher.isEmpty() );
+
+  REQUIRE( isExcluded(matcher, "libGL.so.1") );
+  REQUIRE( hasNoMatch(matcher, "libGL.so") );
+  REQUIRE( hasNoMatch(matcher, "libGL.so.12") );
+  REQUIRE( hasNoMatch(matcher, "libgl.so.1") );
+}
+
+TEST_CASE("wildcards")
+{
+  LibraryRedistributionPolicy policy;
+
+  SECTION("prefix")
+  {
+    policy.addExcludeRule( qs("libGL*") );
+    const auto matcher = LibraryRedistributionPolicyMatcher::compile(policy, OperatingSystem::Linux);
+
+    REQUIRE( isExcluded(matcher, "libGL") );
+    REQUIRE( isExcluded(matcher, "libGL.so.1") );
+    REQUIRE( isExcluded(matcher, "libGLX.so.0") );
+    REQUIRE( hasNoMatch(matcher, "libEGL.so.1") );
+  }
+
+  SECTION("star in the middle")
+  {
+    policy.addExcludeRule( qs("libQt5*.so.5") );
+    const auto matcher = LibraryRedistributionPolicyMatcher::compile(policy, OperatingSystem::Linux);
+
+    REQUIRE( isExcluded(matcher, "libQt5Core.so.5") );
+    REQUIRE( isExcluded(matcher, "libQt5.so.5") );
+    REQUIRE( isExcluded(matcher, "libQt5Core.so.5.so.5") );
+    REQUIRE( hasNoMatch(matcher, "libQt5Core.so.5.15") );
+  }
+
+  SECTION("question mark")
+  {
+    policy.addExcludeRule( qs("libfoo.so.?") );
+    const auto matcher = LibraryRedistributionPolicyMatcher::compile(policy, OperatingSystem::Linux);
+
+    REQUIRE( isExcluded(matcher, "libfoo.so.1") );
+    REQUIRE( isExcluded(matcher, "libfoo.so.2") );
+    REQUIRE( hasNoMatch(matcher, "libfoo.so.") );
+    REQUIRE( hasNoMatch(matcher, "libfoo.so.12") );
+  }
+}
+
+TEST_CASE("severalRules")
+{
+  LibraryRedistributionPolicy policy;
+  policy.addExcludeRule( qs("libGL.so.1") );
+  policy.addExcludeRule( qs("libEGL*") );
+  policy.addExcludeRule( qs("libdrm.so.?") );
+
+  const auto matcher = LibraryRedistributionPolicyMatcher::compile(policy, OperatingSystem::Linux);
+
+  REQUIRE( isExcluded(matcher, "libGL.so.1") );
+  REQUIRE( isExcluded(matcher, "libEGL.so.1") );
+  REQUIRE( isExcluded(matcher, "libdrm.so.2") );
+  REQUIRE( hasNoMatch(matcher, "libQt5Core.so.5") );
+}
+
+TEST_CASE("includeWinsOverExclude")
+{
+  LibraryRedistributionPolicy policy;
+  policy.addExcludeRule( qs("libstdc++*") );
+  policy.addIncludeRule( qs("libstdc++.so.6") );
+
+  const auto matcher = LibraryRedistributionPolicyMatcher::compile(policy, OperatingSystem::Linux);
+
+  REQUIRE( isIncluded(matcher, "libstdc++.so.6") );
+  REQUIRE( isExcluded(matcher, "libstdc++.so.5") );
+}
+
+TEST_CASE("operatingSystem")
+{
+  LibraryRedistributionPolicy policy;
+  policy.addExcludeRule( qs("libcommon*") );
+  policy.addExcludeRule( qs("libGL.so.1"), OperatingSystem::Linux );
+  policy.addExcludeRule( qs("OPENGL32.DLL"), OperatingSystem::Windows );
+
+  SECTION("Linux")
+  {
+    const auto matcher = LibraryRedistributionPolicyMatcher::compile(policy, OperatingSystem::Linux);
+
+    REQUIRE( isExcluded(matcher, "libcommon.so") );
+    REQUIRE( isExcluded(matcher, "libGL.so.1") );
+    REQUIRE( hasNoMatch(matcher, "OPENGL32.DLL") );
+  }
+
+  SECTION("Windows")
+  {
+    const auto matcher = LibraryRedistributionPolicyMatcher::compile(policy, OperatingSystem::Windows);
+
+    REQUIRE( isExcluded(matcher, "libcommon.dll") );
+    REQUIRE( hasNoMatch(matcher, "libGL.so.1") );
+    REQUIRE( isExcluded(matcher, "OPENGL32.DLL") );
+  }
+}
+
+TEST_CASE("windowsIsCaseInsensitive")
+{
+  LibraryRedistributionPolicy policy;
+  policy.addExcludeRule( qs("MyVendor*.dll") );
+
+  const auto matcher = LibraryRedistributionPolicyMatcher::compile(policy, OperatingSystem::Windows);
+
+  REQUIRE( isExcluded(matcher, "MyVendorCore.dll") );
+  REQUIRE( isExcluded(matcher, "MYVENDORCORE.DLL") );
+  REQUIRE( isExcluded(matcher, "myvendorcore.dll") );
+  REQUIRE( hasNoMatch(matcher, "MyOtherVendor.dll") );
+}
+
+TEST_CASE("nonAsciiCharacters")
+{
+  LibraryRedistributionPolicy policy;
+  policy.addExcludeRule( QString::fromUtf8("libé*") );
+
+  const auto matcher = LibraryRedistributionPolicyMatcher::compile(policy, OperatingSystem::Linux);
+
+  REQUIRE( matcher.match( QString::fromUtf8("libé.so") ).has_value() );
+  REQUIRE( hasNoMatch(matcher, "libe.so") );
+}
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "Mdt/DeployUtils/LibraryRedistributionPolicyReader.h"
+#include "Mdt/DeployUtils/LibraryRedistributionPolicy.h"
+#include <QLatin1String>
+#include <QString>
+
+using namespace Mdt::DeployUtils;
+
+QString qs(const char * str)
+{
+  return QString::fromLatin1(str);
+}
+
+LibraryRedistributionPolicy readPolicy(const char * text)
+{
+  LibraryRedistributionPolicyReader reader;
+
+  return reader.readText( qs(text), qs("policy.txt") );
+}
+
+TEST_CASE("readText")
+{
+  SECTION("empty")
+  {
+    const auto policy = readPolicy("");
+    REQUIRE( policy.isEmpty() );
+  }
+
+  SECTION("only comments")
+  {
+    const auto policy = readPolicy("# Comment\n  # Other comment\n\n");
+    REQUIRE( policy.isEmpty() );
+  }
+
+  SECTION("rules without section apply to all")
+  {
+    const auto policy = readPolicy("exclude libGL.so.1\ninclude libstdc++.so.6\n");
+    REQUIRE( policy.ruleCount() == 2 );
+    REQUIRE( policy.rules()[0].action == LibraryRedistributionPolicyAction::Exclude );
+    REQUIRE( policy.rules()[0].pattern == qs("libGL.so.1") );
+    REQUIRE( policy.rules()[0].operatingSystem == OperatingSystem::Unknown );
+    REQUIRE( policy.rules()[1].action == LibraryRedistributionPolicyAction::Include );
+    REQUIRE( policy.rules()[1].pattern == qs("libstdc++.so.6") );
+  }
+
+  SECTION("sections")
+  {
+    const auto policy = readPolicy(
+      "[all]\n"
+      "exclude libcommon*\n"
+      "[linux]\n"
+      "  exclude   libGL.so.1  \n"
+      "[Windows]\n"
+      "exclude OPENGL32.DLL\n"
+    );
+    REQUIRE( policy.ruleCount() == 3 );
+    REQUIRE( policy.rules()[0].operatingSystem == OperatingSystem::Unknown );
+    REQUIRE( policy.rules()[1].operatingSystem == OperatingSystem::Linux );
+    REQUIRE( policy.rules()[1].pattern == qs("libGL.so.1") );
+    REQUIRE( policy.rules()[2].operatingSystem == OperatingSystem::Windows );
+    REQUIRE( policy.rules()[2].appliesToOperatingSystem(OperatingSystem::Windows) );
+    REQUIRE( !policy.rules()[2].appliesToOperatingSystem(OperatingSystem::Linux) );
+  }
+}
+
+TEST_CASE("readText_errors")
+{
+  SECTION("unknown section")
+  {
+    REQUIRE_THROWS_AS( readPolicy("[macos]\nexclude libA.so\n"), ReadLibraryRedistributionPolicyError );
+  }
+
+  SECTION("unterminated section")
+  {
+    REQUIRE_THROWS_AS( readPolicy("[linux\n"), ReadLibraryRedistributionPolicyError );
+  }
+
+  SECTION("unknown action")
+  {
+    REQUIRE_THROWS_AS( readPolicy("remove libA.so\n"), ReadLibraryRedistributionPolicyError );
+  }
+
+  SECTION("missing pattern")
+  {
+    REQUIRE_THROWS_AS( readPolicy("exclude\n"), ReadLibraryRedistributionPolicyError );
+  }
+
+  SECTION("too many items")
+  {
+    REQUIRE_THROWS_AS( readPolicy("exclude libA.so libB.so\n"), ReadLibraryRedistributionPolicyError );
+  }
+}
@@ -25,6 +25,10 @@
 #include "Mdt/DeployUtils/PathList.h"
 #include <QTemporaryDir>
 #include <QDir>
+#include <QFile>
+#include <QStringList>
+#include <QLatin1String>
+#include <QtGlobal>
 #include <vector>
 #include <string>
 
@@ -83,3 +87,74 @@ TEST_CASE("removeNonExistingDirectories")
     REQUIRE( !pathList.containsPath(nonExisting) );
   }
 }
+
+TEST_CASE("removeDuplicateDirectories")
+{
+  PathList pathList;
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  const QString lib = makePath(root, "/lib");
+  REQUIRE( createDirectoryFromPath(lib) );
+  const QString otherLib = makePath(root, "/otherLib");
+  REQUIRE( createDirectoryFromPath(otherLib) );
+
+  SECTION("/lib,/otherLib")
+  {
+    pathList.appendPath(lib);
+    pathList.appendPath(otherLib);
+
+    pathList.removeDuplicateDirectories();
+
+    REQUIRE( pathList.toStringList() == QStringList({lib, otherLib}) );
+  }
+
+  SECTION("/lib,/otherLib/../lib")
+  {
+    const QString sameLib = otherLib + QLatin1String("/../lib");
+    pathList.appendPath(lib);
+    pathList.appendPath(otherLib);
+    pathList.appendPath(sameLib);
+
+    pathList.removeDuplicateDirectories();
+
+    REQUIRE( pathList.toStringList() == QStringList({lib, otherLib}) );
+  }
+
+  SECTION("non existing directories are kept")
+  {
+    const QString nonExisting = makePath(root, "/nonExisting");
+    pathList.appendPath(nonExisting);
+    pathList.appendPath(lib);
+
+    pathList.removeDuplicateDirectories();
+
+    REQUIRE( pathList.toStringList() == QStringList({nonExisting, lib}) );
+  }
+
+#ifdef Q_OS_UNIX
+  const QString linkToLib = makePath(root, "/linkToLib");
+  REQUIRE( QFile::link(lib, linkToLib) );
+
+  SECTION("/lib,/linkToLib")
+  {
+    pathList.appendPath(lib);
+    pathList.appendPath(linkToLib);
+
+    pathList.removeDuplicateDirectories();
+
+    REQUIRE( pathList.toStringList() == QStringList({lib}) );
+  }
+
+  SECTION("/linkToLib,/otherLib,/lib keeps the order of precedence")
+  {
+    pathList.appendPath(linkToLib);
+    pathList.appendPath(otherLib);
+    pathList.appendPath(lib);
+
+    pathList.removeDuplicateDirectories();
+
+    REQUIRE( pathList.toStringList() == QStringList({linkToLib, otherLib}) );
+  }
+#endif // #ifdef Q_OS_UNIX
+}
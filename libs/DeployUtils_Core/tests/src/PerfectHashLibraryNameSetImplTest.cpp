@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "Mdt/DeployUtils/Impl/PerfectHashLibraryNameSet.h"
+#include <QLatin1String>
+#include <QString>
+
+using namespace Mdt::DeployUtils::Impl;
+
+TEST_CASE("perfectHashTableSize")
+{
+  REQUIRE( perfectHashTableSize(1) == 1 );
+  REQUIRE( perfectHashTableSize(2) == 2 );
+  REQUIRE( perfectHashTableSize(3) == 4 );
+  REQUIRE( perfectHashTableSize(57) == 64 );
+}
+
+TEST_CASE("CaseSensitive")
+{
+  static constexpr
+  PerfectHashLibraryNameSet<3, Qt::CaseSensitive> set(
+    std::array<std::string_view, 3>{
+      std::string_view("libc.so.6"),
+      std::string_view("libm.so.6"),
+      std::string_view("libGL.so.1")
+    }
+  );
+  static_assert( set.isValid(), "" );
+  static_assert( set.contains( std::string_view("libm.so.6") ), "" );
+
+  SECTION("names in the set")
+  {
+    REQUIRE( set.contains( QString( QLatin1String("libc.so.6") ) ) );
+    REQUIRE( set.contains( QString( QLatin1String("libm.so.6") ) ) );
+    REQUIRE( set.contains( QString( QLatin1String("libGL.so.1") ) ) );
+  }
+
+  SECTION("names not in the set")
+  {
+    REQUIRE( !set.contains( QString() ) );
+    REQUIRE( !set.contains( QString( QLatin1String("libc.so") ) ) );
+    REQUIRE( !set.contains( QString( QLatin1String("libgl.so.1") ) ) );
+    REQUIRE( !set.contains( QString( QLatin1String("libQt5Core.so.5") ) ) );
+    REQUIRE( !set.contains( QString::fromUtf8("libc\xc3\xa9.so.6") ) );
+  }
+}
+
+TEST_CASE("CaseInsensitive")
+{
+  static constexpr
+  PerfectHashLibraryNameSet<2, Qt::CaseInsensitive> set(
+    std::array<std::string_view, 2>{
+      std::string_view("kernel32.dll"),
+      std::string_view("user32.dll")
+    }
+  );
+  static_assert( set.isValid(), "" );
+
+  SECTION("names in the set")
+  {
+    REQUIRE( set.contains( QString( QLatin1String("kernel32.dll") ) ) );
+    REQUIRE( set.contains( QString( QLatin1String("KERNEL32.DLL") ) ) );
+    REQUIRE( set.contains( QString( QLatin1String("User32.Dll") ) ) );
+  }
+
+  SECTION("names not in the set")
+  {
+    REQUIRE( !set.contains( QString( QLatin1String("Qt5Core.dll") ) ) );
+    REQUIRE( !set.contains( QString( QLatin1String("kernel32") ) ) );
+  }
+}
+
+TEST_CASE("invalidSet")
+{
+  SECTION("duplicate keys")
+  {
+    constexpr
+    PerfectHashLibraryNameSet<2, Qt::CaseSensitive> set(
+      std::array<std::string_view, 2>{
+        std::string_view("libc.so.6"),
+        std::string_view("libc.so.6")
+      }
+    );
+    REQUIRE( !set.isValid() );
+  }
+
+  SECTION("case insensitive set with upper case key")
+  {
+    constexpr
+    PerfectHashLibraryNameSet<1, Qt::CaseInsensitive> set(
+      std::array<std::string_view, 1>{
+        std::string_view("KERNEL32.DLL")
+      }
+    );
+    REQUIRE( !set.isValid() );
+  }
+}
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "TestFileUtils.h"
+#include "Mdt/DeployUtils/RuntimeEnvironment.h"
+#include "Mdt/DeployUtils/BinaryDependenciesResult.h"
+#include "Mdt/DeployUtils/RPath.h"
+#include "Mdt/DeployUtils/FindDependencyError.h"
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFileInfo>
+#include <QFileInfoList>
+#include <QString>
+#include <QStringList>
+#include <QLatin1String>
+#include <QLatin1Char>
+
+using namespace Mdt::DeployUtils;
+
+TEST_CASE("libraryPathVariable")
+{
+  SECTION("Linux")
+  {
+    RuntimeEnvironment environment(OperatingSystem::Linux);
+    REQUIRE( environment.libraryPathVariableName() == QLatin1String("LD_LIBRARY_PATH") );
+    REQUIRE( environment.pathListSeparator() == QLatin1Char(':') );
+  }
+
+  SECTION("Windows")
+  {
+    RuntimeEnvironment environment(OperatingSystem::Windows);
+    REQUIRE( environment.libraryPathVariableName() == QLatin1String("PATH") );
+    REQUIRE( environment.pathListSeparator() == QLatin1Char(';') );
+  }
+}
+
+TEST_CASE("toEnvironmentFileContent")
+{
+  RuntimeEnvironment environment(OperatingSystem::Linux);
+
+  SECTION("no directory")
+  {
+    REQUIRE( environment.toEnvironmentFileContent() == QLatin1String("LD_LIBRARY_PATH=\n") );
+  }
+
+  SECTION("2 directories")
+  {
+    environment.setLibraryDirectories({QLatin1String("/opt/a"),QLatin1String("/opt/b")});
+    const QString expectedContent = QLatin1String("LD_LIBRARY_PATH=")
+                                  + QDir::toNativeSeparators( QLatin1String("/opt/a") )
+                                  + QLatin1Char(':')
+                                  + QDir::toNativeSeparators( QLatin1String("/opt/b") )
+                                  + QLatin1Char('\n');
+    REQUIRE( environment.toEnvironmentFileContent() == expectedContent );
+  }
+}
+
+TEST_CASE("fromLibraries")
+{
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  REQUIRE( createDirectoryFromPath(root, "a") );
+  REQUIRE( createDirectoryFromPath(root, "b") );
+  const QString dirA = makePath(root, "a");
+  const QString dirB = makePath(root, "b");
+
+  const QString libA = makePath(root, "a/libA.so");
+  const QString libA2 = makePath(root, "a/libA2.so");
+  const QString libB = makePath(root, "b/libB.so");
+  REQUIRE( createTextFileUtf8( libA, QLatin1String("A") ) );
+  REQUIRE( createTextFileUtf8( libA2, QLatin1String("A2") ) );
+  REQUIRE( createTextFileUtf8( libB, QLatin1String("B") ) );
+
+  QFileInfoList libraries;
+
+  SECTION("no library")
+  {
+    const auto environment = RuntimeEnvironment::fromLibraries(OperatingSystem::Linux, libraries);
+    REQUIRE( environment.libraryDirectories().isEmpty() );
+  }
+
+  SECTION("each directory is listed once")
+  {
+    libraries << QFileInfo(libA) << QFileInfo(libA2);
+    const auto environment = RuntimeEnvironment::fromLibraries(OperatingSystem::Linux, libraries);
+    REQUIRE( environment.libraryDirectories() == QStringList{dirA} );
+  }
+
+  SECTION("without conflict, the order of the libraries is kept")
+  {
+    libraries << QFileInfo(libB) << QFileInfo(libA);
+    const auto environment = RuntimeEnvironment::fromLibraries(OperatingSystem::Linux, libraries);
+    REQUIRE( environment.libraryDirectories() == QStringList({dirB,dirA}) );
+  }
+
+  SECTION("a other file with the same name in a other directory")
+  {
+    // b contains a other libA.so, so a must come first
+    REQUIRE( createTextFileUtf8( makePath(root, "b/libA.so"), QLatin1String("other A") ) );
+    libraries << QFileInfo(libB) << QFileInfo(libA);
+    const auto environment = RuntimeEnvironment::fromLibraries(OperatingSystem::Linux, libraries);
+    REQUIRE( environment.libraryDirectories() == QStringList({dirA,dirB}) );
+  }
+
+  SECTION("no possible order")
+  {
+    REQUIRE( createTextFileUtf8( makePath(root, "b/libA.so"), QLatin1String("other A") ) );
+    REQUIRE( createTextFileUtf8( makePath(root, "a/libB.so"), QLatin1String("other B") ) );
+    libraries << QFileInfo(libA) << QFileInfo(libB);
+    REQUIRE_THROWS_AS( RuntimeEnvironment::fromLibraries(OperatingSystem::Linux, libraries), FindDependencyError );
+  }
+}
+
+TEST_CASE("fromDependencies")
+{
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  REQUIRE( createDirectoryFromPath(root, "a") );
+  REQUIRE( createDirectoryFromPath(root, "system") );
+  const QString dirA = makePath(root, "a");
+
+  const QString libA = makePath(root, "a/libA.so");
+  const QString libc = makePath(root, "system/libc.so.6");
+  REQUIRE( createTextFileUtf8( libA, QLatin1String("A") ) );
+  REQUIRE( createTextFileUtf8( libc, QLatin1String("c") ) );
+
+  BinaryDependenciesResult dependencies( QFileInfo( makePath(root, "app") ), OperatingSystem::Linux );
+  dependencies.addFoundLibrary( QFileInfo(libA), RPath() );
+  dependencies.addLibraryToNotRedistribute( QFileInfo(libc) );
+  REQUIRE( dependencies.isSolved() );
+
+  const auto environment = RuntimeEnvironment::fromDependencies(dependencies);
+
+  REQUIRE( environment.operatingSystem() == OperatingSystem::Linux );
+  REQUIRE( environment.libraryDirectories() == QStringList{dirA} );
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "TestFileUtils.h"
+#include "Mdt/DeployUtils/SearchPathIndex.h"
+#include <QString>
+#include <QStringList>
+#include <QLatin1String>
+#include <QTemporaryDir>
+
+using namespace Mdt::DeployUtils;
+
+TEST_CASE("fromDirectories")
+{
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  REQUIRE( createDirectoryFromPath(root, "a") );
+  REQUIRE( createDirectoryFromPath(root, "b") );
+  const QString dirA = makePath(root, "a");
+  const QString dirB = makePath(root, "b");
+  const QString dirC = makePath(root, "c");
+
+  REQUIRE( createTextFileUtf8( makePath(root, "a/libA.so"), QLatin1String("A") ) );
+  REQUIRE( createTextFileUtf8( makePath(root, "b/libA.so"), QLatin1String("A") ) );
+  REQUIRE( createTextFileUtf8( makePath(root, "b/libB.so"), QLatin1String("B") ) );
+
+  SECTION("no directory")
+  {
+    const auto index = SearchPathIndex::fromDirectories(QStringList(), Qt::CaseSensitive);
+    REQUIRE( index.isEmpty() );
+    REQUIRE( index.directoriesContaining( QLatin1String("libA.so") ).isEmpty() );
+  }
+
+  SECTION("the directories are returned in the given order")
+  {
+    auto index = SearchPathIndex::fromDirectories({dirA,dirB}, Qt::CaseSensitive);
+    REQUIRE( index.directoryCount() == 2 );
+    REQUIRE( index.fileCount() == 3 );
+    REQUIRE( index.directoriesContaining( QLatin1String("libA.so") ) == QStringList({dirA,dirB}) );
+    REQUIRE( index.directoriesContaining( QLatin1String("libB.so") ) == QStringList{dirB} );
+    REQUIRE( index.directoriesContaining( QLatin1String("libC.so") ).isEmpty() );
+
+    index = SearchPathIndex::fromDirectories({dirB,dirA}, Qt::CaseSensitive);
+    REQUIRE( index.directoriesContaining( QLatin1String("libA.so") ) == QStringList({dirB,dirA}) );
+  }
+
+  SECTION("a directory given twice is indexed once")
+  {
+    const auto index = SearchPathIndex::fromDirectories({dirA,dirB,dirA}, Qt::CaseSensitive);
+    REQUIRE( index.directoryCount() == 2 );
+    REQUIRE( index.directoriesContaining( QLatin1String("libA.so") ) == QStringList({dirA,dirB}) );
+  }
+
+  SECTION("a non existing directory is indexed as empty")
+  {
+    const auto index = SearchPathIndex::fromDirectories({dirC,dirA}, Qt::CaseSensitive);
+    REQUIRE( index.isIndexedDirectory(dirC) );
+    REQUIRE( !index.directoryContains( dirC, QLatin1String("libA.so") ) );
+    REQUIRE( index.directoriesContaining( QLatin1String("libA.so") ) == QStringList{dirA} );
+  }
+
+  SECTION("directoryContains")
+  {
+    const auto index = SearchPathIndex::fromDirectories({dirA,dirB}, Qt::CaseSensitive);
+    REQUIRE( index.isIndexedDirectory(dirA) );
+    REQUIRE( !index.isIndexedDirectory(dirC) );
+    REQUIRE( index.directoryContains( dirA, QLatin1String("libA.so") ) );
+    REQUIRE( !index.directoryContains( dirA, QLatin1String("libB.so") ) );
+    REQUIRE( index.directoryContains( dirB, QLatin1String("libB.so") ) );
+  }
+
+  SECTION("case sensitive")
+  {
+    const auto index = SearchPathIndex::fromDirectories({dirA,dirB}, Qt::CaseSensitive);
+    REQUIRE( index.directoriesContaining( QLatin1String("LIBB.SO") ).isEmpty() );
+  }
+
+  SECTION("case insensitive")
+  {
+    const auto index = SearchPathIndex::fromDirectories({dirA,dirB}, Qt::CaseInsensitive);
+    REQUIRE( index.directoriesContaining( QLatin1String("LIBB.SO") ) == QStringList{dirB} );
+    REQUIRE( index.directoryContains( dirA, QLatin1String("LibA.So") ) );
+  }
+}
@@ -29,11 +29,16 @@
 #include "Mdt/DeployUtils/MessageLogger.h"
 #include "Mdt/DeployUtils/ConsoleMessageLogger.h"
 #include "Mdt/DeployUtils/RPath.h"
+#include "Mdt/DeployUtils/FindDependencyError.h"
 #include <Mdt/ExecutableFile/ExecutableFileReader.h>
+#include <Mdt/ExecutableFile/ExecutableFileWriter.h>
 #include <QLatin1String>
 #include <QString>
 #include <QStringList>
 #include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
 #include <memory>
 
 using namespace Mdt::DeployUtils;
@@ -265,3 +270,38 @@ TEST_CASE("copySharedLibrariesTargetDependsOn")
     REQUIRE( getTestSharedLibraryRunPath(destinationDir).entryAt(0).path() == QLatin1String(".") );
   }
 }
+
+#ifdef Q_OS_LINUX
+TEST_CASE("copySharedLibrariesTargetDependsOn_pipelinedNotSolved")
+{
+  QTemporaryDir targetDir;
+  REQUIRE( targetDir.isValid() );
+  QTemporaryDir destinationDir;
+  REQUIRE( destinationDir.isValid() );
+
+  /*
+   * A copy of the executable without RPATH,
+   * and no search prefix path,
+   * so libtestSharedLibrary can not be found
+   */
+  const QString targetFilePath = makePath(targetDir, "testExecutableDynamic");
+  REQUIRE( QFile::copy(testExecutableFilePath, targetFilePath) );
+  Mdt::ExecutableFile::ExecutableFileWriter writer;
+  writer.openFile( QFileInfo(targetFilePath), Platform::nativePlatform() );
+  writer.setRunPath( RPath() );
+  writer.close();
+
+  MessageLogger messageLogger;
+
+  auto qtDistributionDirectory = std::make_shared<QtDistributionDirectory>();
+  SharedLibrariesDeployer deployer(qtDistributionDirectory);
+  doDeployerCommonSetup(deployer);
+  deployer.setSearchPrefixPathList( PathList() );
+  deployer.setOverwriteBehavior(OverwriteBehavior::Fail);
+  deployer.setPipelinedCopy(true);
+
+  REQUIRE_THROWS_AS( deployer.copySharedLibrariesTargetDependsOn( QFileInfo(targetFilePath), destinationDir.path() ), FindDependencyError );
+  // The libraries that where found, like Qt5Core, have been copied, then removed
+  REQUIRE( QDir( destinationDir.path() ).entryList(QDir::Files).isEmpty() );
+}
+#endif // #ifdef Q_OS_LINUX
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "TestFileUtils.h"
+#include "Mdt/DeployUtils/Impl/SharedLibraryCopyPipeline.h"
+#include "Mdt/DeployUtils/FileCopyError.h"
+#include <QTemporaryDir>
+#include <QDir>
+#include <QString>
+#include <QStringList>
+#include <QLatin1String>
+#include <memory>
+
+using namespace Mdt::DeployUtils;
+using Impl::SharedLibraryCopyPipeline;
+
+TEST_CASE("copy")
+{
+  QTemporaryDir sourceRoot;
+  REQUIRE( sourceRoot.isValid() );
+  QTemporaryDir destinationRoot;
+  REQUIRE( destinationRoot.isValid() );
+
+  const QString libA = makePath(sourceRoot, "libA.so");
+  const QString libB = makePath(sourceRoot, "libB.so");
+  REQUIRE( createTextFileUtf8( libA, QLatin1String("A") ) );
+  REQUIRE( createTextFileUtf8( libB, QLatin1String("B") ) );
+
+  SharedLibraryCopyPipeline pipeline( destinationRoot.path() );
+  pipeline.start();
+  REQUIRE( pipeline.isRunning() );
+
+  SECTION("libraries are copied")
+  {
+    pipeline.enqueue(libA);
+    pipeline.enqueue(libB);
+    const auto copiedFiles = pipeline.finish();
+
+    REQUIRE( !pipeline.isRunning() );
+    REQUIRE( copiedFiles.size() == 2 );
+    REQUIRE( readTextFileUtf8( makePath(destinationRoot, "libA.so") ) == QLatin1String("A") );
+    REQUIRE( readTextFileUtf8( makePath(destinationRoot, "libB.so") ) == QLatin1String("B") );
+  }
+
+  SECTION("a library enqueued twice is copied once")
+  {
+    pipeline.enqueue(libA);
+    pipeline.enqueue(libA);
+    REQUIRE( pipeline.enqueuedCount() == 1 );
+
+    const auto copiedFiles = pipeline.finish();
+    REQUIRE( copiedFiles.size() == 1 );
+  }
+
+  SECTION("nothing enqueued")
+  {
+    const auto copiedFiles = pipeline.finish();
+    REQUIRE( copiedFiles.empty() );
+  }
+}
+
+TEST_CASE("abort")
+{
+  QTemporaryDir sourceRoot;
+  REQUIRE( sourceRoot.isValid() );
+  QTemporaryDir destinationRoot;
+  REQUIRE( destinationRoot.isValid() );
+
+  const QString libA = makePath(sourceRoot, "libA.so");
+  const QString libB = makePath(sourceRoot, "libB.so");
+  REQUIRE( createTextFileUtf8( libA, QLatin1String("A") ) );
+  REQUIRE( createTextFileUtf8( libB, QLatin1String("B") ) );
+
+  const QString existingLibB = makePath(destinationRoot, "libB.so");
+  REQUIRE( createTextFileUtf8( existingLibB, QLatin1String("existing B") ) );
+
+  SECTION("created files are removed")
+  {
+    SharedLibraryCopyPipeline pipeline( destinationRoot.path() );
+    pipeline.setOverwriteBehavior(OverwriteBehavior::Overwrite);
+    pipeline.start();
+    pipeline.enqueue(libA);
+    pipeline.enqueue(libB);
+    pipeline.abort();
+
+    REQUIRE( !pipeline.isRunning() );
+    REQUIRE( !fileExists( makePath(destinationRoot, "libA.so") ) );
+    REQUIRE( readTextFileUtf8(existingLibB) == QLatin1String("existing B") );
+    REQUIRE( QDir( destinationRoot.path() ).entryList(QDir::Files) == QStringList{QLatin1String("libB.so")} );
+  }
+
+  SECTION("overwritten files are restored")
+  {
+    SharedLibraryCopyPipeline pipeline( destinationRoot.path() );
+    pipeline.setOverwriteBehavior(OverwriteBehavior::Overwrite);
+    pipeline.start();
+    pipeline.enqueue(libA);
+    pipeline.enqueue(libB);
+    const auto copiedFiles = pipeline.finish();
+    REQUIRE( copiedFiles.size() == 2 );
+    REQUIRE( readTextFileUtf8(existingLibB) == QLatin1String("B") );
+
+    // For example, changing the RPATH failed
+    pipeline.rollback();
+
+    REQUIRE( !fileExists( makePath(destinationRoot, "libA.so") ) );
+    REQUIRE( readTextFileUtf8(existingLibB) == QLatin1String("existing B") );
+    REQUIRE( QDir( destinationRoot.path() ).entryList(QDir::Files) == QStringList{QLatin1String("libB.so")} );
+  }
+
+  SECTION("backups are removed once the pipeline is destroyed")
+  {
+    {
+      SharedLibraryCopyPipeline pipeline( destinationRoot.path() );
+      pipeline.setOverwriteBehavior(OverwriteBehavior::Overwrite);
+      pipeline.start();
+      pipeline.enqueue(libA);
+      pipeline.enqueue(libB);
+      pipeline.finish();
+    }
+
+    REQUIRE( readTextFileUtf8(existingLibB) == QLatin1String("B") );
+    REQUIRE( QDir( destinationRoot.path() ).entryList(QDir::Files, QDir::Name) == QStringList{QLatin1String("libA.so"),QLatin1String("libB.so")} );
+  }
+
+  SECTION("destruct a running pipeline")
+  {
+    {
+      SharedLibraryCopyPipeline pipeline( destinationRoot.path() );
+      pipeline.setOverwriteBehavior(OverwriteBehavior::Keep);
+      pipeline.start();
+      pipeline.enqueue(libA);
+      pipeline.enqueue(libB);
+    }
+
+    REQUIRE( !fileExists( makePath(destinationRoot, "libA.so") ) );
+    REQUIRE( readTextFileUtf8(existingLibB) == QLatin1String("existing B") );
+  }
+}
+
+TEST_CASE("copyError")
+{
+  QTemporaryDir sourceRoot;
+  REQUIRE( sourceRoot.isValid() );
+  QTemporaryDir destinationRoot;
+  REQUIRE( destinationRoot.isValid() );
+
+  const QString libA = makePath(sourceRoot, "libA.so");
+  const QString libB = makePath(sourceRoot, "libB.so");
+  REQUIRE( createTextFileUtf8( libA, QLatin1String("A") ) );
+  REQUIRE( createTextFileUtf8( libB, QLatin1String("B") ) );
+
+  const QString existingLibB = makePath(destinationRoot, "libB.so");
+  REQUIRE( createTextFileUtf8( existingLibB, QLatin1String("existing B") ) );
+
+  SharedLibraryCopyPipeline pipeline( destinationRoot.path() );
+  pipeline.setOverwriteBehavior(OverwriteBehavior::Fail);
+  pipeline.start();
+  pipeline.enqueue(libA);
+  pipeline.enqueue(libB);
+
+  REQUIRE_THROWS_AS( pipeline.finish(), FileCopyError );
+  REQUIRE( !pipeline.isRunning() );
+  REQUIRE( !fileExists( makePath(destinationRoot, "libA.so") ) );
+  REQUIRE( readTextFileUtf8(existingLibB) == QLatin1String("existing B") );
+}
@@ -24,6 +24,7 @@
 #include "Mdt/DeployUtils/QtDistributionDirectory.h"
 #include "Mdt/DeployUtils/SharedLibraryFinderLinux.h"
 #include "Mdt/DeployUtils/RPath.h"
+#include "Mdt/DeployUtils/LibraryLookupMissCache.h"
 #include <QLatin1String>
 #include <QString>
 #include <memory>
@@ -47,3 +48,50 @@ TEST_CASE("findLibraryAbsolutePath")
     REQUIRE_THROWS_AS( finder.findLibraryAbsolutePath(libraryName, dependentFile), FindDependencyError );
   }
 }
+
+TEST_CASE("findLibraryAbsolutePath_lookupMissCache")
+{
+  const QString libraryName = QLatin1String("libA.so");
+  auto dependentFile = makeBinaryDependenciesFileFromUtf8Path("/tmp/executable");
+  auto isExistingSharedLibraryOp = std::make_shared<TestIsExistingSharedLibrary>();
+  auto qtDistributionDirectory = std::make_shared<QtDistributionDirectory>();
+  SharedLibraryFinderLinux finder(isExistingSharedLibraryOp, qtDistributionDirectory);
+  auto cache = std::make_shared<LibraryLookupMissCache>();
+  finder.setLookupMissCache(cache);
+  finder.setSearchPathList( makePathListFromUtf8Paths({"/tmp","/opt"}) );
+  isExistingSharedLibraryOp->setExistingSharedLibraries({"/usr/lib/libA.so"});
+
+  REQUIRE_THROWS_AS( finder.findLibraryAbsolutePath(libraryName, dependentFile), FindDependencyError );
+  REQUIRE( finder.probeCount() == 2 );
+  REQUIRE( cache->count() == 1 );
+
+  SECTION("search again in the same context")
+  {
+    REQUIRE_THROWS_AS( finder.findLibraryAbsolutePath(libraryName, dependentFile), FindDependencyError );
+
+    REQUIRE( finder.probeCount() == 2 );
+    REQUIRE( cache->hitCount() == 1 );
+    REQUIRE( cache->savedProbeCount() == 2 );
+  }
+
+  SECTION("a other dependent file with the same rpath has the same context")
+  {
+    auto otherDependentFile = makeBinaryDependenciesFileFromUtf8Path("/tmp/otherExecutable");
+
+    REQUIRE_THROWS_AS( finder.findLibraryAbsolutePath(libraryName, otherDependentFile), FindDependencyError );
+
+    REQUIRE( finder.probeCount() == 2 );
+    REQUIRE( cache->hitCount() == 1 );
+  }
+
+  SECTION("a dependent file with a other rpath has a other context")
+  {
+    auto otherDependentFile = makeBinaryDependenciesFileFromUtf8Path("/tmp/otherExecutable");
+    otherDependentFile.setRPath( makeRPathFromUtf8Paths({"/usr/lib"}) );
+
+    const auto library = finder.findLibraryAbsolutePath(libraryName, otherDependentFile);
+
+    REQUIRE( library.absoluteFilePath() == makeAbsolutePath("/usr/lib/libA.so") );
+    REQUIRE( cache->hitCount() == 0 );
+  }
+}
@@ -28,14 +28,41 @@
 #include "Mdt/DeployUtils/RPath.h"
 #include "Mdt/DeployUtils/MessageLogger.h"
 #include "Mdt/DeployUtils/ConsoleMessageLogger.h"
+#include "Mdt/DeployUtils/AbstractMessageSink.h"
 #include <QLatin1String>
 #include <QString>
+#include <QStringList>
+#include <QFileInfo>
 #include <QtGlobal>
 #include <QTemporaryDir>
 #include <memory>
 
 using namespace Mdt::DeployUtils;
 
+class TestMessageSink : public AbstractMessageSink
+{
+ public:
+
+  void status(const QString & message) override
+  {
+    statusMessages.append(message);
+  }
+
+  void verbose(const QString & message) override
+  {
+    verboseMessages.append(message);
+  }
+
+  void debug(const QString & message) override
+  {
+    debugMessages.append(message);
+  }
+
+  QStringList statusMessages;
+  QStringList verboseMessages;
+  QStringList debugMessages;
+};
+
 TEST_CASE("OperatingSystem")
 {
   auto isExistingSharedLibraryOp = std::make_shared<TestIsExistingSharedLibrary>();
@@ -95,6 +122,11 @@ TEST_CASE("libraryShouldBeDistributed")
   {
     REQUIRE( !finder.libraryShouldBeDistributed( QLatin1String("ld-linux.so.2") ) );
   }
+
+  SECTION("libdbus-1.so.3 should not be distributed")
+  {
+    REQUIRE( !finder.libraryShouldBeDistributed( QLatin1String("libdbus-1.so.3") ) );
+  }
 }
 
 TEST_CASE("makeDirectoryFromRpathEntry")
@@ -199,9 +231,97 @@ TEST_CASE("findLibraryAbsolutePath")
   }
 }
 
+TEST_CASE("findLibraryAbsolutePath_searchPathIndex")
+{
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+  REQUIRE( createDirectoryFromPath(root, "a") );
+  REQUIRE( createDirectoryFromPath(root, "b") );
+  const QString dirA = makePath(root, "a");
+  const QString dirB = makePath(root, "b");
+  const QString libAInDirB = makePath(root, "b/libA.so");
+  REQUIRE( createTextFileUtf8( libAInDirB, QLatin1String("A") ) );
+
+  const QString libraryName = QLatin1String("libA.so");
+  auto dependentFile = makeBinaryDependenciesFileFromUtf8Path("/tmp/executable");
+  auto isExistingSharedLibraryOp = std::make_shared<TestIsExistingSharedLibrary>();
+  auto qtDistributionDirectory = std::make_shared<QtDistributionDirectory>();
+  SharedLibraryFinderLinux finder(isExistingSharedLibraryOp, qtDistributionDirectory);
+
+  finder.setSearchPathList( PathList::fromStringList({dirA,dirB}) );
+  /*
+   * The test operator tells that a/libA.so exists,
+   * but it is not in a, so the index does not list a as candidate
+   */
+  isExistingSharedLibraryOp->appendExistingSharedLibrary( QFileInfo(dirA, libraryName) );
+  isExistingSharedLibraryOp->appendExistingSharedLibrary( QFileInfo(libAInDirB) );
+
+  SECTION("without index, each directory is probed")
+  {
+    REQUIRE( !finder.hasSearchPathIndex() );
+    REQUIRE( finder.searchPathCandidateDirectories(libraryName) == QStringList({dirA,dirB}) );
+    auto library = finder.findLibraryAbsolutePath(libraryName, dependentFile);
+    REQUIRE( library.absoluteFilePath() == QFileInfo(dirA, libraryName).absoluteFilePath() );
+  }
+
+  SECTION("with index, only directories that contain the library are probed")
+  {
+    finder.buildSearchPathIndex();
+    REQUIRE( finder.hasSearchPathIndex() );
+    REQUIRE( finder.searchPathCandidateDirectories(libraryName) == QStringList{dirB} );
+    REQUIRE( finder.lookupCandidateDirectories(libraryName, dependentFile) == QStringList{dirB} );
+    auto library = finder.findLibraryAbsolutePath(libraryName, dependentFile);
+    REQUIRE( library.absoluteFilePath() == QFileInfo(libAInDirB).absoluteFilePath() );
+    REQUIRE( finder.probeCount() == 1 );
+  }
+
+  SECTION("setting the search path list clears the index")
+  {
+    finder.buildSearchPathIndex();
+    finder.setSearchPathList( PathList::fromStringList({dirA}) );
+    REQUIRE( !finder.hasSearchPathIndex() );
+  }
+}
+
 /*
  * see https://gitlab.com/scandyna/mdtdeployutils/-/issues/1
  */
+TEST_CASE("messageSink")
+{
+  const QString libraryName = QLatin1String("libA.so");
+  auto dependentFile = makeBinaryDependenciesFileFromUtf8Path("/tmp/executable");
+  auto isExistingSharedLibraryOp = std::make_shared<TestIsExistingSharedLibrary>();
+  auto qtDistributionDirectory = std::make_shared<QtDistributionDirectory>();
+  SharedLibraryFinderLinux finder(isExistingSharedLibraryOp, qtDistributionDirectory);
+
+  finder.setSearchPathList( PathList::fromStringList({QLatin1String("/tmp/a"),QLatin1String("/tmp/b")}) );
+  isExistingSharedLibraryOp->setExistingSharedLibraries({"/tmp/b/libA.so"});
+
+  int signalCount = 0;
+  QObject::connect(&finder, &SharedLibraryFinderLinux::verboseMessage, [&signalCount](){ ++signalCount; });
+  QObject::connect(&finder, &SharedLibraryFinderLinux::debugMessage, [&signalCount](){ ++signalCount; });
+
+  auto sink = std::make_shared<TestMessageSink>();
+  finder.setMessageSink(sink);
+  REQUIRE( finder.messageSink() == sink.get() );
+
+  SECTION("messages are written to the sink instead of being emitted")
+  {
+    finder.findLibraryAbsolutePath(libraryName, dependentFile);
+    REQUIRE( !sink->verboseMessages.isEmpty() );
+    REQUIRE( sink->debugMessages.count() == 2 );
+    REQUIRE( signalCount == 0 );
+  }
+
+  SECTION("messages are only written if the log level requires them")
+  {
+    finder.setLogLevel(LogLevel::Verbose);
+    finder.findLibraryAbsolutePath(libraryName, dependentFile);
+    REQUIRE( !sink->verboseMessages.isEmpty() );
+    REQUIRE( sink->debugMessages.isEmpty() );
+  }
+}
+
 TEST_CASE("find_Qt5Core_inValidDirectory")
 {
   QTemporaryDir qtRoot;
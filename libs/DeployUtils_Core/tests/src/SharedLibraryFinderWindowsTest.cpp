@@ -300,6 +300,11 @@ TEST_CASE("libraryShouldBeDistributed")
   {
     REQUIRE( !finder.libraryShouldBeDistributed( QLatin1String("kernel32.dll") ) );
   }
+
+  SECTION("Imm32.dll should not be distributed")
+  {
+    REQUIRE( !finder.libraryShouldBeDistributed( QLatin1String("Imm32.dll") ) );
+  }
 }
 
 TEST_CASE("buildSearchPathList")
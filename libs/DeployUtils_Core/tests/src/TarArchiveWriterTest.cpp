@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/****************************************************************************
+ **
+ ** MdtDeployUtils - A C++ library to help deploy C++ compiled binaries
+ **
+ ** Copyright (C) 2023-2023 Philippe Steinmann.
+ **
+ ****************************************************************************/
+#include "catch2/catch.hpp"
+#include "Catch2QString.h"
+#include "TestFileUtils.h"
+#include "Mdt/DeployUtils/TarArchiveWriter.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QString>
+#include <QByteArray>
+#include <QLatin1String>
+#include <QLatin1Char>
+
+using namespace Mdt::DeployUtils;
+
+QByteArray headerField(const QByteArray & header, int offset, int size)
+{
+  return QByteArray( header.constData() + offset, size );
+}
+
+QByteArray headerString(const QByteArray & header, int offset, int size)
+{
+  const QByteArray field = headerField(header, offset, size);
+  const int end = field.indexOf('\0');
+
+  return end < 0 ? field : field.left(end);
+}
+
+bool headerChecksumIsValid(const QByteArray & header)
+{
+  qint64 checksum = 0;
+  for(int i = 0; i < 512; ++i){
+    if( (i >= 148) && (i < 156) ){
+      checksum += ' ';
+    }else{
+      checksum += static_cast<unsigned char>( header.at(i) );
+    }
+  }
+
+  return headerString(header, 148, 8).trimmed().toLongLong(nullptr, 8) == checksum;
+}
+
+QByteArray readFile(const QString & filePath)
+{
+  QFile file(filePath);
+  if( !file.open(QIODevice::ReadOnly) ){
+    return QByteArray();
+  }
+
+  return file.readAll();
+}
+
+TEST_CASE("compressionFromFilePath")
+{
+  REQUIRE( TarArchiveWriter::compressionFromFilePath( QLatin1String("/tmp/app.tar") ) == ArchiveCompression::None );
+  REQUIRE( TarArchiveWriter::compressionFromFilePath( QLatin1String("/tmp/app.tar.zst") ) == ArchiveCompression::Zstd );
+  REQUIRE( TarArchiveWriter::compressionFromFilePath( QLatin1String("/tmp/app.tzst") ) == ArchiveCompression::Zstd );
+}
+
+TEST_CASE("modeFromPermissions")
+{
+  const QFileDevice::Permissions permissions = QFileDevice::ReadOwner | QFileDevice::WriteOwner | QFileDevice::ExeOwner
+                                             | QFileDevice::ReadGroup | QFileDevice::ExeGroup
+                                             | QFileDevice::ReadOther | QFileDevice::ExeOther;
+
+  REQUIRE( TarArchiveWriter::modeFromPermissions(permissions) == 0755 );
+}
+
+TEST_CASE("makeEntryHeader")
+{
+  SECTION("file")
+  {
+    const QByteArray header = TarArchiveWriter::makeEntryHeader(QLatin1String("app/bin/app"), '0', 5, 0755, 1000);
+
+    REQUIRE( header.size() == 512 );
+    REQUIRE( headerString(header, 0, 100) == "app/bin/app" );
+    REQUIRE( headerString(header, 100, 8) == "0000755" );
+    REQUIRE( headerString(header, 124, 12) == "00000000005" );
+    REQUIRE( headerString(header, 136, 12) == "00000001750" );
+    REQUIRE( header.at(156) == '0' );
+    REQUIRE( headerField(header, 257, 6) == QByteArray("ustar", 6) );
+    REQUIRE( headerField(header, 263, 2) == "00" );
+    REQUIRE( headerChecksumIsValid(header) );
+  }
+
+  SECTION("directory")
+  {
+    const QByteArray header = TarArchiveWriter::makeEntryHeader(QLatin1String("app/bin"), '5', 0, 0755, 1000);
+
+    REQUIRE( header.size() == 512 );
+    REQUIRE( headerString(header, 0, 100) == "app/bin/" );
+    REQUIRE( header.at(156) == '5' );
+    REQUIRE( headerChecksumIsValid(header) );
+  }
+
+  SECTION("path split in prefix and name")
+  {
+    const QString directory = QLatin1String("app/") + QString( 120, QLatin1Char('d') );
+    const QString name = QString( 90, QLatin1Char('n') );
+    const QByteArray header = TarArchiveWriter::makeEntryHeader(directory + QLatin1Char('/') + name, '0', 0, 0644, 1000);
+
+    REQUIRE( header.size() == 512 );
+    REQUIRE( headerString(header, 0, 100) == name.toUtf8() );
+    REQUIRE( headerString(header, 345, 155) == directory.toUtf8() );
+    REQUIRE( headerChecksumIsValid(header) );
+  }
+
+  SECTION("path too long for ustar")
+  {
+    const QString path = QLatin1String("app/") + QString( 300, QLatin1Char('v') );
+    const QByteArray header = TarArchiveWriter::makeEntryHeader(path, '0', 0, 0644, 1000);
+
+    REQUIRE( header.size() == 3*512 );
+    REQUIRE( header.at(156) == 'x' );
+    REQUIRE( headerChecksumIsValid( header.left(512) ) );
+    const QByteArray record = "314 path=" + path.toUtf8() + '\n';
+    REQUIRE( header.mid(512, record.size()) == record );
+    REQUIRE( header.at(2*512 + 156) == '0' );
+    REQUIRE( headerChecksumIsValid( header.mid(2*512) ) );
+  }
+}
+
+TEST_CASE("writeTarArchive")
+{
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  const QString sourceFilePath = makePath(root, "app");
+  REQUIRE( createTextFileUtf8(sourceFilePath, QLatin1String("hello")) );
+
+  const QString archiveFilePath = makePath(root, "archives/app.tar");
+
+  TarArchiveWriter writer;
+  writer.open(archiveFilePath);
+  REQUIRE( writer.isOpen() );
+  REQUIRE( writer.compression() == ArchiveCompression::None );
+
+  writer.addDirectory( QLatin1String("app/bin") );
+  writer.addFile( QLatin1String("app/bin/app"), sourceFilePath );
+  writer.addFileData( QLatin1String("app/bin/qt.conf"), "[Paths]\n" );
+  writer.close();
+  REQUIRE( !writer.isOpen() );
+
+  REQUIRE( fileExists(archiveFilePath) );
+  REQUIRE( !fileExists( archiveFilePath + QLatin1String(".part") ) );
+
+  const QByteArray archive = readFile(archiveFilePath);
+  REQUIRE( archive.size() == 7*512 );
+  REQUIRE( archive.size() == writer.writtenByteCount() );
+  REQUIRE( headerString(archive, 0, 100) == "app/bin/" );
+  REQUIRE( headerString(archive, 512, 100) == "app/bin/app" );
+  REQUIRE( archive.mid(2*512, 5) == "hello" );
+  REQUIRE( headerString(archive, 3*512, 100) == "app/bin/qt.conf" );
+  REQUIRE( archive.mid(4*512, 8) == "[Paths]\n" );
+  REQUIRE( archive.mid(5*512) == QByteArray(2*512, '\0') );
+}
+
+TEST_CASE("discardUnfinishedArchive")
+{
+  QTemporaryDir root;
+  REQUIRE( root.isValid() );
+
+  const QString archiveFilePath = makePath(root, "app.tar");
+
+  {
+    TarArchiveWriter writer;
+    writer.open(archiveFilePath);
+    writer.addDirectory( QLatin1String("app") );
+  }
+
+  REQUIRE( !fileExists(archiveFilePath) );
+  REQUIRE( !fileExists( archiveFilePath + QLatin1String(".part") ) );
+}
@@ -12,49 +12,40 @@
 
 excludeListSourceURL=https://raw.githubusercontent.com/probonopd/AppImages/master/excludelist
 
-headerFileName=LibraryExcludeListLinux.h
-destinationFile=$(readlink -f $(dirname "$0"))/../libs/DeployUtils_Core/src/Mdt/DeployUtils/Impl/$headerFileName
+listFileName=LibraryExcludeListLinux.txt
+destinationFile=$(readlink -f $(dirname "$0"))/../libs/DeployUtils_Core/src/LibraryExcludeLists/$listFileName
 
 excludeList=($(wget --quiet $excludeListSourceURL -O - | sort | uniq | cut -d '#' -f 1 | grep -v "^#.*" | grep "[^-\s]"))
 if [ "$excludeList" == "" ];
 then
-  echo "generate $headerFileName failed: got a empty exclude list from $excludeListSourceURL"
+  echo "generate $listFileName failed: got a empty exclude list from $excludeListSourceURL"
   exit 1;
 fi
 
-
+# The build generates the perfect hash table from this file
+# (see libs/DeployUtils_Core/src/LibraryExcludeLists/GenerateLibraryExcludeList.cmake)
 cat > "$destinationFile" <<EOF
-/*
- * List of libraries to exclude for different reasons.
- *
- * Automatically generated from
- * https://raw.githubusercontent.com/probonopd/AppImages/master/excludelist
- *
- * This file shall be committed by the developers occassionally,
- * otherwise systems without access to the internet won't be able to build
- * fully working versions of MdtDeployUtils.
- *
- * See https://github.com/probonopd/linuxdeployqt/issues/274 for more
- * information.
- *
- * Credits: https://github.com/probonopd/linuxdeployqt
- */
-#ifndef MDT_DEPLOY_UTILS_IMPL_LIBRARY_EXCLUDE_LIST_LINUX_H
-#define MDT_DEPLOY_UTILS_IMPL_LIBRARY_EXCLUDE_LIST_LINUX_H
-
-#include <QStringList>
-#include <QLatin1String>
+# List of libraries to exclude for different reasons.
+#
+# Taken from
+# https://raw.githubusercontent.com/probonopd/AppImages/master/excludelist
+#
+# This file shall be updated by the developers occassionally,
+# otherwise systems without access to the internet won't be able to build
+# fully working versions of MdtDeployUtils.
+# The format is the one of the upstream excludelist,
+# so a new snapshot can simply replace this file.
+# The perfect hash table is regenerated by the build
+# (see GenerateLibraryExcludeList.cmake).
+#
+# See https://github.com/probonopd/linuxdeployqt/issues/274 for more
+# information.
+#
+# Credits: https://github.com/probonopd/linuxdeployqt
 
-static
-const QStringList libraryExcludelistLinux = {
 EOF
 
-for item in ${excludeList[@]:0:${#excludeList[@]}-1};
+for item in ${excludeList[@]};
 do
-  echo -e '  QLatin1String("'"$item"'"),' >> "$destinationFile"
+  echo "$item" >> "$destinationFile"
 done
-echo -e '  QLatin1String("'"${excludeList[$((${#excludeList[@]}-1))]}"'")' >> "$destinationFile"
-
-echo "};" >> "$destinationFile"
-echo "" >> "$destinationFile"
-echo "#endif // #ifndef MDT_DEPLOY_UTILS_IMPL_LIBRARY_EXCLUDE_LIST_LINUX_H" >> "$destinationFile"